@@ -209,6 +209,69 @@ aom_codec_err_t aom_codec_decode(aom_codec_ctx_t *ctx, const uint8_t *data,
  */
 aom_image_t *aom_codec_get_frame(aom_codec_ctx_t *ctx, aom_codec_iter_t *iter);
 
+/*!\defgroup decode_batch Batched Decoding of Many Streams
+ *
+ * Decodes temporal units of many independent streams on a pool of threads
+ * shared by all of them. Meant for the decoding of many small streams, whose
+ * frames are too small for the tile and row threads of a single decoder.
+ * The decoders of the streams are best created with a single thread.
+ * @{
+ */
+
+/*!\brief Temporal unit of a stream to decode with aom_codec_decode_batch().
+ */
+typedef struct aom_codec_decode_job {
+  aom_codec_ctx_t *ctx; /**< Decoder of the stream */
+  const uint8_t *data;  /**< Coded data, as passed to aom_codec_decode() */
+  size_t data_sz;       /**< Size of the coded data, in bytes */
+  void *user_priv;      /**< Passed to aom_codec_decode() */
+  aom_codec_err_t res;  /**< Result of aom_codec_decode(), set on return */
+} aom_codec_decode_job_t;
+
+/*!\brief Pool of threads shared by batched decodes (opaque).
+ */
+typedef struct aom_codec_dec_pool aom_codec_dec_pool_t;
+
+/*!\brief Creates a pool of threads for aom_codec_decode_batch().
+ *
+ * \param[in] num_threads  Number of threads to decode with, including the
+ *                         thread calling aom_codec_decode_batch().
+ *
+ * \return Returns the pool, or NULL if it could not be created.
+ */
+aom_codec_dec_pool_t *aom_codec_dec_pool_create(unsigned int num_threads);
+
+/*!\brief Destroys a pool created with aom_codec_dec_pool_create().
+ *
+ * \param[in] pool  Pool to destroy. May be NULL.
+ */
+void aom_codec_dec_pool_destroy(aom_codec_dec_pool_t *pool);
+
+/*!\brief Decodes a batch of temporal units of different streams
+ *
+ * Runs aom_codec_decode() on each of the jobs, spreading them over the
+ * threads of the pool, and returns once all of them are done. Each decoder
+ * context \ref MUST appear in at most one job of a batch. The frames of each
+ * stream are then retrieved with aom_codec_get_frame() on its context.
+ *
+ * \param[in]     pool      Pool of threads to decode on
+ * \param[in,out] jobs      Temporal units to decode. The res member of each
+ *                          is set to the result of its decode.
+ * \param[in]     num_jobs  Number of jobs
+ *
+ * \retval #AOM_CODEC_OK
+ *     All the temporal units were decoded.
+ * \retval #AOM_CODEC_INVALID_PARAM
+ *     The pool or the jobs are NULL.
+ * \retval #AOM_CODEC_ERROR
+ *     At least one of the decodes failed. See the res member of the jobs.
+ */
+aom_codec_err_t aom_codec_decode_batch(aom_codec_dec_pool_t *pool,
+                                       aom_codec_decode_job_t *jobs,
+                                       unsigned int num_jobs);
+
+/*!@} - end defgroup decode_batch */
+
 /*!\defgroup cap_external_frame_buffer External Frame Buffer Functions
  *
  * The following function is required to be implemented for all decoders
@@ -1518,6 +1518,33 @@ enum aome_enc_control_id {
    */
   AV1E_GET_LUMA_CDEF_STRENGTH = 162,
 
+  /*!\brief Codec control function to set a per-frame encode time budget in
+   * microseconds for real-time encoding, unsigned int parameter
+   *
+   * When set, the encoder measures the time spent on each frame and raises
+   * the speed level above the one set by AOME_SET_CPUUSED while frames take
+   * longer than the budget, then lowers it again once there is headroom.
+   * Only takes effect in realtime mode with one pass at speed 7 or above.
+   *
+   * - 0 = disable (default)
+   */
+  AV1E_SET_FRAME_TIME_BUDGET = 163,
+
+  /*!\brief Codec control function to run the lookahead analysis stage on a
+   * thread of its own, int parameter
+   *
+   * With one pass and a lookahead (lag_in_frames of 2 or more), the first pass
+   * analysis of each pushed frame then runs next to the encode of the
+   * previous frames instead of before it. The main encoder sees the stats of
+   * the most recent frame one call later, so the output differs from the
+   * synchronous analysis but stays deterministic. Not available in realtime
+   * mode.
+   *
+   * - 0 = disable (default)
+   * - 1 = enable
+   */
+  AV1E_SET_ASYNC_LOOKAHEAD = 164,
+
   // Any new encoder control IDs should be added above.
   // Maximum allowed encoder control ID is 229.
   // No encoder control ID should be added below.
@@ -2160,6 +2187,12 @@ AOM_CTRL_USE_TYPE(AV1E_SET_RATE_DISTRIBUTION_INFO, const char *)
 AOM_CTRL_USE_TYPE(AV1E_GET_LUMA_CDEF_STRENGTH, int *)
 #define AOM_CTRL_AV1E_GET_LUMA_CDEF_STRENGTH
 
+AOM_CTRL_USE_TYPE(AV1E_SET_FRAME_TIME_BUDGET, unsigned int)
+#define AOM_CTRL_AV1E_SET_FRAME_TIME_BUDGET
+
+AOM_CTRL_USE_TYPE(AV1E_SET_ASYNC_LOOKAHEAD, int)
+#define AOM_CTRL_AV1E_SET_ASYNC_LOOKAHEAD
+
 /*!\endcond */
 /*! @} - end defgroup aom_encoder */
 #ifdef __cplusplus
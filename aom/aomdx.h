@@ -69,6 +69,93 @@ typedef struct aom_inspect_init {
   void *inspect_ctx;
 } aom_inspect_init;
 
+/*!\brief Callback that receives rows of a frame as soon as they are final.
+ *
+ * \param[in] user_priv  The user_priv of aom_row_output_cb_init.
+ * \param[in] img        The frame being decoded. Only the rows in
+ *                       [row_start, row_end) of it may be read, and only
+ *                       during the callback.
+ * \param[in] row_start  First final luma row.
+ * \param[in] row_end    End of the final luma rows. Chroma rows are
+ *                       scaled by the chroma subsampling of \p img.
+ */
+typedef void (*aom_row_output_cb_fn_t)(void *user_priv, const aom_image_t *img,
+                                       unsigned int row_start,
+                                       unsigned int row_end);
+
+/*!\brief Structure to hold the sub-frame output callback and its context.
+ */
+typedef struct aom_row_output_cb_init {
+  /*! Sub-frame output callback. */
+  aom_row_output_cb_fn_t row_output_cb;
+
+  /*! Context passed to the callback. */
+  void *user_priv;
+} aom_row_output_cb_init;
+
+/*!\brief Region of interest of AV1D_SET_DECODE_ROI, in luma pixels.
+ */
+typedef struct aom_decode_roi {
+  unsigned int x;      /**< Left edge of the region */
+  unsigned int y;      /**< Top edge of the region */
+  unsigned int width;  /**< Width of the region, 0 to decode whole frames */
+  unsigned int height; /**< Height of the region, 0 to decode whole frames */
+} aom_decode_roi_t;
+
+/*!\brief Stages of the decode timed in aom_decode_stats_t.
+ */
+enum aom_decode_stage {
+  AOM_DECODE_STAGE_TILES,            /**< Entropy decoding, reconstruction */
+  AOM_DECODE_STAGE_LOOP_FILTER,      /**< Deblocking loop filter */
+  AOM_DECODE_STAGE_CDEF,             /**< CDEF */
+  AOM_DECODE_STAGE_SUPERRES,         /**< Super-resolution upscaling */
+  AOM_DECODE_STAGE_LOOP_RESTORATION, /**< Loop restoration */
+  AOM_DECODE_STAGE_FILM_GRAIN,       /**< Film grain synthesis */
+  AOM_DECODE_STAGES                  /**< Number of stages */
+};
+
+/*!\brief Number of coding block sizes counted in aom_decode_stats_t.
+ */
+#define AOM_DECODE_STATS_BLOCK_SIZES 22
+
+/*!\brief Counters of the work done by a call to aom_codec_decode(), see
+ * AV1D_GET_DECODE_STATS.
+ *
+ * Times are wall clock times in microseconds. The time left of decode_us
+ * once the stages are taken out is spent reading headers and setting up
+ * the frames.
+ */
+typedef struct aom_decode_stats {
+  /*! Time spent decoding the frames in aom_codec_decode(). */
+  uint64_t decode_us;
+  /*! Time spent in each of the stages of aom_decode_stage. When the rows of
+   * the frames are filtered while their tiles are decoded, which
+   * AV1D_SET_ROW_OUTPUT_CALLBACK may do, the filtering is counted in
+   * AOM_DECODE_STAGE_TILES. Film grain is added by aom_codec_get_frame(), so
+   * it is only counted once the frames are got. */
+  uint64_t stage_us[AOM_DECODE_STAGES];
+  /*! Time the threads decoding tiles waited on each other, summed over the
+   * threads. */
+  uint64_t worker_idle_us;
+  /*! Size of the compressed data passed to aom_codec_decode(). */
+  uint64_t bytes;
+  /*! Frames whose tiles were decoded, whether they are shown or not. */
+  unsigned int frames;
+  /*! Coding blocks decoded, by block size in the order of the AV1
+   * specification: 4x4, 4x8, 8x4, 8x8, 8x16, 16x8, 16x16, 16x32, 32x16,
+   * 32x32, 32x64, 64x32, 64x64, 64x128, 128x64, 128x128, 4x16, 16x4, 8x32,
+   * 32x8, 16x64 and 64x16. */
+  unsigned int blocks[AOM_DECODE_STATS_BLOCK_SIZES];
+  /*! Intra coded blocks. */
+  unsigned int intra_blocks;
+  /*! Inter coded blocks, including intra block copy. */
+  unsigned int inter_blocks;
+  /*! Inter coded blocks with two references. */
+  unsigned int compound_blocks;
+  /*! Blocks without residual. */
+  unsigned int skip_blocks;
+} aom_decode_stats_t;
+
 /*!\brief Structure to collect a buffer index when inspecting.
  *
  * Defines a structure to hold the buffer and return an index
@@ -463,6 +550,90 @@ enum aom_dec_control_id {
    * be used.
    */
   AV1D_GET_MI_INFO,
+
+  /*!\brief Codec control function to set an application-owned image that
+   * film grain is synthesized into, aom_image_t* parameter
+   *
+   * By default, frames with film grain are written to a buffer obtained from
+   * the frame buffer pool. When this image is set, grain is added directly
+   * into it instead, and aom_codec_get_frame() returns it for such frames.
+   * The image must have the format of the decoded frames and be at least as
+   * large as their dimensions rounded up to even; otherwise the default
+   * buffer is used. Each output frame with film grain overwrites the image,
+   * which must remain valid until this control is called again with NULL.
+   */
+  AV1D_SET_GRAIN_OUTPUT_IMAGE,
+
+  /*!\brief Codec control function to set a callback that receives the rows
+   * of each shown frame as soon as they are final, aom_row_output_cb_init*
+   * parameter
+   *
+   * The callback runs from within aom_codec_decode(), in top to bottom order,
+   * until the whole frame is handed out. The rows are those of the decoded
+   * frame after the loop filter, CDEF, loop restoration and superres, but
+   * before film grain synthesis. When decoding on a single thread, or with
+   * row_mt disabled and a single tile, and with neither loop restoration nor
+   * superres in use, the rows are handed out superblock row by superblock
+   * row while the rest of the frame is decoded. Otherwise the whole frame is
+   * handed out at once when it is complete. Passing NULL removes the
+   * callback. It is disabled by default.
+   */
+  AV1D_SET_ROW_OUTPUT_CALLBACK,
+
+  /*!\brief Codec control function to set a non-conforming fast decode
+   * level, int parameter
+   *
+   * Trades the exactness of the decoded frames for speed, for uses such as
+   * previews and thumbnails. Each level includes the ones below it:
+   * - 0 = conforming decode (default)
+   * - 1 = skip the loop filter, CDEF and loop restoration of frames that are
+   *       not used as references. Other frames are not affected.
+   * - 2 = also skip CDEF and loop restoration of reference frames. Errors
+   *       build up until the next key frame.
+   * - 3 = also use 4-tap instead of 8-tap sub-pixel interpolation filters
+   * - 4 = also use bilinear sub-pixel interpolation
+   */
+  AV1D_SET_FAST_DECODE,
+
+  /*!\brief Codec control function to leave frames out of the decode, int
+   * parameter
+   *
+   * Meant for seeking and thumbnail extraction. Skipped frames are neither
+   * reconstructed nor output, their tile data is dropped once their frame
+   * header is read:
+   * - 0 = decode all the frames (default)
+   * - 1 = skip the frames that do not refresh any reference buffer. The
+   *       frames decoded afterwards are not affected, so to seek to a frame,
+   *       decode from the preceding key frame with this mode and switch it
+   *       off for the target frame.
+   * - 2 = skip all the frames but key frames
+   */
+  AV1D_SET_SKIP_FRAMES,
+
+  /*!\brief Codec control function to only decode the tiles that intersect a
+   * region of interest, aom_decode_roi_t* parameter
+   *
+   * Meant for viewport playback of tiled streams such as 360 degree video.
+   * The pixels of the tiles left out are undefined in the output frames. The
+   * tile whose entropy contexts are carried over to later frames is always
+   * decoded, and frames that use the motion vectors of their references
+   * (allow_ref_frame_mvs) or superres are decoded whole, as their tiles
+   * cannot be decoded apart. The region is only decoded exactly if the
+   * motion vectors of the stream stay within the decoded tiles. As the
+   * in-loop filters are not applied across the edges of the decoded tiles,
+   * the region should also keep a margin from the tile edges. Passing NULL
+   * or an empty region decodes whole frames (default).
+   */
+  AV1D_SET_DECODE_ROI,
+
+  /*!\brief Codec control function to get the counters of the last call to
+   * aom_codec_decode(), aom_decode_stats_t* parameter
+   *
+   * The counters are always collected, and are reset by each call to
+   * aom_codec_decode() with data. They are meant to attribute the decode
+   * time of a stream to the stages of the decode and to its coding tools.
+   */
+  AV1D_GET_DECODE_STATS,
 };
 
 /*!\cond */
@@ -595,6 +766,24 @@ AOM_CTRL_USE_TYPE(AOMD_GET_ORDER_HINT, unsigned int *)
 // The AOM_CTRL_USE_TYPE macro can't be used with AV1D_GET_MI_INFO because
 // AV1D_GET_MI_INFO takes more than one parameter.
 #define AOM_CTRL_AV1D_GET_MI_INFO
+
+AOM_CTRL_USE_TYPE(AV1D_SET_GRAIN_OUTPUT_IMAGE, aom_image_t *)
+#define AOM_CTRL_AV1D_SET_GRAIN_OUTPUT_IMAGE
+
+AOM_CTRL_USE_TYPE(AV1D_SET_ROW_OUTPUT_CALLBACK, aom_row_output_cb_init *)
+#define AOM_CTRL_AV1D_SET_ROW_OUTPUT_CALLBACK
+
+AOM_CTRL_USE_TYPE(AV1D_SET_FAST_DECODE, int)
+#define AOM_CTRL_AV1D_SET_FAST_DECODE
+
+AOM_CTRL_USE_TYPE(AV1D_SET_SKIP_FRAMES, int)
+#define AOM_CTRL_AV1D_SET_SKIP_FRAMES
+
+AOM_CTRL_USE_TYPE(AV1D_SET_DECODE_ROI, aom_decode_roi_t *)
+#define AOM_CTRL_AV1D_SET_DECODE_ROI
+
+AOM_CTRL_USE_TYPE(AV1D_GET_DECODE_STATS, aom_decode_stats_t *)
+#define AOM_CTRL_AV1D_GET_DECODE_STATS
 /*!\endcond */
 /*! @} - end defgroup aom_decoder */
 #ifdef __cplusplus
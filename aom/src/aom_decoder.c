@@ -14,7 +14,10 @@
  *
  */
 #include <string.h>
+#include "config/aom_config.h"
 #include "aom/internal/aom_codec_internal.h"
+#include "aom_mem/aom_mem.h"
+#include "aom_util/aom_thread.h"
 
 #define SAVE_STATUS(ctx, var) (ctx ? (ctx->err = var) : var)
 
@@ -117,6 +120,118 @@ aom_image_t *aom_codec_get_frame(aom_codec_ctx_t *ctx, aom_codec_iter_t *iter) {
   return img;
 }
 
+struct aom_codec_dec_pool {
+  AVxWorker *workers;
+  int num_workers;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t mutex;
+#endif
+  // Jobs of the batch being decoded, handed out in order.
+  aom_codec_decode_job_t *jobs;
+  unsigned int num_jobs;
+  unsigned int next_job;
+};
+
+static aom_codec_decode_job_t *get_next_decode_job(aom_codec_dec_pool_t *pool) {
+  aom_codec_decode_job_t *job = NULL;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&pool->mutex);
+#endif
+  if (pool->next_job < pool->num_jobs) job = &pool->jobs[pool->next_job++];
+#if CONFIG_MULTITHREAD
+  pthread_mutex_unlock(&pool->mutex);
+#endif
+  return job;
+}
+
+static int decode_pool_worker_hook(void *arg1, void *unused) {
+  (void)unused;
+  aom_codec_dec_pool_t *const pool = (aom_codec_dec_pool_t *)arg1;
+  aom_codec_decode_job_t *job;
+  while ((job = get_next_decode_job(pool)) != NULL) {
+    job->res = aom_codec_decode(job->ctx, job->data, job->data_sz,
+                                job->user_priv);
+  }
+  return 1;
+}
+
+aom_codec_dec_pool_t *aom_codec_dec_pool_create(unsigned int num_threads) {
+  aom_codec_dec_pool_t *const pool =
+      (aom_codec_dec_pool_t *)aom_calloc(1, sizeof(*pool));
+  if (pool == NULL) return NULL;
+  if (num_threads < 1) num_threads = 1;
+  if (num_threads > MAX_NUM_THREADS) num_threads = MAX_NUM_THREADS;
+  const int num_workers = (int)num_threads;
+  pool->workers = (AVxWorker *)aom_calloc(num_workers, sizeof(*pool->workers));
+  if (pool->workers == NULL) {
+    aom_free(pool);
+    return NULL;
+  }
+#if CONFIG_MULTITHREAD
+  if (pthread_mutex_init(&pool->mutex, NULL)) {
+    aom_free(pool->workers);
+    aom_free(pool);
+    return NULL;
+  }
+#endif
+
+  // The first worker runs on the thread that decodes the batch.
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  for (int i = 0; i < num_workers; ++i) {
+    AVxWorker *const worker = &pool->workers[i];
+    winterface->init(worker);
+    worker->thread_name = "aom dec pool";
+    worker->hook = decode_pool_worker_hook;
+    worker->data1 = pool;
+    worker->data2 = NULL;
+    ++pool->num_workers;
+    if (i > 0 && !winterface->reset(worker)) {
+      aom_codec_dec_pool_destroy(pool);
+      return NULL;
+    }
+  }
+  return pool;
+}
+
+void aom_codec_dec_pool_destroy(aom_codec_dec_pool_t *pool) {
+  if (pool == NULL) return;
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  for (int i = 0; i < pool->num_workers; ++i) {
+    winterface->end(&pool->workers[i]);
+  }
+#if CONFIG_MULTITHREAD
+  pthread_mutex_destroy(&pool->mutex);
+#endif
+  aom_free(pool->workers);
+  aom_free(pool);
+}
+
+aom_codec_err_t aom_codec_decode_batch(aom_codec_dec_pool_t *pool,
+                                       aom_codec_decode_job_t *jobs,
+                                       unsigned int num_jobs) {
+  if (!pool || (!jobs && num_jobs)) return AOM_CODEC_INVALID_PARAM;
+
+  pool->jobs = jobs;
+  pool->num_jobs = num_jobs;
+  pool->next_job = 0;
+  int num_workers = pool->num_workers;
+  if (num_jobs < (unsigned int)num_workers) num_workers = (int)num_jobs;
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  for (int i = num_workers - 1; i > 0; --i)
+    winterface->launch(&pool->workers[i]);
+  if (num_workers > 0) winterface->execute(&pool->workers[0]);
+  for (int i = num_workers - 1; i > 0; --i)
+    winterface->sync(&pool->workers[i]);
+  pool->jobs = NULL;
+  pool->num_jobs = 0;
+
+  aom_codec_err_t res = AOM_CODEC_OK;
+  for (unsigned int i = 0; i < num_jobs; ++i) {
+    if (jobs[i].res != AOM_CODEC_OK) res = AOM_CODEC_ERROR;
+  }
+  return res;
+}
+
 aom_codec_err_t aom_codec_set_frame_buffer_functions(
     aom_codec_ctx_t *ctx, aom_get_frame_buffer_cb_fn_t cb_get,
     aom_release_frame_buffer_cb_fn_t cb_release, void *cb_priv) {
@@ -993,6 +993,7 @@ if (aom_config("CONFIG_AV1_ENCODER") eq "yes") {
     ($w, $h) = @$_;
     add_proto qw/void/, "aom_sad${w}x${h}x4d", "const uint8_t *src_ptr, int src_stride, const uint8_t * const ref_ptr[4], int ref_stride, uint32_t sad_array[4]";
     add_proto qw/void/, "aom_sad${w}x${h}x3d", "const uint8_t *src_ptr, int src_stride, const uint8_t * const ref_ptr[4], int ref_stride, uint32_t sad_array[4]";
+    add_proto qw/void/, "aom_sad${w}x${h}x8d", "const uint8_t *src_ptr, int src_stride, const uint8_t * const ref_ptr[8], int ref_stride, uint32_t sad_array[8]";
     add_proto qw/void/, "aom_sad_skip_${w}x${h}x4d", "const uint8_t *src_ptr, int src_stride, const uint8_t * const ref_ptr[4], int ref_stride, uint32_t sad_array[4]";
     add_proto qw/void/, "aom_masked_sad${w}x${h}x4d", "const uint8_t *src, int src_stride, const uint8_t *ref[4], int ref_stride, const uint8_t *second_pred, const uint8_t *msk, int msk_stride, int invert_mask, unsigned sads[4]";
   }
@@ -1022,6 +1023,23 @@ if (aom_config("CONFIG_AV1_ENCODER") eq "yes") {
   specialize qw/aom_sad8x32x4d         neon sse2/;
   specialize qw/aom_sad4x16x4d         neon sse2/;
 
+  specialize qw/aom_sad128x128x8d avx2/;
+  specialize qw/aom_sad128x64x8d  avx2/;
+  specialize qw/aom_sad64x128x8d  avx2/;
+  specialize qw/aom_sad64x64x8d   avx2/;
+  specialize qw/aom_sad64x32x8d   avx2/;
+  specialize qw/aom_sad32x64x8d   avx2/;
+  specialize qw/aom_sad32x32x8d   avx2/;
+  specialize qw/aom_sad32x16x8d   avx2/;
+  specialize qw/aom_sad16x32x8d   avx2/;
+  specialize qw/aom_sad16x16x8d   avx2/;
+  specialize qw/aom_sad16x8x8d    avx2/;
+
+  specialize qw/aom_sad64x16x8d   avx2/;
+  specialize qw/aom_sad32x8x8d    avx2/;
+  specialize qw/aom_sad16x64x8d   avx2/;
+  specialize qw/aom_sad16x4x8d    avx2/;
+
   specialize qw/aom_sad_skip_128x128x4d avx2 sse2 neon/;
   specialize qw/aom_sad_skip_128x64x4d  avx2 sse2 neon/;
   specialize qw/aom_sad_skip_64x128x4d  avx2 sse2 neon/;
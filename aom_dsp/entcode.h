@@ -14,6 +14,7 @@
 
 #include <limits.h>
 #include <stddef.h>
+#include <stdint.h>
 #include "aom_dsp/odintrin.h"
 #include "aom_dsp/prob.h"
 
@@ -21,11 +22,18 @@
 #define EC_MIN_PROB 4  // must be <= (1<<EC_PROB_SHIFT)/16
 
 /*OPT: od_ec_window must be at least 32 bits, but if you have fast arithmetic
-   on a larger type, you can speed up the decoder by using it here.*/
+   on a larger type, you can speed up the decoder by using it here.
+  On 64-bit targets a 64-bit window lets the decoder refill up to 7 bytes at a
+   time and refill roughly half as often.*/
+/*The size in bits of od_ec_window. This is a literal rather than a sizeof
+   expression so that it can be tested by the preprocessor.*/
+#if UINTPTR_MAX > 0xffffffffu
+typedef uint64_t od_ec_window;
+#define OD_EC_WINDOW_SIZE (64)
+#else
 typedef uint32_t od_ec_window;
-
-/*The size in bits of od_ec_window.*/
-#define OD_EC_WINDOW_SIZE ((int)sizeof(od_ec_window) * CHAR_BIT)
+#define OD_EC_WINDOW_SIZE (32)
+#endif
 
 /*The resolution of fractional-precision bit usage measurements, i.e.,
    3 => 1/8th bits.*/
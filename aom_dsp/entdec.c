@@ -10,8 +10,10 @@
  */
 
 #include <assert.h>
+#include <string.h>
 #include "aom_dsp/entdec.h"
 #include "aom_dsp/prob.h"
+#include "aom_ports/bitops.h"
 
 /*A range decoder.
   This is an entropy decoder based upon \cite{Mar79}, which is itself a
@@ -73,6 +75,19 @@
   Even relatively modest values like 100 would work fine.*/
 #define OD_EC_LOTS_OF_BITS (0x4000)
 
+#if OD_EC_WINDOW_SIZE == 64
+/*Loads 8 bytes from the stream as a big-endian 64-bit value, so that the first
+   byte ends up in the most significant position.*/
+static INLINE uint64_t od_ec_dec_load_be64(const unsigned char *bptr) {
+  uint64_t val;
+  memcpy(&val, bptr, sizeof(val));
+#if !CONFIG_BIG_ENDIAN
+  val = get_byteswap64(val);
+#endif
+  return val;
+}
+#endif
+
 /*The return value of od_ec_dec_tell does not change across an od_ec_dec_refill
    call.*/
 static void od_ec_dec_refill(od_ec_dec *dec) {
@@ -86,6 +101,20 @@ static void od_ec_dec_refill(od_ec_dec *dec) {
   bptr = dec->bptr;
   end = dec->end;
   s = OD_EC_WINDOW_SIZE - 9 - (cnt + 15);
+#if OD_EC_WINDOW_SIZE == 64
+  if (s >= 0 && end - bptr >= 8) {
+    /*Fast path: insert all of the whole bytes that fit in the window with a
+       single load. This inserts exactly the same bytes at the same positions
+       as the loop below, so the decoder state is bit-identical.*/
+    const int nbytes = (s >> 3) + 1;
+    const uint64_t bytes = od_ec_dec_load_be64(bptr) >> (64 - 8 * nbytes);
+    assert(s <= OD_EC_WINDOW_SIZE - 8);
+    dif ^= (od_ec_window)bytes << (s - 8 * (nbytes - 1));
+    cnt += 8 * nbytes;
+    bptr += nbytes;
+    s -= 8 * nbytes;
+  }
+#endif
   for (; s >= 0 && bptr < end; s -= 8, bptr++) {
     /*Each time a byte is inserted into the window (dif), bptr advances and cnt
        is incremented by 8, so the total number of consumed bits (the return
@@ -143,7 +172,10 @@ static int od_ec_dec_normalize(od_ec_dec *dec, od_ec_window dif, unsigned rng,
 void od_ec_dec_init(od_ec_dec *dec, const unsigned char *buf,
                     uint32_t storage) {
   dec->buf = buf;
-  dec->tell_offs = 10 - (OD_EC_WINDOW_SIZE - 8);
+  /*The initial refill below leaves cnt at 8 times the number of bytes read
+     minus 15, whatever the window size, so this makes od_ec_dec_tell() start
+     at 1, as od_ec_enc_tell() does.*/
+  dec->tell_offs = 10 - 24;
   dec->end = buf + storage;
   dec->bptr = buf;
   dec->dif = ((od_ec_window)1 << (OD_EC_WINDOW_SIZE - 1)) - 1;
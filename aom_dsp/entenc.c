@@ -48,6 +48,59 @@
    URL="http://researchcommons.waikato.ac.nz/bitstream/handle/10289/78/content.pdf"
   }*/
 
+/*Flushes the bytes of low that are ready to the output buffer.
+  This is called once the number of buffered bits, s, reaches 40 (56 - 16).
+  low: The current value of low.
+  c: The number of buffered bits before the pending renormalization.
+  d: The pending renormalization shift.
+  Return: The remaining (unflushed) bits of low. The number of buffered bits
+   after the flush is written back to *s.*/
+static od_ec_enc_window od_ec_enc_flush(od_ec_enc *enc, od_ec_enc_window low,
+                                        int c, int d, int *s) {
+  unsigned char *out = enc->buf;
+  uint32_t storage = enc->storage;
+  uint32_t offs = enc->offs;
+  if (offs + 8 > storage) {
+    storage = 2 * storage + 8;
+    out = (unsigned char *)realloc(out, sizeof(*out) * storage);
+    if (out == NULL) {
+      enc->error = -1;
+      enc->offs = 0;
+      return low;
+    }
+    enc->buf = out;
+    enc->storage = storage;
+  }
+  // Need to add 1 byte here since enc->cnt always counts 1 byte less
+  // (enc->cnt = -9) to ensure correct operation
+  uint8_t num_bytes_ready = (*s >> 3) + 1;
+
+  // Update "c" to contain the number of non-ready bits in "low". Since "low"
+  // has 64-bit capacity, we need to add the (64 - 40) cushion bits and take
+  // off the number of ready bits.
+  c += 24 - (num_bytes_ready << 3);
+
+  // Prepare "output" and update "low"
+  uint64_t output = low >> c;
+  low = low & (((uint64_t)1 << c) - 1);
+
+  // Prepare data and carry mask
+  uint64_t mask = (uint64_t)1 << (num_bytes_ready << 3);
+  uint64_t carry = output & mask;
+
+  mask = mask - 0x01;
+  output = output & mask;
+
+  // Write data in a single operation
+  write_enc_data_to_out_buf(out, offs, output, carry, &enc->offs,
+                            num_bytes_ready);
+
+  // Update state of the encoder: enc->cnt to contain the number of residual
+  // bits
+  *s = c + d - 24;
+  return low;
+}
+
 /*Takes updated low and range values, renormalizes them so that
    32768 <= rng < 65536 (flushing bytes from low to the output buffer if
    necessary), and stores them back in the encoder context.
@@ -75,47 +128,8 @@ static void od_ec_enc_normalize(od_ec_enc *enc, od_ec_enc_window low,
      the leading 0x00's as a special case.
   */
   if (s >= 40) {  // 56 - 16
-    unsigned char *out = enc->buf;
-    uint32_t storage = enc->storage;
-    uint32_t offs = enc->offs;
-    if (offs + 8 > storage) {
-      storage = 2 * storage + 8;
-      out = (unsigned char *)realloc(out, sizeof(*out) * storage);
-      if (out == NULL) {
-        enc->error = -1;
-        enc->offs = 0;
-        return;
-      }
-      enc->buf = out;
-      enc->storage = storage;
-    }
-    // Need to add 1 byte here since enc->cnt always counts 1 byte less
-    // (enc->cnt = -9) to ensure correct operation
-    uint8_t num_bytes_ready = (s >> 3) + 1;
-
-    // Update "c" to contain the number of non-ready bits in "low". Since "low"
-    // has 64-bit capacity, we need to add the (64 - 40) cushion bits and take
-    // off the number of ready bits.
-    c += 24 - (num_bytes_ready << 3);
-
-    // Prepare "output" and update "low"
-    uint64_t output = low >> c;
-    low = low & (((uint64_t)1 << c) - 1);
-
-    // Prepare data and carry mask
-    uint64_t mask = (uint64_t)1 << (num_bytes_ready << 3);
-    uint64_t carry = output & mask;
-
-    mask = mask - 0x01;
-    output = output & mask;
-
-    // Write data in a single operation
-    write_enc_data_to_out_buf(out, offs, output, carry, &enc->offs,
-                              num_bytes_ready);
-
-    // Update state of the encoder: enc->cnt to contain the number of residual
-    // bits
-    s = c + d - 24;
+    low = od_ec_enc_flush(enc, low, c, d, &s);
+    if (enc->error) return;
   }
   enc->low = low << d;
   enc->rng = rng << d;
@@ -211,6 +225,56 @@ void od_ec_encode_bool_q15(od_ec_enc *enc, int val, unsigned f) {
 #endif
 }
 
+/*Encodes a run of equiprobable binary values.
+  This produces exactly the same output as calling od_ec_encode_bool_q15()
+   with f = 16384 once per bit, but keeps the coder state in registers and
+   only touches the encoder context when bytes are ready to be flushed.
+  fl: The bits to encode (in the least ftb significant bits).
+      They are encoded in order from most-significant to least.
+  ftb: The number of bits to encode.
+       This must be no more than 32.*/
+void od_ec_enc_bits(od_ec_enc *enc, uint32_t fl, unsigned ftb) {
+  od_ec_enc_window l;
+  unsigned r;
+  int c;
+  assert(ftb <= 32);
+#if OD_MEASURE_EC_OVERHEAD
+  enc->entropy += ftb;
+  enc->nb_symbols += ftb;
+#endif
+  l = enc->low;
+  r = enc->rng;
+  c = enc->cnt;
+  while (ftb-- > 0) {
+    unsigned v;
+    int d;
+    int s;
+    assert(32768U <= r);
+    /*This is od_ec_encode_bool_q15() with f = 16384, which the compiler
+       reduces to a shift.*/
+    v = ((r >> 8) * (uint32_t)(16384 >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT));
+    v += EC_MIN_PROB;
+    if ((fl >> ftb) & 1) {
+      l += r - v;
+      r = v;
+    } else {
+      r -= v;
+    }
+    d = 16 - OD_ILOG_NZ(r);
+    s = c + d;
+    if (s >= 40) {  // See od_ec_enc_normalize().
+      l = od_ec_enc_flush(enc, l, c, d, &s);
+      if (enc->error) return;
+    }
+    l <<= d;
+    r <<= d;
+    c = s;
+  }
+  enc->low = l;
+  enc->rng = r;
+  enc->cnt = c;
+}
+
 /*Encodes a symbol given a cumulative distribution function (CDF) table in Q15.
   s: The index of the symbol to encode.
   icdf: 32768 minus the CDF, such that symbol s falls in the range
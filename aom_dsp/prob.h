@@ -126,13 +126,15 @@ static INLINE void update_cdf(aom_cdf_prob *cdf, int8_t val, int nsymbs) {
   //  4 + (count >> 4) + (nsymbs > 3).
   const int rate = 4 + (count >> 4) + (nsymbs > 3);
 
+  // Select between the two update directions with a mask rather than a
+  // branch: the branch on i < val is data dependent and mispredicts often in
+  // the entropy decoder's serial critical path.
   int i = 0;
   do {
-    if (i < val) {
-      cdf[i] += (CDF_PROB_TOP - cdf[i]) >> rate;
-    } else {
-      cdf[i] -= cdf[i] >> rate;
-    }
+    const int mask = -(i < val);
+    const int up = (CDF_PROB_TOP - cdf[i]) >> rate;
+    const int down = cdf[i] >> rate;
+    cdf[i] += (up & mask) - (down & ~mask);
   } while (++i < nsymbs - 1);
   cdf[nsymbs] += (count < 32);
 }
@@ -89,85 +89,111 @@ static INLINE unsigned int sad(const uint8_t *a, int a_stride, const uint8_t *b,
     aom_sad##m##x##n##x4d(src, src_stride, ref_array, ref_stride, sad_array); \
   }
 
+// Call SIMD version of aom_sad_mxnx4d twice if the 8d version is unavailable.
+#define SAD_MXNX8D(m, n)                                                      \
+  void aom_sad##m##x##n##x8d_c(const uint8_t *src, int src_stride,            \
+                               const uint8_t *const ref_array[8],             \
+                               int ref_stride, uint32_t sad_array[8]) {       \
+    aom_sad##m##x##n##x4d(src, src_stride, ref_array, ref_stride, sad_array); \
+    aom_sad##m##x##n##x4d(src, src_stride, ref_array + 4, ref_stride,         \
+                          sad_array + 4);                                     \
+  }
+
 // 128x128
 SADMXN(128, 128)
 SAD_MXNX4D(128, 128)
 SAD_MXNX3D(128, 128)
+SAD_MXNX8D(128, 128)
 
 // 128x64
 SADMXN(128, 64)
 SAD_MXNX4D(128, 64)
 SAD_MXNX3D(128, 64)
+SAD_MXNX8D(128, 64)
 
 // 64x128
 SADMXN(64, 128)
 SAD_MXNX4D(64, 128)
 SAD_MXNX3D(64, 128)
+SAD_MXNX8D(64, 128)
 
 // 64x64
 SADMXN(64, 64)
 SAD_MXNX4D(64, 64)
 SAD_MXNX3D(64, 64)
+SAD_MXNX8D(64, 64)
 
 // 64x32
 SADMXN(64, 32)
 SAD_MXNX4D(64, 32)
 SAD_MXNX3D(64, 32)
+SAD_MXNX8D(64, 32)
 
 // 32x64
 SADMXN(32, 64)
 SAD_MXNX4D(32, 64)
 SAD_MXNX3D(32, 64)
+SAD_MXNX8D(32, 64)
 
 // 32x32
 SADMXN(32, 32)
 SAD_MXNX4D(32, 32)
 SAD_MXNX3D(32, 32)
+SAD_MXNX8D(32, 32)
 
 // 32x16
 SADMXN(32, 16)
 SAD_MXNX4D(32, 16)
 SAD_MXNX3D(32, 16)
+SAD_MXNX8D(32, 16)
 
 // 16x32
 SADMXN(16, 32)
 SAD_MXNX4D(16, 32)
 SAD_MXNX3D(16, 32)
+SAD_MXNX8D(16, 32)
 
 // 16x16
 SADMXN(16, 16)
 SAD_MXNX4D(16, 16)
 SAD_MXNX3D(16, 16)
+SAD_MXNX8D(16, 16)
 
 // 16x8
 SADMXN(16, 8)
 SAD_MXNX4D(16, 8)
 SAD_MXNX3D(16, 8)
+SAD_MXNX8D(16, 8)
 
 // 8x16
 SADMXN(8, 16)
 SAD_MXNX4D(8, 16)
 SAD_MXNX3D(8, 16)
+SAD_MXNX8D(8, 16)
 
 // 8x8
 SADMXN(8, 8)
 SAD_MXNX4D(8, 8)
 SAD_MXNX3D(8, 8)
+SAD_MXNX8D(8, 8)
 
 // 8x4
 SADMXN(8, 4)
 SAD_MXNX4D(8, 4)
 SAD_MXNX3D(8, 4)
+SAD_MXNX8D(8, 4)
 
 // 4x8
 SADMXN(4, 8)
 SAD_MXNX4D(4, 8)
 SAD_MXNX3D(4, 8)
+SAD_MXNX8D(4, 8)
 
 // 4x4
 SADMXN(4, 4)
 SAD_MXNX4D(4, 4)
 SAD_MXNX3D(4, 4)
+SAD_MXNX8D(4, 4)
 
 #if !CONFIG_REALTIME_ONLY
 SADMXN(4, 16)
@@ -188,6 +214,12 @@ SAD_MXNX3D(8, 32)
 SAD_MXNX3D(32, 8)
 SAD_MXNX3D(16, 64)
 SAD_MXNX3D(64, 16)
+SAD_MXNX8D(4, 16)
+SAD_MXNX8D(16, 4)
+SAD_MXNX8D(8, 32)
+SAD_MXNX8D(32, 8)
+SAD_MXNX8D(16, 64)
+SAD_MXNX8D(64, 16)
 #endif  // !CONFIG_REALTIME_ONLY
 
 #if CONFIG_AV1_HIGHBITDEPTH
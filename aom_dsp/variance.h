@@ -91,6 +91,8 @@ typedef struct aom_variance_vtable {
   aom_subp_avg_variance_fn_t svaf;
   aom_sad_multi_d_fn_t sdx4df;
   aom_sad_multi_d_fn_t sdx3df;
+  // Same as sadx4, but for 8 references. NULL if there is no 8-wide kernel.
+  aom_sad_multi_d_fn_t sdx8df;
   // Same as sadx4, but downsample the rows by a factor of 2.
   aom_sad_multi_d_fn_t sdsx4df;
   aom_masked_sad_fn_t msdf;
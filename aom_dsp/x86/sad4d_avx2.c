@@ -324,3 +324,138 @@ SAD_SKIP_16XN_AVX2(8)
 SAD_SKIP_16XN_AVX2(64)
 SAD_SKIP_16XN_AVX2(4)
 #endif  // !CONFIG_REALTIME_ONLY
+
+// The 8d kernels share each source load between eight references, so a whole
+// ring of motion search candidates is evaluated in a single pass.
+static AOM_FORCE_INLINE void sad8_accumulate_avx2(__m256i src_reg,
+                                                  const __m256i ref_reg[8],
+                                                  __m256i sum[8]) {
+  sum[0] = _mm256_add_epi32(sum[0], _mm256_sad_epu8(ref_reg[0], src_reg));
+  sum[1] = _mm256_add_epi32(sum[1], _mm256_sad_epu8(ref_reg[1], src_reg));
+  sum[2] = _mm256_add_epi32(sum[2], _mm256_sad_epu8(ref_reg[2], src_reg));
+  sum[3] = _mm256_add_epi32(sum[3], _mm256_sad_epu8(ref_reg[3], src_reg));
+  sum[4] = _mm256_add_epi32(sum[4], _mm256_sad_epu8(ref_reg[4], src_reg));
+  sum[5] = _mm256_add_epi32(sum[5], _mm256_sad_epu8(ref_reg[5], src_reg));
+  sum[6] = _mm256_add_epi32(sum[6], _mm256_sad_epu8(ref_reg[6], src_reg));
+  sum[7] = _mm256_add_epi32(sum[7], _mm256_sad_epu8(ref_reg[7], src_reg));
+}
+
+static AOM_FORCE_INLINE void aom_sadMxNx8d_avx2(
+    int M, int N, const uint8_t *src, int src_stride,
+    const uint8_t *const ref[8], int ref_stride, uint32_t res[8]) {
+  const uint8_t *ref0 = ref[0], *ref1 = ref[1], *ref2 = ref[2],
+                *ref3 = ref[3], *ref4 = ref[4], *ref5 = ref[5],
+                *ref6 = ref[6], *ref7 = ref[7];
+  __m256i sum[8] = {
+    _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(),
+    _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(),
+    _mm256_setzero_si256(), _mm256_setzero_si256()
+  };
+
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < M; j += 32) {
+      const __m256i src_reg = _mm256_loadu_si256((const __m256i *)(src + j));
+      const __m256i ref_reg[8] = {
+        _mm256_loadu_si256((const __m256i *)(ref0 + j)),
+        _mm256_loadu_si256((const __m256i *)(ref1 + j)),
+        _mm256_loadu_si256((const __m256i *)(ref2 + j)),
+        _mm256_loadu_si256((const __m256i *)(ref3 + j)),
+        _mm256_loadu_si256((const __m256i *)(ref4 + j)),
+        _mm256_loadu_si256((const __m256i *)(ref5 + j)),
+        _mm256_loadu_si256((const __m256i *)(ref6 + j)),
+        _mm256_loadu_si256((const __m256i *)(ref7 + j))
+      };
+      sad8_accumulate_avx2(src_reg, ref_reg, sum);
+    }
+    src += src_stride;
+    ref0 += ref_stride;
+    ref1 += ref_stride;
+    ref2 += ref_stride;
+    ref3 += ref_stride;
+    ref4 += ref_stride;
+    ref5 += ref_stride;
+    ref6 += ref_stride;
+    ref7 += ref_stride;
+  }
+
+  aggregate_and_store_sum(res, &sum[0], &sum[1], &sum[2], &sum[3]);
+  aggregate_and_store_sum(res + 4, &sum[4], &sum[5], &sum[6], &sum[7]);
+}
+
+static AOM_FORCE_INLINE void aom_sad16xNx8d_avx2(int N, const uint8_t *src,
+                                                 int src_stride,
+                                                 const uint8_t *const ref[8],
+                                                 int ref_stride,
+                                                 uint32_t res[8]) {
+  const uint8_t *ref0 = ref[0], *ref1 = ref[1], *ref2 = ref[2],
+                *ref3 = ref[3], *ref4 = ref[4], *ref5 = ref[5],
+                *ref6 = ref[6], *ref7 = ref[7];
+  __m256i sum[8] = {
+    _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(),
+    _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(),
+    _mm256_setzero_si256(), _mm256_setzero_si256()
+  };
+  assert(N % 2 == 0);
+
+  for (int i = 0; i < N; i += 2) {
+    const __m256i src_reg = yy_loadu2_128(src + src_stride, src);
+    const __m256i ref_reg[8] = { yy_loadu2_128(ref0 + ref_stride, ref0),
+                                 yy_loadu2_128(ref1 + ref_stride, ref1),
+                                 yy_loadu2_128(ref2 + ref_stride, ref2),
+                                 yy_loadu2_128(ref3 + ref_stride, ref3),
+                                 yy_loadu2_128(ref4 + ref_stride, ref4),
+                                 yy_loadu2_128(ref5 + ref_stride, ref5),
+                                 yy_loadu2_128(ref6 + ref_stride, ref6),
+                                 yy_loadu2_128(ref7 + ref_stride, ref7) };
+    sad8_accumulate_avx2(src_reg, ref_reg, sum);
+
+    src += 2 * src_stride;
+    ref0 += 2 * ref_stride;
+    ref1 += 2 * ref_stride;
+    ref2 += 2 * ref_stride;
+    ref3 += 2 * ref_stride;
+    ref4 += 2 * ref_stride;
+    ref5 += 2 * ref_stride;
+    ref6 += 2 * ref_stride;
+    ref7 += 2 * ref_stride;
+  }
+
+  aggregate_and_store_sum(res, &sum[0], &sum[1], &sum[2], &sum[3]);
+  aggregate_and_store_sum(res + 4, &sum[4], &sum[5], &sum[6], &sum[7]);
+}
+
+#define SADMXNX8D_AVX2(m, n)                                                   \
+  void aom_sad##m##x##n##x8d_avx2(const uint8_t *src, int src_stride,          \
+                                  const uint8_t *const ref[8], int ref_stride, \
+                                  uint32_t res[8]) {                           \
+    aom_sadMxNx8d_avx2(m, n, src, src_stride, ref, ref_stride, res);           \
+  }
+#define SAD16XNX8D_AVX2(n)                                                  \
+  void aom_sad16x##n##x8d_avx2(const uint8_t *src, int src_stride,          \
+                               const uint8_t *const ref[8], int ref_stride, \
+                               uint32_t res[8]) {                           \
+    aom_sad16xNx8d_avx2(n, src, src_stride, ref, ref_stride, res);          \
+  }
+
+SADMXNX8D_AVX2(32, 16)
+SADMXNX8D_AVX2(32, 32)
+SADMXNX8D_AVX2(32, 64)
+
+SADMXNX8D_AVX2(64, 32)
+SADMXNX8D_AVX2(64, 64)
+SADMXNX8D_AVX2(64, 128)
+
+SADMXNX8D_AVX2(128, 64)
+SADMXNX8D_AVX2(128, 128)
+
+SAD16XNX8D_AVX2(32)
+SAD16XNX8D_AVX2(16)
+SAD16XNX8D_AVX2(8)
+
+#if !CONFIG_REALTIME_ONLY
+SADMXNX8D_AVX2(32, 8)
+SADMXNX8D_AVX2(64, 16)
+
+SAD16XNX8D_AVX2(64)
+SAD16XNX8D_AVX2(4)
+#endif  // !CONFIG_REALTIME_ONLY
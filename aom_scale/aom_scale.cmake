@@ -20,6 +20,12 @@ list(APPEND AOM_SCALE_SOURCES "${AOM_ROOT}/aom_scale/aom_scale.h"
             "${AOM_ROOT}/aom_scale/generic/yv12extend.c"
             "${AOM_ROOT}/aom_scale/yv12config.h")
 
+list(APPEND AOM_SCALE_INTRIN_SSE2
+            "${AOM_ROOT}/aom_scale/x86/yv12extend_sse2.c")
+
+list(APPEND AOM_SCALE_INTRIN_AVX2
+            "${AOM_ROOT}/aom_scale/x86/yv12extend_avx2.c")
+
 # Creates the aom_scale build target and makes libaom depend on it. The libaom
 # target must exist before this function is called.
 function(setup_aom_scale_targets)
@@ -31,6 +37,16 @@ function(setup_aom_scale_targets)
     target_sources(aom_static PRIVATE $<TARGET_OBJECTS:aom_scale>)
   endif()
 
+  if(HAVE_SSE2)
+    add_intrinsics_object_library("-msse2" "sse2" "aom_scale"
+                                  "AOM_SCALE_INTRIN_SSE2")
+  endif()
+
+  if(HAVE_AVX2)
+    add_intrinsics_object_library("-mavx2" "avx2" "aom_scale"
+                                  "AOM_SCALE_INTRIN_AVX2")
+  endif()
+
   # Pass the new lib targets up to the parent scope instance of
   # $AOM_LIB_TARGETS.
   set(AOM_LIB_TARGETS ${AOM_LIB_TARGETS} aom_scale PARENT_SCOPE)
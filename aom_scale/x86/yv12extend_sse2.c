@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+#include <emmintrin.h>
+#include <string.h>
+
+#include "config/aom_config.h"
+#include "config/aom_scale_rtcd.h"
+
+#include "aom/aom_integer.h"
+#include "aom_mem/aom_mem.h"
+#include "aom_ports/mem.h"
+#include "aom_scale/yv12config.h"
+
+// Frames larger than this are copied with non-temporal stores so that the
+// destination does not evict the working set from the last level cache.
+#define NT_COPY_MIN_FRAME_BYTES (8 << 20)
+
+// Fills n bytes at dst with the vector v. Requires n >= 16; the final store
+// overlaps the previous one instead of falling back to a scalar tail.
+static INLINE void fill_row_sse2(uint8_t *dst, __m128i v, int n) {
+  int i = 0;
+  for (; i + 16 <= n; i += 16) _mm_storeu_si128((__m128i *)(dst + i), v);
+  if (i < n) _mm_storeu_si128((__m128i *)(dst + n - 16), v);
+}
+
+// Copies n bytes from src to dst with 16-byte loads and stores. Requires
+// n >= 16 and non-overlapping rows.
+static INLINE void copy_row_sse2(uint8_t *dst, const uint8_t *src, int n) {
+  int i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm_storeu_si128((__m128i *)(dst + i),
+                     _mm_loadu_si128((const __m128i *)(src + i)));
+  }
+  if (i < n) {
+    _mm_storeu_si128((__m128i *)(dst + n - 16),
+                     _mm_loadu_si128((const __m128i *)(src + n - 16)));
+  }
+}
+
+// Same as copy_row_sse2() but bypasses the cache for the aligned body of the
+// row. The caller must issue _mm_sfence() before the data is consumed.
+static INLINE void copy_row_nt_sse2(uint8_t *dst, const uint8_t *src, int n) {
+  int head = (int)((16 - ((uintptr_t)dst & 15)) & 15);
+  if (head > n) head = n;
+  memcpy(dst, src, head);
+  int i = head;
+  for (; i + 16 <= n; i += 16) {
+    _mm_stream_si128((__m128i *)(dst + i),
+                     _mm_loadu_si128((const __m128i *)(src + i)));
+  }
+  memcpy(dst + i, src + i, n - i);
+}
+
+static void extend_plane_sse2(uint8_t *const src, int src_stride, int width,
+                              int height, int extend_top, int extend_left,
+                              int extend_bottom, int extend_right, int v_start,
+                              int v_end) {
+  assert(src != NULL);
+  const int linesize = extend_left + extend_right + width;
+  assert(linesize <= src_stride);
+
+  /* copy the left and right most columns out */
+  uint8_t *src_ptr1 = src + v_start * src_stride;
+  uint8_t *src_ptr2 = src + v_start * src_stride + width - 1;
+  uint8_t *dst_ptr1 = src + v_start * src_stride - extend_left;
+  uint8_t *dst_ptr2 = src_ptr2 + 1;
+
+  for (int i = v_start; i < v_end; ++i) {
+    if (extend_left >= 16) {
+      fill_row_sse2(dst_ptr1, _mm_set1_epi8((char)src_ptr1[0]), extend_left);
+    } else {
+      memset(dst_ptr1, src_ptr1[0], extend_left);
+    }
+    if (extend_right >= 16) {
+      fill_row_sse2(dst_ptr2, _mm_set1_epi8((char)src_ptr2[0]), extend_right);
+    } else {
+      memset(dst_ptr2, src_ptr2[0], extend_right);
+    }
+    src_ptr1 += src_stride;
+    src_ptr2 += src_stride;
+    dst_ptr1 += src_stride;
+    dst_ptr2 += src_stride;
+  }
+
+  /* Now copy the top and bottom lines into each line of the respective
+   * borders
+   */
+  src_ptr1 = src - extend_left;
+  dst_ptr1 = src_ptr1 + src_stride * -extend_top;
+
+  for (int i = 0; i < extend_top; ++i) {
+    if (linesize >= 16) {
+      copy_row_sse2(dst_ptr1, src_ptr1, linesize);
+    } else {
+      memcpy(dst_ptr1, src_ptr1, linesize);
+    }
+    dst_ptr1 += src_stride;
+  }
+
+  src_ptr2 = src_ptr1 + src_stride * (height - 1);
+  dst_ptr2 = src_ptr2;
+
+  for (int i = 0; i < extend_bottom; ++i) {
+    dst_ptr2 += src_stride;
+    if (linesize >= 16) {
+      copy_row_sse2(dst_ptr2, src_ptr2, linesize);
+    } else {
+      memcpy(dst_ptr2, src_ptr2, linesize);
+    }
+  }
+}
+
+#if CONFIG_AV1_HIGHBITDEPTH
+static void extend_plane_high_sse2(uint8_t *const src8, int src_stride,
+                                   int width, int height, int extend_top,
+                                   int extend_left, int extend_bottom,
+                                   int extend_right, int v_start, int v_end) {
+  const int linesize = extend_left + extend_right + width;
+  assert(linesize <= src_stride);
+  uint16_t *src = CONVERT_TO_SHORTPTR(src8);
+
+  /* copy the left and right most columns out */
+  uint16_t *src_ptr1 = src + v_start * src_stride;
+  uint16_t *src_ptr2 = src + v_start * src_stride + width - 1;
+  uint16_t *dst_ptr1 = src + v_start * src_stride - extend_left;
+  uint16_t *dst_ptr2 = src_ptr2 + 1;
+
+  for (int i = v_start; i < v_end; ++i) {
+    if (extend_left >= 8) {
+      fill_row_sse2((uint8_t *)dst_ptr1, _mm_set1_epi16((short)src_ptr1[0]),
+                    extend_left * 2);
+    } else {
+      aom_memset16(dst_ptr1, src_ptr1[0], extend_left);
+    }
+    if (extend_right >= 8) {
+      fill_row_sse2((uint8_t *)dst_ptr2, _mm_set1_epi16((short)src_ptr2[0]),
+                    extend_right * 2);
+    } else {
+      aom_memset16(dst_ptr2, src_ptr2[0], extend_right);
+    }
+    src_ptr1 += src_stride;
+    src_ptr2 += src_stride;
+    dst_ptr1 += src_stride;
+    dst_ptr2 += src_stride;
+  }
+
+  /* Now copy the top and bottom lines into each line of the respective
+   * borders
+   */
+  src_ptr1 = src - extend_left;
+  dst_ptr1 = src_ptr1 + src_stride * -extend_top;
+
+  for (int i = 0; i < extend_top; ++i) {
+    if (linesize >= 8) {
+      copy_row_sse2((uint8_t *)dst_ptr1, (const uint8_t *)src_ptr1,
+                    linesize * 2);
+    } else {
+      memcpy(dst_ptr1, src_ptr1, linesize * sizeof(uint16_t));
+    }
+    dst_ptr1 += src_stride;
+  }
+
+  src_ptr2 = src_ptr1 + src_stride * (height - 1);
+  dst_ptr2 = src_ptr2;
+
+  for (int i = 0; i < extend_bottom; ++i) {
+    dst_ptr2 += src_stride;
+    if (linesize >= 8) {
+      copy_row_sse2((uint8_t *)dst_ptr2, (const uint8_t *)src_ptr2,
+                    linesize * 2);
+    } else {
+      memcpy(dst_ptr2, src_ptr2, linesize * sizeof(uint16_t));
+    }
+  }
+}
+#endif  // CONFIG_AV1_HIGHBITDEPTH
+
+void aom_extend_frame_borders_plane_row_sse2(const YV12_BUFFER_CONFIG *ybf,
+                                             int plane, int v_start,
+                                             int v_end) {
+  const int ext_size = ybf->border;
+  const int ss_x = ybf->subsampling_x;
+  const int ss_y = ybf->subsampling_y;
+
+  assert(ybf->y_height - ybf->y_crop_height < 16);
+  assert(ybf->y_width - ybf->y_crop_width < 16);
+  assert(ybf->y_height - ybf->y_crop_height >= 0);
+  assert(ybf->y_width - ybf->y_crop_width >= 0);
+
+  const int is_uv = plane > 0;
+  const int top = ext_size >> (is_uv ? ss_y : 0);
+  const int left = ext_size >> (is_uv ? ss_x : 0);
+  const int bottom = top + ybf->heights[is_uv] - ybf->crop_heights[is_uv];
+  const int right = left + ybf->widths[is_uv] - ybf->crop_widths[is_uv];
+  const int extend_top_border = (v_start == 0);
+  const int extend_bottom_border = (v_end == ybf->crop_heights[is_uv]);
+
+#if CONFIG_AV1_HIGHBITDEPTH
+  if (ybf->flags & YV12_FLAG_HIGHBITDEPTH) {
+    extend_plane_high_sse2(ybf->buffers[plane], ybf->strides[is_uv],
+                           ybf->crop_widths[is_uv], ybf->crop_heights[is_uv],
+                           extend_top_border ? top : 0, left,
+                           extend_bottom_border ? bottom : 0, right, v_start,
+                           v_end);
+    return;
+  }
+#endif
+
+  extend_plane_sse2(ybf->buffers[plane], ybf->strides[is_uv],
+                    ybf->crop_widths[is_uv], ybf->crop_heights[is_uv],
+                    extend_top_border ? top : 0, left,
+                    extend_bottom_border ? bottom : 0, right, v_start, v_end);
+}
+
+void aom_yv12_extend_frame_borders_sse2(YV12_BUFFER_CONFIG *ybf,
+                                        const int num_planes) {
+  assert(ybf->border % 2 == 0);
+  assert(ybf->y_height - ybf->y_crop_height < 16);
+  assert(ybf->y_width - ybf->y_crop_width < 16);
+  assert(ybf->y_height - ybf->y_crop_height >= 0);
+  assert(ybf->y_width - ybf->y_crop_width >= 0);
+
+  for (int plane = 0; plane < num_planes; ++plane) {
+    const int is_uv = plane > 0;
+    const int plane_border = ybf->border >> is_uv;
+#if CONFIG_AV1_HIGHBITDEPTH
+    if (ybf->flags & YV12_FLAG_HIGHBITDEPTH) {
+      extend_plane_high_sse2(
+          ybf->buffers[plane], ybf->strides[is_uv], ybf->crop_widths[is_uv],
+          ybf->crop_heights[is_uv], plane_border, plane_border,
+          plane_border + ybf->heights[is_uv] - ybf->crop_heights[is_uv],
+          plane_border + ybf->widths[is_uv] - ybf->crop_widths[is_uv], 0,
+          ybf->crop_heights[is_uv]);
+      continue;
+    }
+#endif
+    extend_plane_sse2(
+        ybf->buffers[plane], ybf->strides[is_uv], ybf->crop_widths[is_uv],
+        ybf->crop_heights[is_uv], plane_border, plane_border,
+        plane_border + ybf->heights[is_uv] - ybf->crop_heights[is_uv],
+        plane_border + ybf->widths[is_uv] - ybf->crop_widths[is_uv], 0,
+        ybf->crop_heights[is_uv]);
+  }
+}
+
+// Copies the source image into the destination image and updates the
+// destination's UMV borders.
+// Note: The frames are assumed to be identical in size.
+void aom_yv12_copy_frame_sse2(const YV12_BUFFER_CONFIG *src_bc,
+                              YV12_BUFFER_CONFIG *dst_bc,
+                              const int num_planes) {
+  assert(src_bc->y_width == dst_bc->y_width);
+  assert(src_bc->y_height == dst_bc->y_height);
+
+  int bytes_per_sample = 1;
+#if CONFIG_AV1_HIGHBITDEPTH
+  assert((src_bc->flags & YV12_FLAG_HIGHBITDEPTH) ==
+         (dst_bc->flags & YV12_FLAG_HIGHBITDEPTH));
+  if (src_bc->flags & YV12_FLAG_HIGHBITDEPTH) bytes_per_sample = 2;
+#endif
+  const int use_nt = dst_bc->frame_size >= NT_COPY_MIN_FRAME_BYTES;
+
+  for (int plane = 0; plane < num_planes; ++plane) {
+    const int is_uv = plane > 0;
+    const uint8_t *plane_src = src_bc->buffers[plane];
+    uint8_t *plane_dst = dst_bc->buffers[plane];
+    int src_stride = src_bc->strides[is_uv];
+    int dst_stride = dst_bc->strides[is_uv];
+#if CONFIG_AV1_HIGHBITDEPTH
+    if (bytes_per_sample == 2) {
+      plane_src = (const uint8_t *)CONVERT_TO_SHORTPTR(plane_src);
+      plane_dst = (uint8_t *)CONVERT_TO_SHORTPTR(plane_dst);
+      src_stride *= 2;
+      dst_stride *= 2;
+    }
+#endif
+    const int row_bytes = src_bc->widths[is_uv] * bytes_per_sample;
+
+    for (int row = 0; row < src_bc->heights[is_uv]; ++row) {
+      if (use_nt) {
+        copy_row_nt_sse2(plane_dst, plane_src, row_bytes);
+      } else if (row_bytes >= 16) {
+        copy_row_sse2(plane_dst, plane_src, row_bytes);
+      } else {
+        memcpy(plane_dst, plane_src, row_bytes);
+      }
+      plane_src += src_stride;
+      plane_dst += dst_stride;
+    }
+  }
+  if (use_nt) _mm_sfence();
+
+  aom_yv12_extend_frame_borders_sse2(dst_bc, num_planes);
+}
@@ -29,6 +29,7 @@
 #include "aom/aomdx.h"
 #include "aom_ports/aom_timer.h"
 #include "aom_ports/mem_ops.h"
+#include "aom_util/aom_thread.h"
 #include "common/args.h"
 #include "common/ivfdec.h"
 #include "common/md5_utils.h"
@@ -75,6 +76,12 @@ static const arg_def_t limitarg =
     ARG_DEF(NULL, "limit", 1, "Stop decoding after n frames");
 static const arg_def_t skiparg =
     ARG_DEF(NULL, "skip", 1, "Skip the first n input frames");
+static const arg_def_t seekarg =
+    ARG_DEF(NULL, "seek", 1,
+            "Start the output at input frame n, only decoding the frames it "
+            "depends on");
+static const arg_def_t keyframesonlyarg =
+    ARG_DEF(NULL, "key-frames-only", 0, "Only decode and output key frames");
 static const arg_def_t summaryarg =
     ARG_DEF(NULL, "summary", 0, "Show timing summary");
 static const arg_def_t outputfile =
@@ -105,6 +112,16 @@ static const arg_def_t outallarg = ARG_DEF(
     NULL, "all-layers", 0, "Output all decoded frames of a scalable bitstream");
 static const arg_def_t skipfilmgrain =
     ARG_DEF(NULL, "skip-film-grain", 0, "Skip film grain application");
+static const arg_def_t fastdecodearg =
+    ARG_DEF(NULL, "fast-decode", 1,
+            "Non-conforming fast decode level (0: off (default), 1: skip "
+            "filters of non-reference frames, 2: also skip CDEF and loop "
+            "restoration, 3: 4-tap interpolation, 4: bilinear "
+            "interpolation)");
+static const arg_def_t decodestatsarg =
+    ARG_DEF(NULL, "decode-stats", 0,
+            "Show the time spent in each stage of the decode and the blocks "
+            "decoded");
 
 static const arg_def_t *all_args[] = {
   &help,           &codecarg, &use_yv12,      &use_i420,
@@ -113,7 +130,8 @@ static const arg_def_t *all_args[] = {
   &threadsarg,     &rowmtarg, &verbosearg,    &scalearg,
   &fb_arg,         &md5arg,   &framestatsarg, &continuearg,
   &outbitdeptharg, &isannexb, &oppointarg,    &outallarg,
-  &skipfilmgrain,  NULL
+  &skipfilmgrain,  &fastdecodearg, &seekarg,      &keyframesonlyarg,
+  &decodestatsarg, NULL
 };
 
 #if CONFIG_LIBYUV
@@ -261,6 +279,168 @@ static int read_frame(struct AvxDecInputContext *input, uint8_t **buf,
   }
 }
 
+// Returns whether decoding can start at the input frame in 'buf'.
+static int is_key_frame_unit(const struct AvxDecInputContext *input,
+                             const uint8_t *buf, size_t bytes_in_buffer) {
+  const int is_annexb = input->aom_input_ctx->file_type == FILE_TYPE_OBU &&
+                        input->obu_ctx->is_annexb;
+  return obudec_temporal_unit_is_key_frame(buf, bytes_in_buffer, is_annexb);
+}
+
+// Reads the next 'num_frames' input frames and decodes those the frame after
+// them depends on, dropping their output. Only the frames from the last key
+// frame on are decoded, and the decoder skips the non-reference ones. Returns
+// 0 on success.
+static int seek_frames(aom_codec_ctx_t *decoder,
+                       struct AvxDecInputContext *input, int num_frames,
+                       int skip_frames, uint8_t **buf,
+                       size_t *bytes_in_buffer, size_t *buffer_size) {
+  struct SeekUnit {
+    uint8_t *data;
+    size_t size;
+  } *units = NULL;
+  int num_units = 0;
+  int ret = -1;
+
+  for (int i = 0; i < num_frames; ++i) {
+    if (read_frame(input, buf, bytes_in_buffer, buffer_size)) break;
+    if (is_key_frame_unit(input, *buf, *bytes_in_buffer)) {
+      for (int j = 0; j < num_units; ++j) free(units[j].data);
+      num_units = 0;
+    }
+    struct SeekUnit *const new_units =
+        realloc(units, (num_units + 1) * sizeof(*units));
+    if (!new_units) goto fail;
+    units = new_units;
+    units[num_units].data = malloc(*bytes_in_buffer);
+    if (!units[num_units].data) goto fail;
+    memcpy(units[num_units].data, *buf, *bytes_in_buffer);
+    units[num_units].size = *bytes_in_buffer;
+    ++num_units;
+  }
+
+  // Skip the frames that are not used as references.
+  if (AOM_CODEC_CONTROL_TYPECHECKED(decoder, AV1D_SET_SKIP_FRAMES, 1)) {
+    goto fail;
+  }
+  for (int j = 0; j < num_units; ++j) {
+    aom_codec_iter_t iter = NULL;
+    if (aom_codec_decode(decoder, units[j].data, units[j].size, NULL)) {
+      const char *detail = aom_codec_error_detail(decoder);
+      aom_tools_warn("Failed to decode frame while seeking: %s",
+                     aom_codec_error(decoder));
+      if (detail) aom_tools_warn("Additional information: %s", detail);
+      goto fail;
+    }
+    while (aom_codec_get_frame(decoder, &iter)) {
+    }
+  }
+  if (AOM_CODEC_CONTROL_TYPECHECKED(decoder, AV1D_SET_SKIP_FRAMES,
+                                    skip_frames)) {
+    goto fail;
+  }
+  ret = 0;
+
+fail:
+  for (int j = 0; j < num_units; ++j) free(units[j].data);
+  free(units);
+  return ret;
+}
+
+// Reads the input frames one ahead of the decoding, on a thread of its own,
+// so that the file reads and the parsing of the container or of the OBU
+// framing overlap the decoding of the previous frame.
+struct InputReadAhead {
+  AVxWorker worker;
+  int threaded;
+  struct AvxDecInputContext *input;
+  // Buffer the input is read into. The WebM reader requires the same buffer
+  // on every read, so the frames are copied out of it.
+  uint8_t *read_buf;
+  size_t read_bytes;
+  size_t read_buf_size;
+  // The frame handed out for decoding, and the one being read ahead.
+  struct {
+    uint8_t *buf;
+    size_t bytes;
+    size_t size;
+  } frames[2];
+  int next;
+  // Result of read_frame() for the frame read ahead.
+  int status;
+  int pending;
+};
+
+static int read_ahead_hook(void *arg1, void *unused) {
+  (void)unused;
+  struct InputReadAhead *const ra = (struct InputReadAhead *)arg1;
+  ra->status = read_frame(ra->input, &ra->read_buf, &ra->read_bytes,
+                          &ra->read_buf_size);
+  if (ra->status) return 1;
+  if (ra->frames[ra->next].size < ra->read_bytes) {
+    uint8_t *const new_buf = realloc(ra->frames[ra->next].buf, ra->read_bytes);
+    if (!new_buf) {
+      ra->status = -1;
+      return 1;
+    }
+    ra->frames[ra->next].buf = new_buf;
+    ra->frames[ra->next].size = ra->read_bytes;
+  }
+  memcpy(ra->frames[ra->next].buf, ra->read_buf, ra->read_bytes);
+  ra->frames[ra->next].bytes = ra->read_bytes;
+  return 1;
+}
+
+// Starts reading ahead from 'input', taking over the buffer frames have been
+// read into so far.
+static void read_ahead_init(struct InputReadAhead *ra,
+                            struct AvxDecInputContext *input, uint8_t *buf,
+                            size_t buffer_size) {
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  memset(ra, 0, sizeof(*ra));
+  winterface->init(&ra->worker);
+  ra->worker.thread_name = "aomdec input";
+  ra->worker.hook = read_ahead_hook;
+  ra->worker.data1 = ra;
+  // Without a thread the frames are read when they are needed.
+  ra->threaded = winterface->reset(&ra->worker);
+  ra->input = input;
+  ra->read_buf = buf;
+  ra->read_buf_size = buffer_size;
+}
+
+// Returns the next input frame in 'data' and 'size', valid until the next
+// call. Returns 0 on success, as read_frame().
+static int read_ahead_frame(struct InputReadAhead *ra, const uint8_t **data,
+                            size_t *size) {
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  if (ra->pending) {
+    winterface->sync(&ra->worker);
+    ra->pending = 0;
+  } else {
+    winterface->execute(&ra->worker);
+  }
+  if (ra->status) return ra->status;
+  *data = ra->frames[ra->next].buf;
+  *size = ra->frames[ra->next].bytes;
+  ra->next ^= 1;
+  if (ra->threaded) {
+    winterface->launch(&ra->worker);
+    ra->pending = 1;
+  }
+  return 0;
+}
+
+static void read_ahead_free(struct InputReadAhead *ra) {
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  if (ra->pending) winterface->sync(&ra->worker);
+  winterface->end(&ra->worker);
+  for (int i = 0; i < 2; ++i) free(ra->frames[i].buf);
+  if (ra->input && ra->input->aom_input_ctx->file_type != FILE_TYPE_WEBM)
+    free(ra->read_buf);
+  memset(ra, 0, sizeof(*ra));
+}
+
 static int file_is_raw(struct AvxInputContext *input) {
   uint8_t buf[32];
   int is_raw = 0;
@@ -297,6 +477,63 @@ static void show_progress(int frame_in, int frame_out, uint64_t dx_time) {
           (double)frame_out * 1000000.0 / (double)dx_time);
 }
 
+static void add_decode_stats(aom_decode_stats_t *total,
+                             const aom_decode_stats_t *stats) {
+  total->decode_us += stats->decode_us;
+  for (int i = 0; i < AOM_DECODE_STAGES; ++i) {
+    total->stage_us[i] += stats->stage_us[i];
+  }
+  total->worker_idle_us += stats->worker_idle_us;
+  total->bytes += stats->bytes;
+  total->frames += stats->frames;
+  for (int i = 0; i < AOM_DECODE_STATS_BLOCK_SIZES; ++i) {
+    total->blocks[i] += stats->blocks[i];
+  }
+  total->intra_blocks += stats->intra_blocks;
+  total->inter_blocks += stats->inter_blocks;
+  total->compound_blocks += stats->compound_blocks;
+  total->skip_blocks += stats->skip_blocks;
+}
+
+static void show_decode_stats(const aom_decode_stats_t *stats) {
+  static const char *const stage_names[AOM_DECODE_STAGES] = {
+    "tiles", "loop filter", "cdef", "superres", "loop restoration", "film grain"
+  };
+  static const char *const block_size_names[AOM_DECODE_STATS_BLOCK_SIZES] = {
+    "4x4",   "4x8",    "8x4",    "8x8",     "8x16",  "16x8",
+    "16x16", "16x32",  "32x16",  "32x32",   "32x64", "64x32",
+    "64x64", "64x128", "128x64", "128x128", "4x16",  "16x4",
+    "8x32",  "32x8",   "16x64",  "64x16"
+  };
+  // Film grain is added outside of the decode call.
+  const uint64_t total_us =
+      stats->decode_us + stats->stage_us[AOM_DECODE_STAGE_FILM_GRAIN];
+  const double scale = total_us ? 100.0 / (double)total_us : 0.0;
+  uint64_t other_us = stats->decode_us;
+
+  fprintf(stderr,
+          "Decode stats: %u frames, %" PRIu64 " bytes, %" PRIu64 " us\n",
+          stats->frames, stats->bytes, total_us);
+  for (int i = 0; i < AOM_DECODE_STAGES; ++i) {
+    fprintf(stderr, "  %-18s %12" PRIu64 " us %5.1f%%\n", stage_names[i],
+            stats->stage_us[i], (double)stats->stage_us[i] * scale);
+    if (i != AOM_DECODE_STAGE_FILM_GRAIN) {
+      other_us -= stats->stage_us[i] < other_us ? stats->stage_us[i] : other_us;
+    }
+  }
+  fprintf(stderr, "  %-18s %12" PRIu64 " us %5.1f%%\n", "headers and setup",
+          other_us, (double)other_us * scale);
+  fprintf(stderr, "  %-18s %12" PRIu64 " us\n", "worker idle",
+          stats->worker_idle_us);
+  fprintf(stderr, "Blocks: %u intra, %u inter, %u compound, %u skip\n",
+          stats->intra_blocks, stats->inter_blocks, stats->compound_blocks,
+          stats->skip_blocks);
+  for (int i = 0; i < AOM_DECODE_STATS_BLOCK_SIZES; ++i) {
+    if (stats->blocks[i] == 0) continue;
+    fprintf(stderr, "  %-18s %12u\n", block_size_names[i], stats->blocks[i]);
+  }
+}
+
 struct ExternalFrameBuffer {
   uint8_t *data;
   size_t size;
@@ -447,11 +684,14 @@ static int main_loop(int argc, const char **argv_) {
   int ret = EXIT_FAILURE;
   uint8_t *buf = NULL;
   size_t bytes_in_buffer = 0, buffer_size = 0;
+  struct InputReadAhead read_ahead;
   FILE *infile;
   int frame_in = 0, frame_out = 0, flipuv = 0, noblit = 0;
   int do_md5 = 0, progress = 0;
   int stop_after = 0, summary = 0, quiet = 1;
   int arg_skip = 0;
+  int arg_seek = 0;
+  int skip_frames = 0;
   int keep_going = 0;
   uint64_t dx_time = 0;
   struct arg arg;
@@ -471,7 +711,10 @@ static int main_loop(int argc, const char **argv_) {
   int operating_point = 0;
   int output_all_layers = 0;
   int skip_film_grain = 0;
+  int fast_decode = 0;
   int enable_row_mt = 0;
+  int decode_stats = 0;
+  aom_decode_stats_t total_decode_stats;
   aom_image_t *scaled_img = NULL;
   aom_image_t *img_shifted = NULL;
   int frame_avail, got_data, flush_decoder = 0;
@@ -488,6 +731,8 @@ static int main_loop(int argc, const char **argv_) {
   unsigned char md5_digest[16];
 
   struct AvxDecInputContext input = { NULL, NULL, NULL };
+  memset(&read_ahead, 0, sizeof(read_ahead));
+  memset(&total_decode_stats, 0, sizeof(total_decode_stats));
   struct AvxInputContext aom_input_ctx;
   memset(&aom_input_ctx, 0, sizeof(aom_input_ctx));
 #if CONFIG_WEBM_IO
@@ -553,6 +798,10 @@ static int main_loop(int argc, const char **argv_) {
       stop_after = arg_parse_uint(&arg);
     } else if (arg_match(&arg, &skiparg, argi)) {
       arg_skip = arg_parse_uint(&arg);
+    } else if (arg_match(&arg, &seekarg, argi)) {
+      arg_seek = arg_parse_uint(&arg);
+    } else if (arg_match(&arg, &keyframesonlyarg, argi)) {
+      skip_frames = 2;
     } else if (arg_match(&arg, &md5arg, argi)) {
       do_md5 = 1;
     } else if (arg_match(&arg, &framestatsarg, argi)) {
@@ -593,6 +842,10 @@ static int main_loop(int argc, const char **argv_) {
       output_all_layers = 1;
     } else if (arg_match(&arg, &skipfilmgrain, argi)) {
       skip_film_grain = 1;
+    } else if (arg_match(&arg, &fastdecodearg, argi)) {
+      fast_decode = arg_parse_int(&arg);
+    } else if (arg_match(&arg, &decodestatsarg, argi)) {
+      decode_stats = 1;
     } else {
       argj++;
     }
@@ -742,6 +995,14 @@ static int main_loop(int argc, const char **argv_) {
     goto fail;
   }
 
+  if (fast_decode &&
+      AOM_CODEC_CONTROL_TYPECHECKED(&decoder, AV1D_SET_FAST_DECODE,
+                                    fast_decode)) {
+    fprintf(stderr, "Failed to set fast_decode: %s\n",
+            aom_codec_error(&decoder));
+    goto fail;
+  }
+
   if (AOM_CODEC_CONTROL_TYPECHECKED(&decoder, AV1D_SET_ROW_MT, enable_row_mt)) {
     fprintf(stderr, "Failed to set row multithreading mode: %s\n",
             aom_codec_error(&decoder));
@@ -754,6 +1015,23 @@ static int main_loop(int argc, const char **argv_) {
     arg_skip--;
   }
 
+  if (skip_frames &&
+      AOM_CODEC_CONTROL_TYPECHECKED(&decoder, AV1D_SET_SKIP_FRAMES,
+                                    skip_frames)) {
+    fprintf(stderr, "Failed to set skip_frames: %s\n",
+            aom_codec_error(&decoder));
+    goto fail;
+  }
+
+  if (arg_seek) {
+    fprintf(stderr, "Seeking to frame %d.\n", arg_seek);
+    if (seek_frames(&decoder, &input, arg_seek, skip_frames, &buf,
+                    &bytes_in_buffer, &buffer_size)) {
+      fprintf(stderr, "Failed to seek: %s\n", aom_codec_error(&decoder));
+      goto fail;
+    }
+  }
+
   if (num_external_frame_buffers > 0) {
     ext_fb_list.num_external_frame_buffers = num_external_frame_buffers;
     ext_fb_list.ext_fb = (struct ExternalFrameBuffer *)calloc(
@@ -771,6 +1049,10 @@ static int main_loop(int argc, const char **argv_) {
     }
   }
 
+  read_ahead_init(&read_ahead, &input, buf, buffer_size);
+  buf = NULL;
+  buffer_size = 0;
+
   frame_avail = 1;
   got_data = 0;
 
@@ -785,13 +1067,14 @@ static int main_loop(int argc, const char **argv_) {
 
     frame_avail = 0;
     if (!stop_after || frame_in < stop_after) {
-      if (!read_frame(&input, &buf, &bytes_in_buffer, &buffer_size)) {
+      const uint8_t *frame_data;
+      if (!read_ahead_frame(&read_ahead, &frame_data, &bytes_in_buffer)) {
         frame_avail = 1;
         frame_in++;
 
         aom_usec_timer_start(&timer);
 
-        if (aom_codec_decode(&decoder, buf, bytes_in_buffer, NULL)) {
+        if (aom_codec_decode(&decoder, frame_data, bytes_in_buffer, NULL)) {
           const char *detail = aom_codec_error_detail(&decoder);
           aom_tools_warn("Failed to decode frame %d: %s", frame_in,
                          aom_codec_error(&decoder));
@@ -1004,8 +1287,24 @@ static int main_loop(int argc, const char **argv_) {
         }
       }
     }
+
+    // The stats are those of the last call with data, once its frames with
+    // film grain are got.
+    if (decode_stats && frame_avail) {
+      aom_decode_stats_t stats;
+      if (AOM_CODEC_CONTROL_TYPECHECKED(&decoder, AV1D_GET_DECODE_STATS,
+                                        &stats)) {
+        aom_tools_warn("Failed AV1D_GET_DECODE_STATS: %s",
+                       aom_codec_error(&decoder));
+        if (!keep_going) goto fail;
+      } else {
+        add_decode_stats(&total_decode_stats, &stats);
+      }
+    }
   }
 
+  if (decode_stats) show_decode_stats(&total_decode_stats);
+
   if (summary || progress) {
     show_progress(frame_in, frame_out, dx_time);
     fprintf(stderr, "\n");
@@ -1025,6 +1324,8 @@ fail:
   }
 
 fail2:
+  // Stops the reads before the input is closed.
+  read_ahead_free(&read_ahead);
 
   if (!noblit && single_file) {
     if (do_md5) {
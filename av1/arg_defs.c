@@ -678,6 +678,17 @@ const av1_codec_arg_definitions_t g_av1_codec_arg_defs = {
       "Automatically turn off several intra coding tools for allintra mode; "
       "only in effect if --deltaq-mode=3"),
 
+  .frame_time_budget = ARG_DEF(
+      NULL, "frame-time-budget", 1,
+      "Per-frame encode time budget in microseconds for realtime mode at "
+      "speed 7 or above. The speed is raised while frames take longer "
+      "(0: disabled (default))"),
+
+  .async_lookahead = ARG_DEF(
+      NULL, "async-lookahead", 1,
+      "Run the one pass lookahead analysis on its own thread "
+      "(0: off (default), 1: on)"),
+
   .two_pass_input =
       ARG_DEF(NULL, "two-pass-input", 1,
               "The input file for the second pass for three-pass encoding"),
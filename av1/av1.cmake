@@ -177,8 +177,12 @@ list(APPEND AOM_AV1_ENCODER_SOURCES
             "${AOM_ROOT}/av1/encoder/hash_motion.h"
             "${AOM_ROOT}/av1/encoder/hybrid_fwd_txfm.c"
             "${AOM_ROOT}/av1/encoder/hybrid_fwd_txfm.h"
+            "${AOM_ROOT}/av1/encoder/inter_pred_cache.c"
+            "${AOM_ROOT}/av1/encoder/inter_pred_cache.h"
             "${AOM_ROOT}/av1/encoder/interp_search.c"
             "${AOM_ROOT}/av1/encoder/interp_search.h"
+            "${AOM_ROOT}/av1/encoder/lap_worker.c"
+            "${AOM_ROOT}/av1/encoder/lap_worker.h"
             "${AOM_ROOT}/av1/encoder/level.c"
             "${AOM_ROOT}/av1/encoder/level.h"
             "${AOM_ROOT}/av1/encoder/lookahead.c"
@@ -189,6 +193,8 @@ list(APPEND AOM_AV1_ENCODER_SOURCES
             "${AOM_ROOT}/av1/encoder/ml.c"
             "${AOM_ROOT}/av1/encoder/ml.h"
             "${AOM_ROOT}/av1/encoder/model_rd.h"
+            "${AOM_ROOT}/av1/encoder/motion_field_cache.c"
+            "${AOM_ROOT}/av1/encoder/motion_field_cache.h"
             "${AOM_ROOT}/av1/encoder/motion_search_facade.c"
             "${AOM_ROOT}/av1/encoder/motion_search_facade.h"
             "${AOM_ROOT}/av1/encoder/mv_prec.c"
@@ -224,6 +230,8 @@ list(APPEND AOM_AV1_ENCODER_SOURCES
             "${AOM_ROOT}/av1/encoder/segmentation.c"
             "${AOM_ROOT}/av1/encoder/segmentation.h"
             "${AOM_ROOT}/av1/encoder/sorting_network.h"
+            "${AOM_ROOT}/av1/encoder/speed_control.c"
+            "${AOM_ROOT}/av1/encoder/speed_control.h"
             "${AOM_ROOT}/av1/encoder/speed_features.c"
             "${AOM_ROOT}/av1/encoder/speed_features.h"
             "${AOM_ROOT}/av1/encoder/superres_scale.c"
@@ -305,6 +313,12 @@ list(APPEND AOM_AV1_COMMON_INTRIN_AVX2
             "${AOM_ROOT}/av1/common/x86/warp_plane_avx2.c"
             "${AOM_ROOT}/av1/common/x86/wiener_convolve_avx2.c")
 
+list(APPEND AOM_AV1_DECODER_INTRIN_SSE4_1
+            "${AOM_ROOT}/av1/decoder/x86/decodetxb_sse4.c")
+
+list(APPEND AOM_AV1_DECODER_INTRIN_AVX2
+            "${AOM_ROOT}/av1/decoder/x86/decodetxb_avx2.c")
+
 list(APPEND AOM_AV1_ENCODER_ASM_SSE2 "${AOM_ROOT}/av1/encoder/x86/dct_sse2.asm"
             "${AOM_ROOT}/av1/encoder/x86/error_sse2.asm")
 
@@ -347,7 +361,8 @@ list(APPEND AOM_AV1_ENCODER_INTRIN_AVX2
             "${AOM_ROOT}/av1/encoder/x86/av1_k_means_avx2.c"
             "${AOM_ROOT}/av1/encoder/x86/temporal_filter_avx2.c"
             "${AOM_ROOT}/av1/encoder/x86/pickrst_avx2.c"
-            "${AOM_ROOT}/av1/encoder/x86/cnn_avx2.c")
+            "${AOM_ROOT}/av1/encoder/x86/cnn_avx2.c"
+            "${AOM_ROOT}/av1/encoder/x86/ml_avx2.c")
 
 list(APPEND AOM_AV1_ENCODER_INTRIN_NEON
             "${AOM_ROOT}/av1/encoder/arm/neon/quantize_neon.c"
@@ -493,6 +508,8 @@ if(CONFIG_REALTIME_ONLY)
                    "${AOM_ROOT}/av1/encoder/global_motion_facade.h"
                    "${AOM_ROOT}/av1/encoder/gop_structure.c"
                    "${AOM_ROOT}/av1/encoder/gop_structure.h"
+                   "${AOM_ROOT}/av1/encoder/lap_worker.c"
+                   "${AOM_ROOT}/av1/encoder/lap_worker.h"
                    "${AOM_ROOT}/av1/encoder/misc_model_weights.h"
                    "${AOM_ROOT}/av1/encoder/partition_cnn_weights.h"
                    "${AOM_ROOT}/av1/encoder/partition_model_weights.h"
@@ -587,6 +604,13 @@ function(setup_av1_targets)
     add_intrinsics_object_library("-msse4.1" "sse4" "aom_av1_common"
                                   "AOM_AV1_COMMON_INTRIN_SSE4_1")
 
+    if(CONFIG_AV1_DECODER)
+      if(AOM_AV1_DECODER_INTRIN_SSE4_1)
+        add_intrinsics_object_library("-msse4.1" "sse4" "aom_av1_decoder"
+                                      "AOM_AV1_DECODER_INTRIN_SSE4_1")
+      endif()
+    endif()
+
     if(CONFIG_AV1_ENCODER)
       if("${AOM_TARGET_CPU}" STREQUAL "x86_64")
         add_asm_library("aom_av1_encoder_ssse3"
@@ -615,6 +639,13 @@ function(setup_av1_targets)
     add_intrinsics_object_library("-mavx2" "avx2" "aom_av1_common"
                                   "AOM_AV1_COMMON_INTRIN_AVX2")
 
+    if(CONFIG_AV1_DECODER)
+      if(AOM_AV1_DECODER_INTRIN_AVX2)
+        add_intrinsics_object_library("-mavx2" "avx2" "aom_av1_decoder"
+                                      "AOM_AV1_DECODER_INTRIN_AVX2")
+      endif()
+    endif()
+
     if(CONFIG_AV1_ENCODER)
       add_intrinsics_object_library("-mavx2" "avx2" "aom_av1_encoder"
                                     "AOM_AV1_ENCODER_INTRIN_AVX2")
@@ -30,6 +30,7 @@
 #include "av1/encoder/ethread.h"
 #include "av1/encoder/external_partition.h"
 #include "av1/encoder/firstpass.h"
+#include "av1/encoder/lap_worker.h"
 #include "av1/encoder/rc_utils.h"
 #include "av1/arg_defs.h"
 
@@ -200,6 +201,8 @@ struct av1_extracfg {
   int kf_max_pyr_height;
   int sb_qp_sweep;
   GlobalMotionMethod global_motion_method;
+  unsigned int frame_time_budget;
+  int async_lookahead;
 };
 
 #if CONFIG_REALTIME_ONLY
@@ -366,6 +369,8 @@ static const struct av1_extracfg default_extra_cfg = {
   -1,                            // kf_max_pyr_height
   0,                             // sb_qp_sweep
   GLOBAL_MOTION_METHOD_DISFLOW,  // global_motion_method
+  0,                             // frame_time_budget
+  0,                             // async_lookahead
 };
 #else
 static const struct av1_extracfg default_extra_cfg = {
@@ -518,6 +523,8 @@ static const struct av1_extracfg default_extra_cfg = {
   -1,                            // kf_max_pyr_height
   0,                             // sb_qp_sweep
   GLOBAL_MOTION_METHOD_DISFLOW,  // global_motion_method
+  0,                             // frame_time_budget
+  0,                             // async_lookahead
 };
 #endif
 
@@ -546,6 +553,8 @@ struct aom_codec_alg_priv {
   // Number of stats buffers required for look ahead
   int num_lap_buffers;
   STATS_BUFFER_CTX stats_buf_context;
+  // Runs the LAP stage on its own thread when async_lookahead is set.
+  LapWorker *lap_worker;
 };
 
 static INLINE int gcd(int64_t a, int b) {
@@ -576,6 +585,14 @@ static aom_codec_err_t update_error_state(
   return res;
 }
 
+#if !CONFIG_REALTIME_ONLY
+// Waits for the LAP stage launched by the last encoder_encode() call, if any.
+static aom_codec_err_t sync_lap_worker(aom_codec_alg_priv_t *ctx) {
+  if (ctx->lap_worker == NULL) return AOM_CODEC_OK;
+  return av1_lap_worker_sync(ctx->lap_worker, ctx->ppi);
+}
+#endif
+
 // This function deep copies a string src to *dst. For default string we will
 // use a string literal, and otherwise we will allocate memory for the string.
 static aom_codec_err_t allocate_and_set_string(const char *src,
@@ -878,6 +895,7 @@ static aom_codec_err_t validate_config(aom_codec_alg_priv_t *ctx,
   RANGE_CHECK_BOOL(extra_cfg, skip_postproc_filtering);
   RANGE_CHECK_HI(extra_cfg, enable_cdef, 2);
   RANGE_CHECK_BOOL(extra_cfg, auto_intra_tools_off);
+  RANGE_CHECK_BOOL(extra_cfg, async_lookahead);
   RANGE_CHECK_BOOL(extra_cfg, strict_level_conformance);
   RANGE_CHECK_BOOL(extra_cfg, sb_qp_sweep);
   RANGE_CHECK(extra_cfg, global_motion_method,
@@ -1485,6 +1503,8 @@ static void set_encoder_config(AV1EncoderConfig *oxcf,
   oxcf->sb_qp_sweep = extra_cfg->sb_qp_sweep;
 
   oxcf->global_motion_method = extra_cfg->global_motion_method;
+
+  oxcf->frame_time_budget = extra_cfg->frame_time_budget;
 }
 
 AV1EncoderConfig av1_get_encoder_config(const aom_codec_enc_cfg_t *cfg) {
@@ -1524,6 +1544,9 @@ static aom_codec_err_t encoder_set_config(aom_codec_alg_priv_t *ctx,
     ERROR("Cannot change lag_in_frames if LAP is enabled");
 
   res = validate_config(ctx, cfg, &ctx->extra_cfg);
+#if !CONFIG_REALTIME_ONLY
+  if (res == AOM_CODEC_OK) res = sync_lap_worker(ctx);
+#endif
 
   if (res == AOM_CODEC_OK) {
     ctx->cfg = *cfg;
@@ -1584,7 +1607,10 @@ static aom_codec_err_t ctrl_get_baseline_gf_interval(aom_codec_alg_priv_t *ctx,
 
 static aom_codec_err_t update_extra_cfg(aom_codec_alg_priv_t *ctx,
                                         const struct av1_extracfg *extra_cfg) {
-  const aom_codec_err_t res = validate_config(ctx, &ctx->cfg, extra_cfg);
+  aom_codec_err_t res = validate_config(ctx, &ctx->cfg, extra_cfg);
+#if !CONFIG_REALTIME_ONLY
+  if (res == AOM_CODEC_OK) res = sync_lap_worker(ctx);
+#endif
   if (res == AOM_CODEC_OK) {
     ctx->extra_cfg = *extra_cfg;
     set_encoder_config(&ctx->oxcf, &ctx->cfg, &ctx->extra_cfg);
@@ -2658,6 +2684,20 @@ static aom_codec_err_t ctrl_set_auto_intra_tools_off(aom_codec_alg_priv_t *ctx,
   return update_extra_cfg(ctx, &extra_cfg);
 }
 
+static aom_codec_err_t ctrl_set_frame_time_budget(aom_codec_alg_priv_t *ctx,
+                                                  va_list args) {
+  struct av1_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.frame_time_budget = CAST(AV1E_SET_FRAME_TIME_BUDGET, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
+static aom_codec_err_t ctrl_set_async_lookahead(aom_codec_alg_priv_t *ctx,
+                                                va_list args) {
+  struct av1_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.async_lookahead = CAST(AV1E_SET_ASYNC_LOOKAHEAD, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
 static aom_codec_err_t encoder_init(aom_codec_ctx_t *ctx) {
   aom_codec_err_t res = AOM_CODEC_OK;
 
@@ -2805,6 +2845,12 @@ static aom_codec_err_t encoder_destroy(aom_codec_alg_priv_t *ctx) {
 
   if (ctx->ppi) {
     AV1_PRIMARY *ppi = ctx->ppi;
+#if !CONFIG_REALTIME_ONLY
+    if (ctx->lap_worker != NULL) {
+      sync_lap_worker(ctx);
+      av1_lap_worker_free(ctx->lap_worker);
+    }
+#endif
     for (int i = 0; i < MAX_PARALLEL_FRAMES - 1; i++) {
       if (ppi->parallel_frames_data[i].cx_data) {
         free(ppi->parallel_frames_data[i].cx_data);
@@ -2865,6 +2911,19 @@ static INLINE int get_src_border_in_pixels(AV1_COMP *cpi, BLOCK_SIZE sb_size) {
   return border_in_pixels;
 }
 
+#if !CONFIG_REALTIME_ONLY
+// Whether the LAP stage of this call should run on the LAP worker, next to the
+// encode of the frames it was pushed for. The main encoder then gets the stats
+// of a frame one call later, so the LAP stage needs a lead of two frames on it
+// to keep stats for the frame being encoded. The TPL buffers are allocated by
+// whichever stage encodes first, so the LAP stage stays on the caller's thread
+// until they exist.
+static int use_lap_worker(const aom_codec_alg_priv_t *ctx) {
+  return ctx->extra_cfg.async_lookahead && ctx->num_lap_buffers >= 2 &&
+         ctx->ppi->tpl_data.tpl_stats_pool[0] != NULL;
+}
+#endif
+
 // TODO(Mufaddal): Check feasibility of abstracting functions related to LAP
 // into a separate function.
 static aom_codec_err_t encoder_encode(aom_codec_alg_priv_t *ctx,
@@ -2950,6 +3009,14 @@ static aom_codec_err_t encoder_encode(aom_codec_alg_priv_t *ctx,
   }
   ppi->error.setjmp = 1;
 
+#if !CONFIG_REALTIME_ONLY
+  // The LAP stage launched by the previous call must be done before its
+  // compressor is touched or a new frame is pushed into the lookahead.
+  if (sync_lap_worker(ctx) != AOM_CODEC_OK) {
+    aom_internal_error(&ppi->error, AOM_CODEC_ERROR, NULL);
+  }
+#endif
+
   if (ppi->use_svc && ppi->cpi->svc.use_flexible_mode == 0 && flags == 0)
     av1_set_svc_fixed_mode(ppi->cpi);
 
@@ -3122,7 +3189,21 @@ static aom_codec_err_t encoder_encode(aom_codec_alg_priv_t *ctx,
     }
 
     // Call for LAP stage
-    if (cpi_lap != NULL) {
+    int lap_launched = 0;
+#if !CONFIG_REALTIME_ONLY
+    if (cpi_lap != NULL && use_lap_worker(ctx)) {
+      if (ctx->lap_worker == NULL) {
+        ctx->lap_worker = av1_lap_worker_alloc();
+        if (ctx->lap_worker == NULL) {
+          aom_internal_error(&ppi->error, AOM_CODEC_MEM_ERROR,
+                             "Failed to allocate LAP worker");
+        }
+      }
+      av1_lap_worker_launch(ctx->lap_worker, ppi, !img, &ctx->timestamp_ratio);
+      lap_launched = 1;
+    }
+#endif
+    if (cpi_lap != NULL && !lap_launched) {
       AV1_COMP_DATA cpi_lap_data = { 0 };
       cpi_lap_data.flush = !img;
       cpi_lap_data.timestamp_ratio = &ctx->timestamp_ratio;
@@ -4129,6 +4210,12 @@ static aom_codec_err_t encoder_set_option(aom_codec_alg_priv_t *ctx,
   } else if (arg_match_helper(&arg, &g_av1_codec_arg_defs.global_motion_method,
                               argv, err_string)) {
     extra_cfg.global_motion_method = arg_parse_enum_helper(&arg, err_string);
+  } else if (arg_match_helper(&arg, &g_av1_codec_arg_defs.frame_time_budget,
+                              argv, err_string)) {
+    extra_cfg.frame_time_budget = arg_parse_uint_helper(&arg, err_string);
+  } else if (arg_match_helper(&arg, &g_av1_codec_arg_defs.async_lookahead,
+                              argv, err_string)) {
+    extra_cfg.async_lookahead = arg_parse_int_helper(&arg, err_string);
   } else {
     match = 0;
     snprintf(err_string, ARG_ERR_MSG_MAX_LEN, "Cannot find aom option %s",
@@ -4331,6 +4418,8 @@ static aom_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   { AV1E_SET_AUTO_INTRA_TOOLS_OFF, ctrl_set_auto_intra_tools_off },
   { AV1E_SET_RTC_EXTERNAL_RC, ctrl_set_rtc_external_rc },
   { AV1E_SET_QUANTIZER_ONE_PASS, ctrl_set_quantizer_one_pass },
+  { AV1E_SET_FRAME_TIME_BUDGET, ctrl_set_frame_time_budget },
+  { AV1E_SET_ASYNC_LOOKAHEAD, ctrl_set_async_lookahead },
 
   // Getters
   { AOME_GET_LAST_QUANTIZER, ctrl_get_quantizer },
@@ -9,6 +9,7 @@
  * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
  */
 
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -21,6 +22,7 @@
 #include "aom/aom_decoder.h"
 #include "aom_dsp/bitreader_buffer.h"
 #include "aom_dsp/aom_dsp_common.h"
+#include "aom_ports/aom_timer.h"
 #include "aom_ports/mem_ops.h"
 #include "aom_util/aom_thread.h"
 
@@ -48,6 +50,9 @@ struct aom_codec_alg_priv {
   int byte_alignment;
   int skip_loop_filter;
   int skip_film_grain;
+  int fast_decode;
+  int skip_frames;
+  aom_decode_roi_t decode_roi;
   int decode_tile_row;
   int decode_tile_col;
   unsigned int tile_mode;
@@ -61,6 +66,8 @@ struct aom_codec_alg_priv {
   AVxWorker *frame_worker;
 
   aom_image_t image_with_grain;
+  // Application-owned image that film grain is added into, if set.
+  aom_image_t *grain_output_img;
   aom_codec_frame_buffer_t grain_image_frame_buffers[MAX_NUM_SPATIAL_LAYERS];
   size_t num_grain_image_frame_buffers;
   int need_resync;  // wait for key/intra-only frame
@@ -76,6 +83,8 @@ struct aom_codec_alg_priv {
   aom_inspect_cb inspect_cb;
   void *inspect_ctx;
 #endif
+  aom_row_output_cb_fn_t row_output_cb;
+  void *row_output_priv;
 };
 
 static aom_codec_err_t decoder_init(aom_codec_ctx_t *ctx) {
@@ -375,6 +384,15 @@ static aom_codec_err_t update_error_state(
   return error->error_code;
 }
 
+static void set_decode_roi(AV1Decoder *pbi, const aom_decode_roi_t *roi) {
+  pbi->roi.x = (int)AOMMIN(roi->x, (unsigned int)INT_MAX);
+  pbi->roi.y = (int)AOMMIN(roi->y, (unsigned int)INT_MAX);
+  pbi->roi.width =
+      (int)AOMMIN(roi->width, (unsigned int)(INT_MAX - pbi->roi.x));
+  pbi->roi.height =
+      (int)AOMMIN(roi->height, (unsigned int)(INT_MAX - pbi->roi.y));
+}
+
 static void init_buffer_callbacks(aom_codec_alg_priv_t *ctx) {
   AVxWorker *const worker = ctx->frame_worker;
   FrameWorkerData *const frame_worker_data = (FrameWorkerData *)worker->data1;
@@ -386,6 +404,9 @@ static void init_buffer_callbacks(aom_codec_alg_priv_t *ctx) {
   cm->features.byte_alignment = ctx->byte_alignment;
   pbi->skip_loop_filter = ctx->skip_loop_filter;
   pbi->skip_film_grain = ctx->skip_film_grain;
+  pbi->fast_decode = (FAST_DECODE_LEVEL)ctx->fast_decode;
+  pbi->skip_frames = (SKIP_FRAMES_MODE)ctx->skip_frames;
+  set_decode_roi(pbi, &ctx->decode_roi);
 
   if (ctx->get_ext_fb_cb != NULL && ctx->release_ext_fb_cb != NULL) {
     pool->get_fb_cb = ctx->get_ext_fb_cb;
@@ -406,11 +427,16 @@ static void init_buffer_callbacks(aom_codec_alg_priv_t *ctx) {
 static int frame_worker_hook(void *arg1, void *arg2) {
   FrameWorkerData *const frame_worker_data = (FrameWorkerData *)arg1;
   const uint8_t *data = frame_worker_data->data;
+  struct aom_usec_timer timer;
   (void)arg2;
 
+  aom_usec_timer_start(&timer);
   int result = av1_receive_compressed_data(frame_worker_data->pbi,
                                            frame_worker_data->data_size, &data);
   frame_worker_data->data_end = data;
+  aom_usec_timer_mark(&timer);
+  frame_worker_data->pbi->decode_stats.decode_us +=
+      aom_usec_timer_elapsed(&timer);
 
   if (result != 0) {
     // Check decode result in serial decode.
@@ -504,6 +530,16 @@ static INLINE void check_resync(aom_codec_alg_priv_t *const ctx,
     ctx->need_resync = 0;
 }
 
+static void row_output_cb_wrapper(void *priv, const YV12_BUFFER_CONFIG *buf,
+                                  int row_start, int row_end) {
+  aom_codec_alg_priv_t *const ctx = (aom_codec_alg_priv_t *)priv;
+  aom_image_t img;
+  memset(&img, 0, sizeof(img));
+  yuvconfig2image(&img, buf, NULL);
+  ctx->row_output_cb(ctx->row_output_priv, &img, (unsigned int)row_start,
+                     (unsigned int)row_end);
+}
+
 static aom_codec_err_t decode_one(aom_codec_alg_priv_t *ctx,
                                   const uint8_t **data, size_t data_sz,
                                   void *user_priv) {
@@ -535,6 +571,9 @@ static aom_codec_err_t decode_one(aom_codec_alg_priv_t *ctx,
   frame_worker_data->pbi->ext_tile_debug = ctx->ext_tile_debug;
   frame_worker_data->pbi->row_mt = ctx->row_mt;
   frame_worker_data->pbi->ext_refs = ctx->ext_refs;
+  frame_worker_data->pbi->row_output_cb =
+      ctx->row_output_cb != NULL ? row_output_cb_wrapper : NULL;
+  frame_worker_data->pbi->row_output_priv = ctx;
 
   frame_worker_data->pbi->is_annexb = ctx->is_annexb;
 
@@ -692,6 +731,10 @@ static aom_codec_err_t decoder_decode(aom_codec_alg_priv_t *ctx,
     if (res != AOM_CODEC_OK) return res;
   }
 
+  AV1Decoder *const pbi = ((FrameWorkerData *)ctx->frame_worker->data1)->pbi;
+  memset(&pbi->decode_stats, 0, sizeof(pbi->decode_stats));
+  pbi->decode_stats.bytes = data_sz;
+
   const uint8_t *data_start = data;
   const uint8_t *data_end = data + data_sz;
 
@@ -758,12 +801,24 @@ static void *AllocWithGetFrameBufferCb(void *priv, size_t size) {
 static aom_image_t *add_grain_if_needed(aom_codec_alg_priv_t *ctx,
                                         aom_image_t *img,
                                         aom_image_t *grain_img,
-                                        aom_film_grain_t *grain_params) {
+                                        aom_film_grain_t *grain_params,
+                                        AVxWorker *workers, int num_workers) {
   if (!grain_params->apply_grain) return img;
 
   const int w_even = ALIGN_POWER_OF_TWO_UNSIGNED(img->d_w, 1);
   const int h_even = ALIGN_POWER_OF_TWO_UNSIGNED(img->d_h, 1);
 
+  aom_image_t *const app_img = ctx->grain_output_img;
+  if (app_img && app_img->fmt == img->fmt && app_img->w >= (unsigned)w_even &&
+      app_img->h >= (unsigned)h_even) {
+    if (av1_add_film_grain_mt(grain_params, img, app_img, workers,
+                              num_workers)) {
+      return NULL;
+    }
+    app_img->user_priv = img->user_priv;
+    return app_img;
+  }
+
   BufferPool *const pool = ctx->buffer_pool;
   aom_codec_frame_buffer_t *fb =
       &ctx->grain_image_frame_buffers[ctx->num_grain_image_frame_buffers];
@@ -777,7 +832,8 @@ static aom_image_t *add_grain_if_needed(aom_codec_alg_priv_t *ctx,
 
   grain_img->user_priv = img->user_priv;
   grain_img->fb_priv = fb->priv;
-  if (av1_add_film_grain(grain_params, img, grain_img)) {
+  if (av1_add_film_grain_mt(grain_params, img, grain_img, workers,
+                            num_workers)) {
     pool->release_fb_cb(pool->cb_priv, fb);
     return NULL;
   }
@@ -886,8 +942,13 @@ static aom_image_t *decoder_get_frame(aom_codec_alg_priv_t *ctx,
         img->temporal_id = output_frame_buf->temporal_id;
         img->spatial_id = output_frame_buf->spatial_id;
         if (pbi->skip_film_grain) grain_params->apply_grain = 0;
+        // The tile workers are idle once the frame is decoded, so they are
+        // reused to add grain in parallel.
+        start_stage_timing(pbi, AOM_DECODE_STAGE_FILM_GRAIN);
         aom_image_t *res =
-            add_grain_if_needed(ctx, img, &ctx->image_with_grain, grain_params);
+            add_grain_if_needed(ctx, img, &ctx->image_with_grain, grain_params,
+                                pbi->tile_workers, pbi->num_workers);
+        end_stage_timing(pbi, AOM_DECODE_STAGE_FILM_GRAIN);
         if (!res) {
           aom_internal_error(&pbi->error, AOM_CODEC_CORRUPT_FRAME,
                              "Grain systhesis failed\n");
@@ -1476,6 +1537,17 @@ static aom_codec_err_t ctrl_get_order_hint(aom_codec_alg_priv_t *ctx,
   return AOM_CODEC_OK;
 }
 
+static aom_codec_err_t ctrl_get_decode_stats(aom_codec_alg_priv_t *ctx,
+                                            va_list args) {
+  aom_decode_stats_t *const arg = va_arg(args, aom_decode_stats_t *);
+  if (arg == NULL) return AOM_CODEC_INVALID_PARAM;
+  if (ctx->frame_worker == NULL) return AOM_CODEC_ERROR;
+  FrameWorkerData *const frame_worker_data =
+      (FrameWorkerData *)ctx->frame_worker->data1;
+  *arg = frame_worker_data->pbi->decode_stats;
+  return AOM_CODEC_OK;
+}
+
 static aom_codec_err_t ctrl_get_mi_info(aom_codec_alg_priv_t *ctx,
                                         va_list args) {
   int mi_row = va_arg(args, int);
@@ -1543,6 +1615,12 @@ static aom_codec_err_t ctrl_set_skip_loop_filter(aom_codec_alg_priv_t *ctx,
   return AOM_CODEC_OK;
 }
 
+static aom_codec_err_t ctrl_set_grain_output_image(aom_codec_alg_priv_t *ctx,
+                                                   va_list args) {
+  ctx->grain_output_img = va_arg(args, aom_image_t *);
+  return AOM_CODEC_OK;
+}
+
 static aom_codec_err_t ctrl_set_skip_film_grain(aom_codec_alg_priv_t *ctx,
                                                 va_list args) {
   ctx->skip_film_grain = va_arg(args, int);
@@ -1556,6 +1634,56 @@ static aom_codec_err_t ctrl_set_skip_film_grain(aom_codec_alg_priv_t *ctx,
   return AOM_CODEC_OK;
 }
 
+static aom_codec_err_t ctrl_set_fast_decode(aom_codec_alg_priv_t *ctx,
+                                            va_list args) {
+  const int fast_decode = va_arg(args, int);
+  if (fast_decode < FAST_DECODE_OFF || fast_decode >= FAST_DECODE_LEVELS)
+    return AOM_CODEC_INVALID_PARAM;
+  ctx->fast_decode = fast_decode;
+
+  if (ctx->frame_worker) {
+    AVxWorker *const worker = ctx->frame_worker;
+    FrameWorkerData *const frame_worker_data = (FrameWorkerData *)worker->data1;
+    frame_worker_data->pbi->fast_decode = (FAST_DECODE_LEVEL)fast_decode;
+  }
+
+  return AOM_CODEC_OK;
+}
+
+static aom_codec_err_t ctrl_set_skip_frames(aom_codec_alg_priv_t *ctx,
+                                            va_list args) {
+  const int skip_frames = va_arg(args, int);
+  if (skip_frames < SKIP_FRAMES_NONE || skip_frames >= SKIP_FRAMES_MODES)
+    return AOM_CODEC_INVALID_PARAM;
+  ctx->skip_frames = skip_frames;
+
+  if (ctx->frame_worker) {
+    AVxWorker *const worker = ctx->frame_worker;
+    FrameWorkerData *const frame_worker_data = (FrameWorkerData *)worker->data1;
+    frame_worker_data->pbi->skip_frames = (SKIP_FRAMES_MODE)skip_frames;
+  }
+
+  return AOM_CODEC_OK;
+}
+
+static aom_codec_err_t ctrl_set_decode_roi(aom_codec_alg_priv_t *ctx,
+                                           va_list args) {
+  const aom_decode_roi_t *const roi = va_arg(args, aom_decode_roi_t *);
+  if (roi == NULL) {
+    memset(&ctx->decode_roi, 0, sizeof(ctx->decode_roi));
+  } else {
+    ctx->decode_roi = *roi;
+  }
+
+  if (ctx->frame_worker) {
+    AVxWorker *const worker = ctx->frame_worker;
+    FrameWorkerData *const frame_worker_data = (FrameWorkerData *)worker->data1;
+    set_decode_roi(frame_worker_data->pbi, &ctx->decode_roi);
+  }
+
+  return AOM_CODEC_OK;
+}
+
 static aom_codec_err_t ctrl_get_accounting(aom_codec_alg_priv_t *ctx,
                                            va_list args) {
 #if !CONFIG_ACCOUNTING
@@ -1632,6 +1760,19 @@ static aom_codec_err_t ctrl_set_inspection_callback(aom_codec_alg_priv_t *ctx,
 #endif
 }
 
+static aom_codec_err_t ctrl_set_row_output_callback(aom_codec_alg_priv_t *ctx,
+                                                     va_list args) {
+  const aom_row_output_cb_init *init = va_arg(args, aom_row_output_cb_init *);
+  if (init == NULL) {
+    ctx->row_output_cb = NULL;
+    ctx->row_output_priv = NULL;
+  } else {
+    ctx->row_output_cb = init->row_output_cb;
+    ctx->row_output_priv = init->user_priv;
+  }
+  return AOM_CODEC_OK;
+}
+
 static aom_codec_err_t ctrl_ext_tile_debug(aom_codec_alg_priv_t *ctx,
                                            va_list args) {
   ctx->ext_tile_debug = va_arg(args, int);
@@ -1663,6 +1804,11 @@ static aom_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
   { AV1D_SET_ROW_MT, ctrl_set_row_mt },
   { AV1D_SET_EXT_REF_PTR, ctrl_set_ext_ref_ptr },
   { AV1D_SET_SKIP_FILM_GRAIN, ctrl_set_skip_film_grain },
+  { AV1D_SET_GRAIN_OUTPUT_IMAGE, ctrl_set_grain_output_image },
+  { AV1D_SET_ROW_OUTPUT_CALLBACK, ctrl_set_row_output_callback },
+  { AV1D_SET_FAST_DECODE, ctrl_set_fast_decode },
+  { AV1D_SET_SKIP_FRAMES, ctrl_set_skip_frames },
+  { AV1D_SET_DECODE_ROI, ctrl_set_decode_roi },
 
   // Getters
   { AOMD_GET_FRAME_CORRUPTED, ctrl_get_frame_corrupted },
@@ -1693,6 +1839,7 @@ static aom_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
   { AOMD_GET_BASE_Q_IDX, ctrl_get_base_q_idx },
   { AOMD_GET_ORDER_HINT, ctrl_get_order_hint },
   { AV1D_GET_MI_INFO, ctrl_get_mi_info },
+  { AV1D_GET_DECODE_STATS, ctrl_get_decode_stats },
   CTRL_MAP_END,
 };
 
@@ -272,7 +272,9 @@ static TX_SIZE set_lpf_parameters(
       if (coord) {
         {
           const MB_MODE_INFO *const mi_prev = *(mi - mode_step);
-          if (mi_prev == NULL) return TX_INVALID;
+          // The edge is not filtered if the previous block was not decoded,
+          // but the filtering still moves on by the current transform size.
+          if (mi_prev == NULL) return ts;
           const int pv_row =
               (VERT_EDGE == edge_dir) ? (mi_row) : (mi_row - (1 << scale_vert));
           const int pv_col =
@@ -903,13 +905,12 @@ static AOM_FORCE_INLINE void set_lpf_parameters_for_line_chroma(
   }
 }
 
-static AOM_INLINE void filter_vert(uint8_t *dst, int dst_stride,
-                                   const AV1_DEBLOCKING_PARAMETERS *params,
-                                   const SequenceHeader *seq_params,
-                                   USE_FILTER_TYPE use_filter_type) {
+static AOM_FORCE_INLINE void filter_vert(
+    uint8_t *dst, int dst_stride, const AV1_DEBLOCKING_PARAMETERS *params,
+    const SequenceHeader *seq_params, int use_highbitdepth,
+    USE_FILTER_TYPE use_filter_type) {
   const loop_filter_thresh *limits = params->lfthr;
 #if CONFIG_AV1_HIGHBITDEPTH
-  const int use_highbitdepth = seq_params->use_highbitdepth;
   const aom_bit_depth_t bit_depth = seq_params->bit_depth;
   if (use_highbitdepth) {
     uint16_t *dst_shortptr = CONVERT_TO_SHORTPTR(dst);
@@ -1106,17 +1107,17 @@ static AOM_INLINE void filter_vert(uint8_t *dst, int dst_stride,
   }
 #if !CONFIG_AV1_HIGHBITDEPTH
   (void)seq_params;
+  (void)use_highbitdepth;
 #endif  // !CONFIG_AV1_HIGHBITDEPTH
 }
 
-static AOM_INLINE void filter_vert_chroma(
+static AOM_FORCE_INLINE void filter_vert_chroma(
     uint8_t *u_dst, uint8_t *v_dst, int dst_stride,
     const AV1_DEBLOCKING_PARAMETERS *params, const SequenceHeader *seq_params,
-    USE_FILTER_TYPE use_filter_type) {
+    int use_highbitdepth, USE_FILTER_TYPE use_filter_type) {
   const loop_filter_thresh *u_limits = params->lfthr;
   const loop_filter_thresh *v_limits = params->lfthr;
 #if CONFIG_AV1_HIGHBITDEPTH
-  const int use_highbitdepth = seq_params->use_highbitdepth;
   const aom_bit_depth_t bit_depth = seq_params->bit_depth;
   if (use_highbitdepth) {
     uint16_t *u_dst_shortptr = CONVERT_TO_SHORTPTR(u_dst);
@@ -1298,13 +1299,14 @@ static AOM_INLINE void filter_vert_chroma(
   }
 #if !CONFIG_AV1_HIGHBITDEPTH
   (void)seq_params;
+  (void)use_highbitdepth;
 #endif  // !CONFIG_AV1_HIGHBITDEPTH
 }
 
-void av1_filter_block_plane_vert(const AV1_COMMON *const cm,
-                                 const MACROBLOCKD *const xd, const int plane,
-                                 const MACROBLOCKD_PLANE *const plane_ptr,
-                                 const uint32_t mi_row, const uint32_t mi_col) {
+static AOM_FORCE_INLINE void filter_block_plane_vert(
+    const AV1_COMMON *const cm, const MACROBLOCKD *const xd, const int plane,
+    const MACROBLOCKD_PLANE *const plane_ptr, const uint32_t mi_row,
+    const uint32_t mi_col, int use_highbitdepth) {
   const uint32_t scale_horz = plane_ptr->subsampling_x;
   const uint32_t scale_vert = plane_ptr->subsampling_y;
   uint8_t *const dst_ptr = plane_ptr->dst.buf;
@@ -1340,7 +1342,8 @@ void av1_filter_block_plane_vert(const AV1_COMMON *const cm,
         tx_size = TX_4X4;
       }
 
-      filter_vert(p, dst_stride, &params, cm->seq_params, USE_SINGLE);
+      filter_vert(p, dst_stride, &params, cm->seq_params, use_highbitdepth,
+                  USE_SINGLE);
 
       // advance the destination pointer
       advance_units = tx_size_wide_unit[tx_size];
@@ -1350,11 +1353,25 @@ void av1_filter_block_plane_vert(const AV1_COMMON *const cm,
   }
 }
 
-void av1_filter_block_plane_vert_opt(
+void av1_filter_block_plane_vert(const AV1_COMMON *const cm,
+                                 const MACROBLOCKD *const xd, const int plane,
+                                 const MACROBLOCKD_PLANE *const plane_ptr,
+                                 const uint32_t mi_row, const uint32_t mi_col) {
+#if CONFIG_AV1_HIGHBITDEPTH
+  if (cm->seq_params->use_highbitdepth) {
+    filter_block_plane_vert(cm, xd, plane, plane_ptr, mi_row, mi_col, 1);
+    return;
+  }
+#endif  // CONFIG_AV1_HIGHBITDEPTH
+  filter_block_plane_vert(cm, xd, plane, plane_ptr, mi_row, mi_col, 0);
+}
+
+static AOM_FORCE_INLINE void filter_block_plane_vert_opt(
     const AV1_COMMON *const cm, const MACROBLOCKD *const xd,
     const MACROBLOCKD_PLANE *const plane_ptr, const uint32_t mi_row,
     const uint32_t mi_col, AV1_DEBLOCKING_PARAMETERS *params_buf,
-    TX_SIZE *tx_buf, int num_mis_in_lpf_unit_height_log2) {
+    TX_SIZE *tx_buf, int num_mis_in_lpf_unit_height_log2,
+    int use_highbitdepth) {
   uint8_t *const dst_ptr = plane_ptr->dst.buf;
   const int dst_stride = plane_ptr->dst.stride;
   // Ensure that mi_cols/mi_rows are calculated based on frame dimension aligned
@@ -1406,7 +1423,8 @@ void av1_filter_block_plane_vert_opt(
         *tx_size = TX_4X4;
       }
 
-      filter_vert(p, dst_stride, params, cm->seq_params, use_filter_type);
+      filter_vert(p, dst_stride, params, cm->seq_params, use_highbitdepth,
+                  use_filter_type);
 
       // advance the destination pointer
       const uint32_t advance_units = tx_size_wide_unit[*tx_size];
@@ -1418,12 +1436,28 @@ void av1_filter_block_plane_vert_opt(
   }
 }
 
-void av1_filter_block_plane_vert_opt_chroma(
+void av1_filter_block_plane_vert_opt(
+    const AV1_COMMON *const cm, const MACROBLOCKD *const xd,
+    const MACROBLOCKD_PLANE *const plane_ptr, const uint32_t mi_row,
+    const uint32_t mi_col, AV1_DEBLOCKING_PARAMETERS *params_buf,
+    TX_SIZE *tx_buf, int num_mis_in_lpf_unit_height_log2) {
+#if CONFIG_AV1_HIGHBITDEPTH
+  if (cm->seq_params->use_highbitdepth) {
+    filter_block_plane_vert_opt(cm, xd, plane_ptr, mi_row, mi_col, params_buf,
+                              tx_buf, num_mis_in_lpf_unit_height_log2, 1);
+    return;
+  }
+#endif  // CONFIG_AV1_HIGHBITDEPTH
+  filter_block_plane_vert_opt(cm, xd, plane_ptr, mi_row, mi_col, params_buf,
+                            tx_buf, num_mis_in_lpf_unit_height_log2, 0);
+}
+
+static AOM_FORCE_INLINE void filter_block_plane_vert_opt_chroma(
     const AV1_COMMON *const cm, const MACROBLOCKD *const xd,
     const MACROBLOCKD_PLANE *const plane_ptr, const uint32_t mi_row,
     const uint32_t mi_col, AV1_DEBLOCKING_PARAMETERS *params_buf,
     TX_SIZE *tx_buf, int plane, bool joint_filter_chroma,
-    int num_mis_in_lpf_unit_height_log2) {
+    int num_mis_in_lpf_unit_height_log2, int use_highbitdepth) {
   const uint32_t scale_horz = plane_ptr->subsampling_x;
   const uint32_t scale_vert = plane_ptr->subsampling_y;
   const int dst_stride = plane_ptr->dst.stride;
@@ -1487,11 +1521,11 @@ void av1_filter_block_plane_vert_opt_chroma(
         uint8_t *u_dst = plane_ptr[0].dst.buf + offset;
         uint8_t *v_dst = plane_ptr[1].dst.buf + offset;
         filter_vert_chroma(u_dst, v_dst, dst_stride, params, cm->seq_params,
-                           use_filter_type);
+                           use_highbitdepth, use_filter_type);
       } else {
         uint8_t *dst_ptr = plane_ptr->dst.buf + offset;
         filter_vert(dst_ptr, dst_stride, params, cm->seq_params,
-                    use_filter_type);
+                    use_highbitdepth, use_filter_type);
       }
 
       // advance the destination pointer
@@ -1504,13 +1538,31 @@ void av1_filter_block_plane_vert_opt_chroma(
   }
 }
 
-static AOM_INLINE void filter_horz(uint8_t *dst, int dst_stride,
-                                   const AV1_DEBLOCKING_PARAMETERS *params,
-                                   const SequenceHeader *seq_params,
-                                   USE_FILTER_TYPE use_filter_type) {
+void av1_filter_block_plane_vert_opt_chroma(
+    const AV1_COMMON *const cm, const MACROBLOCKD *const xd,
+    const MACROBLOCKD_PLANE *const plane_ptr, const uint32_t mi_row,
+    const uint32_t mi_col, AV1_DEBLOCKING_PARAMETERS *params_buf,
+    TX_SIZE *tx_buf, int plane, bool joint_filter_chroma,
+    int num_mis_in_lpf_unit_height_log2) {
+#if CONFIG_AV1_HIGHBITDEPTH
+  if (cm->seq_params->use_highbitdepth) {
+    filter_block_plane_vert_opt_chroma(
+        cm, xd, plane_ptr, mi_row, mi_col, params_buf, tx_buf, plane,
+        joint_filter_chroma, num_mis_in_lpf_unit_height_log2, 1);
+    return;
+  }
+#endif  // CONFIG_AV1_HIGHBITDEPTH
+  filter_block_plane_vert_opt_chroma(
+      cm, xd, plane_ptr, mi_row, mi_col, params_buf, tx_buf, plane,
+      joint_filter_chroma, num_mis_in_lpf_unit_height_log2, 0);
+}
+
+static AOM_FORCE_INLINE void filter_horz(
+    uint8_t *dst, int dst_stride, const AV1_DEBLOCKING_PARAMETERS *params,
+    const SequenceHeader *seq_params, int use_highbitdepth,
+    USE_FILTER_TYPE use_filter_type) {
   const loop_filter_thresh *limits = params->lfthr;
 #if CONFIG_AV1_HIGHBITDEPTH
-  const int use_highbitdepth = seq_params->use_highbitdepth;
   const aom_bit_depth_t bit_depth = seq_params->bit_depth;
   if (use_highbitdepth) {
     uint16_t *dst_shortptr = CONVERT_TO_SHORTPTR(dst);
@@ -1707,17 +1759,17 @@ static AOM_INLINE void filter_horz(uint8_t *dst, int dst_stride,
   }
 #if !CONFIG_AV1_HIGHBITDEPTH
   (void)seq_params;
+  (void)use_highbitdepth;
 #endif  // !CONFIG_AV1_HIGHBITDEPTH
 }
 
-static AOM_INLINE void filter_horz_chroma(
+static AOM_FORCE_INLINE void filter_horz_chroma(
     uint8_t *u_dst, uint8_t *v_dst, int dst_stride,
     const AV1_DEBLOCKING_PARAMETERS *params, const SequenceHeader *seq_params,
-    USE_FILTER_TYPE use_filter_type) {
+    int use_highbitdepth, USE_FILTER_TYPE use_filter_type) {
   const loop_filter_thresh *u_limits = params->lfthr;
   const loop_filter_thresh *v_limits = params->lfthr;
 #if CONFIG_AV1_HIGHBITDEPTH
-  const int use_highbitdepth = seq_params->use_highbitdepth;
   const aom_bit_depth_t bit_depth = seq_params->bit_depth;
   if (use_highbitdepth) {
     uint16_t *u_dst_shortptr = CONVERT_TO_SHORTPTR(u_dst);
@@ -1899,13 +1951,14 @@ static AOM_INLINE void filter_horz_chroma(
   }
 #if !CONFIG_AV1_HIGHBITDEPTH
   (void)seq_params;
+  (void)use_highbitdepth;
 #endif  // !CONFIG_AV1_HIGHBITDEPTH
 }
 
-void av1_filter_block_plane_horz(const AV1_COMMON *const cm,
-                                 const MACROBLOCKD *const xd, const int plane,
-                                 const MACROBLOCKD_PLANE *const plane_ptr,
-                                 const uint32_t mi_row, const uint32_t mi_col) {
+static AOM_FORCE_INLINE void filter_block_plane_horz(
+    const AV1_COMMON *const cm, const MACROBLOCKD *const xd, const int plane,
+    const MACROBLOCKD_PLANE *const plane_ptr, const uint32_t mi_row,
+    const uint32_t mi_col, int use_highbitdepth) {
   const uint32_t scale_horz = plane_ptr->subsampling_x;
   const uint32_t scale_vert = plane_ptr->subsampling_y;
   uint8_t *const dst_ptr = plane_ptr->dst.buf;
@@ -1940,7 +1993,8 @@ void av1_filter_block_plane_horz(const AV1_COMMON *const cm,
         tx_size = TX_4X4;
       }
 
-      filter_horz(p, dst_stride, &params, cm->seq_params, USE_SINGLE);
+      filter_horz(p, dst_stride, &params, cm->seq_params, use_highbitdepth,
+                  USE_SINGLE);
 
       // advance the destination pointer
       advance_units = tx_size_high_unit[tx_size];
@@ -1950,11 +2004,25 @@ void av1_filter_block_plane_horz(const AV1_COMMON *const cm,
   }
 }
 
-void av1_filter_block_plane_horz_opt(
+void av1_filter_block_plane_horz(const AV1_COMMON *const cm,
+                                 const MACROBLOCKD *const xd, const int plane,
+                                 const MACROBLOCKD_PLANE *const plane_ptr,
+                                 const uint32_t mi_row, const uint32_t mi_col) {
+#if CONFIG_AV1_HIGHBITDEPTH
+  if (cm->seq_params->use_highbitdepth) {
+    filter_block_plane_horz(cm, xd, plane, plane_ptr, mi_row, mi_col, 1);
+    return;
+  }
+#endif  // CONFIG_AV1_HIGHBITDEPTH
+  filter_block_plane_horz(cm, xd, plane, plane_ptr, mi_row, mi_col, 0);
+}
+
+static AOM_FORCE_INLINE void filter_block_plane_horz_opt(
     const AV1_COMMON *const cm, const MACROBLOCKD *const xd,
     const MACROBLOCKD_PLANE *const plane_ptr, const uint32_t mi_row,
     const uint32_t mi_col, AV1_DEBLOCKING_PARAMETERS *params_buf,
-    TX_SIZE *tx_buf, int num_mis_in_lpf_unit_height_log2) {
+    TX_SIZE *tx_buf, int num_mis_in_lpf_unit_height_log2,
+    int use_highbitdepth) {
   uint8_t *const dst_ptr = plane_ptr->dst.buf;
   const int dst_stride = plane_ptr->dst.stride;
   // Ensure that mi_cols/mi_rows are calculated based on frame dimension aligned
@@ -2001,7 +2069,8 @@ void av1_filter_block_plane_horz_opt(
         *tx_size = TX_4X4;
       }
 
-      filter_horz(p, dst_stride, params, cm->seq_params, filter_type);
+      filter_horz(p, dst_stride, params, cm->seq_params, use_highbitdepth,
+                  filter_type);
 
       // advance the destination pointer
       const uint32_t advance_units = tx_size_high_unit[*tx_size];
@@ -2013,12 +2082,28 @@ void av1_filter_block_plane_horz_opt(
   }
 }
 
-void av1_filter_block_plane_horz_opt_chroma(
+void av1_filter_block_plane_horz_opt(
+    const AV1_COMMON *const cm, const MACROBLOCKD *const xd,
+    const MACROBLOCKD_PLANE *const plane_ptr, const uint32_t mi_row,
+    const uint32_t mi_col, AV1_DEBLOCKING_PARAMETERS *params_buf,
+    TX_SIZE *tx_buf, int num_mis_in_lpf_unit_height_log2) {
+#if CONFIG_AV1_HIGHBITDEPTH
+  if (cm->seq_params->use_highbitdepth) {
+    filter_block_plane_horz_opt(cm, xd, plane_ptr, mi_row, mi_col, params_buf,
+                              tx_buf, num_mis_in_lpf_unit_height_log2, 1);
+    return;
+  }
+#endif  // CONFIG_AV1_HIGHBITDEPTH
+  filter_block_plane_horz_opt(cm, xd, plane_ptr, mi_row, mi_col, params_buf,
+                            tx_buf, num_mis_in_lpf_unit_height_log2, 0);
+}
+
+static AOM_FORCE_INLINE void filter_block_plane_horz_opt_chroma(
     const AV1_COMMON *const cm, const MACROBLOCKD *const xd,
     const MACROBLOCKD_PLANE *const plane_ptr, const uint32_t mi_row,
     const uint32_t mi_col, AV1_DEBLOCKING_PARAMETERS *params_buf,
     TX_SIZE *tx_buf, int plane, bool joint_filter_chroma,
-    int num_mis_in_lpf_unit_height_log2) {
+    int num_mis_in_lpf_unit_height_log2, int use_highbitdepth) {
   const uint32_t scale_horz = plane_ptr->subsampling_x;
   const uint32_t scale_vert = plane_ptr->subsampling_y;
   const int dst_stride = plane_ptr->dst.stride;
@@ -2081,11 +2166,11 @@ void av1_filter_block_plane_horz_opt_chroma(
         uint8_t *u_dst = plane_ptr[0].dst.buf + offset;
         uint8_t *v_dst = plane_ptr[1].dst.buf + offset;
         filter_horz_chroma(u_dst, v_dst, dst_stride, params, cm->seq_params,
-                           use_filter_type);
+                           use_highbitdepth, use_filter_type);
       } else {
         uint8_t *dst_ptr = plane_ptr->dst.buf + offset;
         filter_horz(dst_ptr, dst_stride, params, cm->seq_params,
-                    use_filter_type);
+                    use_highbitdepth, use_filter_type);
       }
 
       // advance the destination pointer
@@ -2097,3 +2182,22 @@ void av1_filter_block_plane_horz_opt_chroma(
     x += x_inc;
   }
 }
+
+void av1_filter_block_plane_horz_opt_chroma(
+    const AV1_COMMON *const cm, const MACROBLOCKD *const xd,
+    const MACROBLOCKD_PLANE *const plane_ptr, const uint32_t mi_row,
+    const uint32_t mi_col, AV1_DEBLOCKING_PARAMETERS *params_buf,
+    TX_SIZE *tx_buf, int plane, bool joint_filter_chroma,
+    int num_mis_in_lpf_unit_height_log2) {
+#if CONFIG_AV1_HIGHBITDEPTH
+  if (cm->seq_params->use_highbitdepth) {
+    filter_block_plane_horz_opt_chroma(
+        cm, xd, plane_ptr, mi_row, mi_col, params_buf, tx_buf, plane,
+        joint_filter_chroma, num_mis_in_lpf_unit_height_log2, 1);
+    return;
+  }
+#endif  // CONFIG_AV1_HIGHBITDEPTH
+  filter_block_plane_horz_opt_chroma(
+      cm, xd, plane_ptr, mi_row, mi_col, params_buf, tx_buf, plane,
+      joint_filter_chroma, num_mis_in_lpf_unit_height_log2, 0);
+}
@@ -477,6 +477,9 @@ if (aom_config("CONFIG_AV1_ENCODER") eq "yes") {
   add_proto qw/void av1_nn_predict/, " const float *input_nodes, const NN_CONFIG *const nn_config, int reduce_prec, float *const output";
 
   add_proto qw/void av1_nn_fast_softmax_16/, " const float *input_nodes, float *output";
+
+  add_proto qw/void av1_nn_matvec_int16/, "const int16_t *input, const int16_t *weights, int num_inputs, int num_outputs, int32_t *output";
+  specialize qw/av1_nn_matvec_int16 avx2 neon/;
   if (aom_config("CONFIG_EXCLUDE_SIMD_MISMATCH") ne "yes") {
     specialize qw/av1_nn_predict sse3 neon/;
     specialize qw/av1_nn_fast_softmax_16 sse3/;
@@ -503,6 +506,15 @@ if (aom_config("CONFIG_AV1_ENCODER") eq "yes") {
 }
 # end encoder functions
 
+#
+# Decoder functions below this point.
+#
+if (aom_config("CONFIG_AV1_DECODER") eq "yes") {
+  add_proto qw/void av1_dequant_txb/, "tran_low_t *coeff, int n_coeffs, const int16_t *dequant, const qm_val_t *iqmatrix, int shift, int bd";
+  specialize qw/av1_dequant_txb sse4_1 avx2/;
+}
+# end decoder functions
+
 
 # Deringing Functions
 
@@ -558,6 +558,7 @@ typedef struct dist_wtd_comp_params {
 } DIST_WTD_COMP_PARAMS;
 
 struct scale_factors;
+struct InterPredCache;
 
 /*!\endcond */
 
@@ -925,6 +926,19 @@ typedef struct macroblockd {
    * 'cpi->tile_thr_data[t].td->mb.tmp_pred_bufs'.
    */
   uint8_t *tmp_obmc_bufs[2];
+  /*!
+   * Encoder only: cache of luma inter predictions of the superblock being
+   * searched, 'x->inter_pred_cache' while a superblock goes through the rd
+   * partition search and NULL otherwise.
+   */
+  struct InterPredCache *inter_pred_cache;
+
+  /*!
+   * Number of taps of the interpolation filters that inter prediction uses
+   * in place of the signalled ones: 4 or 2, or 0 to use the signalled
+   * filters. Only set by the non-conforming fast decode modes.
+   */
+  uint8_t reduced_interp_taps;
 } MACROBLOCKD;
 
 /*!\cond */
@@ -287,23 +287,21 @@ static void cdef_fb_col(const AV1_COMMON *const cm, const MACROBLOCKD *const xd,
                         CdefBlockInfo *const fb_info, uint16_t **const colbuf,
                         int *cdef_left, int fbc, int fbr) {
   const CommonModeInfoParams *const mi_params = &cm->mi_params;
-  const int mbmi_cdef_strength =
-      mi_params
-          ->mi_grid_base[MI_SIZE_64X64 * fbr * mi_params->mi_stride +
-                         MI_SIZE_64X64 * fbc]
-          ->cdef_strength;
+  const MB_MODE_INFO *const mbmi =
+      mi_params->mi_grid_base[MI_SIZE_64X64 * fbr * mi_params->mi_stride +
+                              MI_SIZE_64X64 * fbc];
   const int num_planes = av1_num_planes(cm);
   int is_zero_level[PLANE_TYPES] = { 1, 1 };
   int level[PLANE_TYPES] = { 0 };
   int sec_strength[PLANE_TYPES] = { 0 };
   const CdefInfo *const cdef_info = &cm->cdef_info;
 
-  if (mi_params->mi_grid_base[MI_SIZE_64X64 * fbr * mi_params->mi_stride +
-                              MI_SIZE_64X64 * fbc] == NULL ||
-      mbmi_cdef_strength == -1) {
+  // The mode info is not set up in tiles that were not decoded.
+  if (mbmi == NULL || mbmi->cdef_strength == -1) {
     av1_zero_array(cdef_left, num_planes);
     return;
   }
+  const int mbmi_cdef_strength = mbmi->cdef_strength;
 
   // Compute level and secondary strength for planes
   level[PLANE_TYPE_Y] =
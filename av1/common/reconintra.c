@@ -34,7 +34,6 @@ enum {
 #define INTRA_EDGE_FILT 3
 #define INTRA_EDGE_TAPS 5
 #define MAX_UPSAMPLE_SZ 16
-#define NUM_INTRA_NEIGHBOUR_PIXELS (MAX_TX_SIZE * 2 + 32)
 
 static const uint8_t extend_modes[INTRA_MODES] = {
   NEED_ABOVE | NEED_LEFT,                   // DC
@@ -1130,6 +1129,120 @@ void av1_upsample_intra_edge_high_c(uint16_t *p, int sz, int bd) {
   }
 }
 #if CONFIG_AV1_HIGHBITDEPTH
+// Copies the neighbouring pixels needed by a prediction into above_row and
+// left_col, and extends them where they are not available.
+static void gather_intra_edges_high(
+    const uint16_t *above_ref, const uint16_t *left_ref, int ref_stride,
+    uint16_t *above_row, uint16_t *left_col, int txwpx, int txhpx,
+    int need_above, int need_left, int need_above_left, int n_top_px,
+    int n_topright_px, int n_left_px, int n_bottomleft_px, int base) {
+  int i;
+  // NEED_LEFT
+  if (need_left) {
+    const int num_left_pixels_needed =
+        txhpx + (n_bottomleft_px >= 0 ? txwpx : 0);
+    i = 0;
+    if (n_left_px > 0) {
+      for (; i < n_left_px; i++) left_col[i] = left_ref[i * ref_stride];
+      if (n_bottomleft_px > 0) {
+        assert(i == txhpx);
+        for (; i < txhpx + n_bottomleft_px; i++)
+          left_col[i] = left_ref[i * ref_stride];
+      }
+      if (i < num_left_pixels_needed)
+        aom_memset16(&left_col[i], left_col[i - 1], num_left_pixels_needed - i);
+    } else if (n_top_px > 0) {
+      aom_memset16(left_col, above_ref[0], num_left_pixels_needed);
+    }
+  }
+
+  // NEED_ABOVE
+  if (need_above) {
+    const int num_top_pixels_needed = txwpx + (n_topright_px >= 0 ? txhpx : 0);
+    if (n_top_px > 0) {
+      memcpy(above_row, above_ref, n_top_px * sizeof(above_ref[0]));
+      i = n_top_px;
+      if (n_topright_px > 0) {
+        assert(n_top_px == txwpx);
+        memcpy(above_row + txwpx, above_ref + txwpx,
+               n_topright_px * sizeof(above_ref[0]));
+        i += n_topright_px;
+      }
+      if (i < num_top_pixels_needed)
+        aom_memset16(&above_row[i], above_row[i - 1],
+                     num_top_pixels_needed - i);
+    } else if (n_left_px > 0) {
+      aom_memset16(above_row, left_ref[0], num_top_pixels_needed);
+    }
+  }
+
+  if (need_above_left) {
+    if (n_top_px > 0 && n_left_px > 0) {
+      above_row[-1] = above_ref[-1];
+    } else if (n_top_px > 0) {
+      above_row[-1] = above_ref[0];
+    } else if (n_left_px > 0) {
+      above_row[-1] = left_ref[0];
+    } else {
+      above_row[-1] = base;
+    }
+    left_col[-1] = above_row[-1];
+  }
+}
+
+// Builds the prediction of a directional mode from the gathered neighbouring
+// pixels, which are filtered and upsampled in place.
+static void build_dr_predictor_high(uint16_t *above_row, uint16_t *left_col,
+                                    uint16_t *dst, int dst_stride,
+                                    TX_SIZE tx_size, int p_angle,
+                                    int disable_edge_filter, int n_top_px,
+                                    int n_left_px, int intra_edge_filter_type,
+                                    int bit_depth) {
+  const int txwpx = tx_size_wide[tx_size];
+  const int txhpx = tx_size_high[tx_size];
+  const int need_above = p_angle < 180;
+  const int need_left = p_angle > 90;
+  const int need_above_left = 1;
+  int upsample_above = 0;
+  int upsample_left = 0;
+  if (!disable_edge_filter) {
+    const int need_right = p_angle < 90;
+    const int need_bottom = p_angle > 180;
+    if (p_angle != 90 && p_angle != 180) {
+      const int ab_le = need_above_left ? 1 : 0;
+      if (need_above && need_left && (txwpx + txhpx >= 24)) {
+        filter_intra_edge_corner_high(above_row, left_col);
+      }
+      if (need_above && n_top_px > 0) {
+        const int strength = intra_edge_filter_strength(
+            txwpx, txhpx, p_angle - 90, intra_edge_filter_type);
+        const int n_px = n_top_px + ab_le + (need_right ? txhpx : 0);
+        av1_filter_intra_edge_high(above_row - ab_le, n_px, strength);
+      }
+      if (need_left && n_left_px > 0) {
+        const int strength = intra_edge_filter_strength(
+            txhpx, txwpx, p_angle - 180, intra_edge_filter_type);
+        const int n_px = n_left_px + ab_le + (need_bottom ? txwpx : 0);
+        av1_filter_intra_edge_high(left_col - ab_le, n_px, strength);
+      }
+    }
+    upsample_above = av1_use_intra_edge_upsample(txwpx, txhpx, p_angle - 90,
+                                                 intra_edge_filter_type);
+    if (need_above && upsample_above) {
+      const int n_px = txwpx + (need_right ? txhpx : 0);
+      av1_upsample_intra_edge_high(above_row, n_px, bit_depth);
+    }
+    upsample_left = av1_use_intra_edge_upsample(txhpx, txwpx, p_angle - 180,
+                                                intra_edge_filter_type);
+    if (need_left && upsample_left) {
+      const int n_px = txhpx + (need_bottom ? txwpx : 0);
+      av1_upsample_intra_edge_high(left_col, n_px, bit_depth);
+    }
+  }
+  highbd_dr_predictor(dst, dst_stride, tx_size, above_row, left_col,
+                      upsample_above, upsample_left, p_angle, bit_depth);
+}
+
 static void build_intra_predictors_high(
     const uint8_t *ref8, int ref_stride, uint8_t *dst8, int dst_stride,
     PREDICTION_MODE mode, int p_angle, FILTER_INTRA_MODE filter_intra_mode,
@@ -1196,6 +1309,44 @@ static void build_intra_predictors_high(
     return;
   }
 
+  gather_intra_edges_high(above_ref, left_ref, ref_stride, above_row, left_col,
+                          txwpx, txhpx, need_above, need_left, need_above_left,
+                          n_top_px, n_topright_px, n_left_px, n_bottomleft_px,
+                          base);
+
+  if (use_filter_intra) {
+    highbd_filter_intra_predictor(dst, dst_stride, tx_size, above_row, left_col,
+                                  filter_intra_mode, bit_depth);
+    return;
+  }
+
+  if (is_dr_mode) {
+    build_dr_predictor_high(above_row, left_col, dst, dst_stride, tx_size,
+                            p_angle, disable_edge_filter, n_top_px, n_left_px,
+                            intra_edge_filter_type, bit_depth);
+    return;
+  }
+
+  // predict
+  if (mode == DC_PRED) {
+    dc_pred_high[n_left_px > 0][n_top_px > 0][tx_size](
+        dst, dst_stride, above_row, left_col, bit_depth);
+  } else {
+    pred_high[mode][tx_size](dst, dst_stride, above_row, left_col, bit_depth);
+  }
+}
+#endif  // CONFIG_AV1_HIGHBITDEPTH
+
+// Copies the neighbouring pixels needed by a prediction into above_row and
+// left_col, and extends them where they are not available.
+static void gather_intra_edges(const uint8_t *above_ref,
+                               const uint8_t *left_ref, int ref_stride,
+                               uint8_t *above_row, uint8_t *left_col,
+                               int txwpx, int txhpx, int need_above,
+                               int need_left, int need_above_left,
+                               int n_top_px, int n_topright_px, int n_left_px,
+                               int n_bottomleft_px) {
+  int i;
   // NEED_LEFT
   if (need_left) {
     const int num_left_pixels_needed =
@@ -1209,9 +1360,9 @@ static void build_intra_predictors_high(
           left_col[i] = left_ref[i * ref_stride];
       }
       if (i < num_left_pixels_needed)
-        aom_memset16(&left_col[i], left_col[i - 1], num_left_pixels_needed - i);
+        memset(&left_col[i], left_col[i - 1], num_left_pixels_needed - i);
     } else if (n_top_px > 0) {
-      aom_memset16(left_col, above_ref[0], num_left_pixels_needed);
+      memset(left_col, above_ref[0], num_left_pixels_needed);
     }
   }
 
@@ -1219,19 +1370,17 @@ static void build_intra_predictors_high(
   if (need_above) {
     const int num_top_pixels_needed = txwpx + (n_topright_px >= 0 ? txhpx : 0);
     if (n_top_px > 0) {
-      memcpy(above_row, above_ref, n_top_px * sizeof(above_ref[0]));
+      memcpy(above_row, above_ref, n_top_px);
       i = n_top_px;
       if (n_topright_px > 0) {
         assert(n_top_px == txwpx);
-        memcpy(above_row + txwpx, above_ref + txwpx,
-               n_topright_px * sizeof(above_ref[0]));
+        memcpy(above_row + txwpx, above_ref + txwpx, n_topright_px);
         i += n_topright_px;
       }
       if (i < num_top_pixels_needed)
-        aom_memset16(&above_row[i], above_row[i - 1],
-                     num_top_pixels_needed - i);
+        memset(&above_row[i], above_row[i - 1], num_top_pixels_needed - i);
     } else if (n_left_px > 0) {
-      aom_memset16(above_row, left_ref[0], num_top_pixels_needed);
+      memset(above_row, left_ref[0], num_top_pixels_needed);
     }
   }
 
@@ -1243,68 +1392,63 @@ static void build_intra_predictors_high(
     } else if (n_left_px > 0) {
       above_row[-1] = left_ref[0];
     } else {
-      above_row[-1] = base;
+      above_row[-1] = 128;
     }
     left_col[-1] = above_row[-1];
   }
+}
 
-  if (use_filter_intra) {
-    highbd_filter_intra_predictor(dst, dst_stride, tx_size, above_row, left_col,
-                                  filter_intra_mode, bit_depth);
-    return;
-  }
-
-  if (is_dr_mode) {
-    int upsample_above = 0;
-    int upsample_left = 0;
-    if (!disable_edge_filter) {
-      const int need_right = p_angle < 90;
-      const int need_bottom = p_angle > 180;
-      if (p_angle != 90 && p_angle != 180) {
-        const int ab_le = need_above_left ? 1 : 0;
-        if (need_above && need_left && (txwpx + txhpx >= 24)) {
-          filter_intra_edge_corner_high(above_row, left_col);
-        }
-        if (need_above && n_top_px > 0) {
-          const int strength = intra_edge_filter_strength(
-              txwpx, txhpx, p_angle - 90, intra_edge_filter_type);
-          const int n_px = n_top_px + ab_le + (need_right ? txhpx : 0);
-          av1_filter_intra_edge_high(above_row - ab_le, n_px, strength);
-        }
-        if (need_left && n_left_px > 0) {
-          const int strength = intra_edge_filter_strength(
-              txhpx, txwpx, p_angle - 180, intra_edge_filter_type);
-          const int n_px = n_left_px + ab_le + (need_bottom ? txwpx : 0);
-          av1_filter_intra_edge_high(left_col - ab_le, n_px, strength);
-        }
+// Builds the prediction of a directional mode from the gathered neighbouring
+// pixels, which are filtered and upsampled in place.
+static void build_dr_predictor(uint8_t *above_row, uint8_t *left_col,
+                               uint8_t *dst, int dst_stride, TX_SIZE tx_size,
+                               int p_angle, int disable_edge_filter,
+                               int n_top_px, int n_left_px,
+                               int intra_edge_filter_type) {
+  const int txwpx = tx_size_wide[tx_size];
+  const int txhpx = tx_size_high[tx_size];
+  const int need_above = p_angle < 180;
+  const int need_left = p_angle > 90;
+  const int need_above_left = 1;
+  int upsample_above = 0;
+  int upsample_left = 0;
+  if (!disable_edge_filter) {
+    const int need_right = p_angle < 90;
+    const int need_bottom = p_angle > 180;
+    if (p_angle != 90 && p_angle != 180) {
+      const int ab_le = need_above_left ? 1 : 0;
+      if (need_above && need_left && (txwpx + txhpx >= 24)) {
+        filter_intra_edge_corner(above_row, left_col);
       }
-      upsample_above = av1_use_intra_edge_upsample(txwpx, txhpx, p_angle - 90,
-                                                   intra_edge_filter_type);
-      if (need_above && upsample_above) {
-        const int n_px = txwpx + (need_right ? txhpx : 0);
-        av1_upsample_intra_edge_high(above_row, n_px, bit_depth);
+      if (need_above && n_top_px > 0) {
+        const int strength = intra_edge_filter_strength(
+            txwpx, txhpx, p_angle - 90, intra_edge_filter_type);
+        const int n_px = n_top_px + ab_le + (need_right ? txhpx : 0);
+        av1_filter_intra_edge(above_row - ab_le, n_px, strength);
       }
-      upsample_left = av1_use_intra_edge_upsample(txhpx, txwpx, p_angle - 180,
-                                                  intra_edge_filter_type);
-      if (need_left && upsample_left) {
-        const int n_px = txhpx + (need_bottom ? txwpx : 0);
-        av1_upsample_intra_edge_high(left_col, n_px, bit_depth);
+      if (need_left && n_left_px > 0) {
+        const int strength = intra_edge_filter_strength(
+            txhpx, txwpx, p_angle - 180, intra_edge_filter_type);
+        const int n_px = n_left_px + ab_le + (need_bottom ? txwpx : 0);
+        av1_filter_intra_edge(left_col - ab_le, n_px, strength);
       }
     }
-    highbd_dr_predictor(dst, dst_stride, tx_size, above_row, left_col,
-                        upsample_above, upsample_left, p_angle, bit_depth);
-    return;
-  }
-
-  // predict
-  if (mode == DC_PRED) {
-    dc_pred_high[n_left_px > 0][n_top_px > 0][tx_size](
-        dst, dst_stride, above_row, left_col, bit_depth);
-  } else {
-    pred_high[mode][tx_size](dst, dst_stride, above_row, left_col, bit_depth);
+    upsample_above = av1_use_intra_edge_upsample(txwpx, txhpx, p_angle - 90,
+                                                 intra_edge_filter_type);
+    if (need_above && upsample_above) {
+      const int n_px = txwpx + (need_right ? txhpx : 0);
+      av1_upsample_intra_edge(above_row, n_px);
+    }
+    upsample_left = av1_use_intra_edge_upsample(txhpx, txwpx, p_angle - 180,
+                                                intra_edge_filter_type);
+    if (need_left && upsample_left) {
+      const int n_px = txhpx + (need_bottom ? txwpx : 0);
+      av1_upsample_intra_edge(left_col, n_px);
+    }
   }
+  dr_predictor(dst, dst_stride, tx_size, above_row, left_col, upsample_above,
+               upsample_left, p_angle);
 }
-#endif  // CONFIG_AV1_HIGHBITDEPTH
 
 static void build_intra_predictors(
     const uint8_t *ref, int ref_stride, uint8_t *dst, int dst_stride,
@@ -1369,55 +1513,9 @@ static void build_intra_predictors(
     return;
   }
 
-  // NEED_LEFT
-  if (need_left) {
-    const int num_left_pixels_needed =
-        txhpx + (n_bottomleft_px >= 0 ? txwpx : 0);
-    i = 0;
-    if (n_left_px > 0) {
-      for (; i < n_left_px; i++) left_col[i] = left_ref[i * ref_stride];
-      if (n_bottomleft_px > 0) {
-        assert(i == txhpx);
-        for (; i < txhpx + n_bottomleft_px; i++)
-          left_col[i] = left_ref[i * ref_stride];
-      }
-      if (i < num_left_pixels_needed)
-        memset(&left_col[i], left_col[i - 1], num_left_pixels_needed - i);
-    } else if (n_top_px > 0) {
-      memset(left_col, above_ref[0], num_left_pixels_needed);
-    }
-  }
-
-  // NEED_ABOVE
-  if (need_above) {
-    const int num_top_pixels_needed = txwpx + (n_topright_px >= 0 ? txhpx : 0);
-    if (n_top_px > 0) {
-      memcpy(above_row, above_ref, n_top_px);
-      i = n_top_px;
-      if (n_topright_px > 0) {
-        assert(n_top_px == txwpx);
-        memcpy(above_row + txwpx, above_ref + txwpx, n_topright_px);
-        i += n_topright_px;
-      }
-      if (i < num_top_pixels_needed)
-        memset(&above_row[i], above_row[i - 1], num_top_pixels_needed - i);
-    } else if (n_left_px > 0) {
-      memset(above_row, left_ref[0], num_top_pixels_needed);
-    }
-  }
-
-  if (need_above_left) {
-    if (n_top_px > 0 && n_left_px > 0) {
-      above_row[-1] = above_ref[-1];
-    } else if (n_top_px > 0) {
-      above_row[-1] = above_ref[0];
-    } else if (n_left_px > 0) {
-      above_row[-1] = left_ref[0];
-    } else {
-      above_row[-1] = 128;
-    }
-    left_col[-1] = above_row[-1];
-  }
+  gather_intra_edges(above_ref, left_ref, ref_stride, above_row, left_col,
+                     txwpx, txhpx, need_above, need_left, need_above_left,
+                     n_top_px, n_topright_px, n_left_px, n_bottomleft_px);
 
   if (use_filter_intra) {
     av1_filter_intra_predictor(dst, dst_stride, tx_size, above_row, left_col,
@@ -1426,44 +1524,9 @@ static void build_intra_predictors(
   }
 
   if (is_dr_mode) {
-    int upsample_above = 0;
-    int upsample_left = 0;
-    if (!disable_edge_filter) {
-      const int need_right = p_angle < 90;
-      const int need_bottom = p_angle > 180;
-      if (p_angle != 90 && p_angle != 180) {
-        const int ab_le = need_above_left ? 1 : 0;
-        if (need_above && need_left && (txwpx + txhpx >= 24)) {
-          filter_intra_edge_corner(above_row, left_col);
-        }
-        if (need_above && n_top_px > 0) {
-          const int strength = intra_edge_filter_strength(
-              txwpx, txhpx, p_angle - 90, intra_edge_filter_type);
-          const int n_px = n_top_px + ab_le + (need_right ? txhpx : 0);
-          av1_filter_intra_edge(above_row - ab_le, n_px, strength);
-        }
-        if (need_left && n_left_px > 0) {
-          const int strength = intra_edge_filter_strength(
-              txhpx, txwpx, p_angle - 180, intra_edge_filter_type);
-          const int n_px = n_left_px + ab_le + (need_bottom ? txwpx : 0);
-          av1_filter_intra_edge(left_col - ab_le, n_px, strength);
-        }
-      }
-      upsample_above = av1_use_intra_edge_upsample(txwpx, txhpx, p_angle - 90,
-                                                   intra_edge_filter_type);
-      if (need_above && upsample_above) {
-        const int n_px = txwpx + (need_right ? txhpx : 0);
-        av1_upsample_intra_edge(above_row, n_px);
-      }
-      upsample_left = av1_use_intra_edge_upsample(txhpx, txwpx, p_angle - 180,
-                                                  intra_edge_filter_type);
-      if (need_left && upsample_left) {
-        const int n_px = txhpx + (need_bottom ? txwpx : 0);
-        av1_upsample_intra_edge(left_col, n_px);
-      }
-    }
-    dr_predictor(dst, dst_stride, tx_size, above_row, left_col, upsample_above,
-                 upsample_left, p_angle);
+    build_dr_predictor(above_row, left_col, dst, dst_stride, tx_size, p_angle,
+                       disable_edge_filter, n_top_px, n_left_px,
+                       intra_edge_filter_type);
     return;
   }
 
@@ -1527,6 +1590,72 @@ static INLINE BLOCK_SIZE scale_chroma_bsize(BLOCK_SIZE bsize, int subsampling_x,
   return bs;
 }
 
+// Finds the number of neighbouring pixels available to a transform block.
+// n_topright_px and n_bottomleft_px are -1 when they are not needed, and 0
+// when they are needed but not available.
+static void get_intra_neighbour_px(const MACROBLOCKD *xd, BLOCK_SIZE sb_size,
+                                   int wpx, int hpx, TX_SIZE tx_size,
+                                   int col_off, int row_off, int plane,
+                                   int need_top_right, int need_bottom_left,
+                                   int *n_top_px, int *n_topright_px,
+                                   int *n_left_px, int *n_bottomleft_px) {
+  const MB_MODE_INFO *const mbmi = xd->mi[0];
+  const int txwpx = tx_size_wide[tx_size];
+  const int txhpx = tx_size_high[tx_size];
+  const int x = col_off << MI_SIZE_LOG2;
+  const int y = row_off << MI_SIZE_LOG2;
+  const struct macroblockd_plane *const pd = &xd->plane[plane];
+  const int txw = tx_size_wide_unit[tx_size];
+  const int txh = tx_size_high_unit[tx_size];
+  const int ss_x = pd->subsampling_x;
+  const int ss_y = pd->subsampling_y;
+  const int have_top =
+      row_off || (ss_y ? xd->chroma_up_available : xd->up_available);
+  const int have_left =
+      col_off || (ss_x ? xd->chroma_left_available : xd->left_available);
+  const int mi_row = -xd->mb_to_top_edge >> (3 + MI_SIZE_LOG2);
+  const int mi_col = -xd->mb_to_left_edge >> (3 + MI_SIZE_LOG2);
+
+  // Distance between the right edge of this prediction block to
+  // the frame right edge
+  const int xr = (xd->mb_to_right_edge >> (3 + ss_x)) + wpx - x - txwpx;
+  // Distance between the bottom edge of this prediction block to
+  // the frame bottom edge
+  const int yd = (xd->mb_to_bottom_edge >> (3 + ss_y)) + hpx - y - txhpx;
+  const int right_available =
+      mi_col + ((col_off + txw) << ss_x) < xd->tile.mi_col_end;
+  const int bottom_available =
+      (yd > 0) && (mi_row + ((row_off + txh) << ss_y) < xd->tile.mi_row_end);
+
+  const PARTITION_TYPE partition = mbmi->partition;
+
+  BLOCK_SIZE bsize = mbmi->bsize;
+  // force 4x4 chroma component block size.
+  if (ss_x || ss_y) {
+    bsize = scale_chroma_bsize(bsize, ss_x, ss_y);
+  }
+
+  // Possible states for have_top_right(TR) and have_bottom_left(BL)
+  // -1 : TR and BL are not needed
+  //  0 : TR and BL are needed but not available
+  // > 0 : TR and BL are needed and pixels are available
+  const int have_top_right =
+      need_top_right ? has_top_right(sb_size, bsize, mi_row, mi_col, have_top,
+                                     right_available, partition, tx_size,
+                                     row_off, col_off, ss_x, ss_y)
+                     : -1;
+  const int have_bottom_left =
+      need_bottom_left ? has_bottom_left(sb_size, bsize, mi_row, mi_col,
+                                         bottom_available, have_left, partition,
+                                         tx_size, row_off, col_off, ss_x, ss_y)
+                       : -1;
+  *n_top_px = have_top ? AOMMIN(txwpx, xr + txwpx) : 0;
+  *n_topright_px = have_top_right > 0 ? AOMMIN(txwpx, xr) : have_top_right;
+  *n_left_px = have_left ? AOMMIN(txhpx, yd + txhpx) : 0;
+  *n_bottomleft_px =
+      have_bottom_left > 0 ? AOMMIN(txhpx, yd) : have_bottom_left;
+}
+
 void av1_predict_intra_block(const MACROBLOCKD *xd, BLOCK_SIZE sb_size,
                              int enable_intra_edge_filter, int wpx, int hpx,
                              TX_SIZE tx_size, PREDICTION_MODE mode,
@@ -1565,37 +1694,6 @@ void av1_predict_intra_block(const MACROBLOCKD *xd, BLOCK_SIZE sb_size,
     return;
   }
 
-  const struct macroblockd_plane *const pd = &xd->plane[plane];
-  const int txw = tx_size_wide_unit[tx_size];
-  const int txh = tx_size_high_unit[tx_size];
-  const int ss_x = pd->subsampling_x;
-  const int ss_y = pd->subsampling_y;
-  const int have_top =
-      row_off || (ss_y ? xd->chroma_up_available : xd->up_available);
-  const int have_left =
-      col_off || (ss_x ? xd->chroma_left_available : xd->left_available);
-  const int mi_row = -xd->mb_to_top_edge >> (3 + MI_SIZE_LOG2);
-  const int mi_col = -xd->mb_to_left_edge >> (3 + MI_SIZE_LOG2);
-
-  // Distance between the right edge of this prediction block to
-  // the frame right edge
-  const int xr = (xd->mb_to_right_edge >> (3 + ss_x)) + wpx - x - txwpx;
-  // Distance between the bottom edge of this prediction block to
-  // the frame bottom edge
-  const int yd = (xd->mb_to_bottom_edge >> (3 + ss_y)) + hpx - y - txhpx;
-  const int right_available =
-      mi_col + ((col_off + txw) << ss_x) < xd->tile.mi_col_end;
-  const int bottom_available =
-      (yd > 0) && (mi_row + ((row_off + txh) << ss_y) < xd->tile.mi_row_end);
-
-  const PARTITION_TYPE partition = mbmi->partition;
-
-  BLOCK_SIZE bsize = mbmi->bsize;
-  // force 4x4 chroma component block size.
-  if (ss_x || ss_y) {
-    bsize = scale_chroma_bsize(bsize, ss_x, ss_y);
-  }
-
   const int is_dr_mode = av1_is_directional_mode(mode);
   const int use_filter_intra = filter_intra_mode != FILTER_INTRA_MODES;
   int p_angle = 0;
@@ -1612,20 +1710,10 @@ void av1_predict_intra_block(const MACROBLOCKD *xd, BLOCK_SIZE sb_size,
     need_bottom_left = p_angle > 180;
   }
 
-  // Possible states for have_top_right(TR) and have_bottom_left(BL)
-  // -1 : TR and BL are not needed
-  //  0 : TR and BL are needed but not available
-  // > 0 : TR and BL are needed and pixels are available
-  const int have_top_right =
-      need_top_right ? has_top_right(sb_size, bsize, mi_row, mi_col, have_top,
-                                     right_available, partition, tx_size,
-                                     row_off, col_off, ss_x, ss_y)
-                     : -1;
-  const int have_bottom_left =
-      need_bottom_left ? has_bottom_left(sb_size, bsize, mi_row, mi_col,
-                                         bottom_available, have_left, partition,
-                                         tx_size, row_off, col_off, ss_x, ss_y)
-                       : -1;
+  int n_top_px, n_topright_px, n_left_px, n_bottomleft_px;
+  get_intra_neighbour_px(xd, sb_size, wpx, hpx, tx_size, col_off, row_off,
+                         plane, need_top_right, need_bottom_left, &n_top_px,
+                         &n_topright_px, &n_left_px, &n_bottomleft_px);
 
   const int disable_edge_filter = !enable_intra_edge_filter;
   const int intra_edge_filter_type = get_intra_edge_filter_type(xd, plane);
@@ -1633,21 +1721,121 @@ void av1_predict_intra_block(const MACROBLOCKD *xd, BLOCK_SIZE sb_size,
   if (is_cur_buf_hbd(xd)) {
     build_intra_predictors_high(
         ref, ref_stride, dst, dst_stride, mode, p_angle, filter_intra_mode,
-        tx_size, disable_edge_filter, have_top ? AOMMIN(txwpx, xr + txwpx) : 0,
-        have_top_right > 0 ? AOMMIN(txwpx, xr) : have_top_right,
-        have_left ? AOMMIN(txhpx, yd + txhpx) : 0,
-        have_bottom_left > 0 ? AOMMIN(txhpx, yd) : have_bottom_left,
-        intra_edge_filter_type, xd->bd);
+        tx_size, disable_edge_filter, n_top_px, n_topright_px, n_left_px,
+        n_bottomleft_px, intra_edge_filter_type, xd->bd);
+    return;
+  }
+#endif
+  build_intra_predictors(ref, ref_stride, dst, dst_stride, mode, p_angle,
+                         filter_intra_mode, tx_size, disable_edge_filter,
+                         n_top_px, n_topright_px, n_left_px, n_bottomleft_px,
+                         intra_edge_filter_type);
+}
+
+void av1_prepare_dr_intra_edges(const MACROBLOCKD *xd, BLOCK_SIZE sb_size,
+                                int enable_intra_edge_filter, int wpx, int hpx,
+                                TX_SIZE tx_size, const uint8_t *ref,
+                                int ref_stride, int col_off, int row_off,
+                                int plane, IntraEdges *edges) {
+  const int txwpx = tx_size_wide[tx_size];
+  const int txhpx = tx_size_high[tx_size];
+  // Gather the union of the pixels needed by all the prediction angles.
+  get_intra_neighbour_px(xd, sb_size, wpx, hpx, tx_size, col_off, row_off,
+                         plane, /*need_top_right=*/1, /*need_bottom_left=*/1,
+                         &edges->n_top_px, &edges->n_topright_px,
+                         &edges->n_left_px, &edges->n_bottomleft_px);
+  edges->tx_size = tx_size;
+  edges->disable_edge_filter = !enable_intra_edge_filter;
+  edges->intra_edge_filter_type = get_intra_edge_filter_type(xd, plane);
+  edges->use_hbd = is_cur_buf_hbd(xd);
+  edges->bd = xd->bd;
+#if CONFIG_AV1_HIGHBITDEPTH
+  if (edges->use_hbd) {
+    const uint16_t *ref16 = CONVERT_TO_SHORTPTR(ref);
+    const int base = 128 << (xd->bd - 8);
+    aom_memset16(edges->left_data, base + 1, NUM_INTRA_NEIGHBOUR_PIXELS);
+    aom_memset16(edges->above_data, base - 1, NUM_INTRA_NEIGHBOUR_PIXELS);
+    gather_intra_edges_high(ref16 - ref_stride, ref16 - 1, ref_stride,
+                            edges->above_data + 16, edges->left_data + 16,
+                            txwpx, txhpx, 1, 1, 1, edges->n_top_px,
+                            edges->n_topright_px, edges->n_left_px,
+                            edges->n_bottomleft_px, base);
     return;
   }
 #endif
-  build_intra_predictors(
-      ref, ref_stride, dst, dst_stride, mode, p_angle, filter_intra_mode,
-      tx_size, disable_edge_filter, have_top ? AOMMIN(txwpx, xr + txwpx) : 0,
-      have_top_right > 0 ? AOMMIN(txwpx, xr) : have_top_right,
-      have_left ? AOMMIN(txhpx, yd + txhpx) : 0,
-      have_bottom_left > 0 ? AOMMIN(txhpx, yd) : have_bottom_left,
-      intra_edge_filter_type);
+  uint8_t *const above_data = (uint8_t *)edges->above_data;
+  uint8_t *const left_data = (uint8_t *)edges->left_data;
+  memset(left_data, 129, NUM_INTRA_NEIGHBOUR_PIXELS);
+  memset(above_data, 127, NUM_INTRA_NEIGHBOUR_PIXELS);
+  gather_intra_edges(ref - ref_stride, ref - 1, ref_stride, above_data + 16,
+                     left_data + 16, txwpx, txhpx, 1, 1, 1, edges->n_top_px,
+                     edges->n_topright_px, edges->n_left_px,
+                     edges->n_bottomleft_px);
+}
+
+void av1_predict_dr_intra_from_edges(const IntraEdges *edges, int p_angle,
+                                     uint8_t *dst, int dst_stride) {
+  const TX_SIZE tx_size = edges->tx_size;
+  const int txwpx = tx_size_wide[tx_size];
+  const int txhpx = tx_size_high[tx_size];
+  const int n_top_px = edges->n_top_px;
+  const int n_left_px = edges->n_left_px;
+  const int need_above = p_angle < 180;
+  const int need_left = p_angle > 90;
+#if CONFIG_AV1_HIGHBITDEPTH
+  if (edges->use_hbd) {
+    uint16_t *dst16 = CONVERT_TO_SHORTPTR(dst);
+    const uint16_t *above_row = edges->above_data + 16;
+    const uint16_t *left_col = edges->left_data + 16;
+    if ((!need_above && n_left_px == 0) || (!need_left && n_top_px == 0)) {
+      const int base = 128 << (edges->bd - 8);
+      int val;
+      if (need_left) {
+        val = (n_top_px > 0) ? above_row[0] : base + 1;
+      } else {
+        val = (n_left_px > 0) ? left_col[0] : base - 1;
+      }
+      for (int i = 0; i < txhpx; ++i) {
+        aom_memset16(dst16, val, txwpx);
+        dst16 += dst_stride;
+      }
+      return;
+    }
+    // The edges are filtered and upsampled in place, depending on the angle.
+    DECLARE_ALIGNED(16, uint16_t, above_data[NUM_INTRA_NEIGHBOUR_PIXELS]);
+    DECLARE_ALIGNED(16, uint16_t, left_data[NUM_INTRA_NEIGHBOUR_PIXELS]);
+    memcpy(above_data, edges->above_data, sizeof(above_data));
+    memcpy(left_data, edges->left_data, sizeof(left_data));
+    build_dr_predictor_high(above_data + 16, left_data + 16, dst16, dst_stride,
+                            tx_size, p_angle, edges->disable_edge_filter,
+                            n_top_px, n_left_px, edges->intra_edge_filter_type,
+                            edges->bd);
+    return;
+  }
+#endif
+  const uint8_t *above_row = (const uint8_t *)edges->above_data + 16;
+  const uint8_t *left_col = (const uint8_t *)edges->left_data + 16;
+  if ((!need_above && n_left_px == 0) || (!need_left && n_top_px == 0)) {
+    int val;
+    if (need_left) {
+      val = (n_top_px > 0) ? above_row[0] : 129;
+    } else {
+      val = (n_left_px > 0) ? left_col[0] : 127;
+    }
+    for (int i = 0; i < txhpx; ++i) {
+      memset(dst, val, txwpx);
+      dst += dst_stride;
+    }
+    return;
+  }
+  // The edges are filtered and upsampled in place, depending on the angle.
+  DECLARE_ALIGNED(16, uint8_t, above_data[NUM_INTRA_NEIGHBOUR_PIXELS]);
+  DECLARE_ALIGNED(16, uint8_t, left_data[NUM_INTRA_NEIGHBOUR_PIXELS]);
+  memcpy(above_data, edges->above_data, sizeof(above_data));
+  memcpy(left_data, edges->left_data, sizeof(left_data));
+  build_dr_predictor(above_data + 16, left_data + 16, dst, dst_stride, tx_size,
+                     p_angle, edges->disable_edge_filter, n_top_px, n_left_px,
+                     edges->intra_edge_filter_type);
 }
 
 void av1_predict_intra_block_facade(const AV1_COMMON *cm, MACROBLOCKD *xd,
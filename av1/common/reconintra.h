@@ -35,6 +35,39 @@ void av1_predict_intra_block(const MACROBLOCKD *xd, BLOCK_SIZE sb_size,
                              int dst_stride, int col_off, int row_off,
                              int plane);
 
+#define NUM_INTRA_NEIGHBOUR_PIXELS (MAX_TX_SIZE * 2 + 32)
+
+// Neighbouring pixels of a transform block, gathered once to build the
+// predictions of all the directional modes. The low bitdepth pixels are
+// stored as bytes at the start of the arrays.
+typedef struct IntraEdges {
+  DECLARE_ALIGNED(16, uint16_t, above_data[NUM_INTRA_NEIGHBOUR_PIXELS]);
+  DECLARE_ALIGNED(16, uint16_t, left_data[NUM_INTRA_NEIGHBOUR_PIXELS]);
+  TX_SIZE tx_size;
+  int n_top_px;
+  int n_topright_px;
+  int n_left_px;
+  int n_bottomleft_px;
+  int disable_edge_filter;
+  int intra_edge_filter_type;
+  int use_hbd;
+  int bd;
+} IntraEdges;
+
+// Gathers the neighbouring pixels of the transform block at (col_off,
+// row_off), with the same arguments as av1_predict_intra_block().
+void av1_prepare_dr_intra_edges(const MACROBLOCKD *xd, BLOCK_SIZE sb_size,
+                                int enable_intra_edge_filter, int wpx, int hpx,
+                                TX_SIZE tx_size, const uint8_t *ref,
+                                int ref_stride, int col_off, int row_off,
+                                int plane, IntraEdges *edges);
+
+// Builds the prediction of the given directional angle from the gathered
+// edges. The result matches that of av1_predict_intra_block() for the mode and
+// angle delta making up p_angle.
+void av1_predict_dr_intra_from_edges(const IntraEdges *edges, int p_angle,
+                                     uint8_t *dst, int dst_stride);
+
 // Mapping of interintra to intra mode for use in the intra component
 static const PREDICTION_MODE interintra_to_intra_mode[INTERINTRA_MODES] = {
   DC_PRED, V_PRED, H_PRED, SMOOTH_PRED
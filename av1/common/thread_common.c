@@ -396,6 +396,19 @@ static void loop_filter_rows(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
   }
 }
 
+void av1_loop_filter_frame_rows(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
+                                MACROBLOCKD *xd, int plane_start, int plane_end,
+                                int start_mi_row, int end_mi_row) {
+  int planes_to_lf[3];
+
+  if (!check_planes_to_loop_filter(&cm->lf, planes_to_lf, plane_start,
+                                   plane_end))
+    return;
+
+  loop_filter_rows(frame, cm, xd, start_mi_row,
+                   AOMMIN(end_mi_row, cm->mi_params.mi_rows), planes_to_lf, 0);
+}
+
 void av1_loop_filter_frame_mt(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
                               MACROBLOCKD *xd, int plane_start, int plane_end,
                               int partial_frame, AVxWorker *workers,
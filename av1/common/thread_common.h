@@ -170,6 +170,14 @@ void av1_loop_filter_frame_mt(YV12_BUFFER_CONFIG *frame, struct AV1Common *cm,
                               AVxWorker *workers, int num_workers,
                               AV1LfSync *lf_sync, int lpf_opt_level);
 
+// Filters the rows [start_mi_row, end_mi_row) of the frame on the calling
+// thread. The rows must start on a multiple of MAX_MIB_SIZE and
+// av1_loop_filter_frame_init() must have been called for the frame.
+void av1_loop_filter_frame_rows(YV12_BUFFER_CONFIG *frame, struct AV1Common *cm,
+                                struct macroblockd *xd, int plane_start,
+                                int plane_end, int start_mi_row,
+                                int end_mi_row);
+
 void av1_loop_restoration_filter_frame_mt(YV12_BUFFER_CONFIG *frame,
                                           struct AV1Common *cm,
                                           int optimized_lr, AVxWorker *workers,
@@ -630,6 +630,18 @@ static AOM_INLINE void dec_calc_subpel_params(
   *src_stride = pre_buf->stride;
 }
 
+// Replaces the interpolation filters of the prediction with their 4-tap
+// versions, or with bilinear ones if 'taps' is 2.
+static AOM_INLINE void reduce_interp_filters(
+    InterPredParams *const inter_pred_params, int taps) {
+  for (int dir = 0; dir < 2; ++dir) {
+    const InterpFilter filter =
+        taps == 2 ? BILINEAR
+                  : inter_pred_params->interp_filter_params[dir]->interp_filter;
+    inter_pred_params->interp_filter_params[dir] = &av1_interp_4tap[filter];
+  }
+}
+
 static AOM_INLINE void dec_calc_subpel_params_and_extend(
     const MV *const src_mv, InterPredParams *const inter_pred_params,
     MACROBLOCKD *const xd, int mi_x, int mi_y, int ref, uint8_t **mc_buf,
@@ -637,6 +649,8 @@ static AOM_INLINE void dec_calc_subpel_params_and_extend(
   PadBlock block;
   MV32 scaled_mv;
   int subpel_x_mv, subpel_y_mv;
+  if (xd->reduced_interp_taps && !inter_pred_params->is_intrabc)
+    reduce_interp_filters(inter_pred_params, xd->reduced_interp_taps);
   dec_calc_subpel_params(src_mv, inter_pred_params, xd, mi_x, mi_y, pre,
                          subpel_params, src_stride, &block, &scaled_mv,
                          &subpel_x_mv, &subpel_y_mv);
@@ -1113,6 +1127,18 @@ static TX_SIZE read_tx_size(const MACROBLOCKD *const xd, TX_MODE tx_mode,
   }
 }
 
+static AOM_INLINE void count_block(DecodeBlockCounts *counts,
+                                   const MB_MODE_INFO *mbmi) {
+  ++counts->blocks[mbmi->bsize];
+  if (is_inter_block(mbmi)) {
+    ++counts->inter_blocks;
+    counts->compound_blocks += has_second_ref(mbmi);
+  } else {
+    ++counts->intra_blocks;
+  }
+  counts->skip_blocks += mbmi->skip_txfm;
+}
+
 static AOM_INLINE void parse_decode_block(AV1Decoder *const pbi,
                                           ThreadData *const td, int mi_row,
                                           int mi_col, aom_reader *r,
@@ -1127,6 +1153,7 @@ static AOM_INLINE void parse_decode_block(AV1Decoder *const pbi,
   AV1_COMMON *cm = &pbi->common;
   const int num_planes = av1_num_planes(cm);
   MB_MODE_INFO *mbmi = xd->mi[0];
+  count_block(&td->block_counts, mbmi);
   int inter_block_tx = is_inter_block(mbmi) || is_intrabc_block(mbmi);
   if (cm->features.tx_mode == TX_MODE_SELECT && block_signals_txsize(bsize) &&
       !mbmi->skip_txfm && inter_block_tx && !xd->lossless[mbmi->segment_id]) {
@@ -2523,8 +2550,10 @@ void av1_dec_row_mt_dealloc(AV1DecRowMTSync *dec_row_mt_sync) {
   }
 }
 
+// Waits for the superblocks row r depends on to be decoded, and adds the time
+// waited to *idle_us.
 static INLINE void sync_read(AV1DecRowMTSync *const dec_row_mt_sync, int r,
-                             int c) {
+                             int c, int64_t *idle_us) {
 #if CONFIG_MULTITHREAD
   const int nsync = dec_row_mt_sync->sync_range;
 
@@ -2532,9 +2561,16 @@ static INLINE void sync_read(AV1DecRowMTSync *const dec_row_mt_sync, int r,
     pthread_mutex_t *const mutex = &dec_row_mt_sync->mutex_[r - 1];
     pthread_mutex_lock(mutex);
 
-    while (c > dec_row_mt_sync->cur_sb_col[r - 1] - nsync -
-                   dec_row_mt_sync->intrabc_extra_top_right_sb_delay) {
-      pthread_cond_wait(&dec_row_mt_sync->cond_[r - 1], mutex);
+    if (c > dec_row_mt_sync->cur_sb_col[r - 1] - nsync -
+                dec_row_mt_sync->intrabc_extra_top_right_sb_delay) {
+      struct aom_usec_timer timer;
+      aom_usec_timer_start(&timer);
+      while (c > dec_row_mt_sync->cur_sb_col[r - 1] - nsync -
+                     dec_row_mt_sync->intrabc_extra_top_right_sb_delay) {
+        pthread_cond_wait(&dec_row_mt_sync->cond_[r - 1], mutex);
+      }
+      aom_usec_timer_mark(&timer);
+      *idle_us += aom_usec_timer_elapsed(&timer);
     }
     pthread_mutex_unlock(mutex);
   }
@@ -2542,6 +2578,7 @@ static INLINE void sync_read(AV1DecRowMTSync *const dec_row_mt_sync, int r,
   (void)dec_row_mt_sync;
   (void)r;
   (void)c;
+  (void)idle_us;
 #endif  // CONFIG_MULTITHREAD
 }
 
@@ -2609,7 +2646,8 @@ static AOM_INLINE void decode_tile_sb_row(AV1Decoder *pbi, ThreadData *const td,
     set_cb_buffer(pbi, &td->dcb, pbi->cb_buffer_base, num_planes, mi_row,
                   mi_col);
 
-    sync_read(&tile_data->dec_row_mt_sync, sb_row_in_tile, sb_col_in_tile);
+    sync_read(&tile_data->dec_row_mt_sync, sb_row_in_tile, sb_col_in_tile,
+              &td->idle_us);
 
 #if CONFIG_MULTITHREAD
     pthread_mutex_lock(pbi->row_mt_mutex_);
@@ -2675,6 +2713,184 @@ static AOM_INLINE void set_decode_func_pointers(ThreadData *td,
   }
 }
 
+// Whether the fast decode mode skips all the post-filters of the frame.
+static AOM_INLINE int skip_post_filters(const AV1Decoder *pbi) {
+  return pbi->fast_decode >= FAST_DECODE_SKIP_NONREF_FILTERS &&
+         pbi->common.current_frame.refresh_frame_flags == 0;
+}
+
+static AOM_INLINE int frame_needs_loop_filter(const AV1Decoder *pbi) {
+  const AV1_COMMON *const cm = &pbi->common;
+  return !skip_post_filters(pbi) &&
+         (cm->lf.filter_level[0] || cm->lf.filter_level[1]);
+}
+
+static AOM_INLINE int frame_needs_cdef(const AV1Decoder *pbi) {
+  const AV1_COMMON *const cm = &pbi->common;
+  if (pbi->fast_decode >= FAST_DECODE_SKIP_CDEF_LR || skip_post_filters(pbi))
+    return 0;
+  return !pbi->skip_loop_filter && !cm->features.coded_lossless &&
+         (cm->cdef_info.cdef_bits || cm->cdef_info.cdef_strengths[0] ||
+          cm->cdef_info.cdef_uv_strengths[0]);
+}
+
+static AOM_INLINE int frame_needs_loop_restoration(const AV1Decoder *pbi) {
+  const AV1_COMMON *const cm = &pbi->common;
+  if (pbi->fast_decode >= FAST_DECODE_SKIP_CDEF_LR || skip_post_filters(pbi))
+    return 0;
+  return cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
+         cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
+         cm->rst_info[2].frame_restoration_type != RESTORE_NONE;
+}
+
+// Decides whether the tiles outside the region of interest are skipped in the
+// frame about to be decoded. The tiles of frames that use the motion vectors
+// of their references cannot be parsed apart, as the motion field projected
+// from the references spans tiles.
+static void decode_roi_init(AV1Decoder *pbi) {
+  AV1_COMMON *const cm = &pbi->common;
+  DecodeRoi *const roi = &pbi->roi;
+  roi->active = roi->width > 0 && roi->height > 0 && !cm->tiles.large_scale &&
+                !cm->features.allow_ref_frame_mvs && !av1_superres_scaled(cm);
+  if (!roi->active) return;
+
+  // Later frames may project the motion vectors of this one, so leave none in
+  // the tiles that are not decoded.
+  memset(cm->cur_frame->mvs, 0,
+         ((cm->mi_params.mi_rows + 1) >> 1) *
+             ((cm->mi_params.mi_cols + 1) >> 1) * sizeof(*cm->cur_frame->mvs));
+  // The loop restoration units of the tiles that are not decoded are left
+  // unfiltered.
+  for (int plane = 0; plane < av1_num_planes(cm); ++plane) {
+    RestorationInfo *const rsi = &cm->rst_info[plane];
+    if (rsi->frame_restoration_type == RESTORE_NONE) continue;
+    for (int i = 0; i < rsi->units_per_tile; ++i)
+      rsi->unit_info[i].restoration_type = RESTORE_NONE;
+  }
+}
+
+// Returns whether the tile is left out of the decode by the region of
+// interest.
+static AOM_INLINE int tile_outside_roi(const AV1Decoder *pbi, int tile_row,
+                                       int tile_col) {
+  const DecodeRoi *const roi = &pbi->roi;
+  if (!roi->active) return 0;
+  const AV1_COMMON *const cm = &pbi->common;
+  const CommonTileParams *const tiles = &cm->tiles;
+  // The entropy contexts of this tile are carried over to later frames.
+  if (cm->features.refresh_frame_context == REFRESH_FRAME_CONTEXT_BACKWARD &&
+      tile_row * tiles->cols + tile_col == pbi->context_update_tile_id)
+    return 0;
+  const int sb_size_log2 = cm->seq_params->mib_size_log2 + MI_SIZE_LOG2;
+  const int top = tiles->row_start_sb[tile_row] << sb_size_log2;
+  const int bottom = tiles->row_start_sb[tile_row + 1] << sb_size_log2;
+  const int left = tiles->col_start_sb[tile_col] << sb_size_log2;
+  const int right = tiles->col_start_sb[tile_col + 1] << sb_size_log2;
+  return bottom <= roi->y || top >= roi->y + roi->height ||
+         right <= roi->x || left >= roi->x + roi->width;
+}
+
+// Returns the end of the data of the last tile of the tile group.
+static const uint8_t *tile_group_end(AV1Decoder *pbi, int end_tile) {
+  const int tile_cols = pbi->common.tiles.cols;
+  const int tile_row = end_tile / tile_cols;
+  const int tile_col = end_tile % tile_cols;
+  if (tile_outside_roi(pbi, tile_row, tile_col)) {
+    const TileBufferDec *const buf = &pbi->tile_buffers[tile_row][tile_col];
+    return buf->data + buf->size;
+  }
+  return aom_reader_find_end(&pbi->tile_data[end_tile].bit_reader);
+}
+
+// Sets up the sub-frame output of the frame about to be decoded. The rows are
+// filtered behind the decoding only when the tiles are decoded in order on
+// the calling thread, and there is no loop restoration or superres, which
+// need the whole frame. Otherwise the frame is handed out once complete.
+static void row_output_init(AV1Decoder *pbi) {
+  AV1_COMMON *const cm = &pbi->common;
+  const CommonTileParams *const tiles = &cm->tiles;
+  RowOutputState *const ro = &pbi->row_output;
+  memset(ro, 0, sizeof(*ro));
+  if (pbi->row_output_cb == NULL || !cm->show_frame) return;
+  if (pbi->max_threads > 1 && (pbi->row_mt || tiles->rows * tiles->cols > 1))
+    return;
+  if (tiles->large_scale || pbi->inv_tile_order || pbi->roi.active) return;
+
+  const int apply_filters =
+      !cm->features.allow_intrabc && !tiles->single_tile_decoding;
+  if (apply_filters &&
+      (av1_superres_scaled(cm) || frame_needs_loop_restoration(pbi)))
+    return;
+
+  ro->active = 1;
+  ro->do_lf = apply_filters && frame_needs_loop_filter(pbi);
+  ro->do_cdef = apply_filters && frame_needs_cdef(pbi);
+  if (ro->do_lf) av1_loop_filter_frame_init(cm, 0, av1_num_planes(cm));
+  if (ro->do_cdef) {
+    av1_alloc_cdef_buffers(cm, &pbi->cdef_worker, &pbi->cdef_sync,
+                           pbi->num_workers, 1);
+    av1_alloc_cdef_sync(cm, &pbi->cdef_sync, pbi->num_workers);
+  }
+}
+
+// Filters the rows that the first 'decoded_mi_rows' decoded rows allow to,
+// and hands out those that became final.
+static void row_output_progress(AV1Decoder *pbi, int decoded_mi_rows) {
+  AV1_COMMON *const cm = &pbi->common;
+  MACROBLOCKD *const xd = &pbi->dcb.xd;
+  RowOutputState *const ro = &pbi->row_output;
+  const int mi_rows = cm->mi_params.mi_rows;
+  const int num_planes = av1_num_planes(cm);
+  YV12_BUFFER_CONFIG *const buf = &cm->cur_frame->buf;
+
+  ro->decoded_mi_rows = AOMMAX(ro->decoded_mi_rows, decoded_mi_rows);
+  int final_mi_rows = ro->decoded_mi_rows;
+  if (ro->do_lf) {
+    // The last pixel row of a filtering unit is the top neighbour of the
+    // intra prediction of the superblock row below it, so the unit is only
+    // filtered once that row is decoded.
+    while (ro->lf_mi_rows < mi_rows &&
+           (ro->decoded_mi_rows == mi_rows ||
+            ro->decoded_mi_rows >= ro->lf_mi_rows + MAX_MIB_SIZE +
+                                       cm->seq_params->mib_size)) {
+      av1_loop_filter_frame_rows(buf, cm, xd, 0, num_planes, ro->lf_mi_rows,
+                                 ro->lf_mi_rows + MAX_MIB_SIZE);
+      ro->lf_mi_rows += MAX_MIB_SIZE;
+    }
+    // Filtering the next unit reads and changes up to the last 7 pixel rows
+    // of the filtered ones.
+    final_mi_rows = ro->lf_mi_rows >= mi_rows
+                        ? mi_rows
+                        : AOMMAX(ro->lf_mi_rows - (8 >> MI_SIZE_LOG2), 0);
+  }
+  if (ro->do_cdef) {
+    // CDEF reads the deblocked pixel rows right below the filter block row.
+    int filtered = 0;
+    while (ro->cdef_fb_rows * MI_SIZE_64X64 < mi_rows &&
+           (final_mi_rows == mi_rows ||
+            (ro->cdef_fb_rows + 1) * MI_SIZE_64X64 < final_mi_rows)) {
+      if (!filtered) {
+        av1_setup_dst_planes(xd->plane, cm->seq_params->sb_size, buf, 0, 0, 0,
+                             num_planes);
+        filtered = 1;
+      }
+      av1_cdef_fb_row(cm, xd, cm->cdef_info.linebuf, cm->cdef_info.colbuf,
+                      cm->cdef_info.srcbuf, ro->cdef_fb_rows,
+                      av1_cdef_init_fb_row, NULL);
+      ro->cdef_fb_rows++;
+    }
+    final_mi_rows = AOMMIN(ro->cdef_fb_rows * MI_SIZE_64X64, mi_rows);
+  }
+
+  if (final_mi_rows > ro->output_mi_rows) {
+    const int row_start = ro->output_mi_rows * MI_SIZE;
+    const int row_end = AOMMIN(final_mi_rows * MI_SIZE, cm->height);
+    ro->output_mi_rows = final_mi_rows;
+    if (row_end > row_start)
+      pbi->row_output_cb(pbi->row_output_priv, buf, row_start, row_end);
+  }
+}
+
 static AOM_INLINE void decode_tile(AV1Decoder *pbi, ThreadData *const td,
                                    int tile_row, int tile_col) {
   TileInfo tile_info;
@@ -2709,6 +2925,10 @@ static AOM_INLINE void decode_tile(AV1Decoder *pbi, ThreadData *const td,
         return;
       }
     }
+    if (pbi->row_output.active && cm->tiles.cols == 1) {
+      row_output_progress(pbi, AOMMIN(mi_row + cm->seq_params->mib_size,
+                                      tile_info.mi_row_end));
+    }
   }
 
   int corrupted =
@@ -2815,7 +3035,8 @@ static const uint8_t *decode_tiles(AV1Decoder *pbi, const uint8_t *data,
       const TileBufferDec *const tile_bs_buf = &tile_buffers[row][col];
 
       if (row * tiles->cols + col < start_tile ||
-          row * tiles->cols + col > end_tile)
+          row * tiles->cols + col > end_tile ||
+          tile_outside_roi(pbi, row, col))
         continue;
 
       td->bit_reader = &tile_data->bit_reader;
@@ -2848,6 +3069,8 @@ static const uint8_t *decode_tiles(AV1Decoder *pbi, const uint8_t *data,
       if (pbi->dcb.corrupted)
         aom_internal_error(&pbi->error, AOM_CODEC_CORRUPT_FRAME,
                            "Failed to decode tile data");
+      if (pbi->row_output.active && col == tile_cols - 1)
+        row_output_progress(pbi, td->dcb.xd.tile.mi_row_end);
     }
   }
 
@@ -2859,9 +3082,7 @@ static const uint8_t *decode_tiles(AV1Decoder *pbi, const uint8_t *data,
     // Return the end of the last tile buffer
     return raw_data_end;
   }
-  TileDataDec *const tile_data = pbi->tile_data + end_tile;
-
-  return aom_reader_find_end(&tile_data->bit_reader);
+  return tile_group_end(pbi, end_tile);
 }
 
 static TileJobsDec *get_dec_job_info(AV1DecTileMT *tile_mt_info) {
@@ -3036,7 +3257,8 @@ static int get_next_job_info(AV1Decoder *const pbi,
     for (tile_col_idx = tile_cols_start; tile_col_idx < tile_cols_end;
          ++tile_col_idx) {
       if (tile_row_idx * cm->tiles.cols + tile_col_idx < start_tile ||
-          tile_row_idx * cm->tiles.cols + tile_col_idx > end_tile)
+          tile_row_idx * cm->tiles.cols + tile_col_idx > end_tile ||
+          tile_outside_roi(pbi, tile_row_idx, tile_col_idx))
         continue;
 
       tile_data = pbi->tile_data + tile_row_idx * cm->tiles.cols + tile_col_idx;
@@ -3247,10 +3469,17 @@ static int row_mt_worker_hook(void *arg1, void *arg2) {
     AV1DecRowMTJobInfo next_job_info;
     int end_of_frame = 0;
 
+    struct aom_usec_timer idle_timer;
+    int waited = 0;
+
 #if CONFIG_MULTITHREAD
     pthread_mutex_lock(pbi->row_mt_mutex_);
 #endif
     while (!get_next_job_info(pbi, &next_job_info, &end_of_frame)) {
+      if (!waited) {
+        aom_usec_timer_start(&idle_timer);
+        waited = 1;
+      }
 #if CONFIG_MULTITHREAD
       pthread_cond_wait(pbi->row_mt_cond_, pbi->row_mt_mutex_);
 #endif
@@ -3258,6 +3487,10 @@ static int row_mt_worker_hook(void *arg1, void *arg2) {
 #if CONFIG_MULTITHREAD
     pthread_mutex_unlock(pbi->row_mt_mutex_);
 #endif
+    if (waited) {
+      aom_usec_timer_mark(&idle_timer);
+      td->idle_us += aom_usec_timer_elapsed(&idle_timer);
+    }
 
     if (end_of_frame) break;
 
@@ -3306,7 +3539,8 @@ static AOM_INLINE void enqueue_tile_jobs(AV1Decoder *pbi, AV1_COMMON *cm,
   for (int row = tile_rows_start; row < tile_rows_end; row++) {
     for (int col = tile_cols_start; col < tile_cols_end; col++) {
       if (row * cm->tiles.cols + col < start_tile ||
-          row * cm->tiles.cols + col > end_tile)
+          row * cm->tiles.cols + col > end_tile ||
+          tile_outside_roi(pbi, row, col))
         continue;
       tile_job_queue->tile_buffer = &pbi->tile_buffers[row][col];
       tile_job_queue->tile_data = pbi->tile_data + row * cm->tiles.cols + col;
@@ -3452,11 +3686,17 @@ static AOM_INLINE void launch_dec_workers(AV1Decoder *pbi,
 static AOM_INLINE void sync_dec_workers(AV1Decoder *pbi, int num_workers) {
   const AVxWorkerInterface *const winterface = aom_get_worker_interface();
   int corrupted = 0;
+  struct aom_usec_timer timer;
 
+  // The main thread is done with its share of the tiles, and waits on the
+  // other workers.
+  aom_usec_timer_start(&timer);
   for (int worker_idx = num_workers; worker_idx > 0; --worker_idx) {
     AVxWorker *const worker = &pbi->tile_workers[worker_idx - 1];
     aom_merge_corrupted_flag(&corrupted, !winterface->sync(worker));
   }
+  aom_usec_timer_mark(&timer);
+  pbi->td.idle_us += aom_usec_timer_elapsed(&timer);
 
   pbi->dcb.corrupted = corrupted;
 }
@@ -3622,9 +3862,7 @@ static const uint8_t *decode_tiles_mt(AV1Decoder *pbi, const uint8_t *data,
     // Return the end of the last tile buffer
     return raw_data_end;
   }
-  TileDataDec *const tile_data = pbi->tile_data + end_tile;
-
-  return aom_reader_find_end(&tile_data->bit_reader);
+  return tile_group_end(pbi, end_tile);
 }
 
 static AOM_INLINE void dec_alloc_cb_buf(AV1Decoder *pbi) {
@@ -3662,7 +3900,8 @@ static AOM_INLINE void row_mt_frame_init(AV1Decoder *pbi, int tile_rows_start,
   for (int tile_row = tile_rows_start; tile_row < tile_rows_end; ++tile_row) {
     for (int tile_col = tile_cols_start; tile_col < tile_cols_end; ++tile_col) {
       if (tile_row * cm->tiles.cols + tile_col < start_tile ||
-          tile_row * cm->tiles.cols + tile_col > end_tile)
+          tile_row * cm->tiles.cols + tile_col > end_tile ||
+          tile_outside_roi(pbi, tile_row, tile_col))
         continue;
 
       TileDataDec *const tile_data =
@@ -3833,9 +4072,7 @@ static const uint8_t *decode_tiles_row_mt(AV1Decoder *pbi, const uint8_t *data,
     // Return the end of the last tile buffer
     return raw_data_end;
   }
-  TileDataDec *const tile_data = pbi->tile_data + end_tile;
-
-  return aom_reader_find_end(&tile_data->bit_reader);
+  return tile_group_end(pbi, end_tile);
 }
 
 static AOM_INLINE void error_handler(void *data) {
@@ -4449,6 +4686,28 @@ static INLINE void reset_frame_buffers(AV1_COMMON *cm) {
 
 // On success, returns 0. On failure, calls aom_internal_error and does not
 // return.
+// Returns whether the frame whose header is being read is left out of the
+// decode. Called once the reference buffers the frame refreshes are known.
+static int skip_frame(const AV1Decoder *pbi) {
+  const CurrentFrame *const current_frame = &pbi->common.current_frame;
+  switch (pbi->skip_frames) {
+    case SKIP_FRAMES_NON_REFERENCE:
+      return current_frame->refresh_frame_flags == 0;
+    case SKIP_FRAMES_NON_KEY: return current_frame->frame_type != KEY_FRAME;
+    default: return 0;
+  }
+}
+
+// Returns whether showing 'frame_to_show' is left out of the decode. Only
+// the key frames not yet shown are output when skipping all other frames,
+// since the skipped frames do not refresh the reference buffers.
+static int skip_existing_frame(const AV1Decoder *pbi,
+                               const RefCntBuffer *frame_to_show) {
+  if (pbi->skip_frames != SKIP_FRAMES_NON_KEY) return 0;
+  return frame_to_show == NULL || frame_to_show->frame_type != KEY_FRAME ||
+         !frame_to_show->showable_frame;
+}
+
 static int read_uncompressed_header(AV1Decoder *pbi,
                                     struct aom_read_bit_buffer *rb) {
   AV1_COMMON *const cm = &pbi->common;
@@ -4461,6 +4720,7 @@ static int read_uncompressed_header(AV1Decoder *pbi,
   aom_s_frame_info *sframe_info = &pbi->sframe_info;
   sframe_info->is_s_frame = 0;
   sframe_info->is_s_frame_at_altref = 0;
+  pbi->frame_skipped = 0;
 
   if (!pbi->sequence_header_ready) {
     aom_internal_error(&pbi->error, AOM_CODEC_CORRUPT_FRAME,
@@ -4491,6 +4751,10 @@ static int read_uncompressed_header(AV1Decoder *pbi,
       // Show an existing frame directly.
       const int existing_frame_idx = aom_rb_read_literal(rb, 3);
       RefCntBuffer *const frame_to_show = cm->ref_frame_map[existing_frame_idx];
+      if (skip_existing_frame(pbi, frame_to_show)) {
+        pbi->frame_skipped = 1;
+        return 0;
+      }
       if (frame_to_show == NULL) {
         aom_internal_error(&pbi->error, AOM_CODEC_UNSUP_BITSTREAM,
                            "Buffer does not contain a decoded frame");
@@ -4735,6 +4999,13 @@ static int read_uncompressed_header(AV1Decoder *pbi,
     }
   }
 
+  // The rest of the header of a skipped frame is not needed, its tile data is
+  // dropped along with it.
+  if (skip_frame(pbi)) {
+    pbi->frame_skipped = 1;
+    return 0;
+  }
+
   if (!frame_is_intra_only(cm) || current_frame->refresh_frame_flags != 0xFF) {
     // Read all ref frame order hints if error_resilient_mode == 1
     if (features->error_resilient_mode &&
@@ -5159,6 +5430,7 @@ uint32_t av1_decode_frame_headers_and_setup(AV1Decoder *pbi,
   xd->global_motion = cm->global_motion;
 
   read_uncompressed_header(pbi, rb);
+  if (pbi->frame_skipped) return (uint32_t)aom_rb_bytes_read(rb);
 
   if (trailing_bits_present) av1_check_trailing_bits(pbi, rb);
 
@@ -5229,6 +5501,28 @@ static AOM_INLINE void setup_frame_info(AV1Decoder *pbi) {
   }
 }
 
+// Adds the counters of the threads that decoded the tile group to the decode
+// stats, and clears them.
+static AOM_INLINE void accumulate_decode_stats(AV1Decoder *pbi) {
+  aom_decode_stats_t *const stats = &pbi->decode_stats;
+  const int num_threads = AOMMAX(pbi->num_workers, 1);
+  assert(BLOCK_SIZES_ALL == AOM_DECODE_STATS_BLOCK_SIZES);
+  for (int i = 0; i < num_threads; ++i) {
+    ThreadData *const td = i == 0 ? &pbi->td : pbi->thread_data[i].td;
+    const DecodeBlockCounts *const counts = &td->block_counts;
+    for (int b = 0; b < BLOCK_SIZES_ALL; ++b) {
+      stats->blocks[b] += counts->blocks[b];
+    }
+    stats->intra_blocks += counts->intra_blocks;
+    stats->inter_blocks += counts->inter_blocks;
+    stats->compound_blocks += counts->compound_blocks;
+    stats->skip_blocks += counts->skip_blocks;
+    stats->worker_idle_us += td->idle_us;
+    av1_zero(td->block_counts);
+    td->idle_us = 0;
+  }
+}
+
 void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
                                     const uint8_t *data_end,
                                     const uint8_t **p_data_end, int start_tile,
@@ -5238,9 +5532,18 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
   MACROBLOCKD *const xd = &pbi->dcb.xd;
   const int tile_count_tg = end_tile - start_tile + 1;
 
-  if (initialize_flag) setup_frame_info(pbi);
+  if (initialize_flag) {
+    setup_frame_info(pbi);
+    decode_roi_init(pbi);
+    row_output_init(pbi);
+    pbi->dcb.xd.reduced_interp_taps =
+        pbi->fast_decode >= FAST_DECODE_BILINEAR_INTERP ? 2
+        : pbi->fast_decode >= FAST_DECODE_4TAP_INTERP   ? 4
+                                                        : 0;
+  }
   const int num_planes = av1_num_planes(cm);
 
+  start_stage_timing(pbi, AOM_DECODE_STAGE_TILES);
   if (pbi->max_threads > 1 && !(tiles->large_scale && !pbi->ext_tile_debug) &&
       pbi->row_mt)
     *p_data_end =
@@ -5250,6 +5553,8 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
     *p_data_end = decode_tiles_mt(pbi, data, data_end, start_tile, end_tile);
   else
     *p_data_end = decode_tiles(pbi, data, data_end, start_tile, end_tile);
+  end_stage_timing(pbi, AOM_DECODE_STAGE_TILES);
+  accumulate_decode_stats(pbi);
 
   // If the bit stream is monochrome, set the U and V buffers to a constant.
   if (num_planes < 3) {
@@ -5259,28 +5564,28 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
   if (end_tile != tiles->rows * tiles->cols - 1) {
     return;
   }
+  ++pbi->decode_stats.frames;
 
   av1_alloc_cdef_buffers(cm, &pbi->cdef_worker, &pbi->cdef_sync,
                          pbi->num_workers, 1);
   av1_alloc_cdef_sync(cm, &pbi->cdef_sync, pbi->num_workers);
 
-  if (!cm->features.allow_intrabc && !tiles->single_tile_decoding) {
-    if (cm->lf.filter_level[0] || cm->lf.filter_level[1]) {
+  if (pbi->row_output.active) {
+    // Filters and hands out the rows left.
+    row_output_progress(pbi, cm->mi_params.mi_rows);
+  } else if (!cm->features.allow_intrabc && !tiles->single_tile_decoding) {
+    if (frame_needs_loop_filter(pbi)) {
+      start_stage_timing(pbi, AOM_DECODE_STAGE_LOOP_FILTER);
       av1_loop_filter_frame_mt(&cm->cur_frame->buf, cm, &pbi->dcb.xd, 0,
                                num_planes, 0, pbi->tile_workers,
                                pbi->num_workers, &pbi->lf_row_sync, 0);
+      end_stage_timing(pbi, AOM_DECODE_STAGE_LOOP_FILTER);
     }
 
-    const int do_cdef =
-        !pbi->skip_loop_filter && !cm->features.coded_lossless &&
-        (cm->cdef_info.cdef_bits || cm->cdef_info.cdef_strengths[0] ||
-         cm->cdef_info.cdef_uv_strengths[0]);
+    const int do_cdef = frame_needs_cdef(pbi);
     const int do_superres = av1_superres_scaled(cm);
     const int optimized_loop_restoration = !do_cdef && !do_superres;
-    const int do_loop_restoration =
-        cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
-        cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
-        cm->rst_info[2].frame_restoration_type != RESTORE_NONE;
+    const int do_loop_restoration = frame_needs_loop_restoration(pbi);
     // Frame border extension is not required in the decoder
     // as it happens in extend_mc_border().
     int do_extend_border_mt = 0;
@@ -5290,6 +5595,7 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
                                                  cm, 0);
 
       if (do_cdef) {
+        start_stage_timing(pbi, AOM_DECODE_STAGE_CDEF);
         if (pbi->num_workers > 1) {
           av1_cdef_frame_mt(cm, &pbi->dcb.xd, pbi->cdef_worker,
                             pbi->tile_workers, &pbi->cdef_sync,
@@ -5299,11 +5605,17 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
           av1_cdef_frame(&pbi->common.cur_frame->buf, cm, &pbi->dcb.xd,
                          av1_cdef_init_fb_row);
         }
+        end_stage_timing(pbi, AOM_DECODE_STAGE_CDEF);
       }
 
-      superres_post_decode(pbi);
+      if (do_superres) {
+        start_stage_timing(pbi, AOM_DECODE_STAGE_SUPERRES);
+        superres_post_decode(pbi);
+        end_stage_timing(pbi, AOM_DECODE_STAGE_SUPERRES);
+      }
 
       if (do_loop_restoration) {
+        start_stage_timing(pbi, AOM_DECODE_STAGE_LOOP_RESTORATION);
         av1_loop_restoration_save_boundary_lines(&pbi->common.cur_frame->buf,
                                                  cm, 1);
         if (pbi->num_workers > 1) {
@@ -5316,11 +5628,13 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
                                             cm, optimized_loop_restoration,
                                             &pbi->lr_ctxt);
         }
+        end_stage_timing(pbi, AOM_DECODE_STAGE_LOOP_RESTORATION);
       }
     } else {
       // In no cdef and no superres case. Provide an optimized version of
       // loop_restoration_filter.
       if (do_loop_restoration) {
+        start_stage_timing(pbi, AOM_DECODE_STAGE_LOOP_RESTORATION);
         if (pbi->num_workers > 1) {
           av1_loop_restoration_filter_frame_mt(
               (YV12_BUFFER_CONFIG *)xd->cur_buf, cm, optimized_loop_restoration,
@@ -5331,10 +5645,17 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
                                             cm, optimized_loop_restoration,
                                             &pbi->lr_ctxt);
         }
+        end_stage_timing(pbi, AOM_DECODE_STAGE_LOOP_RESTORATION);
       }
     }
   }
 
+  if (pbi->row_output_cb != NULL && !pbi->row_output.active &&
+      cm->show_frame) {
+    pbi->row_output_cb(pbi->row_output_priv, &cm->cur_frame->buf, 0,
+                       cm->superres_upscaled_height);
+  }
+
   if (!pbi->dcb.corrupted) {
     if (cm->features.refresh_frame_context == REFRESH_FRAME_CONTEXT_BACKWARD) {
       assert(pbi->context_update_tile_id < pbi->allocated_tiles);
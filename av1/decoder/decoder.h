@@ -16,6 +16,7 @@
 
 #include "aom/aom_codec.h"
 #include "aom_dsp/bitreader.h"
+#include "aom_ports/aom_timer.h"
 #include "aom_scale/yv12config.h"
 #include "aom_util/aom_thread.h"
 
@@ -98,6 +99,15 @@ typedef void (*predict_inter_block_visitor_fn_t)(AV1_COMMON *const cm,
 typedef void (*cfl_store_inter_block_visitor_fn_t)(AV1_COMMON *const cm,
                                                    MACROBLOCKD *const xd);
 
+// Coding blocks read by a thread, see aom_decode_stats_t.
+typedef struct DecodeBlockCounts {
+  unsigned int blocks[BLOCK_SIZES_ALL];
+  unsigned int intra_blocks;
+  unsigned int inter_blocks;
+  unsigned int compound_blocks;
+  unsigned int skip_blocks;
+} DecodeBlockCounts;
+
 typedef struct ThreadData {
   DecoderCodingBlock dcb;
 
@@ -129,6 +139,11 @@ typedef struct ThreadData {
   decode_block_visitor_fn_t inverse_tx_inter_block_visit;
   predict_inter_block_visitor_fn_t predict_inter_block_visit;
   cfl_store_inter_block_visitor_fn_t cfl_store_inter_block_visit;
+
+  // Counters added to the decode stats at the end of each tile group.
+  DecodeBlockCounts block_counts;
+  // Time spent waiting on other threads, in microseconds.
+  int64_t idle_us;
 } ThreadData;
 
 typedef struct AV1DecRowMTJobInfo {
@@ -229,6 +244,62 @@ typedef struct AV1DecTileMTData {
   int alloc_tile_cols;
 } AV1DecTileMT;
 
+// Non-conforming decode modes that trade exactness for speed. Each level
+// includes the ones below it.
+enum {
+  FAST_DECODE_OFF,
+  // Skips all the post-filters of frames that are not used as references.
+  FAST_DECODE_SKIP_NONREF_FILTERS,
+  // Also skips CDEF and loop restoration on reference frames.
+  FAST_DECODE_SKIP_CDEF_LR,
+  // Also predicts with 4-tap instead of 8-tap interpolation filters.
+  FAST_DECODE_4TAP_INTERP,
+  // Also predicts with bilinear interpolation.
+  FAST_DECODE_BILINEAR_INTERP,
+  FAST_DECODE_LEVELS
+} UENUM1BYTE(FAST_DECODE_LEVEL);
+
+// Frames left out of the decode, e.g. to seek or to extract thumbnails.
+// Skipped frames are neither reconstructed nor output.
+enum {
+  SKIP_FRAMES_NONE,
+  // Skips the frames that do not refresh any reference buffer.
+  SKIP_FRAMES_NON_REFERENCE,
+  // Skips all the frames but key frames.
+  SKIP_FRAMES_NON_KEY,
+  SKIP_FRAMES_MODES
+} UENUM1BYTE(SKIP_FRAMES_MODE);
+
+// Region of interest outside of which tiles are not decoded.
+typedef struct DecodeRoi {
+  // Region in luma pixels. Whole frames are decoded if it is empty.
+  int x;
+  int y;
+  int width;
+  int height;
+  // Whether the tiles outside the region are skipped in the current frame.
+  int active;
+} DecodeRoi;
+
+// Called as the rows [row_start, row_end) of the frame being decoded become
+// final, in luma pixels.
+typedef void (*av1_row_output_cb)(void *priv, const YV12_BUFFER_CONFIG *buf,
+                                  int row_start, int row_end);
+
+// State of the sub-frame output of the current frame. When active, the loop
+// filter and CDEF run on the rows behind the tile decoding, and the rows are
+// handed to the callback as soon as they are final.
+typedef struct RowOutputState {
+  int active;
+  int do_lf;
+  int do_cdef;
+  // Rows decoded, filtered and handed out so far, in mi units.
+  int decoded_mi_rows;
+  int lf_mi_rows;
+  int cdef_fb_rows;
+  int output_mi_rows;
+} RowOutputState;
+
 typedef struct AV1Decoder {
   DecoderCodingBlock dcb;
 
@@ -337,6 +408,18 @@ typedef struct AV1Decoder {
   int context_update_tile_id;
   int skip_loop_filter;
   int skip_film_grain;
+  FAST_DECODE_LEVEL fast_decode;
+  SKIP_FRAMES_MODE skip_frames;
+  DecodeRoi roi;
+  // Set when the last frame header read belongs to a skipped frame. The tile
+  // groups that follow it are dropped.
+  int frame_skipped;
+  av1_row_output_cb row_output_cb;
+  void *row_output_priv;
+  RowOutputState row_output;
+  // Counters of the current call to aom_codec_decode().
+  aom_decode_stats_t decode_stats;
+  struct aom_usec_timer stage_timer[AOM_DECODE_STAGES];
   int is_annexb;
   int valid_for_referencing[REF_FRAMES];
   int is_fwd_kf_present;
@@ -421,6 +504,16 @@ static INLINE void decrease_ref_count(RefCntBuffer *const buf,
   }
 }
 
+static INLINE void start_stage_timing(AV1Decoder *pbi, int stage) {
+  aom_usec_timer_start(&pbi->stage_timer[stage]);
+}
+
+static INLINE void end_stage_timing(AV1Decoder *pbi, int stage) {
+  aom_usec_timer_mark(&pbi->stage_timer[stage]);
+  pbi->decode_stats.stage_us[stage] +=
+      aom_usec_timer_elapsed(&pbi->stage_timer[stage]);
+}
+
 #define ACCT_STR __func__
 static INLINE int av1_read_uniform(aom_reader *r, int n) {
   const int l = get_unsigned_bits(n);
@@ -11,6 +11,10 @@
 
 #include "av1/decoder/decodetxb.h"
 
+#include <stdlib.h>
+
+#include "config/av1_rtcd.h"
+
 #include "aom_ports/mem.h"
 #include "av1/common/idct.h"
 #include "av1/common/scan.h"
@@ -59,6 +63,26 @@ static INLINE int get_dqv(const int16_t *dequant, int coeff_idx,
   return dqv;
 }
 
+void av1_dequant_txb_c(tran_low_t *coeff, int n_coeffs,
+                       const int16_t *dequant, const qm_val_t *iqmatrix,
+                       int shift, int bd) {
+  const int32_t max_value = (1 << (7 + bd)) - 1;
+  const int32_t min_value = -(1 << (7 + bd));
+  for (int pos = 0; pos < n_coeffs; ++pos) {
+    const tran_low_t qcoeff = coeff[pos];
+    if (!qcoeff) continue;
+    // Bitmasking to clamp dq_coeff to valid range:
+    //   The valid range for 8/10/12 bit video is at most 17/19/21 bit
+    tran_low_t dq_coeff = (tran_low_t)(
+        (int64_t)abs(qcoeff) * get_dqv(dequant, pos, iqmatrix) & 0xffffff);
+    dq_coeff = dq_coeff >> shift;
+    if (qcoeff < 0) {
+      dq_coeff = -dq_coeff;
+    }
+    coeff[pos] = clamp(dq_coeff, min_value, max_value);
+  }
+}
+
 static INLINE void read_coeffs_reverse_2d(aom_reader *r, TX_SIZE tx_size,
                                           int start_si, int end_si,
                                           const int16_t *scan, int bhl,
@@ -114,8 +138,6 @@ uint8_t av1_read_coeffs_txb(const AV1_COMMON *const cm, DecoderCodingBlock *dcb,
                             const TX_SIZE tx_size) {
   MACROBLOCKD *const xd = &dcb->xd;
   FRAME_CONTEXT *const ec_ctx = xd->tile_ctx;
-  const int32_t max_value = (1 << (7 + xd->bd)) - 1;
-  const int32_t min_value = -(1 << (7 + xd->bd));
   const TX_SIZE txs_ctx = get_txsize_entropy_ctx(tx_size);
   const PLANE_TYPE plane_type = get_plane_type(plane);
   MB_MODE_INFO *const mbmi = xd->mi[0];
@@ -277,6 +299,9 @@ uint8_t av1_read_coeffs_txb(const AV1_COMMON *const cm, DecoderCodingBlock *dcb,
     }
   }
 
+  // Signs and Golomb remainders are read in scan order and the signed
+  // quantized levels are stored in place; dequantization then runs as a
+  // single raster-order pass over the coefficients up to max_scan_line.
   for (int c = 0; c < *eob; ++c) {
     const int pos = scan[c];
     uint8_t sign;
@@ -300,19 +325,13 @@ uint8_t av1_read_coeffs_txb(const AV1_COMMON *const cm, DecoderCodingBlock *dcb,
       //   The valid range for 8/10/12 bit vdieo is at most 14/16/18 bit
       level &= 0xfffff;
       cul_level += level;
-      tran_low_t dq_coeff;
-      // Bitmasking to clamp dq_coeff to valid range:
-      //   The valid range for 8/10/12 bit video is at most 17/19/21 bit
-      dq_coeff = (tran_low_t)(
-          (int64_t)level * get_dqv(dequant, scan[c], iqmatrix) & 0xffffff);
-      dq_coeff = dq_coeff >> shift;
-      if (sign) {
-        dq_coeff = -dq_coeff;
-      }
-      tcoeffs[pos] = clamp(dq_coeff, min_value, max_value);
+      tcoeffs[pos] = sign ? -level : level;
     }
   }
 
+  av1_dequant_txb(tcoeffs, *max_scan_line + 1, dequant, iqmatrix, shift,
+                  xd->bd);
+
   cul_level = AOMMIN(COEFF_CONTEXT_MASK, cul_level);
 
   // DC value
@@ -21,6 +21,7 @@
 #include <assert.h>
 #include "aom_dsp/aom_dsp_common.h"
 #include "aom_mem/aom_mem.h"
+#include "aom_util/aom_thread.h"
 #include "av1/decoder/grain_synthesis.h"
 
 // Samples with Gaussian distribution in the range of [-2048, 2047] (12 bits)
@@ -218,11 +219,8 @@ static const int gaussian_sequence[2048] = {
 
 static const int gauss_bits = 11;
 
-static int luma_subblock_size_y = 32;
-static int luma_subblock_size_x = 32;
-
-static int chroma_subblock_size_y = 16;
-static int chroma_subblock_size_x = 16;
+static const int luma_subblock_size_y = 32;
+static const int luma_subblock_size_x = 32;
 
 static const int min_luma_legal_range = 16;
 static const int max_luma_legal_range = 235;
@@ -230,92 +228,131 @@ static const int max_luma_legal_range = 235;
 static const int min_chroma_legal_range = 16;
 static const int max_chroma_legal_range = 240;
 
-static int scaling_lut_y[256];
-static int scaling_lut_cb[256];
-static int scaling_lut_cr[256];
+// Film grain synthesis state for one frame. The grain templates and scaling
+// functions are generated once and are only read while grain is added, so the
+// 32-row luma stripes of a frame can be processed concurrently.
+typedef struct {
+  const aom_film_grain_t *params;
+
+  int scaling_lut_y[256];
+  int scaling_lut_cb[256];
+  int scaling_lut_cr[256];
 
-static int grain_min;
-static int grain_max;
+  int grain_min;
+  int grain_max;
 
-static uint16_t random_register = 0;  // random number generator register
+  int **pred_pos_luma;
+  int **pred_pos_chroma;
+  int *luma_grain_block;
+  int *cb_grain_block;
+  int *cr_grain_block;
+  int luma_grain_stride;
+  int chroma_grain_stride;
+
+  int chroma_subblock_size_y;
+  int chroma_subblock_size_x;
+
+  // Destination planes, which grain is added to in place.
+  uint8_t *luma;
+  uint8_t *cb;
+  uint8_t *cr;
+  int height;
+  int width;
+  int luma_stride;
+  int chroma_stride;
+  int use_high_bit_depth;
+  int chroma_subsamp_y;
+  int chroma_subsamp_x;
+  int mc_identity;
+
+  // If not NULL, each stripe is copied from src into the destination planes
+  // just before grain is added to it.
+  const aom_image_t *src;
+} GrainSynthCtx;
+
+// Overlap buffers and random number generator state private to the thread
+// processing a range of stripes.
+typedef struct {
+  const GrainSynthCtx *ctx;
+  int stripe_start;
+  int stripe_end;
+
+  int *y_line_buf;
+  int *cb_line_buf;
+  int *cr_line_buf;
 
-static void dealloc_arrays(const aom_film_grain_t *params, int ***pred_pos_luma,
-                           int ***pred_pos_chroma, int **luma_grain_block,
-                           int **cb_grain_block, int **cr_grain_block,
-                           int **y_line_buf, int **cb_line_buf,
-                           int **cr_line_buf, int **y_col_buf, int **cb_col_buf,
-                           int **cr_col_buf) {
+  int *y_col_buf;
+  int *cb_col_buf;
+  int *cr_col_buf;
+
+  uint16_t random_register;  // random number generator register
+  int ret;
+} GrainStripeData;
+
+static void dealloc_grain_templates(GrainSynthCtx *ctx) {
+  const aom_film_grain_t *params = ctx->params;
   int num_pos_luma = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
   int num_pos_chroma = num_pos_luma;
   if (params->num_y_points > 0) ++num_pos_chroma;
 
-  if (*pred_pos_luma) {
+  if (ctx->pred_pos_luma) {
     for (int row = 0; row < num_pos_luma; row++) {
-      aom_free((*pred_pos_luma)[row]);
+      aom_free(ctx->pred_pos_luma[row]);
     }
-    aom_free(*pred_pos_luma);
-    *pred_pos_luma = NULL;
+    aom_free(ctx->pred_pos_luma);
+    ctx->pred_pos_luma = NULL;
   }
 
-  if (*pred_pos_chroma) {
+  if (ctx->pred_pos_chroma) {
     for (int row = 0; row < num_pos_chroma; row++) {
-      aom_free((*pred_pos_chroma)[row]);
+      aom_free(ctx->pred_pos_chroma[row]);
     }
-    aom_free(*pred_pos_chroma);
-    *pred_pos_chroma = NULL;
+    aom_free(ctx->pred_pos_chroma);
+    ctx->pred_pos_chroma = NULL;
   }
 
-  aom_free(*y_line_buf);
-  *y_line_buf = NULL;
+  aom_free(ctx->luma_grain_block);
+  ctx->luma_grain_block = NULL;
 
-  aom_free(*cb_line_buf);
-  *cb_line_buf = NULL;
+  aom_free(ctx->cb_grain_block);
+  ctx->cb_grain_block = NULL;
 
-  aom_free(*cr_line_buf);
-  *cr_line_buf = NULL;
+  aom_free(ctx->cr_grain_block);
+  ctx->cr_grain_block = NULL;
+}
 
-  aom_free(*y_col_buf);
-  *y_col_buf = NULL;
+static void dealloc_stripe_bufs(GrainStripeData *sd) {
+  aom_free(sd->y_line_buf);
+  sd->y_line_buf = NULL;
 
-  aom_free(*cb_col_buf);
-  *cb_col_buf = NULL;
+  aom_free(sd->cb_line_buf);
+  sd->cb_line_buf = NULL;
 
-  aom_free(*cr_col_buf);
-  *cr_col_buf = NULL;
+  aom_free(sd->cr_line_buf);
+  sd->cr_line_buf = NULL;
 
-  aom_free(*luma_grain_block);
-  *luma_grain_block = NULL;
+  aom_free(sd->y_col_buf);
+  sd->y_col_buf = NULL;
 
-  aom_free(*cb_grain_block);
-  *cb_grain_block = NULL;
+  aom_free(sd->cb_col_buf);
+  sd->cb_col_buf = NULL;
 
-  aom_free(*cr_grain_block);
-  *cr_grain_block = NULL;
+  aom_free(sd->cr_col_buf);
+  sd->cr_col_buf = NULL;
 }
 
-static bool init_arrays(const aom_film_grain_t *params, int luma_stride,
-                        int chroma_stride, int ***pred_pos_luma_p,
-                        int ***pred_pos_chroma_p, int **luma_grain_block,
-                        int **cb_grain_block, int **cr_grain_block,
-                        int **y_line_buf, int **cb_line_buf, int **cr_line_buf,
-                        int **y_col_buf, int **cb_col_buf, int **cr_col_buf,
-                        int luma_grain_samples, int chroma_grain_samples,
-                        int chroma_subsamp_y, int chroma_subsamp_x) {
-  *pred_pos_luma_p = NULL;
-  *pred_pos_chroma_p = NULL;
-  *luma_grain_block = NULL;
-  *cb_grain_block = NULL;
-  *cr_grain_block = NULL;
-  *y_line_buf = NULL;
-  *cb_line_buf = NULL;
-  *cr_line_buf = NULL;
-  *y_col_buf = NULL;
-  *cb_col_buf = NULL;
-  *cr_col_buf = NULL;
-
-  memset(scaling_lut_y, 0, sizeof(*scaling_lut_y) * 256);
-  memset(scaling_lut_cb, 0, sizeof(*scaling_lut_cb) * 256);
-  memset(scaling_lut_cr, 0, sizeof(*scaling_lut_cr) * 256);
+static bool init_grain_templates(GrainSynthCtx *ctx, int luma_grain_samples,
+                                 int chroma_grain_samples) {
+  const aom_film_grain_t *params = ctx->params;
+  ctx->pred_pos_luma = NULL;
+  ctx->pred_pos_chroma = NULL;
+  ctx->luma_grain_block = NULL;
+  ctx->cb_grain_block = NULL;
+  ctx->cr_grain_block = NULL;
+
+  memset(ctx->scaling_lut_y, 0, sizeof(ctx->scaling_lut_y));
+  memset(ctx->scaling_lut_cb, 0, sizeof(ctx->scaling_lut_cb));
+  memset(ctx->scaling_lut_cr, 0, sizeof(ctx->scaling_lut_cr));
 
   int num_pos_luma = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
   int num_pos_chroma = num_pos_luma;
@@ -326,14 +363,12 @@ static bool init_arrays(const aom_film_grain_t *params, int luma_stride,
 
   pred_pos_luma = (int **)aom_calloc(num_pos_luma, sizeof(*pred_pos_luma));
   if (!pred_pos_luma) return false;
+  ctx->pred_pos_luma = pred_pos_luma;
 
   for (int row = 0; row < num_pos_luma; row++) {
     pred_pos_luma[row] = (int *)aom_malloc(sizeof(**pred_pos_luma) * 3);
     if (!pred_pos_luma[row]) {
-      dealloc_arrays(params, pred_pos_luma_p, pred_pos_chroma_p,
-                     luma_grain_block, cb_grain_block, cr_grain_block,
-                     y_line_buf, cb_line_buf, cr_line_buf, y_col_buf,
-                     cb_col_buf, cr_col_buf);
+      dealloc_grain_templates(ctx);
       return false;
     }
   }
@@ -341,19 +376,15 @@ static bool init_arrays(const aom_film_grain_t *params, int luma_stride,
   pred_pos_chroma =
       (int **)aom_calloc(num_pos_chroma, sizeof(*pred_pos_chroma));
   if (!pred_pos_chroma) {
-    dealloc_arrays(params, pred_pos_luma_p, pred_pos_chroma_p, luma_grain_block,
-                   cb_grain_block, cr_grain_block, y_line_buf, cb_line_buf,
-                   cr_line_buf, y_col_buf, cb_col_buf, cr_col_buf);
+    dealloc_grain_templates(ctx);
     return false;
   }
+  ctx->pred_pos_chroma = pred_pos_chroma;
 
   for (int row = 0; row < num_pos_chroma; row++) {
     pred_pos_chroma[row] = (int *)aom_malloc(sizeof(**pred_pos_chroma) * 3);
     if (!pred_pos_chroma[row]) {
-      dealloc_arrays(params, pred_pos_luma_p, pred_pos_chroma_p,
-                     luma_grain_block, cb_grain_block, cr_grain_block,
-                     y_line_buf, cb_line_buf, cr_line_buf, y_col_buf,
-                     cb_col_buf, cr_col_buf);
+      dealloc_grain_templates(ctx);
       return false;
     }
   }
@@ -392,72 +423,81 @@ static bool init_arrays(const aom_film_grain_t *params, int luma_stride,
     pred_pos_chroma[pos_ar_index][2] = 1;
   }
 
-  *pred_pos_luma_p = pred_pos_luma;
-  *pred_pos_chroma_p = pred_pos_chroma;
-
-  *y_line_buf = (int *)aom_malloc(sizeof(**y_line_buf) * luma_stride * 2);
-  *cb_line_buf = (int *)aom_malloc(sizeof(**cb_line_buf) * chroma_stride *
-                                   (2 >> chroma_subsamp_y));
-  *cr_line_buf = (int *)aom_malloc(sizeof(**cr_line_buf) * chroma_stride *
-                                   (2 >> chroma_subsamp_y));
+  ctx->luma_grain_block =
+      (int *)aom_malloc(sizeof(*ctx->luma_grain_block) * luma_grain_samples);
+  ctx->cb_grain_block =
+      (int *)aom_malloc(sizeof(*ctx->cb_grain_block) * chroma_grain_samples);
+  ctx->cr_grain_block =
+      (int *)aom_malloc(sizeof(*ctx->cr_grain_block) * chroma_grain_samples);
+  if (!(ctx->luma_grain_block && ctx->cb_grain_block && ctx->cr_grain_block)) {
+    dealloc_grain_templates(ctx);
+    return false;
+  }
+  return true;
+}
 
-  *y_col_buf =
-      (int *)aom_malloc(sizeof(**y_col_buf) * (luma_subblock_size_y + 2) * 2);
-  *cb_col_buf =
-      (int *)aom_malloc(sizeof(**cb_col_buf) *
+static bool init_stripe_bufs(GrainStripeData *sd) {
+  const GrainSynthCtx *ctx = sd->ctx;
+  const int chroma_subsamp_y = ctx->chroma_subsamp_y;
+  const int chroma_subsamp_x = ctx->chroma_subsamp_x;
+  const int chroma_subblock_size_y = ctx->chroma_subblock_size_y;
+
+  sd->y_line_buf =
+      (int *)aom_malloc(sizeof(*sd->y_line_buf) * ctx->luma_stride * 2);
+  sd->cb_line_buf = (int *)aom_malloc(
+      sizeof(*sd->cb_line_buf) * ctx->chroma_stride * (2 >> chroma_subsamp_y));
+  sd->cr_line_buf = (int *)aom_malloc(
+      sizeof(*sd->cr_line_buf) * ctx->chroma_stride * (2 >> chroma_subsamp_y));
+
+  sd->y_col_buf = (int *)aom_malloc(sizeof(*sd->y_col_buf) *
+                                    (luma_subblock_size_y + 2) * 2);
+  sd->cb_col_buf =
+      (int *)aom_malloc(sizeof(*sd->cb_col_buf) *
                         (chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
                         (2 >> chroma_subsamp_x));
-  *cr_col_buf =
-      (int *)aom_malloc(sizeof(**cr_col_buf) *
+  sd->cr_col_buf =
+      (int *)aom_malloc(sizeof(*sd->cr_col_buf) *
                         (chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
                         (2 >> chroma_subsamp_x));
-
-  *luma_grain_block =
-      (int *)aom_malloc(sizeof(**luma_grain_block) * luma_grain_samples);
-  *cb_grain_block =
-      (int *)aom_malloc(sizeof(**cb_grain_block) * chroma_grain_samples);
-  *cr_grain_block =
-      (int *)aom_malloc(sizeof(**cr_grain_block) * chroma_grain_samples);
-  if (!(*pred_pos_luma_p && *pred_pos_chroma_p && *y_line_buf && *cb_line_buf &&
-        *cr_line_buf && *y_col_buf && *cb_col_buf && *cr_col_buf &&
-        *luma_grain_block && *cb_grain_block && *cr_grain_block)) {
-    dealloc_arrays(params, pred_pos_luma_p, pred_pos_chroma_p, luma_grain_block,
-                   cb_grain_block, cr_grain_block, y_line_buf, cb_line_buf,
-                   cr_line_buf, y_col_buf, cb_col_buf, cr_col_buf);
+  if (!(sd->y_line_buf && sd->cb_line_buf && sd->cr_line_buf &&
+        sd->y_col_buf && sd->cb_col_buf && sd->cr_col_buf)) {
+    dealloc_stripe_bufs(sd);
     return false;
   }
   return true;
 }
 
 // get a number between 0 and 2^bits - 1
-static INLINE int get_random_number(int bits) {
+static INLINE int get_random_number(uint16_t *random_register, int bits) {
   uint16_t bit;
-  bit = ((random_register >> 0) ^ (random_register >> 1) ^
-         (random_register >> 3) ^ (random_register >> 12)) &
-        1;
-  random_register = (random_register >> 1) | (bit << 15);
-  return (random_register >> (16 - bits)) & ((1 << bits) - 1);
+  uint16_t rr = *random_register;
+  bit = ((rr >> 0) ^ (rr >> 1) ^ (rr >> 3) ^ (rr >> 12)) & 1;
+  rr = (rr >> 1) | (bit << 15);
+  *random_register = rr;
+  return (rr >> (16 - bits)) & ((1 << bits) - 1);
 }
 
-static void init_random_generator(int luma_line, uint16_t seed) {
+static void init_random_generator(uint16_t *random_register, int luma_line,
+                                  uint16_t seed) {
   // same for the picture
 
   uint16_t msb = (seed >> 8) & 255;
   uint16_t lsb = seed & 255;
 
-  random_register = (msb << 8) + lsb;
+  *random_register = (msb << 8) + lsb;
 
   //  changes for each row
   int luma_num = luma_line >> 5;
 
-  random_register ^= ((luma_num * 37 + 178) & 255) << 8;
-  random_register ^= ((luma_num * 173 + 105) & 255);
+  *random_register ^= ((luma_num * 37 + 178) & 255) << 8;
+  *random_register ^= ((luma_num * 173 + 105) & 255);
 }
 
 static void generate_luma_grain_block(
     const aom_film_grain_t *params, int **pred_pos_luma, int *luma_grain_block,
     int luma_block_size_y, int luma_block_size_x, int luma_grain_stride,
-    int left_pad, int top_pad, int right_pad, int bottom_pad) {
+    int left_pad, int top_pad, int right_pad, int bottom_pad,
+    uint16_t *random_register, int grain_min, int grain_max) {
   if (params->num_y_points == 0) {
     memset(luma_grain_block, 0,
            sizeof(*luma_grain_block) * luma_block_size_y * luma_grain_stride);
@@ -473,7 +513,7 @@ static void generate_luma_grain_block(
   for (int i = 0; i < luma_block_size_y; i++)
     for (int j = 0; j < luma_block_size_x; j++)
       luma_grain_block[i * luma_grain_stride + j] =
-          (gaussian_sequence[get_random_number(gauss_bits)] +
+          (gaussian_sequence[get_random_number(random_register, gauss_bits)] +
            ((1 << gauss_sec_shift) >> 1)) >>
           gauss_sec_shift;
 
@@ -498,7 +538,8 @@ static bool generate_chroma_grain_blocks(
     int *luma_grain_block, int *cb_grain_block, int *cr_grain_block,
     int luma_grain_stride, int chroma_block_size_y, int chroma_block_size_x,
     int chroma_grain_stride, int left_pad, int top_pad, int right_pad,
-    int bottom_pad, int chroma_subsamp_y, int chroma_subsamp_x) {
+    int bottom_pad, int chroma_subsamp_y, int chroma_subsamp_x,
+    uint16_t *random_register, int grain_min, int grain_max) {
   int bit_depth = params->bit_depth;
   int gauss_sec_shift = 12 - bit_depth + params->grain_scale_shift;
 
@@ -508,12 +549,12 @@ static bool generate_chroma_grain_blocks(
   int chroma_grain_block_size = chroma_block_size_y * chroma_grain_stride;
 
   if (params->num_cb_points || params->chroma_scaling_from_luma) {
-    init_random_generator(7 << 5, params->random_seed);
+    init_random_generator(random_register, 7 << 5, params->random_seed);
 
     for (int i = 0; i < chroma_block_size_y; i++)
       for (int j = 0; j < chroma_block_size_x; j++)
         cb_grain_block[i * chroma_grain_stride + j] =
-            (gaussian_sequence[get_random_number(gauss_bits)] +
+            (gaussian_sequence[get_random_number(random_register, gauss_bits)] +
              ((1 << gauss_sec_shift) >> 1)) >>
             gauss_sec_shift;
   } else {
@@ -522,12 +563,12 @@ static bool generate_chroma_grain_blocks(
   }
 
   if (params->num_cr_points || params->chroma_scaling_from_luma) {
-    init_random_generator(11 << 5, params->random_seed);
+    init_random_generator(random_register, 11 << 5, params->random_seed);
 
     for (int i = 0; i < chroma_block_size_y; i++)
       for (int j = 0; j < chroma_block_size_x; j++)
         cr_grain_block[i * chroma_grain_stride + j] =
-            (gaussian_sequence[get_random_number(gauss_bits)] +
+            (gaussian_sequence[get_random_number(random_register, gauss_bits)] +
              ((1 << gauss_sec_shift) >> 1)) >>
             gauss_sec_shift;
   } else {
@@ -613,7 +654,7 @@ static void init_scaling_function(const int scaling_points[][2], int num_points,
 
 // function that extracts samples from a LUT (and interpolates intemediate
 // frames for 10- and 12-bit video)
-static int scale_LUT(int *scaling_lut, int index, int bit_depth) {
+static int scale_LUT(const int *scaling_lut, int index, int bit_depth) {
   int x = index >> (bit_depth - 8);
 
   if (!(bit_depth - 8) || x == 255)
@@ -625,7 +666,7 @@ static int scale_LUT(int *scaling_lut, int index, int bit_depth) {
                              (bit_depth - 8));
 }
 
-static void add_noise_to_block(const aom_film_grain_t *params, uint8_t *luma,
+static void add_noise_to_block(const GrainSynthCtx *ctx, uint8_t *luma,
                                uint8_t *cb, uint8_t *cr, int luma_stride,
                                int chroma_stride, int *luma_grain,
                                int *cb_grain, int *cr_grain,
@@ -633,6 +674,7 @@ static void add_noise_to_block(const aom_film_grain_t *params, uint8_t *luma,
                                int half_luma_height, int half_luma_width,
                                int bit_depth, int chroma_subsamp_y,
                                int chroma_subsamp_x, int mc_identity) {
+  const aom_film_grain_t *params = ctx->params;
   int cb_mult = params->cb_mult - 128;            // fixed scale
   int cb_luma_mult = params->cb_luma_mult - 128;  // fixed scale
   int cb_offset = params->cb_offset - 256;
@@ -694,7 +736,7 @@ static void add_noise_to_block(const aom_film_grain_t *params, uint8_t *luma,
       if (apply_cb) {
         cb[i * chroma_stride + j] = clamp(
             cb[i * chroma_stride + j] +
-                ((scale_LUT(scaling_lut_cb,
+                ((scale_LUT(ctx->scaling_lut_cb,
                             clamp(((average_luma * cb_luma_mult +
                                     cb_mult * cb[i * chroma_stride + j]) >>
                                    6) +
@@ -710,7 +752,7 @@ static void add_noise_to_block(const aom_film_grain_t *params, uint8_t *luma,
       if (apply_cr) {
         cr[i * chroma_stride + j] = clamp(
             cr[i * chroma_stride + j] +
-                ((scale_LUT(scaling_lut_cr,
+                ((scale_LUT(ctx->scaling_lut_cr,
                             clamp(((average_luma * cr_luma_mult +
                                     cr_mult * cr[i * chroma_stride + j]) >>
                                    6) +
@@ -730,7 +772,8 @@ static void add_noise_to_block(const aom_film_grain_t *params, uint8_t *luma,
       for (int j = 0; j < (half_luma_width << 1); j++) {
         luma[i * luma_stride + j] =
             clamp(luma[i * luma_stride + j] +
-                      ((scale_LUT(scaling_lut_y, luma[i * luma_stride + j], 8) *
+                      ((scale_LUT(ctx->scaling_lut_y,
+                                  luma[i * luma_stride + j], 8) *
                             luma_grain[i * luma_grain_stride + j] +
                         rounding_offset) >>
                        params->scaling_shift),
@@ -741,11 +784,12 @@ static void add_noise_to_block(const aom_film_grain_t *params, uint8_t *luma,
 }
 
 static void add_noise_to_block_hbd(
-    const aom_film_grain_t *params, uint16_t *luma, uint16_t *cb, uint16_t *cr,
+    const GrainSynthCtx *ctx, uint16_t *luma, uint16_t *cb, uint16_t *cr,
     int luma_stride, int chroma_stride, int *luma_grain, int *cb_grain,
     int *cr_grain, int luma_grain_stride, int chroma_grain_stride,
     int half_luma_height, int half_luma_width, int bit_depth,
     int chroma_subsamp_y, int chroma_subsamp_x, int mc_identity) {
+  const aom_film_grain_t *params = ctx->params;
   int cb_mult = params->cb_mult - 128;            // fixed scale
   int cb_luma_mult = params->cb_luma_mult - 128;  // fixed scale
   // offset value depends on the bit depth
@@ -811,7 +855,7 @@ static void add_noise_to_block_hbd(
       if (apply_cb) {
         cb[i * chroma_stride + j] = clamp(
             cb[i * chroma_stride + j] +
-                ((scale_LUT(scaling_lut_cb,
+                ((scale_LUT(ctx->scaling_lut_cb,
                             clamp(((average_luma * cb_luma_mult +
                                     cb_mult * cb[i * chroma_stride + j]) >>
                                    6) +
@@ -826,7 +870,7 @@ static void add_noise_to_block_hbd(
       if (apply_cr) {
         cr[i * chroma_stride + j] = clamp(
             cr[i * chroma_stride + j] +
-                ((scale_LUT(scaling_lut_cr,
+                ((scale_LUT(ctx->scaling_lut_cr,
                             clamp(((average_luma * cr_luma_mult +
                                     cr_mult * cr[i * chroma_stride + j]) >>
                                    6) +
@@ -846,7 +890,7 @@ static void add_noise_to_block_hbd(
       for (int j = 0; j < (half_luma_width << 1); j++) {
         luma[i * luma_stride + j] =
             clamp(luma[i * luma_stride + j] +
-                      ((scale_LUT(scaling_lut_y, luma[i * luma_stride + j],
+                      ((scale_LUT(ctx->scaling_lut_y, luma[i * luma_stride + j],
                                   bit_depth) *
                             luma_grain[i * luma_grain_stride + j] +
                         rounding_offset) >>
@@ -912,7 +956,7 @@ static void extend_even(uint8_t *dst, int dst_stride, int width, int height,
 static void ver_boundary_overlap(int *left_block, int left_stride,
                                  int *right_block, int right_stride,
                                  int *dst_block, int dst_stride, int width,
-                                 int height) {
+                                 int height, int grain_min, int grain_max) {
   if (width == 1) {
     while (height) {
       *dst_block = clamp((*left_block * 23 + *right_block * 22 + 16) >> 5,
@@ -941,7 +985,7 @@ static void ver_boundary_overlap(int *left_block, int left_stride,
 static void hor_boundary_overlap(int *top_block, int top_stride,
                                  int *bottom_block, int bottom_stride,
                                  int *dst_block, int dst_stride, int width,
-                                 int height) {
+                                 int height, int grain_min, int grain_max) {
   if (height == 1) {
     while (width) {
       *dst_block = clamp((*top_block * 23 + *bottom_block * 22 + 16) >> 5,
@@ -969,210 +1013,99 @@ static void hor_boundary_overlap(int *top_block, int top_stride,
   }
 }
 
-int av1_add_film_grain(const aom_film_grain_t *params, const aom_image_t *src,
-                       aom_image_t *dst) {
-  uint8_t *luma, *cb, *cr;
-  int height, width, luma_stride, chroma_stride;
-  int use_high_bit_depth = 0;
-  int chroma_subsamp_x = 0;
-  int chroma_subsamp_y = 0;
-  int mc_identity = src->mc == AOM_CICP_MC_IDENTITY ? 1 : 0;
-
-  switch (src->fmt) {
-    case AOM_IMG_FMT_AOMI420:
-    case AOM_IMG_FMT_I420:
-      use_high_bit_depth = 0;
-      chroma_subsamp_x = 1;
-      chroma_subsamp_y = 1;
-      break;
-    case AOM_IMG_FMT_I42016:
-      use_high_bit_depth = 1;
-      chroma_subsamp_x = 1;
-      chroma_subsamp_y = 1;
-      break;
-      //    case AOM_IMG_FMT_444A:
-    case AOM_IMG_FMT_I444:
-      use_high_bit_depth = 0;
-      chroma_subsamp_x = 0;
-      chroma_subsamp_y = 0;
-      break;
-    case AOM_IMG_FMT_I44416:
-      use_high_bit_depth = 1;
-      chroma_subsamp_x = 0;
-      chroma_subsamp_y = 0;
-      break;
-    case AOM_IMG_FMT_I422:
-      use_high_bit_depth = 0;
-      chroma_subsamp_x = 1;
-      chroma_subsamp_y = 0;
-      break;
-    case AOM_IMG_FMT_I42216:
-      use_high_bit_depth = 1;
-      chroma_subsamp_x = 1;
-      chroma_subsamp_y = 0;
-      break;
-    default:  // unknown input format
-      fprintf(stderr, "Film grain error: input format is not supported!");
-      return -1;
-  }
-
-  assert(params->bit_depth == src->bit_depth);
-
-  dst->fmt = src->fmt;
-  dst->bit_depth = src->bit_depth;
-
-  dst->r_w = src->r_w;
-  dst->r_h = src->r_h;
-  dst->d_w = src->d_w;
-  dst->d_h = src->d_h;
-
-  dst->cp = src->cp;
-  dst->tc = src->tc;
-  dst->mc = src->mc;
-
-  dst->monochrome = src->monochrome;
-  dst->csp = src->csp;
-  dst->range = src->range;
-
-  dst->x_chroma_shift = src->x_chroma_shift;
-  dst->y_chroma_shift = src->y_chroma_shift;
-
-  dst->temporal_id = src->temporal_id;
-  dst->spatial_id = src->spatial_id;
-
-  width = src->d_w % 2 ? src->d_w + 1 : src->d_w;
-  height = src->d_h % 2 ? src->d_h + 1 : src->d_h;
-
-  copy_rect(src->planes[AOM_PLANE_Y], src->stride[AOM_PLANE_Y],
-            dst->planes[AOM_PLANE_Y], dst->stride[AOM_PLANE_Y], src->d_w,
-            src->d_h, use_high_bit_depth);
+// Copies the rows of the stripe starting at luma row (y << 1) from ctx->src
+// into the destination planes and extends them to even dimensions. Copying
+// each stripe just before grain is added to it keeps the frame copy off the
+// serial path and the rows in cache.
+static void copy_src_stripe(const GrainSynthCtx *ctx, int y) {
+  const aom_image_t *src = ctx->src;
+  const int use_high_bit_depth = ctx->use_high_bit_depth;
+  const int row_start = y << 1;
+  const int row_end = AOMMIN(row_start + luma_subblock_size_y, ctx->height);
+  const int copy_end = AOMMIN(row_end, (int)src->d_h);
+  const int luma_stride = ctx->luma_stride << use_high_bit_depth;
+  uint8_t *luma = ctx->luma + row_start * luma_stride;
+
+  copy_rect(src->planes[AOM_PLANE_Y] + row_start * src->stride[AOM_PLANE_Y],
+            src->stride[AOM_PLANE_Y], luma, luma_stride, src->d_w,
+            copy_end - row_start, use_high_bit_depth);
   // Note that dst is already assumed to be aligned to even.
-  extend_even(dst->planes[AOM_PLANE_Y], dst->stride[AOM_PLANE_Y], src->d_w,
-              src->d_h, use_high_bit_depth);
-
-  if (!src->monochrome) {
-    copy_rect(src->planes[AOM_PLANE_U], src->stride[AOM_PLANE_U],
-              dst->planes[AOM_PLANE_U], dst->stride[AOM_PLANE_U],
-              width >> chroma_subsamp_x, height >> chroma_subsamp_y,
+  extend_even(luma, luma_stride, src->d_w, copy_end - row_start,
               use_high_bit_depth);
 
-    copy_rect(src->planes[AOM_PLANE_V], src->stride[AOM_PLANE_V],
-              dst->planes[AOM_PLANE_V], dst->stride[AOM_PLANE_V],
-              width >> chroma_subsamp_x, height >> chroma_subsamp_y,
-              use_high_bit_depth);
+  if (!src->monochrome) {
+    const int chroma_stride = ctx->chroma_stride << use_high_bit_depth;
+    const int chroma_start = row_start >> ctx->chroma_subsamp_y;
+    const int chroma_rows = (row_end >> ctx->chroma_subsamp_y) - chroma_start;
+    const int chroma_width = ctx->width >> ctx->chroma_subsamp_x;
+
+    for (int plane = AOM_PLANE_U; plane <= AOM_PLANE_V; ++plane) {
+      uint8_t *dst = plane == AOM_PLANE_U ? ctx->cb : ctx->cr;
+      copy_rect(src->planes[plane] + chroma_start * src->stride[plane],
+                src->stride[plane], dst + chroma_start * chroma_stride,
+                chroma_stride, chroma_width, chroma_rows, use_high_bit_depth);
+    }
   }
-
-  luma = dst->planes[AOM_PLANE_Y];
-  cb = dst->planes[AOM_PLANE_U];
-  cr = dst->planes[AOM_PLANE_V];
-
-  // luma and chroma strides in samples
-  luma_stride = dst->stride[AOM_PLANE_Y] >> use_high_bit_depth;
-  chroma_stride = dst->stride[AOM_PLANE_U] >> use_high_bit_depth;
-
-  return av1_add_film_grain_run(
-      params, luma, cb, cr, height, width, luma_stride, chroma_stride,
-      use_high_bit_depth, chroma_subsamp_y, chroma_subsamp_x, mc_identity);
 }
 
-int av1_add_film_grain_run(const aom_film_grain_t *params, uint8_t *luma,
-                           uint8_t *cb, uint8_t *cr, int height, int width,
-                           int luma_stride, int chroma_stride,
-                           int use_high_bit_depth, int chroma_subsamp_y,
-                           int chroma_subsamp_x, int mc_identity) {
-  int **pred_pos_luma;
-  int **pred_pos_chroma;
-  int *luma_grain_block;
-  int *cb_grain_block;
-  int *cr_grain_block;
-
-  int *y_line_buf;
-  int *cb_line_buf;
-  int *cr_line_buf;
-
-  int *y_col_buf;
-  int *cb_col_buf;
-  int *cr_col_buf;
-
-  random_register = params->random_seed;
-
-  int left_pad = 3;
-  int right_pad = 3;  // padding to offset for AR coefficients
-  int top_pad = 3;
-  int bottom_pad = 0;
-
-  int ar_padding = 3;  // maximum lag used for stabilization of AR coefficients
-
-  luma_subblock_size_y = 32;
-  luma_subblock_size_x = 32;
-
-  chroma_subblock_size_y = luma_subblock_size_y >> chroma_subsamp_y;
-  chroma_subblock_size_x = luma_subblock_size_x >> chroma_subsamp_x;
-
-  // Initial padding is only needed for generation of
-  // film grain templates (to stabilize the AR process)
-  // Only a 64x64 luma and 32x32 chroma part of a template
-  // is used later for adding grain, padding can be discarded
-
-  int luma_block_size_y =
-      top_pad + 2 * ar_padding + luma_subblock_size_y * 2 + bottom_pad;
-  int luma_block_size_x = left_pad + 2 * ar_padding + luma_subblock_size_x * 2 +
-                          2 * ar_padding + right_pad;
-
-  int chroma_block_size_y = top_pad + (2 >> chroma_subsamp_y) * ar_padding +
-                            chroma_subblock_size_y * 2 + bottom_pad;
-  int chroma_block_size_x = left_pad + (2 >> chroma_subsamp_x) * ar_padding +
-                            chroma_subblock_size_x * 2 +
-                            (2 >> chroma_subsamp_x) * ar_padding + right_pad;
-
-  int luma_grain_stride = luma_block_size_x;
-  int chroma_grain_stride = chroma_block_size_x;
-
-  int overlap = params->overlap_flag;
-  int bit_depth = params->bit_depth;
-
-  const int grain_center = 128 << (bit_depth - 8);
-  grain_min = 0 - grain_center;
-  grain_max = grain_center - 1;
-
-  if (!init_arrays(params, luma_stride, chroma_stride, &pred_pos_luma,
-                   &pred_pos_chroma, &luma_grain_block, &cb_grain_block,
-                   &cr_grain_block, &y_line_buf, &cb_line_buf, &cr_line_buf,
-                   &y_col_buf, &cb_col_buf, &cr_col_buf,
-                   luma_block_size_y * luma_block_size_x,
-                   chroma_block_size_y * chroma_block_size_x, chroma_subsamp_y,
-                   chroma_subsamp_x))
-    return -1;
-
-  generate_luma_grain_block(params, pred_pos_luma, luma_grain_block,
-                            luma_block_size_y, luma_block_size_x,
-                            luma_grain_stride, left_pad, top_pad, right_pad,
-                            bottom_pad);
-
-  if (!generate_chroma_grain_blocks(
-          params, pred_pos_chroma, luma_grain_block, cb_grain_block,
-          cr_grain_block, luma_grain_stride, chroma_block_size_y,
-          chroma_block_size_x, chroma_grain_stride, left_pad, top_pad,
-          right_pad, bottom_pad, chroma_subsamp_y, chroma_subsamp_x))
-    return -1;
-
-  init_scaling_function(params->scaling_points_y, params->num_y_points,
-                        scaling_lut_y);
-
-  if (params->chroma_scaling_from_luma) {
-    memcpy(scaling_lut_cb, scaling_lut_y, sizeof(*scaling_lut_y) * 256);
-    memcpy(scaling_lut_cr, scaling_lut_y, sizeof(*scaling_lut_y) * 256);
-  } else {
-    init_scaling_function(params->scaling_points_cb, params->num_cb_points,
-                          scaling_lut_cb);
-    init_scaling_function(params->scaling_points_cr, params->num_cr_points,
-                          scaling_lut_cr);
-  }
-  for (int y = 0; y < height / 2; y += (luma_subblock_size_y >> 1)) {
-    init_random_generator(y * 2, params->random_seed);
+// Adds grain to the stripes [sd->stripe_start, sd->stripe_end) of the frame,
+// each of which covers luma_subblock_size_y luma rows.
+static void add_film_grain_stripes(GrainStripeData *sd) {
+  const GrainSynthCtx *ctx = sd->ctx;
+  const aom_film_grain_t *params = ctx->params;
+  uint8_t *luma = ctx->luma;
+  uint8_t *cb = ctx->cb;
+  uint8_t *cr = ctx->cr;
+  const int height = ctx->height;
+  const int width = ctx->width;
+  const int luma_stride = ctx->luma_stride;
+  const int chroma_stride = ctx->chroma_stride;
+  const int use_high_bit_depth = ctx->use_high_bit_depth;
+  const int chroma_subsamp_y = ctx->chroma_subsamp_y;
+  const int chroma_subsamp_x = ctx->chroma_subsamp_x;
+  const int mc_identity = ctx->mc_identity;
+  const int chroma_subblock_size_y = ctx->chroma_subblock_size_y;
+  const int chroma_subblock_size_x = ctx->chroma_subblock_size_x;
+  const int grain_min = ctx->grain_min;
+  const int grain_max = ctx->grain_max;
+
+  int *luma_grain_block = ctx->luma_grain_block;
+  int *cb_grain_block = ctx->cb_grain_block;
+  int *cr_grain_block = ctx->cr_grain_block;
+  const int luma_grain_stride = ctx->luma_grain_stride;
+  const int chroma_grain_stride = ctx->chroma_grain_stride;
+
+  int *y_line_buf = sd->y_line_buf;
+  int *cb_line_buf = sd->cb_line_buf;
+  int *cr_line_buf = sd->cr_line_buf;
+
+  int *y_col_buf = sd->y_col_buf;
+  int *cb_col_buf = sd->cb_col_buf;
+  int *cr_col_buf = sd->cr_col_buf;
+
+  const int left_pad = 3;
+  const int top_pad = 3;
+  const int ar_padding = 3;
+
+  const int overlap = params->overlap_flag;
+  const int bit_depth = params->bit_depth;
+
+  const int stripe_step = luma_subblock_size_y >> 1;
+  const int y_first = sd->stripe_start * stripe_step;
+  const int y_end = AOMMIN(sd->stripe_end * stripe_step, height / 2);
+  // With overlap, the line buffers carry the bottom rows of the previous
+  // stripe's grain into the next one. They only depend on the previous
+  // stripe's random offsets, so a thread starting mid-frame rebuilds them by
+  // replaying that stripe without touching any pixels.
+  const int y_start = (overlap && y_first) ? y_first - stripe_step : y_first;
+
+  for (int y = y_start; y < y_end; y += stripe_step) {
+    const int apply = y >= y_first;
+    if (apply && ctx->src) copy_src_stripe(ctx, y);
+    init_random_generator(&sd->random_register, y * 2, params->random_seed);
 
     for (int x = 0; x < width / 2; x += (luma_subblock_size_x >> 1)) {
-      int offset_y = get_random_number(8);
+      int offset_y = get_random_number(&sd->random_register, 8);
       int offset_x = (offset_y >> 4) & 15;
       offset_y &= 15;
 
@@ -1190,7 +1123,8 @@ int av1_add_film_grain_run(const aom_film_grain_t *params, uint8_t *luma,
             luma_grain_block + luma_offset_y * luma_grain_stride +
                 luma_offset_x,
             luma_grain_stride, y_col_buf, 2, 2,
-            AOMMIN(luma_subblock_size_y + 2, height - (y << 1)));
+            AOMMIN(luma_subblock_size_y + 2, height - (y << 1)), grain_min,
+            grain_max);
 
         ver_boundary_overlap(
             cb_col_buf, 2 >> chroma_subsamp_x,
@@ -1199,7 +1133,8 @@ int av1_add_film_grain_run(const aom_film_grain_t *params, uint8_t *luma,
             chroma_grain_stride, cb_col_buf, 2 >> chroma_subsamp_x,
             2 >> chroma_subsamp_x,
             AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
-                   (height - (y << 1)) >> chroma_subsamp_y));
+                   (height - (y << 1)) >> chroma_subsamp_y),
+            grain_min, grain_max);
 
         ver_boundary_overlap(
             cr_col_buf, 2 >> chroma_subsamp_x,
@@ -1208,58 +1143,66 @@ int av1_add_film_grain_run(const aom_film_grain_t *params, uint8_t *luma,
             chroma_grain_stride, cr_col_buf, 2 >> chroma_subsamp_x,
             2 >> chroma_subsamp_x,
             AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
-                   (height - (y << 1)) >> chroma_subsamp_y));
+                   (height - (y << 1)) >> chroma_subsamp_y),
+            grain_min, grain_max);
 
         int i = y ? 1 : 0;
 
-        if (use_high_bit_depth) {
-          add_noise_to_block_hbd(
-              params,
-              (uint16_t *)luma + ((y + i) << 1) * luma_stride + (x << 1),
-              (uint16_t *)cb +
-                  ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                  (x << (1 - chroma_subsamp_x)),
-              (uint16_t *)cr +
-                  ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                  (x << (1 - chroma_subsamp_x)),
-              luma_stride, chroma_stride, y_col_buf + i * 4,
-              cb_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-              cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-              2, (2 - chroma_subsamp_x),
-              AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i, 1,
-              bit_depth, chroma_subsamp_y, chroma_subsamp_x, mc_identity);
-        } else {
-          add_noise_to_block(
-              params, luma + ((y + i) << 1) * luma_stride + (x << 1),
-              cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                  (x << (1 - chroma_subsamp_x)),
-              cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                  (x << (1 - chroma_subsamp_x)),
-              luma_stride, chroma_stride, y_col_buf + i * 4,
-              cb_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-              cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-              2, (2 - chroma_subsamp_x),
-              AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i, 1,
-              bit_depth, chroma_subsamp_y, chroma_subsamp_x, mc_identity);
+        if (apply) {
+          if (use_high_bit_depth) {
+            add_noise_to_block_hbd(
+                ctx,
+                (uint16_t *)luma + ((y + i) << 1) * luma_stride + (x << 1),
+                (uint16_t *)cb +
+                    ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
+                    (x << (1 - chroma_subsamp_x)),
+                (uint16_t *)cr +
+                    ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
+                    (x << (1 - chroma_subsamp_x)),
+                luma_stride, chroma_stride, y_col_buf + i * 4,
+                cb_col_buf +
+                    i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
+                cr_col_buf +
+                    i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
+                2, (2 - chroma_subsamp_x),
+                AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i, 1,
+                bit_depth, chroma_subsamp_y, chroma_subsamp_x, mc_identity);
+          } else {
+            add_noise_to_block(
+                ctx, luma + ((y + i) << 1) * luma_stride + (x << 1),
+                cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
+                    (x << (1 - chroma_subsamp_x)),
+                cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
+                    (x << (1 - chroma_subsamp_x)),
+                luma_stride, chroma_stride, y_col_buf + i * 4,
+                cb_col_buf +
+                    i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
+                cr_col_buf +
+                    i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
+                2, (2 - chroma_subsamp_x),
+                AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i, 1,
+                bit_depth, chroma_subsamp_y, chroma_subsamp_x, mc_identity);
+          }
         }
       }
 
-      if (overlap && y) {
+      if (overlap && y && apply) {
         if (x) {
           hor_boundary_overlap(y_line_buf + (x << 1), luma_stride, y_col_buf, 2,
-                               y_line_buf + (x << 1), luma_stride, 2, 2);
+                               y_line_buf + (x << 1), luma_stride, 2, 2,
+                               grain_min, grain_max);
 
           hor_boundary_overlap(cb_line_buf + x * (2 >> chroma_subsamp_x),
                                chroma_stride, cb_col_buf, 2 >> chroma_subsamp_x,
                                cb_line_buf + x * (2 >> chroma_subsamp_x),
                                chroma_stride, 2 >> chroma_subsamp_x,
-                               2 >> chroma_subsamp_y);
+                               2 >> chroma_subsamp_y, grain_min, grain_max);
 
           hor_boundary_overlap(cr_line_buf + x * (2 >> chroma_subsamp_x),
                                chroma_stride, cr_col_buf, 2 >> chroma_subsamp_x,
                                cr_line_buf + x * (2 >> chroma_subsamp_x),
                                chroma_stride, 2 >> chroma_subsamp_x,
-                               2 >> chroma_subsamp_y);
+                               2 >> chroma_subsamp_y, grain_min, grain_max);
         }
 
         hor_boundary_overlap(
@@ -1269,7 +1212,7 @@ int av1_add_film_grain_run(const aom_film_grain_t *params, uint8_t *luma,
             luma_grain_stride, y_line_buf + ((x ? x + 1 : 0) << 1), luma_stride,
             AOMMIN(luma_subblock_size_x - ((x ? 1 : 0) << 1),
                    width - ((x ? x + 1 : 0) << 1)),
-            2);
+            2, grain_min, grain_max);
 
         hor_boundary_overlap(
             cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
@@ -1282,7 +1225,7 @@ int av1_add_film_grain_run(const aom_film_grain_t *params, uint8_t *luma,
             AOMMIN(chroma_subblock_size_x -
                        ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
                    (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
-            2 >> chroma_subsamp_y);
+            2 >> chroma_subsamp_y, grain_min, grain_max);
 
         hor_boundary_overlap(
             cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
@@ -1295,11 +1238,11 @@ int av1_add_film_grain_run(const aom_film_grain_t *params, uint8_t *luma,
             AOMMIN(chroma_subblock_size_x -
                        ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
                    (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
-            2 >> chroma_subsamp_y);
+            2 >> chroma_subsamp_y, grain_min, grain_max);
 
         if (use_high_bit_depth) {
           add_noise_to_block_hbd(
-              params, (uint16_t *)luma + (y << 1) * luma_stride + (x << 1),
+              ctx, (uint16_t *)luma + (y << 1) * luma_stride + (x << 1),
               (uint16_t *)cb + (y << (1 - chroma_subsamp_y)) * chroma_stride +
                   (x << ((1 - chroma_subsamp_x))),
               (uint16_t *)cr + (y << (1 - chroma_subsamp_y)) * chroma_stride +
@@ -1312,7 +1255,7 @@ int av1_add_film_grain_run(const aom_film_grain_t *params, uint8_t *luma,
               chroma_subsamp_y, chroma_subsamp_x, mc_identity);
         } else {
           add_noise_to_block(
-              params, luma + (y << 1) * luma_stride + (x << 1),
+              ctx, luma + (y << 1) * luma_stride + (x << 1),
               cb + (y << (1 - chroma_subsamp_y)) * chroma_stride +
                   (x << ((1 - chroma_subsamp_x))),
               cr + (y << (1 - chroma_subsamp_y)) * chroma_stride +
@@ -1326,56 +1269,60 @@ int av1_add_film_grain_run(const aom_film_grain_t *params, uint8_t *luma,
         }
       }
 
-      int i = overlap && y ? 1 : 0;
-      int j = overlap && x ? 1 : 0;
-
-      if (use_high_bit_depth) {
-        add_noise_to_block_hbd(
-            params,
-            (uint16_t *)luma + ((y + i) << 1) * luma_stride + ((x + j) << 1),
-            (uint16_t *)cb +
-                ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                ((x + j) << (1 - chroma_subsamp_x)),
-            (uint16_t *)cr +
-                ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                ((x + j) << (1 - chroma_subsamp_x)),
-            luma_stride, chroma_stride,
-            luma_grain_block + (luma_offset_y + (i << 1)) * luma_grain_stride +
-                luma_offset_x + (j << 1),
-            cb_grain_block +
-                (chroma_offset_y + (i << (1 - chroma_subsamp_y))) *
-                    chroma_grain_stride +
-                chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-            cr_grain_block +
-                (chroma_offset_y + (i << (1 - chroma_subsamp_y))) *
-                    chroma_grain_stride +
-                chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-            luma_grain_stride, chroma_grain_stride,
-            AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-            AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j, bit_depth,
-            chroma_subsamp_y, chroma_subsamp_x, mc_identity);
-      } else {
-        add_noise_to_block(
-            params, luma + ((y + i) << 1) * luma_stride + ((x + j) << 1),
-            cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                ((x + j) << (1 - chroma_subsamp_x)),
-            cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                ((x + j) << (1 - chroma_subsamp_x)),
-            luma_stride, chroma_stride,
-            luma_grain_block + (luma_offset_y + (i << 1)) * luma_grain_stride +
-                luma_offset_x + (j << 1),
-            cb_grain_block +
-                (chroma_offset_y + (i << (1 - chroma_subsamp_y))) *
-                    chroma_grain_stride +
-                chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-            cr_grain_block +
-                (chroma_offset_y + (i << (1 - chroma_subsamp_y))) *
-                    chroma_grain_stride +
-                chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-            luma_grain_stride, chroma_grain_stride,
-            AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-            AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j, bit_depth,
-            chroma_subsamp_y, chroma_subsamp_x, mc_identity);
+      if (apply) {
+        int i = overlap && y ? 1 : 0;
+        int j = overlap && x ? 1 : 0;
+
+        if (use_high_bit_depth) {
+          add_noise_to_block_hbd(
+              ctx,
+              (uint16_t *)luma + ((y + i) << 1) * luma_stride + ((x + j) << 1),
+              (uint16_t *)cb +
+                  ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
+                  ((x + j) << (1 - chroma_subsamp_x)),
+              (uint16_t *)cr +
+                  ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
+                  ((x + j) << (1 - chroma_subsamp_x)),
+              luma_stride, chroma_stride,
+              luma_grain_block +
+                  (luma_offset_y + (i << 1)) * luma_grain_stride +
+                  luma_offset_x + (j << 1),
+              cb_grain_block +
+                  (chroma_offset_y + (i << (1 - chroma_subsamp_y))) *
+                      chroma_grain_stride +
+                  chroma_offset_x + (j << (1 - chroma_subsamp_x)),
+              cr_grain_block +
+                  (chroma_offset_y + (i << (1 - chroma_subsamp_y))) *
+                      chroma_grain_stride +
+                  chroma_offset_x + (j << (1 - chroma_subsamp_x)),
+              luma_grain_stride, chroma_grain_stride,
+              AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
+              AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j, bit_depth,
+              chroma_subsamp_y, chroma_subsamp_x, mc_identity);
+        } else {
+          add_noise_to_block(
+              ctx, luma + ((y + i) << 1) * luma_stride + ((x + j) << 1),
+              cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
+                  ((x + j) << (1 - chroma_subsamp_x)),
+              cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
+                  ((x + j) << (1 - chroma_subsamp_x)),
+              luma_stride, chroma_stride,
+              luma_grain_block +
+                  (luma_offset_y + (i << 1)) * luma_grain_stride +
+                  luma_offset_x + (j << 1),
+              cb_grain_block +
+                  (chroma_offset_y + (i << (1 - chroma_subsamp_y))) *
+                      chroma_grain_stride +
+                  chroma_offset_x + (j << (1 - chroma_subsamp_x)),
+              cr_grain_block +
+                  (chroma_offset_y + (i << (1 - chroma_subsamp_y))) *
+                      chroma_grain_stride +
+                  chroma_offset_x + (j << (1 - chroma_subsamp_x)),
+              luma_grain_stride, chroma_grain_stride,
+              AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
+              AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j, bit_depth,
+              chroma_subsamp_y, chroma_subsamp_x, mc_identity);
+        }
       }
 
       if (overlap) {
@@ -1453,9 +1400,256 @@ int av1_add_film_grain_run(const aom_film_grain_t *params, uint8_t *luma,
       }
     }
   }
+}
+
+static int film_grain_worker_hook(void *arg1, void *unused) {
+  (void)unused;
+  add_film_grain_stripes((GrainStripeData *)arg1);
+  return 1;
+}
+
+// Generates the grain templates and scaling functions for the frame described
+// by ctx, then adds grain to it. The stripes are split into contiguous ranges
+// across up to num_workers workers.
+static int add_film_grain_frame(GrainSynthCtx *ctx, AVxWorker *workers,
+                                int num_workers) {
+  const aom_film_grain_t *params = ctx->params;
+  const int chroma_subsamp_y = ctx->chroma_subsamp_y;
+  const int chroma_subsamp_x = ctx->chroma_subsamp_x;
+  uint16_t random_register = params->random_seed;
+
+  int left_pad = 3;
+  int right_pad = 3;  // padding to offset for AR coefficients
+  int top_pad = 3;
+  int bottom_pad = 0;
+
+  int ar_padding = 3;  // maximum lag used for stabilization of AR coefficients
+
+  ctx->chroma_subblock_size_y = luma_subblock_size_y >> chroma_subsamp_y;
+  ctx->chroma_subblock_size_x = luma_subblock_size_x >> chroma_subsamp_x;
+
+  // Initial padding is only needed for generation of
+  // film grain templates (to stabilize the AR process)
+  // Only a 64x64 luma and 32x32 chroma part of a template
+  // is used later for adding grain, padding can be discarded
+
+  int luma_block_size_y =
+      top_pad + 2 * ar_padding + luma_subblock_size_y * 2 + bottom_pad;
+  int luma_block_size_x = left_pad + 2 * ar_padding + luma_subblock_size_x * 2 +
+                          2 * ar_padding + right_pad;
+
+  int chroma_block_size_y = top_pad + (2 >> chroma_subsamp_y) * ar_padding +
+                            ctx->chroma_subblock_size_y * 2 + bottom_pad;
+  int chroma_block_size_x = left_pad + (2 >> chroma_subsamp_x) * ar_padding +
+                            ctx->chroma_subblock_size_x * 2 +
+                            (2 >> chroma_subsamp_x) * ar_padding + right_pad;
+
+  ctx->luma_grain_stride = luma_block_size_x;
+  ctx->chroma_grain_stride = chroma_block_size_x;
+
+  const int grain_center = 128 << (params->bit_depth - 8);
+  ctx->grain_min = 0 - grain_center;
+  ctx->grain_max = grain_center - 1;
+
+  if (!init_grain_templates(ctx, luma_block_size_y * luma_block_size_x,
+                            chroma_block_size_y * chroma_block_size_x))
+    return -1;
+
+  generate_luma_grain_block(params, ctx->pred_pos_luma, ctx->luma_grain_block,
+                            luma_block_size_y, luma_block_size_x,
+                            ctx->luma_grain_stride, left_pad, top_pad,
+                            right_pad, bottom_pad, &random_register,
+                            ctx->grain_min, ctx->grain_max);
+
+  if (!generate_chroma_grain_blocks(
+          params, ctx->pred_pos_chroma, ctx->luma_grain_block,
+          ctx->cb_grain_block, ctx->cr_grain_block, ctx->luma_grain_stride,
+          chroma_block_size_y, chroma_block_size_x, ctx->chroma_grain_stride,
+          left_pad, top_pad, right_pad, bottom_pad, chroma_subsamp_y,
+          chroma_subsamp_x, &random_register, ctx->grain_min,
+          ctx->grain_max)) {
+    dealloc_grain_templates(ctx);
+    return -1;
+  }
+
+  init_scaling_function(params->scaling_points_y, params->num_y_points,
+                        ctx->scaling_lut_y);
+
+  if (params->chroma_scaling_from_luma) {
+    memcpy(ctx->scaling_lut_cb, ctx->scaling_lut_y,
+           sizeof(ctx->scaling_lut_y));
+    memcpy(ctx->scaling_lut_cr, ctx->scaling_lut_y,
+           sizeof(ctx->scaling_lut_y));
+  } else {
+    init_scaling_function(params->scaling_points_cb, params->num_cb_points,
+                          ctx->scaling_lut_cb);
+    init_scaling_function(params->scaling_points_cr, params->num_cr_points,
+                          ctx->scaling_lut_cr);
+  }
+
+  const int stripe_step = luma_subblock_size_y >> 1;
+  const int num_stripes = (ctx->height / 2 + stripe_step - 1) / stripe_step;
+  const int num_jobs =
+      AOMMAX(1, AOMMIN(workers ? num_workers : 1, num_stripes));
+  GrainStripeData *sd =
+      (GrainStripeData *)aom_calloc(num_jobs, sizeof(*sd));
+  if (!sd) {
+    dealloc_grain_templates(ctx);
+    return -1;
+  }
+
+  int ret = 0;
+  for (int i = 0; i < num_jobs; ++i) {
+    sd[i].ctx = ctx;
+    sd[i].stripe_start = i * num_stripes / num_jobs;
+    sd[i].stripe_end = (i + 1) * num_stripes / num_jobs;
+    if (!init_stripe_bufs(&sd[i])) ret = -1;
+  }
+
+  if (!ret) {
+    if (num_jobs == 1) {
+      add_film_grain_stripes(&sd[0]);
+    } else {
+      const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+      for (int i = num_jobs - 1; i >= 0; --i) {
+        AVxWorker *const worker = &workers[i];
+        worker->hook = film_grain_worker_hook;
+        worker->data1 = &sd[i];
+        worker->data2 = NULL;
+        worker->had_error = 0;
+        if (i == 0) {
+          winterface->execute(worker);
+        } else {
+          winterface->launch(worker);
+        }
+      }
+      for (int i = num_jobs - 1; i >= 0; --i) {
+        if (!winterface->sync(&workers[i])) ret = -1;
+      }
+    }
+  }
+
+  for (int i = 0; i < num_jobs; ++i) dealloc_stripe_bufs(&sd[i]);
+  aom_free(sd);
+  dealloc_grain_templates(ctx);
+  return ret;
+}
+
+int av1_add_film_grain_mt(const aom_film_grain_t *params,
+                          const aom_image_t *src, aom_image_t *dst,
+                          AVxWorker *workers, int num_workers) {
+  GrainSynthCtx ctx;
+  int use_high_bit_depth = 0;
+  int chroma_subsamp_x = 0;
+  int chroma_subsamp_y = 0;
+
+  switch (src->fmt) {
+    case AOM_IMG_FMT_AOMI420:
+    case AOM_IMG_FMT_I420:
+      use_high_bit_depth = 0;
+      chroma_subsamp_x = 1;
+      chroma_subsamp_y = 1;
+      break;
+    case AOM_IMG_FMT_I42016:
+      use_high_bit_depth = 1;
+      chroma_subsamp_x = 1;
+      chroma_subsamp_y = 1;
+      break;
+      //    case AOM_IMG_FMT_444A:
+    case AOM_IMG_FMT_I444:
+      use_high_bit_depth = 0;
+      chroma_subsamp_x = 0;
+      chroma_subsamp_y = 0;
+      break;
+    case AOM_IMG_FMT_I44416:
+      use_high_bit_depth = 1;
+      chroma_subsamp_x = 0;
+      chroma_subsamp_y = 0;
+      break;
+    case AOM_IMG_FMT_I422:
+      use_high_bit_depth = 0;
+      chroma_subsamp_x = 1;
+      chroma_subsamp_y = 0;
+      break;
+    case AOM_IMG_FMT_I42216:
+      use_high_bit_depth = 1;
+      chroma_subsamp_x = 1;
+      chroma_subsamp_y = 0;
+      break;
+    default:  // unknown input format
+      fprintf(stderr, "Film grain error: input format is not supported!");
+      return -1;
+  }
+
+  assert(params->bit_depth == src->bit_depth);
+
+  dst->fmt = src->fmt;
+  dst->bit_depth = src->bit_depth;
+
+  dst->r_w = src->r_w;
+  dst->r_h = src->r_h;
+  dst->d_w = src->d_w;
+  dst->d_h = src->d_h;
 
-  dealloc_arrays(params, &pred_pos_luma, &pred_pos_chroma, &luma_grain_block,
-                 &cb_grain_block, &cr_grain_block, &y_line_buf, &cb_line_buf,
-                 &cr_line_buf, &y_col_buf, &cb_col_buf, &cr_col_buf);
-  return 0;
+  dst->cp = src->cp;
+  dst->tc = src->tc;
+  dst->mc = src->mc;
+
+  dst->monochrome = src->monochrome;
+  dst->csp = src->csp;
+  dst->range = src->range;
+
+  dst->x_chroma_shift = src->x_chroma_shift;
+  dst->y_chroma_shift = src->y_chroma_shift;
+
+  dst->temporal_id = src->temporal_id;
+  dst->spatial_id = src->spatial_id;
+
+  memset(&ctx, 0, sizeof(ctx));
+  ctx.params = params;
+  ctx.src = src;
+  ctx.width = src->d_w % 2 ? src->d_w + 1 : src->d_w;
+  ctx.height = src->d_h % 2 ? src->d_h + 1 : src->d_h;
+
+  ctx.luma = dst->planes[AOM_PLANE_Y];
+  ctx.cb = dst->planes[AOM_PLANE_U];
+  ctx.cr = dst->planes[AOM_PLANE_V];
+
+  // luma and chroma strides in samples
+  ctx.luma_stride = dst->stride[AOM_PLANE_Y] >> use_high_bit_depth;
+  ctx.chroma_stride = dst->stride[AOM_PLANE_U] >> use_high_bit_depth;
+
+  ctx.use_high_bit_depth = use_high_bit_depth;
+  ctx.chroma_subsamp_y = chroma_subsamp_y;
+  ctx.chroma_subsamp_x = chroma_subsamp_x;
+  ctx.mc_identity = src->mc == AOM_CICP_MC_IDENTITY ? 1 : 0;
+
+  return add_film_grain_frame(&ctx, workers, num_workers);
+}
+
+int av1_add_film_grain(const aom_film_grain_t *params, const aom_image_t *src,
+                       aom_image_t *dst) {
+  return av1_add_film_grain_mt(params, src, dst, NULL, 0);
+}
+
+int av1_add_film_grain_run(const aom_film_grain_t *params, uint8_t *luma,
+                           uint8_t *cb, uint8_t *cr, int height, int width,
+                           int luma_stride, int chroma_stride,
+                           int use_high_bit_depth, int chroma_subsamp_y,
+                           int chroma_subsamp_x, int mc_identity) {
+  GrainSynthCtx ctx;
+  memset(&ctx, 0, sizeof(ctx));
+  ctx.params = params;
+  ctx.luma = luma;
+  ctx.cb = cb;
+  ctx.cr = cr;
+  ctx.height = height;
+  ctx.width = width;
+  ctx.luma_stride = luma_stride;
+  ctx.chroma_stride = chroma_stride;
+  ctx.use_high_bit_depth = use_high_bit_depth;
+  ctx.chroma_subsamp_y = chroma_subsamp_y;
+  ctx.chroma_subsamp_x = chroma_subsamp_x;
+  ctx.mc_identity = mc_identity;
+  return add_film_grain_frame(&ctx, NULL, 0);
 }
@@ -24,6 +24,7 @@ extern "C" {
 
 #include "aom_dsp/grain_params.h"
 #include "aom/aom_image.h"
+#include "aom_util/aom_thread.h"
 
 /*!\brief Add film grain
  *
@@ -59,6 +60,26 @@ int av1_add_film_grain_run(const aom_film_grain_t *grain_params, uint8_t *luma,
 int av1_add_film_grain(const aom_film_grain_t *grain_params,
                        const aom_image_t *src, aom_image_t *dst);
 
+/*!\brief Add film grain using a pool of workers
+ *
+ * Same as av1_add_film_grain(), but the 32-row luma stripes of the image are
+ * split into contiguous ranges processed concurrently by up to num_workers
+ * workers. Each stripe is copied from src just before grain is added to it,
+ * so dst may be any image of the same format with even-aligned dimensions,
+ * including one provided by the application.
+ *
+ * Returns 0 for success, -1 for failure
+ *
+ * \param[in]    grain_params     Grain parameters
+ * \param[in]    src              Source image
+ * \param[out]   dst              Resulting image with grain
+ * \param[in]    workers          Workers, or NULL to run on the calling thread
+ * \param[in]    num_workers      Number of workers
+ */
+int av1_add_film_grain_mt(const aom_film_grain_t *grain_params,
+                          const aom_image_t *src, aom_image_t *dst,
+                          AVxWorker *workers, int num_workers);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
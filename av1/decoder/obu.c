@@ -929,6 +929,7 @@ int aom_decode_frame_from_obus(struct AV1Decoder *pbi, const uint8_t *data,
     switch (obu_header.type) {
       case OBU_TEMPORAL_DELIMITER:
         decoded_payload_size = read_temporal_delimiter_obu();
+        pbi->frame_skipped = 0;
         if (pbi->seen_frame_header) {
           // A new temporal unit has started, but the frame in the previous
           // temporal unit is incomplete.
@@ -949,6 +950,10 @@ int aom_decode_frame_from_obus(struct AV1Decoder *pbi, const uint8_t *data,
       case OBU_REDUNDANT_FRAME_HEADER:
       case OBU_FRAME:
         if (obu_header.type == OBU_REDUNDANT_FRAME_HEADER) {
+          if (pbi->frame_skipped) {
+            decoded_payload_size = payload_size;
+            break;
+          }
           if (!pbi->seen_frame_header) {
             pbi->error.error_code = AOM_CODEC_CORRUPT_FRAME;
             return -1;
@@ -981,6 +986,16 @@ int aom_decode_frame_from_obus(struct AV1Decoder *pbi, const uint8_t *data,
           rb.bit_offset = 8 * frame_header_size;
         }
 
+        if (pbi->frame_skipped) {
+          // Drop the rest of the frame. Its tile groups are dropped as they
+          // come, as it is not known how many there are.
+          frame_decoding_finished = 1;
+          pbi->seen_frame_header = 0;
+          decoded_payload_size = payload_size;
+          *p_data_end = data + payload_size;
+          break;
+        }
+
         decoded_payload_size = frame_header_size;
         pbi->frame_header_size = frame_header_size;
         cm->cur_frame->temporal_id = obu_header.temporal_layer_id;
@@ -1019,6 +1034,10 @@ int aom_decode_frame_from_obus(struct AV1Decoder *pbi, const uint8_t *data,
         if (byte_alignment(cm, &rb)) return -1;
         AOM_FALLTHROUGH_INTENDED;  // fall through to read tile group.
       case OBU_TILE_GROUP:
+        if (pbi->frame_skipped) {
+          decoded_payload_size = payload_size;
+          break;
+        }
         if (!pbi->seen_frame_header) {
           pbi->error.error_code = AOM_CODEC_CORRUPT_FRAME;
           return -1;
@@ -1097,5 +1116,5 @@ int aom_decode_frame_from_obus(struct AV1Decoder *pbi, const uint8_t *data,
   }
 
   if (pbi->error.error_code != AOM_CODEC_OK) return -1;
-  return frame_decoding_finished;
+  return frame_decoding_finished && !pbi->frame_skipped;
 }
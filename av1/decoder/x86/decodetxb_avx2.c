@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <immintrin.h> /* AVX2 */
+
+#include "config/av1_rtcd.h"
+
+#include "aom/aom_integer.h"
+#include "aom_dsp/x86/synonyms.h"
+#include "aom_dsp/x86/synonyms_avx2.h"
+#include "av1/common/quant_common.h"
+
+// Processes coefficients in groups of 8. The caller guarantees that the
+// coefficient buffer is zero past n_coeffs up to the end of the transform
+// block, whose size is always a multiple of 16.
+void av1_dequant_txb_avx2(tran_low_t *coeff, int n_coeffs,
+                          const int16_t *dequant, const qm_val_t *iqmatrix,
+                          int shift, int bd) {
+  const __m256i max_value = _mm256_set1_epi32((1 << (7 + bd)) - 1);
+  const __m256i min_value = _mm256_set1_epi32(-(1 << (7 + bd)));
+  const __m256i mask = _mm256_set1_epi32(0xffffff);
+  const __m256i qm_round = _mm256_set1_epi32(1 << (AOM_QM_BITS - 1));
+  const __m128i shift_v = _mm_cvtsi32_si128(shift);
+  const __m256i dqv_ac = _mm256_set1_epi32(dequant[1]);
+  __m256i dqv = _mm256_setr_epi32(dequant[0], dequant[1], dequant[1],
+                                  dequant[1], dequant[1], dequant[1],
+                                  dequant[1], dequant[1]);
+
+  for (int i = 0; i < n_coeffs; i += 8) {
+    const __m256i qcoeff = yy_loadu_256(coeff + i);
+    __m256i d = dqv;
+    if (iqmatrix != NULL) {
+      const __m256i wt = _mm256_cvtepu8_epi32(xx_loadl_64(iqmatrix + i));
+      d = _mm256_srai_epi32(
+          _mm256_add_epi32(_mm256_mullo_epi32(wt, d), qm_round), AOM_QM_BITS);
+    }
+    // Only the low 24 bits of the product are kept, so a 32-bit multiply is
+    // exact here.
+    __m256i dq = _mm256_and_si256(
+        _mm256_mullo_epi32(_mm256_abs_epi32(qcoeff), d), mask);
+    dq = _mm256_sra_epi32(dq, shift_v);
+    // Restores the sign and leaves zero coefficients untouched.
+    dq = _mm256_sign_epi32(dq, qcoeff);
+    dq = _mm256_min_epi32(_mm256_max_epi32(dq, min_value), max_value);
+    yy_storeu_256(coeff + i, dq);
+    dqv = dqv_ac;
+  }
+}
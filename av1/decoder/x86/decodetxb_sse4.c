@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <emmintrin.h>  // SSE2
+#include <smmintrin.h>  /* SSE4.1 */
+
+#include "config/av1_rtcd.h"
+
+#include "aom/aom_integer.h"
+#include "aom_dsp/x86/mem_sse2.h"
+#include "aom_dsp/x86/synonyms.h"
+#include "av1/common/quant_common.h"
+
+// Processes coefficients in groups of 4. The caller guarantees that the
+// coefficient buffer is zero past n_coeffs up to the end of the transform
+// block, whose size is always a multiple of 16.
+void av1_dequant_txb_sse4_1(tran_low_t *coeff, int n_coeffs,
+                            const int16_t *dequant, const qm_val_t *iqmatrix,
+                            int shift, int bd) {
+  const __m128i max_value = _mm_set1_epi32((1 << (7 + bd)) - 1);
+  const __m128i min_value = _mm_set1_epi32(-(1 << (7 + bd)));
+  const __m128i mask = _mm_set1_epi32(0xffffff);
+  const __m128i qm_round = _mm_set1_epi32(1 << (AOM_QM_BITS - 1));
+  const __m128i shift_v = _mm_cvtsi32_si128(shift);
+  const __m128i dqv_ac = _mm_set1_epi32(dequant[1]);
+  __m128i dqv = _mm_setr_epi32(dequant[0], dequant[1], dequant[1], dequant[1]);
+
+  for (int i = 0; i < n_coeffs; i += 4) {
+    const __m128i qcoeff = xx_loadu_128(coeff + i);
+    __m128i d = dqv;
+    if (iqmatrix != NULL) {
+      const __m128i wt =
+          _mm_cvtepu8_epi32(_mm_cvtsi32_si128(loadu_int32(iqmatrix + i)));
+      d = _mm_srai_epi32(_mm_add_epi32(_mm_mullo_epi32(wt, d), qm_round),
+                         AOM_QM_BITS);
+    }
+    // Only the low 24 bits of the product are kept, so a 32-bit multiply is
+    // exact here.
+    __m128i dq = _mm_and_si128(_mm_mullo_epi32(_mm_abs_epi32(qcoeff), d), mask);
+    dq = _mm_sra_epi32(dq, shift_v);
+    // Restores the sign and leaves zero coefficients untouched.
+    dq = _mm_sign_epi32(dq, qcoeff);
+    dq = _mm_min_epi32(_mm_max_epi32(dq, min_value), max_value);
+    xx_storeu_128(coeff + i, dq);
+    dqv = dqv_ac;
+  }
+}
@@ -14,6 +14,7 @@
 #include <arm_neon.h>
 
 #include "config/av1_rtcd.h"
+#include "aom_dsp/arm/sum_neon.h"
 #include "av1/encoder/ml.h"
 
 static void nn_activate8(float32x4_t *out_h, float32x4_t *out_l,
@@ -336,3 +337,21 @@ void av1_nn_predict_neon(const float *input_nodes,
   }
   if (reduce_prec) av1_nn_output_prec_reduce(output, nn_config->num_outputs);
 }
+
+void av1_nn_matvec_int16_neon(const int16_t *input, const int16_t *weights,
+                              int num_inputs, int num_outputs,
+                              int32_t *output) {
+  assert(num_inputs % NN_QUANT_ALIGN == 0);
+  for (int node = 0; node < num_outputs; ++node) {
+    int32x4_t sum0 = vdupq_n_s32(0);
+    int32x4_t sum1 = vdupq_n_s32(0);
+    for (int i = 0; i < num_inputs; i += 8) {
+      const int16x8_t in = vld1q_s16(input + i);
+      const int16x8_t w = vld1q_s16(weights + i);
+      sum0 = vmlal_s16(sum0, vget_low_s16(in), vget_low_s16(w));
+      sum1 = vmlal_s16(sum1, vget_high_s16(in), vget_high_s16(w));
+    }
+    output[node] = horizontal_add_s32x4(vaddq_s32(sum0, sum1));
+    weights += num_inputs;
+  }
+}
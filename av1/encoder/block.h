@@ -941,6 +941,8 @@ typedef struct macroblock {
   CompoundTypeRdBuffers comp_rd_buffer;
   //! Buffer to store convolution during averaging process in compound mode.
   CONV_BUF_TYPE *tmp_conv_dst;
+  //! Cache of luma inter predictions, reused within a superblock.
+  struct InterPredCache *inter_pred_cache;
 
   /*! \brief Temporary buffer to hold prediction.
    *
@@ -1072,6 +1074,11 @@ typedef struct macroblock {
    */
   int force_zeromv_skip_for_blk;
 
+  /*!\brief Flag to reuse the partition and modes of the last frame for the
+   * current superblock, for nonrd path.
+   */
+  int reuse_sb_decisions;
+
   /*! \brief Previous segment id for which qmatrices were updated.
    * This is used to bypass setting of qmatrices if no change in qindex.
    */
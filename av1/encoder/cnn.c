@@ -16,9 +16,13 @@
 #include "aom_dsp/aom_dsp_common.h"
 #include "av1/common/av1_common_int.h"
 #include "av1/encoder/cnn.h"
+#include "av1/encoder/ml.h"
 
 #define CLAMPINDEX(a, hi) ((a) < 0 ? 0 : ((a) >= (hi) ? ((hi)-1) : (a)))
 
+// Largest number of weights per output channel of the quantized path.
+#define CNN_QUANT_MAX_KERNEL 1024
+
 typedef struct {
   const float **input;
   int in_width;
@@ -1193,3 +1197,221 @@ bool av1_cnn_predict_img_multi_out_highbd(uint16_t **dgd, int width, int height,
   aom_free(input_);
   return success;
 }
+
+static bool is_quantizable_layer(const CNN_LAYER_CONFIG *layer_config) {
+  return !layer_config->deconvolve && !layer_config->maxpool &&
+         layer_config->pad == PADDING_VALID && layer_config->branch == 0 &&
+         layer_config->branch_copy_type == BRANCH_NO_COPY &&
+         layer_config->branch_combine_type == BRANCH_NOC &&
+         !layer_config->bn_params.bn_gamma &&
+         (layer_config->activation == NONE ||
+          layer_config->activation == RELU);
+}
+
+void av1_cnn_free_quant_config(CNN_QUANT_CONFIG *quant) {
+  for (int layer = 0; layer < CNN_MAX_LAYERS; ++layer) {
+    aom_free(quant->layer[layer].weights);
+    aom_free(quant->layer[layer].weight_scale);
+  }
+  memset(quant, 0, sizeof(*quant));
+}
+
+bool av1_cnn_quantize_config(const CNN_CONFIG *cnn_config,
+                             CNN_QUANT_CONFIG *quant) {
+  memset(quant, 0, sizeof(*quant));
+  if (cnn_config->is_residue || cnn_config->ext_width ||
+      cnn_config->ext_height || cnn_config->num_layers > CNN_MAX_LAYERS) {
+    return false;
+  }
+  float channel_weights[CNN_QUANT_MAX_KERNEL];
+  for (int layer = 0; layer < cnn_config->num_layers; ++layer) {
+    const CNN_LAYER_CONFIG *const layer_config =
+        &cnn_config->layer_config[layer];
+    const int in_channels = layer_config->in_channels;
+    const int out_channels = layer_config->out_channels;
+    const int filter_width = layer_config->filter_width;
+    const int filter_height = layer_config->filter_height;
+    const int num_weights = in_channels * filter_height * filter_width;
+    const int kernel_size =
+        (num_weights + NN_QUANT_ALIGN - 1) & ~(NN_QUANT_ALIGN - 1);
+    if (!is_quantizable_layer(layer_config) ||
+        kernel_size > CNN_QUANT_MAX_KERNEL ||
+        out_channels > CNN_MAX_CHANNELS ||
+        (layer > 0 &&
+         in_channels != cnn_config->layer_config[layer - 1].out_channels)) {
+      av1_cnn_free_quant_config(quant);
+      return false;
+    }
+    CNN_QUANT_LAYER *const quant_layer = &quant->layer[layer];
+    quant_layer->kernel_size = kernel_size;
+    quant_layer->act_max = av1_nn_quant_act_max(kernel_size);
+    quant_layer->weights = (int16_t *)aom_calloc(
+        (size_t)out_channels * kernel_size, sizeof(*quant_layer->weights));
+    quant_layer->weight_scale = (float *)aom_malloc(
+        out_channels * sizeof(*quant_layer->weight_scale));
+    if (!quant_layer->weights || !quant_layer->weight_scale) {
+      av1_cnn_free_quant_config(quant);
+      return false;
+    }
+    // The float weights are laid out as [row][column][in][out]. Gather each
+    // output channel in the order the input patches are read in.
+    for (int i = 0; i < out_channels; ++i) {
+      int idx = 0;
+      for (int k = 0; k < in_channels; ++k) {
+        for (int ii = 0; ii < filter_height; ++ii) {
+          for (int jj = 0; jj < filter_width; ++jj) {
+            const int off = (ii * filter_width + jj) * in_channels + k;
+            channel_weights[idx++] =
+                layer_config->weights[off * out_channels + i];
+          }
+        }
+      }
+      quant_layer->weight_scale[i] = av1_nn_quantize_weights(
+          channel_weights, num_weights,
+          quant_layer->weights + (size_t)i * kernel_size);
+    }
+  }
+  quant->cnn_config = cnn_config;
+  return true;
+}
+
+// Valid-padded convolution of the quantized input tensor, with the bias and
+// the activation applied to the float output.
+static void cnn_convolve_quant(const int16_t *input, int in_width,
+                               int in_height, float in_scale,
+                               const CNN_LAYER_CONFIG *layer_config,
+                               const CNN_QUANT_LAYER *quant_layer,
+                               float *output, int out_width, int out_height) {
+  DECLARE_ALIGNED(32, int16_t, patch[CNN_QUANT_MAX_KERNEL]);
+  int32_t acc[CNN_MAX_CHANNELS];
+  const int in_channels = layer_config->in_channels;
+  const int out_channels = layer_config->out_channels;
+  const int filter_width = layer_config->filter_width;
+  const int filter_height = layer_config->filter_height;
+  const int kernel_size = quant_layer->kernel_size;
+  const int in_plane = in_width * in_height;
+  const int out_plane = out_width * out_height;
+  const int relu = layer_config->activation == RELU;
+  float scale[CNN_MAX_CHANNELS];
+  for (int i = 0; i < out_channels; ++i)
+    scale[i] = in_scale * quant_layer->weight_scale[i];
+  memset(patch, 0, kernel_size * sizeof(*patch));
+
+  for (int u = 0; u < out_height; ++u) {
+    const int h = u * layer_config->skip_height;
+    for (int v = 0; v < out_width; ++v) {
+      const int w = v * layer_config->skip_width;
+      int idx = 0;
+      for (int k = 0; k < in_channels; ++k) {
+        const int16_t *src = input + k * in_plane + h * in_width + w;
+        for (int ii = 0; ii < filter_height; ++ii, src += in_width) {
+          for (int jj = 0; jj < filter_width; ++jj) patch[idx++] = src[jj];
+        }
+      }
+      av1_nn_matvec_int16(patch, quant_layer->weights, kernel_size,
+                          out_channels, acc);
+      float *const out = output + u * out_width + v;
+      for (int i = 0; i < out_channels; ++i) {
+        const float val = acc[i] * scale[i] + layer_config->bias[i];
+        out[i * out_plane] = (relu && val < 0.0f) ? 0.0f : val;
+      }
+    }
+  }
+}
+
+bool av1_cnn_predict_img_multi_out_quant(uint8_t **dgd, int width, int height,
+                                         int stride, int use_highbitdepth,
+                                         int bit_depth,
+                                         const CNN_QUANT_CONFIG *quant,
+                                         CNN_MULTI_OUT *output_struct) {
+  const CNN_CONFIG *const cnn_config = quant->cnn_config;
+  const int in_channels = cnn_config->layer_config[0].in_channels;
+
+  // Size the buffers for the largest tensor of the network.
+  size_t max_in_size = (size_t)in_channels * width * height;
+  size_t max_out_size = 0;
+  int in_width = width, in_height = height;
+  for (int layer = 0; layer < cnn_config->num_layers; ++layer) {
+    const CNN_LAYER_CONFIG *const layer_config =
+        &cnn_config->layer_config[layer];
+    int out_width, out_height;
+    av1_find_cnn_layer_output_size(in_width, in_height, layer_config,
+                                   &out_width, &out_height);
+    const size_t size =
+        (size_t)layer_config->out_channels * out_width * out_height;
+    max_in_size = AOMMAX(max_in_size, size);
+    max_out_size = AOMMAX(max_out_size, size);
+    in_width = out_width;
+    in_height = out_height;
+  }
+  int16_t *const input = (int16_t *)aom_malloc(max_in_size * sizeof(*input));
+  float *const conv_out = (float *)aom_malloc(max_out_size * sizeof(*conv_out));
+  if (!input || !conv_out) {
+    aom_free(input);
+    aom_free(conv_out);
+    return false;
+  }
+
+  // The first layer takes the pixels, shifted down only if the accumulators
+  // could overflow otherwise.
+  const int max_val = (1 << (use_highbitdepth ? bit_depth : 8)) - 1;
+  int in_shift = 0;
+  while ((max_val >> in_shift) > quant->layer[0].act_max) ++in_shift;
+  for (int c = 0; c < in_channels; ++c) {
+    int16_t *const dst = input + c * width * height;
+    for (int i = 0; i < height; ++i) {
+      if (use_highbitdepth) {
+        const uint16_t *const src = CONVERT_TO_SHORTPTR(dgd[c]) + i * stride;
+        for (int j = 0; j < width; ++j)
+          dst[i * width + j] = (int16_t)(src[j] >> in_shift);
+      } else {
+        const uint8_t *const src = dgd[c] + i * stride;
+        for (int j = 0; j < width; ++j) dst[i * width + j] = src[j];
+      }
+    }
+  }
+  float in_scale = (float)(1 << in_shift) / max_val;
+
+  float **output[CNN_MAX_BRANCHES];
+  const int *out_chs = output_struct->output_channels;
+  output[0] = output_struct->output_buffer;
+  for (int out_idx = 1; out_idx < output_struct->num_outputs; out_idx++) {
+    output[out_idx] = output[out_idx - 1] + out_chs[out_idx - 1];
+  }
+
+  in_width = width;
+  in_height = height;
+  for (int layer = 0; layer < cnn_config->num_layers; ++layer) {
+    const CNN_LAYER_CONFIG *const layer_config =
+        &cnn_config->layer_config[layer];
+    int out_width, out_height;
+    av1_find_cnn_layer_output_size(in_width, in_height, layer_config,
+                                   &out_width, &out_height);
+    cnn_convolve_quant(input, in_width, in_height, in_scale, layer_config,
+                       &quant->layer[layer], conv_out, out_width, out_height);
+
+    const int out_plane = out_width * out_height;
+    const int output_num = layer_config->output_num;
+    if (output_num != -1) {
+      const int out_stride = output_struct->output_strides[output_num];
+      for (int c = 0; c < layer_config->out_channels; ++c) {
+        for (int i = 0; i < out_height; ++i) {
+          memcpy(&output[output_num][c][i * out_stride],
+                 &conv_out[c * out_plane + i * out_width],
+                 out_width * sizeof(*conv_out));
+        }
+      }
+    }
+    if (layer + 1 < cnn_config->num_layers) {
+      in_scale = av1_nn_quantize_activations(
+          conv_out, layer_config->out_channels * out_plane,
+          quant->layer[layer + 1].act_max, input);
+    }
+    in_width = out_width;
+    in_height = out_height;
+  }
+
+  aom_free(input);
+  aom_free(conv_out);
+  return true;
+}
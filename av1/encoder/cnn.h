@@ -163,6 +163,25 @@ struct CNN_MULTI_OUT {
   float **output_buffer;
 };
 
+// Quantized copy of the weights of one convolution layer.
+typedef struct {
+  // Number of weights per output channel: in_channels * filter_height *
+  // filter_width, rounded up to NN_QUANT_ALIGN.
+  int kernel_size;
+  // Largest magnitude the layer inputs are quantized to.
+  int act_max;
+  // out_channels x kernel_size weights, in channel, row, column order.
+  int16_t *weights;
+  // Scale of the weights of each output channel.
+  float *weight_scale;
+} CNN_QUANT_LAYER;
+
+// Quantized copy of a CNN_CONFIG, see av1_cnn_quantize_config().
+typedef struct {
+  const CNN_CONFIG *cnn_config;
+  CNN_QUANT_LAYER layer[CNN_MAX_LAYERS];
+} CNN_QUANT_CONFIG;
+
 // Function to return size of output
 void av1_find_cnn_output_size(int in_width, int in_height,
                               const CNN_CONFIG *cnn_config, int *out_width,
@@ -184,6 +203,26 @@ bool av1_cnn_predict_img_multi_out_highbd(uint16_t **dgd, int width, int height,
                                           const CNN_CONFIG *cnn_config,
                                           const CNN_THREAD_DATA *thread_data,
                                           int bit_depth, CNN_MULTI_OUT *output);
+
+// Builds the quantized copy of cnn_config. Only networks made of
+// valid-padded convolutions with no max pooling, branches, batch
+// normalization or input extension, and with ReLU or no activation, are
+// supported. Returns false for other networks and on allocation failure, in
+// which case quant holds nothing to free.
+bool av1_cnn_quantize_config(const CNN_CONFIG *cnn_config,
+                             CNN_QUANT_CONFIG *quant);
+void av1_cnn_free_quant_config(CNN_QUANT_CONFIG *quant);
+
+// Quantized counterpart of av1_cnn_predict_img_multi_out() and
+// av1_cnn_predict_img_multi_out_highbd(). The pixels are used as they are for
+// the first layer, and the activations of each following layer are quantized
+// to int16 with one scale for the whole layer. When use_highbitdepth is set,
+// dgd holds CONVERT_TO_BYTEPTR() pointers to 16-bit pixels.
+bool av1_cnn_predict_img_multi_out_quant(uint8_t **dgd, int width, int height,
+                                         int stride, int use_highbitdepth,
+                                         int bit_depth,
+                                         const CNN_QUANT_CONFIG *quant,
+                                         CNN_MULTI_OUT *output);
 #ifdef __cplusplus
 }  // extern "C"
 #endif
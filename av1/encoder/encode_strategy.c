@@ -1504,8 +1504,11 @@ int av1_encode_strategy(AV1_COMP *const cpi, size_t *const size,
 
   // Per-frame encode speed.  In theory this can vary, but things may have
   // been written assuming speed-level will not change within a sequence, so
-  // this parameter should be used with caution.
-  frame_params.speed = oxcf->speed;
+  // this parameter should be used with caution. The real-time speed control
+  // only moves between speeds whose buffers and tools are compatible.
+  frame_params.speed = cpi->speed_control.budget_us > 0
+                           ? cpi->speed_control.speed
+                           : oxcf->speed;
 
 #if !CONFIG_REALTIME_ONLY
   // Set forced key frames when necessary. For two-pass encoding / lap mode,
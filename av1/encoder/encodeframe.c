@@ -56,6 +56,7 @@
 #include "av1/encoder/encodetxb.h"
 #include "av1/encoder/ethread.h"
 #include "av1/encoder/extend.h"
+#include "av1/encoder/inter_pred_cache.h"
 #include "av1/encoder/intra_mode_search_utils.h"
 #include "av1/encoder/ml.h"
 #include "av1/encoder/motion_search_facade.h"
@@ -541,9 +542,14 @@ static AOM_INLINE void encode_nonrd_sb(AV1_COMP *cpi, ThreadData *td,
     const BLOCK_SIZE bsize =
         seg_skip ? sb_size : sf->part_sf.fixed_partition_size;
     av1_set_fixed_partitioning(cpi, tile_info, mi, mi_row, mi_col, bsize);
+    av1_nonrd_reuse_sb_decisions(cpi, x, mi_row, mi_col);
+    x->reuse_sb_decisions = 0;
   } else if (sf->part_sf.partition_search_type == VAR_BASED_PARTITION) {
-    // set a variance-based partition
+    // set a variance-based partition, or the partition of the last frame if
+    // the superblock is unchanged
     av1_set_offsets(cpi, tile_info, x, mi_row, mi_col, sb_size);
+    x->reuse_sb_decisions =
+        av1_nonrd_reuse_sb_decisions(cpi, x, mi_row, mi_col);
     av1_choose_var_based_partitioning(cpi, tile_info, td, x, mi_row, mi_col);
   }
   assert(sf->part_sf.partition_search_type == FIXED_PARTITION || seg_skip ||
@@ -572,6 +578,7 @@ static AOM_INLINE void encode_nonrd_sb(AV1_COMP *cpi, ThreadData *td,
 #if CONFIG_COLLECT_COMPONENT_TIMING
   end_timing(cpi, nonrd_use_partition_time);
 #endif
+  av1_nonrd_store_sb_decisions(cpi, mi_row, mi_col);
 }
 
 // This function initializes the stats for encode_rd_sb.
@@ -778,6 +785,13 @@ static AOM_INLINE void encode_rd_sb(AV1_COMP *cpi, ThreadData *td,
   init_encode_rd_sb(cpi, td, tile_data, sms_root, &dummy_rdc, mi_row, mi_col,
                     1);
 
+  // Luma predictions are shared between the partition sizes and rd passes of
+  // this superblock only, so that no entry outlives its reference buffers.
+  if (x->inter_pred_cache != NULL && !frame_is_intra_only(cm)) {
+    av1_inter_pred_cache_reset(x->inter_pred_cache);
+    x->e_mbd.inter_pred_cache = x->inter_pred_cache;
+  }
+
   // Encode the superblock
   if (sf->part_sf.partition_search_type == VAR_BASED_PARTITION) {
     // partition search starting from a variance-based partition
@@ -916,6 +930,8 @@ static AOM_INLINE void encode_rd_sb(AV1_COMP *cpi, ThreadData *td,
   }
 #endif  // !CONFIG_REALTIME_ONLY
 
+  x->e_mbd.inter_pred_cache = NULL;
+
   // Update the inter rd model
   // TODO(angiebird): Let inter_mode_rd_model_estimation support multi-tile.
   if (cpi->sf.inter_sf.inter_mode_rd_model_estimation == 1 &&
@@ -1155,6 +1171,7 @@ static AOM_INLINE void encode_sb_row(AV1_COMP *cpi, ThreadData *td,
     x->content_state_sb.lighting_change = 0;
     x->content_state_sb.low_sumdiff = 0;
     x->force_zeromv_skip_for_sb = 0;
+    x->reuse_sb_decisions = 0;
 
     if (cpi->oxcf.mode == ALLINTRA) {
       x->intra_sb_rdmult_modifier = 128;
@@ -1732,75 +1749,22 @@ static AOM_INLINE void encode_frame_internal(AV1_COMP *cpi) {
       features->allow_warped_motion = 0;
   }
 
-  int hash_table_created = 0;
   if (!is_stat_generation_stage(cpi) && av1_use_hash_me(cpi) &&
       !cpi->sf.rt_sf.use_nonrd_pick_mode) {
-    // TODO(any): move this outside of the recoding loop to avoid recalculating
-    // the hash table.
-    // add to hash table
-    const int pic_width = cpi->source->y_crop_width;
-    const int pic_height = cpi->source->y_crop_height;
-    uint32_t *block_hash_values[2][2];
-    int8_t *is_block_same[2][3];
-    int k, j;
-
-    for (k = 0; k < 2; k++) {
-      for (j = 0; j < 2; j++) {
-        CHECK_MEM_ERROR(cm, block_hash_values[k][j],
-                        aom_malloc(sizeof(uint32_t) * pic_width * pic_height));
-      }
-
-      for (j = 0; j < 3; j++) {
-        CHECK_MEM_ERROR(cm, is_block_same[k][j],
-                        aom_malloc(sizeof(int8_t) * pic_width * pic_height));
-      }
-    }
-
-    av1_hash_table_init(intrabc_hash_info);
-    if (!av1_hash_table_create(&intrabc_hash_info->intrabc_hash_table)) {
-      aom_internal_error(cm->error, AOM_CODEC_MEM_ERROR,
-                         "Error allocating intrabc_hash_table");
-    }
-    hash_table_created = 1;
-    av1_generate_block_2x2_hash_value(intrabc_hash_info, cpi->source,
-                                      block_hash_values[0], is_block_same[0]);
-    // Hash data generated for screen contents is used for intraBC ME
+    // Hash data generated for screen contents is used for intraBC ME. The
+    // table is kept across recodes and consecutive frames using it, and only
+    // the rows of the source that changed are hashed again.
     const int min_alloc_size = block_size_wide[mi_params->mi_alloc_bsize];
     const int max_sb_size =
         (1 << (cm->seq_params->mib_size_log2 + MI_SIZE_LOG2));
-    int src_idx = 0;
-    bool error = false;
-    for (int size = 4; size <= max_sb_size; size *= 2, src_idx = !src_idx) {
-      const int dst_idx = !src_idx;
-      av1_generate_block_hash_value(
-          intrabc_hash_info, cpi->source, size, block_hash_values[src_idx],
-          block_hash_values[dst_idx], is_block_same[src_idx],
-          is_block_same[dst_idx]);
-      if (size >= min_alloc_size) {
-        if (!av1_add_to_hash_map_by_row_with_precal_data(
-                &intrabc_hash_info->intrabc_hash_table,
-                block_hash_values[dst_idx], is_block_same[dst_idx][2],
-                pic_width, pic_height, size)) {
-          error = true;
-          break;
-        }
-      }
-    }
-
-    for (k = 0; k < 2; k++) {
-      for (j = 0; j < 2; j++) {
-        aom_free(block_hash_values[k][j]);
-      }
-
-      for (j = 0; j < 3; j++) {
-        aom_free(is_block_same[k][j]);
-      }
-    }
-
-    if (error) {
+    av1_hash_table_init(intrabc_hash_info);
+    if (!av1_hash_table_update(intrabc_hash_info, cpi->source, min_alloc_size,
+                               max_sb_size)) {
       aom_internal_error(cm->error, AOM_CODEC_MEM_ERROR,
-                         "Error adding data to intrabc_hash_table");
+                         "Error updating intrabc_hash_table");
     }
+  } else {
+    av1_hash_table_release(intrabc_hash_info);
   }
 
   const CommonQuantParams *quant_params = &cm->quant_params;
@@ -1938,6 +1902,7 @@ static AOM_INLINE void encode_frame_internal(AV1_COMP *cpi) {
   av1_initialize_rd_consts(cpi);
   av1_set_sad_per_bit(cpi, &x->sadperbit, quant_params->base_qindex);
   populate_thresh_to_force_zeromv_skip(cpi);
+  if (cpi->sf.rt_sf.use_nonrd_pick_mode) av1_nonrd_decision_cache_setup(cpi);
 
   enc_row_mt->sync_read_ptr = av1_row_mt_sync_read_dummy;
   enc_row_mt->sync_write_ptr = av1_row_mt_sync_write_dummy;
@@ -2214,9 +2179,6 @@ static AOM_INLINE void encode_frame_internal(AV1_COMP *cpi) {
       }
     }
   }
-  if (hash_table_created) {
-    av1_hash_table_destroy(&intrabc_hash_info->intrabc_hash_table);
-  }
 }
 
 /*!\brief Setup reference frame buffers and encode a frame
@@ -65,6 +65,7 @@
 #include "av1/encoder/firstpass.h"
 #include "av1/encoder/hash_motion.h"
 #include "av1/encoder/hybrid_fwd_txfm.h"
+#include "av1/encoder/inter_pred_cache.h"
 #include "av1/encoder/intra_mode_search.h"
 #include "av1/encoder/mv_prec.h"
 #include "av1/encoder/pass2_strategy.h"
@@ -853,6 +854,12 @@ void av1_change_config(struct AV1_COMP *cpi, const AV1EncoderConfig *oxcf,
     if (x->comp_rd_buffer.pred0 == NULL)
       alloc_compound_type_rd_buffers(cm->error, &x->comp_rd_buffer);
 
+    if (x->inter_pred_cache == NULL) {
+      CHECK_MEM_ERROR(cm, x->inter_pred_cache,
+                      aom_memalign(32, sizeof(*x->inter_pred_cache)));
+      av1_inter_pred_cache_reset(x->inter_pred_cache);
+    }
+
     for (int i = 0; i < 2; ++i) {
       if (x->tmp_pred_bufs[i] == NULL) {
         CHECK_MEM_ERROR(cm, x->tmp_pred_bufs[i],
@@ -888,6 +895,15 @@ void av1_change_config(struct AV1_COMP *cpi, const AV1EncoderConfig *oxcf,
     }
   }
 
+  // The speed control only moves between the nonrd pick mode speeds of one
+  // pass real-time encoding.
+  const int use_speed_control = oxcf->mode == REALTIME &&
+                                oxcf->pass == AOM_RC_ONE_PASS &&
+                                oxcf->speed >= SPEED_CONTROL_MIN_SPEED;
+  av1_speed_control_configure(
+      &cpi->speed_control, use_speed_control ? oxcf->frame_time_budget : 0,
+      oxcf->speed, AOMMAX(oxcf->speed, SPEED_CONTROL_MAX_SPEED));
+
   features->interp_filter =
       oxcf->tile_cfg.enable_large_scale_tile ? EIGHTTAP_REGULAR : SWITCHABLE;
   features->switchable_motion_mode = is_switchable_motion_mode_allowed(
@@ -1262,6 +1278,38 @@ AV1_PRIMARY *av1_create_primary_compressor(
 #endif
 #undef SDSFP
 
+#define SDX8FP(BT, SDX8DF) ppi->fn_ptr[BT].sdx8df = SDX8DF;
+
+  SDX8FP(BLOCK_128X128, aom_sad128x128x8d)
+  SDX8FP(BLOCK_128X64, aom_sad128x64x8d)
+  SDX8FP(BLOCK_64X128, aom_sad64x128x8d)
+  SDX8FP(BLOCK_64X64, aom_sad64x64x8d)
+  SDX8FP(BLOCK_64X32, aom_sad64x32x8d)
+
+  SDX8FP(BLOCK_32X64, aom_sad32x64x8d)
+  SDX8FP(BLOCK_32X32, aom_sad32x32x8d)
+  SDX8FP(BLOCK_32X16, aom_sad32x16x8d)
+
+  SDX8FP(BLOCK_16X32, aom_sad16x32x8d)
+  SDX8FP(BLOCK_16X16, aom_sad16x16x8d)
+  SDX8FP(BLOCK_16X8, aom_sad16x8x8d)
+  SDX8FP(BLOCK_8X16, aom_sad8x16x8d)
+  SDX8FP(BLOCK_8X8, aom_sad8x8x8d)
+  SDX8FP(BLOCK_8X4, aom_sad8x4x8d)
+
+  SDX8FP(BLOCK_4X8, aom_sad4x8x8d)
+  SDX8FP(BLOCK_4X4, aom_sad4x4x8d)
+
+#if !CONFIG_REALTIME_ONLY
+  SDX8FP(BLOCK_64X16, aom_sad64x16x8d)
+  SDX8FP(BLOCK_16X64, aom_sad16x64x8d)
+  SDX8FP(BLOCK_32X8, aom_sad32x8x8d)
+  SDX8FP(BLOCK_8X32, aom_sad8x32x8d)
+  SDX8FP(BLOCK_16X4, aom_sad16x4x8d)
+  SDX8FP(BLOCK_4X16, aom_sad4x16x8d)
+#endif
+#undef SDX8FP
+
 #if CONFIG_AV1_HIGHBITDEPTH
   highbd_set_var_fns(ppi);
 #endif
@@ -1622,6 +1670,7 @@ void av1_remove_primary_compressor(AV1_PRIMARY *ppi) {
 #if !CONFIG_REALTIME_ONLY
   av1_tf_info_free(&ppi->tf_info);
 #endif  // !CONFIG_REALTIME_ONLY
+  av1_mf_cache_free(&ppi->mf_cache);
 
   for (int i = 0; i < MAX_NUM_OPERATING_POINTS; ++i) {
     aom_free(ppi->level_params.level_info[i]);
@@ -4731,6 +4780,9 @@ int av1_get_compressed_data(AV1_COMP *cpi, AV1_COMP_DATA *const cpi_data) {
                        "Failed to allocate new cur_frame");
   }
 
+  struct aom_usec_timer frame_timer;
+  aom_usec_timer_start(&frame_timer);
+
 #if CONFIG_COLLECT_COMPONENT_TIMING
   // Accumulate 2nd pass time in 2-pass case or 1 pass time in 1-pass case.
   if (cpi->oxcf.pass == 2 || cpi->oxcf.pass == 0)
@@ -4795,6 +4847,12 @@ int av1_get_compressed_data(AV1_COMP *cpi, AV1_COMP_DATA *const cpi_data) {
     aom_internal_error(cpi->common.error, AOM_CODEC_ERROR,
                        "Failed to encode frame");
   }
+  if (cpi->speed_control.budget_us > 0 &&
+      cpi->compressor_stage == ENCODE_STAGE && cpi_data->frame_size > 0) {
+    aom_usec_timer_mark(&frame_timer);
+    av1_speed_control_update(&cpi->speed_control,
+                             aom_usec_timer_elapsed(&frame_timer));
+  }
 #if CONFIG_INTERNAL_STATS
   aom_usec_timer_mark(&cmptimer);
   cpi->time_compress_data += aom_usec_timer_elapsed(&cmptimer);
@@ -43,9 +43,11 @@
 #include "av1/encoder/level.h"
 #include "av1/encoder/lookahead.h"
 #include "av1/encoder/mcomp.h"
+#include "av1/encoder/motion_field_cache.h"
 #include "av1/encoder/pickcdef.h"
 #include "av1/encoder/ratectrl.h"
 #include "av1/encoder/rd.h"
+#include "av1/encoder/speed_control.h"
 #include "av1/encoder/speed_features.h"
 #include "av1/encoder/svc_layercontext.h"
 #include "av1/encoder/temporal_filter.h"
@@ -1091,6 +1093,10 @@ typedef struct AV1EncoderConfig {
 
   // Selected global motion search method
   GlobalMotionMethod global_motion_method;
+
+  // Per-frame encode time budget in microseconds for the real-time speed
+  // control. 0 disables it.
+  unsigned int frame_time_budget;
   /*!\endcond */
 } AV1EncoderConfig;
 
@@ -1455,6 +1461,7 @@ typedef struct ThreadData {
   PALETTE_BUFFER *palette_buffer;
   CompoundTypeRdBuffers comp_rd_buffer;
   CONV_BUF_TYPE *tmp_conv_dst;
+  struct InterPredCache *inter_pred_cache;
   uint64_t abs_sum_level;
   uint8_t *tmp_pred_bufs[2];
   int intrabc_used;
@@ -2461,6 +2468,44 @@ typedef struct RTC_REF {
 } RTC_REF;
 /*!\endcond */
 
+/*!\cond */
+// Decision recorded for one 4x4 unit of a frame coded with nonrd pickmode.
+typedef struct {
+  // Luma sse of the chosen mode at mode decision time, or UINT32_MAX if the
+  // mode cannot be reused.
+  uint32_t sse;
+  // Size of the block whose top-left unit this is, or BLOCK_INVALID for the
+  // other units of the block.
+  uint8_t bsize;
+  // Block size the last mode decision at this unit was made for.
+  uint8_t picked_bsize;
+  uint8_t mode;
+  int8_t ref_frame;
+} NONRD_BLOCK_DECISION;
+
+typedef struct {
+  // Sum of the 8x8 luma source averages of the superblock at the time its
+  // decisions were made.
+  uint32_t fingerprint;
+  // Number of consecutive frames the decisions have been reused for.
+  uint8_t reuse_count;
+  uint8_t valid;
+} NONRD_SB_DECISION;
+
+typedef struct {
+  // Buffers of the frame being encoded and of the previous frame.
+  NONRD_BLOCK_DECISION *blocks[2];
+  NONRD_SB_DECISION *sbs[2];
+  int cur_idx;
+  int mi_rows;
+  int mi_cols;
+  int sb_rows;
+  int sb_cols;
+  // Number of the frame the current buffers belong to.
+  unsigned int frame_number;
+} NONRD_DECISION_CACHE;
+/*!\endcond */
+
 /*!
  * \brief Structure to hold data corresponding to an encoded frame.
  */
@@ -2676,6 +2721,11 @@ typedef struct AV1_PRIMARY {
    * Info and resources used by temporal filtering.
    */
   TEMPORAL_FILTER_INFO tf_info;
+  /*!
+   * Motion fields between source frames, filled by temporal filtering and
+   * TPL and reused by later motion searches on the same frame pairs.
+   */
+  MotionFieldCache mf_cache;
   /*!
    * Elements part of the sequence header, that are applicable for all the
    * frames in the video.
@@ -3039,6 +3089,12 @@ typedef struct AV1_COMP {
    */
   SPEED_FEATURES sf;
 
+  /*!
+   * Picks the per-frame speed against the encode time budget in real-time
+   * mode.
+   */
+  SpeedControl speed_control;
+
   /*!
    * Parameters for motion vector search process.
    */
@@ -3367,6 +3423,12 @@ typedef struct AV1_COMP {
    */
   uint8_t *consec_zero_mv;
 
+  /*!
+   * Partition and mode decisions of the last frame, reused for unchanged
+   * superblocks when sf->rt_sf.reuse_sb_decisions_nonrd is set.
+   */
+  NONRD_DECISION_CACHE nonrd_decisions;
+
   /*!
    * Block size of first pass encoding
    */
@@ -3997,6 +4059,21 @@ static INLINE int is_one_pass_rt_params(const AV1_COMP *cpi) {
          cpi->oxcf.gf_cfg.lag_in_frames == 0;
 }
 
+// Returns whether motion fields are shared through AV1_PRIMARY::mf_cache. The
+// cache is not synchronized between frame parallel encoder contexts.
+static INLINE int use_motion_field_cache(const AV1_COMP *cpi) {
+  return cpi->sf.mv_sf.motion_field_cache && cpi->ppi->num_fp_contexts == 1 &&
+         cpi->compressor_stage == ENCODE_STAGE;
+}
+
+// Converts a display order hint, which restarts at each key frame, into the
+// display index used by lookahead_entry::display_idx.
+static INLINE int get_abs_display_idx(const AV1_COMP *cpi,
+                                      unsigned int display_order_hint) {
+  return (int)display_order_hint + cpi->frame_index_set.show_frame_count -
+         (int)cpi->common.current_frame.frame_number;
+}
+
 // Use default/internal reference structure for single-layer RTC.
 static INLINE int use_rtc_reference_structure_one_layer(const AV1_COMP *cpi) {
   return is_one_pass_rt_params(cpi) && cpi->ppi->number_spatial_layers == 1 &&
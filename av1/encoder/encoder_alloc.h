@@ -17,6 +17,7 @@
 #include "av1/encoder/encodetxb.h"
 #include "av1/encoder/ethread.h"
 #include "av1/encoder/intra_mode_search_utils.h"
+#include "av1/encoder/rdopt.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -235,6 +236,7 @@ static AOM_INLINE void dealloc_compressor_data(AV1_COMP *cpi) {
       aom_free(cpi->td.mb.intrabc_hash_info.hash_value_buffer[i][j]);
       cpi->td.mb.intrabc_hash_info.hash_value_buffer[i][j] = NULL;
     }
+  av1_hash_table_release(&cpi->td.mb.intrabc_hash_info);
 
   aom_free(cm->tpl_mvs);
   cm->tpl_mvs = NULL;
@@ -284,6 +286,7 @@ static AOM_INLINE void dealloc_compressor_data(AV1_COMP *cpi) {
   aom_free(cpi->td.mb.palette_buffer);
   release_compound_type_rd_buffers(&cpi->td.mb.comp_rd_buffer);
   aom_free(cpi->td.mb.tmp_conv_dst);
+  aom_free(cpi->td.mb.inter_pred_cache);
   for (int j = 0; j < 2; ++j) {
     aom_free(cpi->td.mb.tmp_pred_bufs[j]);
   }
@@ -308,6 +311,8 @@ static AOM_INLINE void dealloc_compressor_data(AV1_COMP *cpi) {
     cpi->consec_zero_mv = NULL;
   }
 
+  av1_nonrd_decision_cache_free(&cpi->nonrd_decisions);
+
   if (cpi->src_sad_blk_64x64) {
     aom_free(cpi->src_sad_blk_64x64);
     cpi->src_sad_blk_64x64 = NULL;
@@ -413,6 +418,7 @@ static AOM_INLINE void free_thread_data(AV1_PRIMARY *ppi) {
     aom_free(thread_data->td->palette_buffer);
     aom_free(thread_data->td->tmp_conv_dst);
     release_compound_type_rd_buffers(&thread_data->td->comp_rd_buffer);
+    aom_free(thread_data->td->inter_pred_cache);
     for (int j = 0; j < 2; ++j) {
       aom_free(thread_data->td->tmp_pred_bufs[j]);
     }
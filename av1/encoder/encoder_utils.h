@@ -135,6 +135,7 @@ static AOM_INLINE void init_buffer_indices(
   ppi->fn_ptr[BT].svaf = SVAF;                                                 \
   ppi->fn_ptr[BT].sdx4df = SDX4DF;                                             \
   ppi->fn_ptr[BT].sdx3df = SDX3DF;                                             \
+  ppi->fn_ptr[BT].sdx8df = NULL;                                               \
   ppi->fn_ptr[BT].jsdaf = JSDAF;                                               \
   ppi->fn_ptr[BT].jsvaf = JSVAF;
 
@@ -92,9 +92,9 @@ static void write_golomb(aom_writer *w, int level) {
   }
   assert(length > 0);
 
-  for (i = 0; i < length - 1; ++i) aom_write_bit(w, 0);
-
-  for (i = length - 1; i >= 0; --i) aom_write_bit(w, (x >> i) & 0x01);
+  // The prefix of length - 1 zeros followed by the length bits of x.
+  aom_write_literal(w, 0, length - 1);
+  aom_write_literal(w, x, length);
 }
 
 static const int8_t eob_to_pos_small[33] = {
@@ -24,6 +24,7 @@
 #endif
 #include "av1/encoder/global_motion.h"
 #include "av1/encoder/global_motion_facade.h"
+#include "av1/encoder/inter_pred_cache.h"
 #include "av1/encoder/intra_mode_search_utils.h"
 #include "av1/encoder/picklpf.h"
 #include "av1/encoder/rdopt.h"
@@ -832,6 +833,11 @@ void av1_init_tile_thread_data(AV1_PRIMARY *ppi, int is_first_pass) {
           alloc_compound_type_rd_buffers(&ppi->error,
                                          &thread_data->td->comp_rd_buffer);
 
+          AOM_CHECK_MEM_ERROR(
+              &ppi->error, thread_data->td->inter_pred_cache,
+              aom_memalign(32, sizeof(*thread_data->td->inter_pred_cache)));
+          av1_inter_pred_cache_reset(thread_data->td->inter_pred_cache);
+
           for (int j = 0; j < 2; ++j) {
             AOM_CHECK_MEM_ERROR(
                 &ppi->error, thread_data->td->tmp_pred_bufs[j],
@@ -1395,6 +1401,7 @@ static AOM_INLINE void prepare_enc_workers(AV1_COMP *cpi, AVxWorkerHook hook,
       thread_data->td->mb.palette_buffer = thread_data->td->palette_buffer;
       thread_data->td->mb.comp_rd_buffer = thread_data->td->comp_rd_buffer;
       thread_data->td->mb.tmp_conv_dst = thread_data->td->tmp_conv_dst;
+      thread_data->td->mb.inter_pred_cache = thread_data->td->inter_pred_cache;
       for (int j = 0; j < 2; ++j) {
         thread_data->td->mb.tmp_pred_bufs[j] =
             thread_data->td->tmp_pred_bufs[j];
@@ -11,9 +11,12 @@
 
 #include <assert.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "config/av1_rtcd.h"
 
+#include "aom_mem/aom_mem.h"
+
 #include "av1/encoder/block.h"
 #include "av1/encoder/hash.h"
 #include "av1/encoder/hash_motion.h"
@@ -99,7 +102,6 @@ void av1_hash_table_init(IntraBCHashInfo *intrabc_hash_info) {
     av1_crc_calculator_init(&intrabc_hash_info->crc_calculator2, 24, 0x864CFB);
     intrabc_hash_info->g_crc_initialized = 1;
   }
-  intrabc_hash_info->intrabc_hash_table.p_lookup_table = NULL;
 }
 
 void av1_hash_table_clear_all(hash_table *p_hash_table) {
@@ -128,7 +130,7 @@ bool av1_hash_table_create(hash_table *p_hash_table) {
   }
   p_hash_table->p_lookup_table =
       (Vector **)aom_calloc(kMaxAddr, sizeof(p_hash_table->p_lookup_table[0]));
-  if (!p_hash_table) return false;
+  if (!p_hash_table->p_lookup_table) return false;
   return true;
 }
 
@@ -350,6 +352,331 @@ bool av1_add_to_hash_map_by_row_with_precal_data(hash_table *p_hash_table,
   return true;
 }
 
+static void hash_table_history_free(hash_table_history *history) {
+  aom_free(history->src);
+  aom_free(history->row_changed);
+  aom_free(history->changed_rows_above);
+  aom_free(history->old_size);
+  aom_free(history->touched);
+  memset(history, 0, sizeof(*history));
+}
+
+static bool hash_table_history_alloc(hash_table_history *history,
+                                     const YV12_BUFFER_CONFIG *picture,
+                                     int min_block_size, int max_block_size) {
+  history->width = picture->y_crop_width;
+  history->height = picture->y_crop_height;
+  history->use_highbitdepth = (picture->flags & YV12_FLAG_HIGHBITDEPTH) != 0;
+  history->min_block_size = min_block_size;
+  history->max_block_size = max_block_size;
+  history->src = aom_malloc(((size_t)history->width * history->height)
+                            << history->use_highbitdepth);
+  history->row_changed = aom_malloc(history->height);
+  history->changed_rows_above =
+      aom_malloc((history->height + 1) * sizeof(*history->changed_rows_above));
+  history->old_size = aom_malloc(kMaxAddr * sizeof(*history->old_size));
+  history->touched = aom_malloc(kMaxAddr * sizeof(*history->touched));
+  if (!history->src || !history->row_changed ||
+      !history->changed_rows_above || !history->old_size ||
+      !history->touched) {
+    hash_table_history_free(history);
+    return false;
+  }
+  memset(history->old_size, 0xff, kMaxAddr * sizeof(*history->old_size));
+  return true;
+}
+
+void av1_hash_table_release(IntraBCHashInfo *intrabc_hash_info) {
+  av1_hash_table_destroy(&intrabc_hash_info->intrabc_hash_table);
+  hash_table_history_free(&intrabc_hash_info->intrabc_hash_history);
+}
+
+// Rows of the picture hashed again for a band of changed rows, together with
+// the hash values computed for them.
+typedef struct {
+  // Changed rows [changed_start, changed_end) of the band.
+  int changed_start;
+  int changed_end;
+  // View of the picture rows [start, start + pic.y_crop_height) used to
+  // compute the hash values. start is a multiple of the largest block size,
+  // so that block alignment is the same as in the whole picture.
+  int start;
+  YV12_BUFFER_CONFIG pic;
+  uint32_t *block_hash_values[2][2];
+  int8_t *is_block_same[2][3];
+} hash_band;
+
+static void free_hash_bands(hash_band *bands, int num_bands) {
+  for (int i = 0; i < num_bands; ++i) {
+    for (int k = 0; k < 2; ++k) {
+      for (int j = 0; j < 2; ++j) aom_free(bands[i].block_hash_values[k][j]);
+      for (int j = 0; j < 3; ++j) aom_free(bands[i].is_block_same[k][j]);
+    }
+  }
+  aom_free(bands);
+}
+
+// Groups the changed rows into bands far enough apart for the blocks touching
+// two bands to be all stale, and allocates their hash buffers. Returns the
+// number of bands, or -1 on allocation failure.
+static int setup_hash_bands(const hash_table_history *history,
+                            const YV12_BUFFER_CONFIG *picture,
+                            hash_band **p_bands) {
+  const int height = history->height;
+  const int max_size = history->max_block_size;
+  const uint8_t *const row_changed = history->row_changed;
+  hash_band *bands = aom_calloc(height / max_size + 1, sizeof(*bands));
+  if (!bands) return -1;
+
+  int num_bands = 0;
+  for (int row = 0; row < height;) {
+    if (!row_changed[row]) {
+      ++row;
+      continue;
+    }
+    int end = row + 1;
+    for (int next = end; next < height && next < end + max_size; ++next) {
+      if (row_changed[next]) end = next + 1;
+    }
+    hash_band *const band = &bands[num_bands++];
+    band->changed_start = row;
+    band->changed_end = end;
+    band->start = AOMMAX(0, row - max_size + 1) & ~(max_size - 1);
+    const int band_end = AOMMIN(height, end + max_size - 1);
+    band->pic = *picture;
+    band->pic.y_buffer += (size_t)band->start * picture->y_stride;
+    band->pic.y_crop_height = band_end - band->start;
+    const size_t num_pixels = (size_t)history->width * band->pic.y_crop_height;
+    for (int k = 0; k < 2; ++k) {
+      for (int j = 0; j < 2; ++j) {
+        band->block_hash_values[k][j] =
+            aom_malloc(num_pixels * sizeof(*band->block_hash_values[k][j]));
+        if (!band->block_hash_values[k][j]) {
+          free_hash_bands(bands, num_bands);
+          return -1;
+        }
+      }
+      for (int j = 0; j < 3; ++j) {
+        band->is_block_same[k][j] = aom_malloc(num_pixels);
+        if (!band->is_block_same[k][j]) {
+          free_hash_bands(bands, num_bands);
+          return -1;
+        }
+      }
+    }
+    row = end;
+  }
+  *p_bands = bands;
+  return num_bands;
+}
+
+// Returns 1 if the block of the given size starting at row y overlaps one of
+// the changed rows.
+static INLINE int is_block_stale(const int *changed_rows_above, int height,
+                                 int y, int block_size) {
+  return changed_rows_above[AOMMIN(y + block_size, height)] >
+         changed_rows_above[y];
+}
+
+// Drops the entries of the blocks of the given size overlapping changed rows.
+static void remove_stale_entries(hash_table *p_hash_table,
+                                 const hash_table_history *history,
+                                 int block_size) {
+  const int index = hash_block_size_to_index(block_size);
+  assert(index >= 0);
+  const int first = index << kSrcBits;
+  const int last = (index + 1) << kSrcBits;
+  for (int addr = first; addr < last; ++addr) {
+    Vector *const vector = p_hash_table->p_lookup_table[addr];
+    if (vector == NULL) continue;
+    block_hash *const entries = (block_hash *)vector->data;
+    size_t num_kept = 0;
+    for (size_t i = 0; i < vector->size; ++i) {
+      if (!is_block_stale(history->changed_rows_above, history->height,
+                          entries[i].y, block_size)) {
+        entries[num_kept++] = entries[i];
+      }
+    }
+    vector->size = num_kept;
+  }
+}
+
+static INLINE int block_hash_before(const block_hash *a, const block_hash *b) {
+  return a->x < b->x || (a->x == b->x && a->y < b->y);
+}
+
+// Merges the entries appended to each lookup table address by the update with
+// the ones kept from the previous picture, restoring the column-major order in
+// which a complete build adds them.
+static bool merge_new_entries(hash_table *p_hash_table,
+                              hash_table_history *history, int num_touched) {
+  bool ok = true;
+  for (int i = 0; i < num_touched; ++i) {
+    const uint32_t addr = history->touched[i];
+    Vector *const vector = p_hash_table->p_lookup_table[addr];
+    const size_t num_old = history->old_size[addr];
+    history->old_size[addr] = UINT32_MAX;
+    const size_t num_new = vector->size - num_old;
+    if (!ok || num_old == 0 || num_new == 0) continue;
+    block_hash *const entries = (block_hash *)vector->data;
+    if (block_hash_before(&entries[num_old - 1], &entries[num_old])) continue;
+
+    block_hash *const new_entries = aom_malloc(num_new * sizeof(*new_entries));
+    if (!new_entries) {
+      ok = false;
+      continue;
+    }
+    memcpy(new_entries, entries + num_old, num_new * sizeof(*new_entries));
+    // Merge from the back so that the old entries can be moved in place.
+    size_t old_idx = num_old;
+    size_t new_idx = num_new;
+    size_t dst = vector->size;
+    while (new_idx > 0) {
+      if (old_idx > 0 &&
+          block_hash_before(&new_entries[new_idx - 1], &entries[old_idx - 1])) {
+        entries[--dst] = entries[--old_idx];
+      } else {
+        entries[--dst] = new_entries[--new_idx];
+      }
+    }
+    aom_free(new_entries);
+  }
+  return ok;
+}
+
+// Adds the entries of the blocks of the given size overlapping changed rows,
+// column by column across the bands, as a complete build would.
+static bool add_band_entries(hash_table *p_hash_table,
+                             hash_table_history *history,
+                             const hash_band *bands, int num_bands,
+                             int block_size, int dst_idx, bool track_touched,
+                             int *num_touched) {
+  const int width = history->width;
+  const int height = history->height;
+  const int x_end = width - block_size + 1;
+  const int add_value = hash_block_size_to_index(block_size) << kSrcBits;
+  const int crc_mask = (1 << kSrcBits) - 1;
+
+  for (int x_pos = 0; x_pos < x_end; x_pos++) {
+    for (int i = 0; i < num_bands; ++i) {
+      const hash_band *const band = &bands[i];
+      uint32_t *const *const hash = band->block_hash_values[dst_idx];
+      const int8_t *const is_added = band->is_block_same[dst_idx][2];
+      const int y_start = AOMMAX(0, band->changed_start - block_size + 1);
+      const int y_end = AOMMIN(band->changed_end, height - block_size + 1);
+      for (int y_pos = y_start; y_pos < y_end; y_pos++) {
+        const int pos = (y_pos - band->start) * width + x_pos;
+        if (!is_added[pos] || !is_block_stale(history->changed_rows_above,
+                                              height, y_pos, block_size))
+          continue;
+        block_hash curr_block_hash;
+        curr_block_hash.x = x_pos;
+        curr_block_hash.y = y_pos;
+        curr_block_hash.hash_value2 = hash[1][pos];
+        const uint32_t hash_value1 = (hash[0][pos] & crc_mask) + add_value;
+        if (track_touched && history->old_size[hash_value1] == UINT32_MAX) {
+          const Vector *const vec = p_hash_table->p_lookup_table[hash_value1];
+          history->old_size[hash_value1] = vec ? (uint32_t)vec->size : 0;
+          history->touched[(*num_touched)++] = hash_value1;
+        }
+        if (!hash_table_add_to_table(p_hash_table, hash_value1,
+                                     &curr_block_hash)) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool av1_hash_table_update(IntraBCHashInfo *intrabc_hash_info,
+                           const YV12_BUFFER_CONFIG *picture,
+                           int min_block_size, int max_block_size) {
+  hash_table *const p_hash_table = &intrabc_hash_info->intrabc_hash_table;
+  hash_table_history *const history = &intrabc_hash_info->intrabc_hash_history;
+  const int width = picture->y_crop_width;
+  const int height = picture->y_crop_height;
+  const int use_hbd = (picture->flags & YV12_FLAG_HIGHBITDEPTH) != 0;
+  const size_t row_bytes = (size_t)width << use_hbd;
+  const uint8_t *const buf = use_hbd
+                                 ? (const uint8_t *)CONVERT_TO_SHORTPTR(
+                                       picture->y_buffer)
+                                 : picture->y_buffer;
+  const size_t stride_bytes = (size_t)picture->y_stride << use_hbd;
+
+  // Hash the whole picture unless the table holds the same block sizes of a
+  // picture of the same format.
+  const bool rebuild = p_hash_table->p_lookup_table == NULL ||
+                       history->src == NULL || history->width != width ||
+                       history->height != height ||
+                       history->use_highbitdepth != use_hbd ||
+                       history->min_block_size != min_block_size ||
+                       history->max_block_size != max_block_size;
+  if (rebuild) {
+    hash_table_history_free(history);
+    if (!av1_hash_table_create(p_hash_table) ||
+        !hash_table_history_alloc(history, picture, min_block_size,
+                                  max_block_size)) {
+      return false;
+    }
+  }
+
+  int num_changed = 0;
+  history->changed_rows_above[0] = 0;
+  for (int row = 0; row < height; ++row) {
+    const uint8_t *const src = buf + row * stride_bytes;
+    uint8_t *const prev = history->src + row * row_bytes;
+    history->row_changed[row] = rebuild || memcmp(src, prev, row_bytes) != 0;
+    if (history->row_changed[row]) {
+      memcpy(prev, src, row_bytes);
+      ++num_changed;
+    }
+    history->changed_rows_above[row + 1] = num_changed;
+  }
+  if (num_changed == 0) return true;
+
+  hash_band *bands = NULL;
+  const int num_bands = setup_hash_bands(history, picture, &bands);
+  if (num_bands < 0) {
+    hash_table_history_free(history);
+    return false;
+  }
+
+  if (!rebuild) {
+    for (int size = min_block_size; size <= max_block_size; size *= 2)
+      remove_stale_entries(p_hash_table, history, size);
+  }
+
+  for (int i = 0; i < num_bands; ++i) {
+    av1_generate_block_2x2_hash_value(intrabc_hash_info, &bands[i].pic,
+                                      bands[i].block_hash_values[0],
+                                      bands[i].is_block_same[0]);
+  }
+  int num_touched = 0;
+  int src_idx = 0;
+  bool ok = true;
+  for (int size = 4; size <= max_block_size && ok;
+       size *= 2, src_idx = !src_idx) {
+    const int dst_idx = !src_idx;
+    for (int i = 0; i < num_bands; ++i) {
+      hash_band *const band = &bands[i];
+      av1_generate_block_hash_value(
+          intrabc_hash_info, &band->pic, size, band->block_hash_values[src_idx],
+          band->block_hash_values[dst_idx], band->is_block_same[src_idx],
+          band->is_block_same[dst_idx]);
+    }
+    if (size >= min_block_size) {
+      ok = add_band_entries(p_hash_table, history, bands, num_bands, size,
+                            dst_idx, !rebuild, &num_touched);
+    }
+  }
+  ok = merge_new_entries(p_hash_table, history, num_touched) && ok;
+  free_hash_bands(bands, num_bands);
+  // The table no longer matches the history if it could not be updated.
+  if (!ok) hash_table_history_free(history);
+  return ok;
+}
+
 int av1_hash_is_horizontal_perfect(const YV12_BUFFER_CONFIG *picture,
                                    int block_size, int x_start, int y_start) {
   const int stride = picture->y_stride;
@@ -40,6 +40,26 @@ typedef struct _hash_table {
   Vector **p_lookup_table;
 } hash_table;
 
+// Source the hash table was last built for, kept so that the table of the
+// next frame only needs to be updated for the rows that changed.
+typedef struct _hash_table_history {
+  // Luma samples of the source, with a stride of width. High bitdepth samples
+  // are stored as uint16_t.
+  uint8_t *src;
+  int width;
+  int height;
+  int use_highbitdepth;
+  // Range of block sizes held by the table.
+  int min_block_size;
+  int max_block_size;
+  // Scratch buffers for the update: per row change flags and counts, and
+  // per lookup table address sizes before the update.
+  uint8_t *row_changed;
+  int *changed_rows_above;
+  uint32_t *old_size;
+  uint32_t *touched;
+} hash_table_history;
+
 struct intrabc_hash_info;
 
 typedef struct intrabc_hash_info {
@@ -49,6 +69,7 @@ typedef struct intrabc_hash_info {
   // [two buffers used ping-pong]
   uint32_t *hash_value_buffer[2][2];
   hash_table intrabc_hash_table;
+  hash_table_history intrabc_hash_history;
 
   CRC_CALCULATOR crc_calculator1;
   CRC_CALCULATOR crc_calculator2;
@@ -76,6 +97,16 @@ void av1_generate_block_hash_value(IntraBCHashInfo *intra_bc_hash_info,
                                    uint32_t *dst_pic_block_hash[2],
                                    int8_t *src_pic_block_same_info[3],
                                    int8_t *dst_pic_block_same_info[3]);
+// Builds the hash table of the picture for the square block sizes from
+// min_block_size to max_block_size. If the table was built for the previous
+// picture of the same size, only the entries of the blocks overlapping rows
+// that changed are replaced. The table then holds the same entries, in the
+// same order, as a table built from scratch.
+bool av1_hash_table_update(IntraBCHashInfo *intrabc_hash_info,
+                           const YV12_BUFFER_CONFIG *picture,
+                           int min_block_size, int max_block_size);
+// Frees the hash table and the history kept for its incremental update.
+void av1_hash_table_release(IntraBCHashInfo *intrabc_hash_info);
 bool av1_add_to_hash_map_by_row_with_precal_data(hash_table *p_hash_table,
                                                  uint32_t *pic_hash[2],
                                                  int8_t *pic_is_same,
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "av1/encoder/inter_pred_cache.h"
+
+static INLINE int same_key(const InterPredKey *a, const InterPredKey *b) {
+  return a->ref_buf == b->ref_buf && a->filter_x == b->filter_x &&
+         a->filter_y == b->filter_y && a->offset_x == b->offset_x &&
+         a->offset_y == b->offset_y && a->subpel_x == b->subpel_x &&
+         a->subpel_y == b->subpel_y;
+}
+
+// Returns 1 if the region (x, y, width, height) lies inside the entry.
+static INLINE int covers(const InterPredCacheEntry *e, int x, int y,
+                         int width, int height) {
+  return x >= e->x && y >= e->y && x + width <= e->x + e->width &&
+         y + height <= e->y + e->height;
+}
+
+void av1_inter_pred_cache_reset(InterPredCache *cache) {
+  for (int i = 0; i < INTER_PRED_CACHE_ENTRIES; ++i)
+    cache->entries[i].valid = 0;
+  cache->use_count = 0;
+}
+
+int av1_inter_pred_cache_read(InterPredCache *cache, const InterPredKey *key,
+                              int x, int y, int width, int height,
+                              uint8_t *dst, int dst_stride, int use_hbd) {
+  for (int i = 0; i < INTER_PRED_CACHE_ENTRIES; ++i) {
+    InterPredCacheEntry *const e = &cache->entries[i];
+    if (!e->valid || !same_key(&e->key, key) ||
+        !covers(e, x, y, width, height))
+      continue;
+    const int offset = (y - e->y) * e->width + (x - e->x);
+    if (use_hbd) {
+      const uint16_t *src = e->buf + offset;
+      uint16_t *dst16 = CONVERT_TO_SHORTPTR(dst);
+      for (int r = 0; r < height; ++r) {
+        memcpy(dst16, src, width * sizeof(*dst16));
+        src += e->width;
+        dst16 += dst_stride;
+      }
+    } else {
+      const uint8_t *src = (const uint8_t *)e->buf + offset;
+      for (int r = 0; r < height; ++r) {
+        memcpy(dst, src, width);
+        src += e->width;
+        dst += dst_stride;
+      }
+    }
+    e->last_use = ++cache->use_count;
+    return 1;
+  }
+  return 0;
+}
+
+void av1_inter_pred_cache_write(InterPredCache *cache, const InterPredKey *key,
+                                int x, int y, int width, int height,
+                                const uint8_t *dst, int dst_stride,
+                                int use_hbd) {
+  assert(width * height <= MAX_SB_SQUARE);
+  InterPredCacheEntry *victim = NULL;
+  for (int i = 0; i < INTER_PRED_CACHE_ENTRIES; ++i) {
+    InterPredCacheEntry *const e = &cache->entries[i];
+    if (e->valid && same_key(&e->key, key) && e->x >= x && e->y >= y &&
+        e->x + e->width <= x + width && e->y + e->height <= y + height) {
+      victim = e;
+      break;
+    }
+    if (victim == NULL || !e->valid ||
+        (victim->valid && e->last_use < victim->last_use)) {
+      victim = e;
+    }
+  }
+  assert(victim != NULL);
+
+  victim->key = *key;
+  victim->x = x;
+  victim->y = y;
+  victim->width = width;
+  victim->height = height;
+  victim->valid = 1;
+  victim->last_use = ++cache->use_count;
+  if (use_hbd) {
+    const uint16_t *src16 = CONVERT_TO_SHORTPTR(dst);
+    uint16_t *buf = victim->buf;
+    for (int r = 0; r < height; ++r) {
+      memcpy(buf, src16, width * sizeof(*buf));
+      src16 += dst_stride;
+      buf += width;
+    }
+  } else {
+    uint8_t *buf = (uint8_t *)victim->buf;
+    for (int r = 0; r < height; ++r) {
+      memcpy(buf, dst, width);
+      dst += dst_stride;
+      buf += width;
+    }
+  }
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+/*!\file
+ * \brief Superblock-scoped cache of single reference luma inter predictions.
+ */
+#ifndef AOM_AV1_ENCODER_INTER_PRED_CACHE_H_
+#define AOM_AV1_ENCODER_INTER_PRED_CACHE_H_
+
+#include <stdint.h>
+
+#include "aom_ports/mem.h"
+#include "av1/common/enums.h"
+#include "av1/common/filter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!\cond */
+
+// Number of predictions kept per superblock.
+#define INTER_PRED_CACHE_ENTRIES 8
+
+// Identifies a translational prediction independently of the block it was
+// built for: two blocks with equal keys read the same filtered reference
+// samples at the same offset from their own position.
+typedef struct {
+  // Start of the reference plane.
+  const uint8_t *ref_buf;
+  const InterpFilterParams *filter_x;
+  const InterpFilterParams *filter_y;
+  // Full pel offset of the reference block from the predicted block, after
+  // motion vector clamping.
+  int offset_x;
+  int offset_y;
+  // Subpel phases in SCALE_SUBPEL_BITS precision.
+  int subpel_x;
+  int subpel_y;
+} InterPredKey;
+
+typedef struct {
+  InterPredKey key;
+  // Luma region covered by the prediction, in pixels from the frame origin.
+  int x;
+  int y;
+  int width;
+  int height;
+  int valid;
+  uint64_t last_use;
+  // Prediction samples with a stride of 'width'. High bitdepth predictions
+  // are stored as uint16_t.
+  DECLARE_ALIGNED(32, uint16_t, buf[MAX_SB_SQUARE]);
+} InterPredCacheEntry;
+
+typedef struct InterPredCache {
+  InterPredCacheEntry entries[INTER_PRED_CACHE_ENTRIES];
+  uint64_t use_count;
+} InterPredCache;
+
+/*!\endcond */
+
+/*!\brief Invalidates all the predictions held by the cache. */
+void av1_inter_pred_cache_reset(InterPredCache *cache);
+
+/*!\brief Copies the prediction of the given luma region out of the cache.
+ *
+ * \param[in]   cache       Inter prediction cache
+ * \param[in]   key         Prediction key of the block
+ * \param[in]   x           Column of the block in the frame
+ * \param[in]   y           Row of the block in the frame
+ * \param[in]   width       Width of the block
+ * \param[in]   height      Height of the block
+ * \param[out]  dst         Destination buffer (CONVERT_TO_BYTEPTR() for high
+ *                          bitdepth)
+ * \param[in]   dst_stride  Stride of \p dst
+ * \param[in]   use_hbd     Whether \p dst holds 16-bit samples
+ *
+ * \return 1 if an entry with the same key covers the whole region and was
+ * copied to \p dst, 0 otherwise.
+ */
+int av1_inter_pred_cache_read(InterPredCache *cache, const InterPredKey *key,
+                              int x, int y, int width, int height,
+                              uint8_t *dst, int dst_stride, int use_hbd);
+
+/*!\brief Stores the prediction of the given luma region in the cache.
+ *
+ * Replaces an entry with the same key whose region lies inside the new one if
+ * there is one, and the least recently used entry otherwise. Parameters are as
+ * for av1_inter_pred_cache_read(), with \p dst being the source.
+ */
+void av1_inter_pred_cache_write(InterPredCache *cache, const InterPredKey *key,
+                                int x, int y, int width, int height,
+                                const uint8_t *dst, int dst_stride,
+                                int use_hbd);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // AOM_AV1_ENCODER_INTER_PRED_CACHE_H_
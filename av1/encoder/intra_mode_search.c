@@ -1434,6 +1434,169 @@ int av1_search_intra_uv_modes_in_interframe(
 
 // Checks if odd delta angles can be pruned based on rdcosts of even delta
 // angles of the corresponding directional mode.
+// Model rd of the luma intra modes of a block. When the block is a single
+// transform block, the neighbouring pixels are gathered once and the
+// prediction of each directional angle is built from them.
+typedef struct {
+  IntraEdges edges;
+  int edges_ready;
+  int single_tx_block;
+  // Indexed by [mode][angle_delta + MAX_ANGLE_DELTA], -1 if not computed yet.
+  int64_t model_rd[INTRA_MODES][2 * MAX_ANGLE_DELTA + 1];
+} LumaModelRdCache;
+
+static AOM_INLINE void init_luma_model_rd_cache(LumaModelRdCache *cache,
+                                                BLOCK_SIZE bsize,
+                                                TX_SIZE tx_size) {
+  cache->edges_ready = 0;
+  cache->single_tx_block = tx_size_wide[tx_size] == block_size_wide[bsize] &&
+                           tx_size_high[tx_size] == block_size_high[bsize];
+  for (int i = 0; i < INTRA_MODES; i++) {
+    for (int j = 0; j < 2 * MAX_ANGLE_DELTA + 1; j++) {
+      cache->model_rd[i][j] = -1;
+    }
+  }
+}
+
+// Same as intra_model_rd() with use_hadamard = 1 for the luma mode and angle
+// delta set in mbmi.
+static int64_t luma_model_rd(const AV1_COMMON *cm, MACROBLOCK *x,
+                             BLOCK_SIZE bsize, TX_SIZE tx_size,
+                             LumaModelRdCache *cache) {
+  MACROBLOCKD *const xd = &x->e_mbd;
+  const MB_MODE_INFO *const mbmi = xd->mi[0];
+  const PREDICTION_MODE mode = mbmi->mode;
+  const int angle_delta = mbmi->angle_delta[PLANE_TYPE_Y];
+  int64_t *const model_rd =
+      &cache->model_rd[mode][angle_delta + MAX_ANGLE_DELTA];
+  if (*model_rd >= 0) return *model_rd;
+  if (!av1_is_directional_mode(mode) || !cache->single_tx_block) {
+    *model_rd =
+        intra_model_rd(cm, x, AOM_PLANE_Y, bsize, tx_size, /*use_hadamard=*/1);
+    return *model_rd;
+  }
+
+  struct macroblock_plane *const p = &x->plane[AOM_PLANE_Y];
+  struct macroblockd_plane *const pd = &xd->plane[AOM_PLANE_Y];
+  const int txbw = tx_size_wide[tx_size];
+  const int txbh = tx_size_high[tx_size];
+  if (!cache->edges_ready) {
+    av1_prepare_dr_intra_edges(xd, cm->seq_params->sb_size,
+                               cm->seq_params->enable_intra_edge_filter,
+                               pd->width, pd->height, tx_size, pd->dst.buf,
+                               pd->dst.stride, 0, 0, AOM_PLANE_Y,
+                               &cache->edges);
+    cache->edges_ready = 1;
+  }
+  DECLARE_ALIGNED(32, uint16_t, pred16[32 * 32]);
+  uint8_t *const pred = is_cur_buf_hbd(xd) ? CONVERT_TO_BYTEPTR(pred16)
+                                           : (uint8_t *)pred16;
+  av1_predict_dr_intra_from_edges(
+      &cache->edges, mode_to_angle_map[mode] + angle_delta * ANGLE_STEP, pred,
+      txbw);
+  const BitDepthInfo bd_info = get_bit_depth_info(xd);
+  av1_subtract_block(bd_info, txbh, txbw, p->src_diff, block_size_wide[bsize],
+                     p->src.buf, p->src.stride, pred, txbw);
+  av1_quick_txfm(/*use_hadamard=*/1, tx_size, bd_info, p->src_diff,
+                 block_size_wide[bsize], p->coeff);
+  *model_rd = aom_satd(p->coeff, tx_size_2d[tx_size]);
+  return *model_rd;
+}
+
+// Returns whether av1_rd_pick_intra_sby_mode() searches the luma mode and
+// angle delta set in mbmi, given the encoder config and speed features.
+static int is_luma_mode_searched(const AV1_COMP *const cpi,
+                                 const MACROBLOCK *x, BLOCK_SIZE bsize,
+                                 const uint8_t *directional_mode_skip_mask) {
+  const IntraModeCfg *const intra_mode_cfg = &cpi->oxcf.intra_mode_cfg;
+  const INTRA_MODE_SPEED_FEATURES *const intra_sf = &cpi->sf.intra_sf;
+  const MB_MODE_INFO *const mbmi = x->e_mbd.mi[0];
+  const int luma_delta_angle = mbmi->angle_delta[PLANE_TYPE_Y];
+
+  if (av1_is_diagonal_mode(mbmi->mode) &&
+      !intra_mode_cfg->enable_diagonal_intra)
+    return 0;
+  if (av1_is_directional_mode(mbmi->mode) &&
+      !intra_mode_cfg->enable_directional_intra)
+    return 0;
+
+  // The smooth prediction mode appears to be more frequently picked
+  // than horizontal / vertical smooth prediction modes. Hence treat
+  // them differently in speed features.
+  if ((!intra_mode_cfg->enable_smooth_intra ||
+       intra_sf->disable_smooth_intra) &&
+      (mbmi->mode == SMOOTH_H_PRED || mbmi->mode == SMOOTH_V_PRED))
+    return 0;
+  if (!intra_mode_cfg->enable_smooth_intra && mbmi->mode == SMOOTH_PRED)
+    return 0;
+
+  // The functionality of filter intra modes and smooth prediction
+  // overlap. Hence smooth prediction is pruned only if all the
+  // filter intra modes are enabled.
+  if (intra_sf->disable_smooth_intra &&
+      intra_sf->prune_filter_intra_level == 0 && mbmi->mode == SMOOTH_PRED)
+    return 0;
+  if (!intra_mode_cfg->enable_paeth_intra && mbmi->mode == PAETH_PRED)
+    return 0;
+
+  // Skip the evaluation of modes that do not match with the winner mode in
+  // x->mb_mode_cache.
+  if (x->use_mb_mode_cache && mbmi->mode != x->mb_mode_cache->mode) return 0;
+
+  const int is_directional_mode = av1_is_directional_mode(mbmi->mode);
+  if (is_directional_mode && directional_mode_skip_mask[mbmi->mode]) return 0;
+  if (is_directional_mode &&
+      !(av1_use_angle_delta(bsize) && intra_mode_cfg->enable_angle_delta) &&
+      luma_delta_angle != 0)
+    return 0;
+
+  // Use intra_y_mode_mask speed feature to skip intra mode evaluation.
+  if (!(intra_sf->intra_y_mode_mask[max_txsize_lookup[bsize]] &
+        (1 << mbmi->mode)))
+    return 0;
+  return 1;
+}
+
+// Estimates the model rd of all the searched luma modes and angle deltas of
+// the block up front, and marks all but the best top_luma_model_rd_count of
+// them in mode_skip_mask, one bit per angle delta.
+static void prune_luma_modes_using_model_rd(
+    const AV1_COMP *const cpi, MACROBLOCK *x, BLOCK_SIZE bsize,
+    TX_SIZE tx_size, const uint8_t *directional_mode_skip_mask,
+    LumaModelRdCache *cache, uint16_t mode_skip_mask[INTRA_MODES]) {
+  const INTRA_MODE_SPEED_FEATURES *const intra_sf = &cpi->sf.intra_sf;
+  MB_MODE_INFO *const mbmi = x->e_mbd.mi[0];
+  int64_t top_model_rd[LUMA_MODE_COUNT];
+  int num_candidates = 0;
+  for (int mode_idx = INTRA_MODE_START; mode_idx < LUMA_MODE_COUNT;
+       ++mode_idx) {
+    set_y_mode_and_delta_angle(mode_idx, mbmi,
+                               intra_sf->prune_luma_odd_delta_angles_in_intra);
+    if (!is_luma_mode_searched(cpi, x, bsize, directional_mode_skip_mask))
+      continue;
+    top_model_rd[num_candidates++] =
+        luma_model_rd(&cpi->common, x, bsize, tx_size, cache);
+  }
+  const int top_count = intra_sf->top_luma_model_rd_count;
+  if (num_candidates <= top_count) return;
+  // Partial selection sort for the model rd of the last candidate kept.
+  for (int i = 0; i < top_count; i++) {
+    for (int j = i + 1; j < num_candidates; j++) {
+      if (top_model_rd[j] < top_model_rd[i]) {
+        const int64_t tmp = top_model_rd[i];
+        top_model_rd[i] = top_model_rd[j];
+        top_model_rd[j] = tmp;
+      }
+    }
+  }
+  const int64_t thresh = top_model_rd[top_count - 1];
+  for (int i = 0; i < INTRA_MODES; i++) {
+    for (int j = 0; j < 2 * MAX_ANGLE_DELTA + 1; j++) {
+      if (cache->model_rd[i][j] > thresh) mode_skip_mask[i] |= 1 << j;
+    }
+  }
+}
+
 static AOM_INLINE int prune_luma_odd_delta_angles_using_rd_cost(
     const MB_MODE_INFO *const mbmi, const int64_t *const intra_modes_rd_cost,
     int64_t best_rd, int prune_luma_odd_delta_angles_in_intra) {
@@ -1468,13 +1631,11 @@ int64_t av1_rd_pick_intra_sby_mode(const AV1_COMP *const cpi, MACROBLOCK *x,
   MB_MODE_INFO *const mbmi = xd->mi[0];
   assert(!is_inter_block(mbmi));
   int64_t best_model_rd = INT64_MAX;
-  int is_directional_mode;
   uint8_t directional_mode_skip_mask[INTRA_MODES] = { 0 };
   // Flag to check rd of any intra mode is better than best_rd passed to this
   // function
   int beat_best_rd = 0;
   const int *bmode_costs;
-  const IntraModeCfg *const intra_mode_cfg = &cpi->oxcf.intra_mode_cfg;
   PALETTE_MODE_INFO *const pmi = &mbmi->palette_mode_info;
   const int try_palette =
       cpi->oxcf.tool_cfg.enable_palette &&
@@ -1505,6 +1666,16 @@ int64_t av1_rd_pick_intra_sby_mode(const AV1_COMP *const cpi, MACROBLOCK *x,
   mbmi->filter_intra_mode_info.use_filter_intra = 0;
   pmi->palette_size[0] = 0;
 
+  const TX_SIZE model_tx_size = AOMMIN(TX_32X32, max_txsize_lookup[bsize]);
+  LumaModelRdCache model_rd_cache;
+  init_luma_model_rd_cache(&model_rd_cache, bsize, model_tx_size);
+  uint16_t mode_skip_mask[INTRA_MODES] = { 0 };
+  if (intra_sf->top_luma_model_rd_count) {
+    prune_luma_modes_using_model_rd(cpi, x, bsize, model_tx_size,
+                                    directional_mode_skip_mask, &model_rd_cache,
+                                    mode_skip_mask);
+  }
+
   // Set params for mode evaluation
   set_mode_eval_params(cpi, x, MODE_EVAL);
 
@@ -1542,49 +1713,10 @@ int64_t av1_rd_pick_intra_sby_mode(const AV1_COMP *const cpi, MACROBLOCK *x,
                                intra_sf->prune_luma_odd_delta_angles_in_intra);
     RD_STATS this_rd_stats;
     int this_rate, this_rate_tokenonly, s;
-    int is_diagonal_mode;
     int64_t this_distortion, this_rd;
     const int luma_delta_angle = mbmi->angle_delta[PLANE_TYPE_Y];
 
-    is_diagonal_mode = av1_is_diagonal_mode(mbmi->mode);
-    if (is_diagonal_mode && !intra_mode_cfg->enable_diagonal_intra) continue;
-    if (av1_is_directional_mode(mbmi->mode) &&
-        !intra_mode_cfg->enable_directional_intra)
-      continue;
-
-    // The smooth prediction mode appears to be more frequently picked
-    // than horizontal / vertical smooth prediction modes. Hence treat
-    // them differently in speed features.
-    if ((!intra_mode_cfg->enable_smooth_intra ||
-         intra_sf->disable_smooth_intra) &&
-        (mbmi->mode == SMOOTH_H_PRED || mbmi->mode == SMOOTH_V_PRED))
-      continue;
-    if (!intra_mode_cfg->enable_smooth_intra && mbmi->mode == SMOOTH_PRED)
-      continue;
-
-    // The functionality of filter intra modes and smooth prediction
-    // overlap. Hence smooth prediction is pruned only if all the
-    // filter intra modes are enabled.
-    if (intra_sf->disable_smooth_intra &&
-        intra_sf->prune_filter_intra_level == 0 && mbmi->mode == SMOOTH_PRED)
-      continue;
-    if (!intra_mode_cfg->enable_paeth_intra && mbmi->mode == PAETH_PRED)
-      continue;
-
-    // Skip the evaluation of modes that do not match with the winner mode in
-    // x->mb_mode_cache.
-    if (x->use_mb_mode_cache && mbmi->mode != x->mb_mode_cache->mode) continue;
-
-    is_directional_mode = av1_is_directional_mode(mbmi->mode);
-    if (is_directional_mode && directional_mode_skip_mask[mbmi->mode]) continue;
-    if (is_directional_mode &&
-        !(av1_use_angle_delta(bsize) && intra_mode_cfg->enable_angle_delta) &&
-        luma_delta_angle != 0)
-      continue;
-
-    // Use intra_y_mode_mask speed feature to skip intra mode evaluation.
-    if (!(intra_sf->intra_y_mode_mask[max_txsize_lookup[bsize]] &
-          (1 << mbmi->mode)))
+    if (!is_luma_mode_searched(cpi, x, bsize, directional_mode_skip_mask))
       continue;
 
     if (prune_luma_odd_delta_angles_using_rd_cost(
@@ -1592,9 +1724,12 @@ int64_t av1_rd_pick_intra_sby_mode(const AV1_COMP *const cpi, MACROBLOCK *x,
             intra_sf->prune_luma_odd_delta_angles_in_intra))
       continue;
 
-    const TX_SIZE tx_size = AOMMIN(TX_32X32, max_txsize_lookup[bsize]);
+    if (mode_skip_mask[mbmi->mode] &
+        (1 << (luma_delta_angle + MAX_ANGLE_DELTA)))
+      continue;
+
     const int64_t this_model_rd =
-        intra_model_rd(&cpi->common, x, 0, bsize, tx_size, /*use_hadamard=*/1);
+        luma_model_rd(&cpi->common, x, bsize, model_tx_size, &model_rd_cache);
 
     const int model_rd_index_for_pruning =
         get_model_rd_index_for_pruning(x, intra_sf);
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "aom_mem/aom_mem.h"
+#include "av1/encoder/firstpass.h"
+#include "av1/encoder/lap_worker.h"
+
+static int lap_worker_hook(void *arg1, void *unused) {
+  (void)unused;
+  LapWorker *const lap = (LapWorker *)arg1;
+  AV1_PRIMARY *const ppi = lap->ppi;
+  // Errors raised on the primary compressor copy end the analysis here rather
+  // than in the caller of aom_codec_encode(), which runs on another thread.
+  if (setjmp(ppi->error.jmp)) {
+    ppi->error.setjmp = 0;
+    lap->status = ppi->error.error_code;
+    return 1;
+  }
+  ppi->error.setjmp = 1;
+  lap->status = av1_get_compressed_data(ppi->cpi_lap, &lap->cpi_data);
+  ppi->error.setjmp = 0;
+  return 1;
+}
+
+LapWorker *av1_lap_worker_alloc(void) {
+  LapWorker *const lap = (LapWorker *)aom_calloc(1, sizeof(*lap));
+  if (lap == NULL) return NULL;
+  lap->ppi = (AV1_PRIMARY *)aom_memalign(32, sizeof(*lap->ppi));
+  if (lap->ppi == NULL) {
+    aom_free(lap);
+    return NULL;
+  }
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  winterface->init(&lap->worker);
+  lap->worker.thread_name = "aom lap worker";
+  if (!winterface->reset(&lap->worker)) {
+    aom_free(lap->ppi);
+    aom_free(lap);
+    return NULL;
+  }
+  lap->worker.hook = lap_worker_hook;
+  lap->worker.data1 = lap;
+  lap->worker.data2 = NULL;
+  return lap;
+}
+
+void av1_lap_worker_launch(LapWorker *lap, AV1_PRIMARY *ppi, int flush,
+                           const aom_rational64_t *timestamp_ratio) {
+  assert(!lap->active);
+  AV1_COMP *const cpi_lap = ppi->cpi_lap;
+  memcpy(lap->ppi, ppi, sizeof(*ppi));
+  lap->ppi->error.setjmp = 0;
+  lap->stats_buf_ctx = *ppi->twopass.stats_buf_ctx;
+  lap->stats_in_end = lap->stats_buf_ctx.stats_in_end;
+  lap->stats_buf_ctx.total_stats = &lap->total_stats;
+  lap->ppi->twopass.stats_buf_ctx = &lap->stats_buf_ctx;
+  cpi_lap->ppi = lap->ppi;
+
+  // The worker pool belongs to the main encoder.
+  cpi_lap->mt_info.num_workers = 1;
+  for (int i = MOD_FP; i < NUM_MT_MODULES; i++)
+    cpi_lap->mt_info.num_mod_workers[i] =
+        AOMMIN(1, cpi_lap->mt_info.num_mod_workers[i]);
+
+  memset(&lap->cpi_data, 0, sizeof(lap->cpi_data));
+  lap->cpi_data.flush = flush;
+  lap->cpi_data.timestamp_ratio = timestamp_ratio;
+  lap->status = -1;
+  lap->active = 1;
+  aom_get_worker_interface()->launch(&lap->worker);
+}
+
+aom_codec_err_t av1_lap_worker_sync(LapWorker *lap, AV1_PRIMARY *ppi) {
+  if (!lap->active) return AOM_CODEC_OK;
+  aom_get_worker_interface()->sync(&lap->worker);
+  lap->active = 0;
+  AV1_COMP *const cpi_lap = ppi->cpi_lap;
+  cpi_lap->ppi = ppi;
+  if (lap->status != -1 && lap->status != AOM_CODEC_OK) {
+    return AOM_CODEC_ERROR;
+  }
+
+  TWO_PASS *const twopass = &ppi->twopass;
+  STATS_BUFFER_CTX *const stats_buf_ctx = twopass->stats_buf_ctx;
+  // The main encoder may have moved its stats down the buffer meanwhile (see
+  // input_stats_lap()), so copy the new ones to its current end.
+  for (const FIRSTPASS_STATS *stats = lap->stats_in_end;
+       stats < lap->stats_buf_ctx.stats_in_end; ++stats) {
+    FIRSTPASS_STATS *const this_frame_stats = stats_buf_ctx->stats_in_end;
+    *this_frame_stats = *stats;
+    av1_firstpass_info_push(&twopass->firstpass_info, this_frame_stats);
+    if (stats_buf_ctx->total_stats != NULL)
+      av1_accumulate_stats(stats_buf_ctx->total_stats, this_frame_stats);
+    stats_buf_ctx->stats_in_end++;
+  }
+  twopass->sr_update_lag = lap->ppi->twopass.sr_update_lag;
+
+  av1_post_encode_updates(cpi_lap, &lap->cpi_data);
+  return AOM_CODEC_OK;
+}
+
+void av1_lap_worker_free(LapWorker *lap) {
+  if (lap == NULL) return;
+  assert(!lap->active);
+  aom_get_worker_interface()->end(&lap->worker);
+  aom_free(lap->ppi);
+  aom_free(lap);
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+/*!\file
+ * \brief Runs the lookahead analysis (LAP) stage on a thread of its own, next
+ * to the encode of the previous frames.
+ */
+#ifndef AOM_AV1_ENCODER_LAP_WORKER_H_
+#define AOM_AV1_ENCODER_LAP_WORKER_H_
+
+#include "aom_util/aom_thread.h"
+#include "av1/encoder/encoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!\cond */
+
+typedef struct LapWorker {
+  AVxWorker worker;
+  // Copy of the primary compressor taken at launch. The LAP compressor points
+  // to it while it runs, so that it neither sees nor races with the changes
+  // the main encoder makes to the GF group, the first pass stats queue and
+  // the rest of the shared state.
+  AV1_PRIMARY *ppi;
+  // Stats buffer context of the copy. The stats of the analysed frame are
+  // written right after the end of the shared stats buffer and appended to
+  // it on sync.
+  STATS_BUFFER_CTX stats_buf_ctx;
+  FIRSTPASS_STATS total_stats;
+  // End of the shared stats buffer at launch.
+  const FIRSTPASS_STATS *stats_in_end;
+  AV1_COMP_DATA cpi_data;
+  // Return value of av1_get_compressed_data() for the LAP compressor.
+  int status;
+  // Whether a frame was launched and not synced yet.
+  int active;
+} LapWorker;
+
+/*!\endcond */
+
+/*!\brief Allocates the worker and starts its thread.
+ *
+ * \return The worker, or NULL if it could not be allocated.
+ */
+LapWorker *av1_lap_worker_alloc(void);
+
+/*!\brief Starts the analysis of the next lookahead frame.
+ *
+ * Runs av1_get_compressed_data() for ppi->cpi_lap on the worker thread. The
+ * LAP compressor is single threaded while it runs, and must not be touched
+ * until av1_lap_worker_sync() is called.
+ *
+ * \param[in]   lap              LAP worker
+ * \param[in]   ppi              Primary compressor
+ * \param[in]   flush            Whether the encoder is being flushed
+ * \param[in]   timestamp_ratio  Timebase to ticks ratio of the encoder
+ */
+void av1_lap_worker_launch(LapWorker *lap, AV1_PRIMARY *ppi, int flush,
+                           const aom_rational64_t *timestamp_ratio);
+
+/*!\brief Waits for the launched analysis and hands its results over to the
+ * main encoder.
+ *
+ * Appends the stats of the analysed frame to the shared stats buffer and runs
+ * the post encode updates of the LAP compressor, as the synchronous LAP stage
+ * does. Does nothing if no analysis is pending.
+ *
+ * \param[in]   lap   LAP worker
+ * \param[in]   ppi   Primary compressor
+ *
+ * \return AOM_CODEC_OK, or the error the analysis failed with.
+ */
+aom_codec_err_t av1_lap_worker_sync(LapWorker *lap, AV1_PRIMARY *ppi);
+
+/*!\brief Stops the worker thread and frees the worker. The pending analysis,
+ * if any, must have been synced. */
+void av1_lap_worker_free(LapWorker *lap);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // AOM_AV1_ENCODER_LAP_WORKER_H_
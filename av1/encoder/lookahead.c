@@ -13,6 +13,7 @@
 
 #include "config/aom_config.h"
 
+#include "aom_dsp/pyramid.h"
 #include "aom_scale/yv12config.h"
 #include "av1/common/common.h"
 #include "av1/encoder/encoder.h"
@@ -148,6 +149,10 @@ int av1_lookahead_push(struct lookahead_ctx *ctx, const YV12_BUFFER_CONFIG *src,
   }
   // Partial copy not implemented yet
   av1_copy_and_extend_frame(src, &buf->img);
+#if !CONFIG_REALTIME_ONLY
+  // The pyramid, if any, was built from the frame the buffer held before.
+  aom_invalidate_pyramid(buf->img.y_pyramid);
+#endif  // !CONFIG_REALTIME_ONLY
 
   buf->ts_start = ts_start;
   buf->ts_end = ts_end;
@@ -136,10 +136,12 @@ void av1_make_default_fullpel_ms_params(
     ms_params->sdx4df = ms_params->vfp->sdsx4df;
     // Skip version of sadx3 is not is not available yet
     ms_params->sdx3df = ms_params->vfp->sdsx4df;
+    ms_params->sdx8df = NULL;
   } else {
     ms_params->sdf = ms_params->vfp->sdf;
     ms_params->sdx4df = ms_params->vfp->sdx4df;
     ms_params->sdx3df = ms_params->vfp->sdx3df;
+    ms_params->sdx8df = ms_params->vfp->sdx8df;
   }
 
   ms_params->mesh_patterns[0] = mv_sf->mesh_patterns;
@@ -876,6 +878,64 @@ static AOM_INLINE int update_mvs_and_sad(const unsigned int this_sad,
   return 0;
 }
 
+// Maximum number of sites in one step of a search_site_config.
+#define MAX_RING_SITES 16
+
+// Computes the sads of num_sites consecutive search sites around
+// center_address. The candidates of a ring are batched into as few wide sad
+// calls as possible: 8 at a time when an 8-wide kernel is available, then 4 at
+// a time, and the leftovers one by one. All the sites must be inside the mv
+// limits.
+static AOM_INLINE void calc_ring_sads(
+    const FULLPEL_MOTION_SEARCH_PARAMS *ms_params, const search_site *site,
+    int num_sites, const uint8_t *center_address, unsigned int *sads) {
+  const struct buf_2d *const src = ms_params->ms_buffers.src;
+  const int ref_stride = ms_params->ms_buffers.ref->stride;
+  const uint8_t *block_offset[MAX_RING_SITES];
+  assert(num_sites <= MAX_RING_SITES);
+
+  for (int j = 0; j < num_sites; j++)
+    block_offset[j] = center_address + site[j].offset;
+
+  int j = 0;
+  if (ms_params->sdx8df != NULL) {
+    for (; j + 8 <= num_sites; j += 8) {
+      ms_params->sdx8df(src->buf, src->stride, block_offset + j, ref_stride,
+                        sads + j);
+    }
+  }
+  for (; j + 4 <= num_sites; j += 4) {
+    ms_params->sdx4df(src->buf, src->stride, block_offset + j, ref_stride,
+                      sads + j);
+  }
+  for (; j < num_sites; j++) {
+    sads[j] =
+        ms_params->sdf(src->buf, src->stride, block_offset[j], ref_stride);
+  }
+}
+
+// Calculate sad and update the bestmv information for a whole ring of
+// candidates that is known to be inside the mv limits.
+static AOM_INLINE void calc_sad_ring_update_bestmv(
+    const FULLPEL_MOTION_SEARCH_PARAMS *ms_params,
+    const MV_COST_PARAMS *mv_cost_params, FULLPEL_MV *best_mv,
+    const FULLPEL_MV center_mv, const uint8_t *center_address,
+    unsigned int *bestsad, unsigned int *raw_bestsad, int search_step,
+    int *best_site, const int num_candidates) {
+  const search_site *site = ms_params->search_sites->site[search_step];
+  unsigned int sads[MAX_RING_SITES];
+  calc_ring_sads(ms_params, site, num_candidates, center_address, sads);
+
+  for (int j = 0; j < num_candidates; j++) {
+    const FULLPEL_MV this_mv = { center_mv.row + site[j].mv.row,
+                                 center_mv.col + site[j].mv.col };
+    const int found_better_mv = update_mvs_and_sad(
+        sads[j], &this_mv, mv_cost_params, bestsad, raw_bestsad, best_mv,
+        /*second_best_mv=*/NULL);
+    if (found_better_mv) *best_site = j;
+  }
+}
+
 // Calculate sad4 and update the bestmv information
 // in FAST_DIAMOND search method.
 static AOM_INLINE void calc_sad4_update_bestmv(
@@ -1021,7 +1081,7 @@ static int pattern_search(FULLPEL_MV start_mv,
   static const int search_steps[MAX_MVSEARCH_STEPS] = {
     10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
   };
-  int i, s, t;
+  int s, t;
 
   const struct buf_2d *const src = ms_params->ms_buffers.src;
   const struct buf_2d *const ref = ms_params->ms_buffers.ref;
@@ -1062,19 +1122,10 @@ static int pattern_search(FULLPEL_MV start_mv,
       int best_site = -1;
       FULLPEL_MV center_mv = { br, bc };
       if (check_bounds(&ms_params->mv_limits, br, bc, 1 << t)) {
-        // Call 4-point sad for multiples of 4 candidates.
-        const int no_of_4_cand_loops = num_candidates[t] >> 2;
-        for (i = 0; i < no_of_4_cand_loops; i++) {
-          calc_sad4_update_bestmv(ms_params, mv_cost_params, best_mv, center_mv,
-                                  center_address, &bestsad, &raw_bestsad, t,
-                                  &best_site, i * 4, /*cost_list=*/NULL);
-        }
-        // Rest of the candidates
-        const int remaining_cand = num_candidates[t] % 4;
-        calc_sad_update_bestmv(ms_params, mv_cost_params, best_mv, center_mv,
-                               center_address, &bestsad, &raw_bestsad, t,
-                               &best_site, remaining_cand,
-                               no_of_4_cand_loops * 4, NULL);
+        calc_sad_ring_update_bestmv(ms_params, mv_cost_params, best_mv,
+                                    center_mv, center_address, &bestsad,
+                                    &raw_bestsad, t, &best_site,
+                                    num_candidates[t]);
       } else {
         calc_sad_update_bestmv(ms_params, mv_cost_params, best_mv, center_mv,
                                center_address, &bestsad, &raw_bestsad, t,
@@ -1106,20 +1157,10 @@ static int pattern_search(FULLPEL_MV start_mv,
       if (!do_init_search || s != best_init_s) {
         FULLPEL_MV center_mv = { br, bc };
         if (check_bounds(&ms_params->mv_limits, br, bc, 1 << s)) {
-          // Call 4-point sad for multiples of 4 candidates.
-          const int no_of_4_cand_loops = num_candidates[s] >> 2;
-          for (i = 0; i < no_of_4_cand_loops; i++) {
-            calc_sad4_update_bestmv(ms_params, mv_cost_params, best_mv,
-                                    center_mv, center_address, &bestsad,
-                                    &raw_bestsad, s, &best_site, i * 4,
-                                    /*cost_list=*/NULL);
-          }
-          // Rest of the candidates
-          const int remaining_cand = num_candidates[s] % 4;
-          calc_sad_update_bestmv(ms_params, mv_cost_params, best_mv, center_mv,
-                                 center_address, &bestsad, &raw_bestsad, s,
-                                 &best_site, remaining_cand,
-                                 no_of_4_cand_loops * 4, NULL);
+          calc_sad_ring_update_bestmv(ms_params, mv_cost_params, best_mv,
+                                      center_mv, center_address, &bestsad,
+                                      &raw_bestsad, s, &best_site,
+                                      num_candidates[s]);
         } else {
           calc_sad_update_bestmv(ms_params, mv_cost_params, best_mv, center_mv,
                                  center_address, &bestsad, &raw_bestsad, s,
@@ -1344,8 +1385,6 @@ static int diamond_search_sad(FULLPEL_MV start_mv,
   const struct buf_2d *const src = ms_params->ms_buffers.src;
   const struct buf_2d *const ref = ms_params->ms_buffers.ref;
 
-  const uint8_t *src_buf = src->buf;
-  const int src_stride = src->stride;
   const int ref_stride = ref->stride;
 
   const MV_COST_PARAMS *mv_cost_params = &ms_params->mv_cost_params;
@@ -1419,26 +1458,19 @@ static int diamond_search_sad(FULLPEL_MV start_mv,
       all_in &= best_mv->col + site[4].mv.col <= ms_params->mv_limits.col_max;
 
       if (all_in) {
-        for (int idx = 1; idx <= num_searches; idx += 4) {
-          unsigned char const *block_offset[4];
-          unsigned int sads[4];
+        // Evaluate the whole ring before comparing any of its candidates.
+        unsigned int sads[MAX_RING_SITES];
+        calc_ring_sads(ms_params, site + 1, num_searches, best_address, sads);
 
-          for (int j = 0; j < 4; j++)
-            block_offset[j] = site[idx + j].offset + best_address;
-
-          ms_params->sdx4df(src_buf, src_stride, block_offset, ref_stride,
-                            sads);
-          for (int j = 0; j < 4; j++) {
-            if (sads[j] < bestsad) {
-              const FULLPEL_MV this_mv = { best_mv->row + site[idx + j].mv.row,
-                                           best_mv->col +
-                                               site[idx + j].mv.col };
-              unsigned int thissad =
-                  sads[j] + mvsad_err_cost_(&this_mv, mv_cost_params);
-              if (thissad < bestsad) {
-                bestsad = thissad;
-                best_site = idx + j;
-              }
+        for (int idx = 1; idx <= num_searches; idx++) {
+          if (sads[idx - 1] < bestsad) {
+            const FULLPEL_MV this_mv = { best_mv->row + site[idx].mv.row,
+                                         best_mv->col + site[idx].mv.col };
+            unsigned int thissad =
+                sads[idx - 1] + mvsad_err_cost_(&this_mv, mv_cost_params);
+            if (thissad < bestsad) {
+              bestsad = thissad;
+              best_site = idx;
             }
           }
         }
@@ -1866,6 +1898,7 @@ int av1_full_pixel_search(const FULLPEL_MV start_mv,
       new_ms_params.sdf = new_ms_params.vfp->sdf;
       new_ms_params.sdx4df = new_ms_params.vfp->sdx4df;
       new_ms_params.sdx3df = new_ms_params.vfp->sdx3df;
+      new_ms_params.sdx8df = new_ms_params.vfp->sdx8df;
 
       return av1_full_pixel_search(start_mv, &new_ms_params, step_param,
                                    cost_list, best_mv, second_best_mv);
@@ -2167,6 +2200,142 @@ unsigned int av1_int_pro_motion_estimation(const AV1_COMP *cpi, MACROBLOCK *x,
   return best_sad;
 }
 
+#if !CONFIG_REALTIME_ONLY
+// =============================================================================
+//  Fullpixel Motion Search: Pyramid
+// =============================================================================
+// Radius of the exhaustive search on the coarsest pyramid level.
+#define PYRAMID_SEARCH_RANGE 8
+
+static unsigned int pyramid_sad(const uint8_t *src, int src_stride,
+                                const uint8_t *ref, int ref_stride, int w,
+                                int h) {
+  if (w == h) {
+    switch (w) {
+      case 4: return aom_sad4x4(src, src_stride, ref, ref_stride);
+      case 8: return aom_sad8x8(src, src_stride, ref, ref_stride);
+      case 16: return aom_sad16x16(src, src_stride, ref, ref_stride);
+      case 32: return aom_sad32x32(src, src_stride, ref, ref_stride);
+      default: break;
+    }
+  }
+  unsigned int sad = 0;
+  for (int r = 0; r < h; ++r) {
+    for (int c = 0; c < w; ++c) sad += abs(src[c] - ref[c]);
+    src += src_stride;
+    ref += ref_stride;
+  }
+  return sad;
+}
+
+// Searches the square window of the given radius around *best_mv on one
+// pyramid level. Updates *best_mv and *best_sad and returns 1 if a position
+// with a lower SAD than *best_sad was found.
+static int pyramid_level_search(const PyramidLayer *src_layer,
+                                const PyramidLayer *ref_layer, int x, int y,
+                                int w, int h, int radius,
+                                const FullMvLimits *limits,
+                                FULLPEL_MV *best_mv, unsigned int *best_sad) {
+  int improved = 0;
+  const uint8_t *const src = src_layer->buffer + y * src_layer->stride + x;
+  const FULLPEL_MV center = *best_mv;
+  const int row_min = AOMMAX(limits->row_min, center.row - radius);
+  const int row_max = AOMMIN(limits->row_max, center.row + radius);
+  const int col_min = AOMMAX(limits->col_min, center.col - radius);
+  const int col_max = AOMMIN(limits->col_max, center.col + radius);
+  for (int row = row_min; row <= row_max; ++row) {
+    const uint8_t *const ref =
+        ref_layer->buffer + (y + row) * ref_layer->stride + x;
+    for (int col = col_min; col <= col_max; ++col) {
+      const unsigned int sad =
+          pyramid_sad(src, src_layer->stride, ref + col, ref_layer->stride, w,
+                      h);
+      if (sad < *best_sad) {
+        *best_sad = sad;
+        best_mv->row = row;
+        best_mv->col = col;
+        improved = 1;
+      }
+    }
+  }
+  return improved;
+}
+
+FULLPEL_MV av1_pyramid_full_pixel_search(const ImagePyramid *src_pyr,
+                                         const ImagePyramid *ref_pyr, int x,
+                                         int y, int bw, int bh, int max_levels,
+                                         const FullMvLimits *mv_limits,
+                                         FULLPEL_MV start_mv) {
+  // Go up while the block still covers at least 4x4 pixels.
+  const int num_levels = AOMMIN(src_pyr->n_levels, ref_pyr->n_levels);
+  int top = AOMMIN(max_levels, num_levels - 1);
+  while (top > 0 && (AOMMIN(bw, bh) >> top) < 4) --top;
+  if (top <= 0) return start_mv;
+
+  FULLPEL_MV best_mv = kZeroFullMv;
+  unsigned int best_sad = UINT_MAX;
+  for (int level = top; level >= 1; --level) {
+    const PyramidLayer *const src_layer = &src_pyr->layers[level];
+    const PyramidLayer *const ref_layer = &ref_pyr->layers[level];
+    if (src_layer->width != ref_layer->width ||
+        src_layer->height != ref_layer->height)
+      return start_mv;
+    const int lx = x >> level;
+    const int ly = y >> level;
+    const int lw = bw >> level;
+    const int lh = bh >> level;
+    // The block and its displaced copies have to stay inside the padded
+    // layer.
+    if (lx + lw > src_layer->width + PYRAMID_PADDING ||
+        ly + lh > src_layer->height + PYRAMID_PADDING)
+      return start_mv;
+    FullMvLimits limits;
+    limits.col_min = AOMMAX(-((-mv_limits->col_min) >> level),
+                            -PYRAMID_PADDING - lx);
+    limits.col_max = AOMMIN(mv_limits->col_max >> level,
+                            src_layer->width + PYRAMID_PADDING - lw - lx);
+    limits.row_min = AOMMAX(-((-mv_limits->row_min) >> level),
+                            -PYRAMID_PADDING - ly);
+    limits.row_max = AOMMIN(mv_limits->row_max >> level,
+                            src_layer->height + PYRAMID_PADDING - lh - ly);
+    if (limits.col_min > limits.col_max || limits.row_min > limits.row_max)
+      return start_mv;
+
+    if (level == top) {
+      // Exhaustive search on the coarsest level around the scaled starting
+      // vector, plus the zero vector if the window does not cover it.
+      best_mv.row = start_mv.row >> level;
+      best_mv.col = start_mv.col >> level;
+      clamp_fullmv(&best_mv, &limits);
+      const int covers_zero = abs(best_mv.row) <= PYRAMID_SEARCH_RANGE &&
+                              abs(best_mv.col) <= PYRAMID_SEARCH_RANGE;
+      pyramid_level_search(src_layer, ref_layer, lx, ly, lw, lh,
+                           PYRAMID_SEARCH_RANGE, &limits, &best_mv, &best_sad);
+      FULLPEL_MV zero_mv = kZeroFullMv;
+      clamp_fullmv(&zero_mv, &limits);
+      if (!covers_zero &&
+          pyramid_level_search(src_layer, ref_layer, lx, ly, lw, lh, 1,
+                               &limits, &zero_mv, &best_sad)) {
+        best_mv = zero_mv;
+      }
+    } else {
+      // Refine the vector found on the level above.
+      best_mv.row *= 2;
+      best_mv.col *= 2;
+      clamp_fullmv(&best_mv, &limits);
+      best_sad = UINT_MAX;
+      pyramid_level_search(src_layer, ref_layer, lx, ly, lw, lh, 1, &limits,
+                           &best_mv, &best_sad);
+    }
+  }
+
+  best_mv.row *= 2;
+  best_mv.col *= 2;
+  clamp_fullmv(&best_mv, mv_limits);
+  return best_mv;
+}
+#endif  // !CONFIG_REALTIME_ONLY
+
 // =============================================================================
 //  Fullpixel Motion Search: OBMC
 // =============================================================================
@@ -16,6 +16,7 @@
 #include "av1/encoder/block.h"
 #include "av1/encoder/rd.h"
 
+#include "aom_dsp/pyramid.h"
 #include "aom_dsp/variance.h"
 
 #ifdef __cplusplus
@@ -138,6 +139,9 @@ typedef struct {
   aom_sad_fn_t sdf;
   aom_sad_multi_d_fn_t sdx4df;
   aom_sad_multi_d_fn_t sdx3df;
+  // 8-wide version of sdx4df used to evaluate whole search rings at once. May
+  // be NULL, in which case the rings are evaluated 4 candidates at a time.
+  aom_sad_multi_d_fn_t sdx8df;
 } FULLPEL_MOTION_SEARCH_PARAMS;
 
 void av1_init_obmc_buffer(OBMCBuffer *obmc_buffer);
@@ -283,6 +287,21 @@ int av1_obmc_full_pixel_search(const FULLPEL_MV start_mv,
                                const FULLPEL_MOTION_SEARCH_PARAMS *ms_params,
                                const int step_param, FULLPEL_MV *best_mv);
 
+#if !CONFIG_REALTIME_ONLY
+// Coarse-to-fine search of the bw x bh luma block at (x, y) on the 8-bit
+// downsampled pyramids of the source and reference frames, which must have
+// been computed. Does an exhaustive search on the coarsest usable level, at
+// most max_levels above full resolution, and refines it down to half
+// resolution. Returns the result scaled to full resolution as a starting
+// point for av1_full_pixel_search() with a reduced range, or start_mv if the
+// pyramids cannot be used for this block.
+FULLPEL_MV av1_pyramid_full_pixel_search(const ImagePyramid *src_pyr,
+                                         const ImagePyramid *ref_pyr, int x,
+                                         int y, int bw, int bh, int max_levels,
+                                         const FullMvLimits *mv_limits,
+                                         FULLPEL_MV start_mv);
+#endif  // !CONFIG_REALTIME_ONLY
+
 static INLINE int av1_is_fullmv_in_range(const FullMvLimits *mv_limits,
                                          FULLPEL_MV mv) {
   return (mv.col >= mv_limits->col_min) && (mv.col <= mv_limits->col_max) &&
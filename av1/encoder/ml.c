@@ -11,9 +11,11 @@
 
 #include <assert.h>
 #include <math.h>
+#include <string.h>
 
 #include "aom_dsp/aom_dsp_common.h"
 #include "aom_dsp/mathutils.h"
+#include "aom_mem/aom_mem.h"
 #include "av1/encoder/ml.h"
 
 void av1_nn_output_prec_reduce(float *const output, int num_output) {
@@ -69,6 +71,129 @@ void av1_nn_predict_c(const float *input_nodes,
   if (reduce_prec) av1_nn_output_prec_reduce(output, nn_config->num_outputs);
 }
 
+void av1_nn_matvec_int16_c(const int16_t *input, const int16_t *weights,
+                           int num_inputs, int num_outputs, int32_t *output) {
+  assert(num_inputs % NN_QUANT_ALIGN == 0);
+  for (int node = 0; node < num_outputs; ++node) {
+    int32_t val = 0;
+    for (int i = 0; i < num_inputs; ++i) val += weights[i] * input[i];
+    output[node] = val;
+    weights += num_inputs;
+  }
+}
+
+float av1_nn_quantize_weights(const float *weights, int n, int16_t *out) {
+  float max_abs = 0.0f;
+  for (int i = 0; i < n; ++i) max_abs = AOMMAX(max_abs, fabsf(weights[i]));
+  if (max_abs == 0.0f) {
+    memset(out, 0, n * sizeof(*out));
+    return 0.0f;
+  }
+  const float inv_scale = NN_QUANT_WEIGHT_MAX / max_abs;
+  for (int i = 0; i < n; ++i) out[i] = (int16_t)lrintf(weights[i] * inv_scale);
+  return max_abs / NN_QUANT_WEIGHT_MAX;
+}
+
+float av1_nn_quantize_activations(const float *input, int n, int act_max,
+                                  int16_t *out) {
+  float max_abs = 0.0f;
+  for (int i = 0; i < n; ++i) max_abs = AOMMAX(max_abs, fabsf(input[i]));
+  if (max_abs == 0.0f) {
+    memset(out, 0, n * sizeof(*out));
+    return 0.0f;
+  }
+  const float inv_scale = act_max / max_abs;
+  for (int i = 0; i < n; ++i) out[i] = (int16_t)lrintf(input[i] * inv_scale);
+  return max_abs / act_max;
+}
+
+int av1_nn_quantize_config(const NN_CONFIG *nn_config,
+                           NN_QUANT_CONFIG *quant) {
+  memset(quant, 0, sizeof(*quant));
+  const int num_layers = nn_config->num_hidden_layers;
+  if (num_layers > NN_MAX_HIDDEN_LAYERS ||
+      nn_config->num_inputs > NN_MAX_NODES_PER_LAYER ||
+      nn_config->num_outputs > NN_MAX_NODES_PER_LAYER) {
+    return 0;
+  }
+  quant->num_inputs = nn_config->num_inputs;
+  quant->num_outputs = nn_config->num_outputs;
+  quant->num_hidden_layers = num_layers;
+  int num_inputs = nn_config->num_inputs;
+  for (int layer = 0; layer <= num_layers; ++layer) {
+    const int num_outputs = layer < num_layers
+                                ? nn_config->num_hidden_nodes[layer]
+                                : nn_config->num_outputs;
+    if (num_outputs > NN_MAX_NODES_PER_LAYER) {
+      av1_nn_free_quant_config(quant);
+      return 0;
+    }
+    if (layer < num_layers) quant->num_hidden_nodes[layer] = num_outputs;
+    const int padded =
+        (num_inputs + NN_QUANT_ALIGN - 1) & ~(NN_QUANT_ALIGN - 1);
+    quant->padded_inputs[layer] = padded;
+    quant->act_max[layer] = av1_nn_quant_act_max(padded);
+    quant->bias[layer] = nn_config->bias[layer];
+    quant->weights[layer] = (int16_t *)aom_calloc(
+        (size_t)num_outputs * padded, sizeof(*quant->weights[layer]));
+    quant->weight_scale[layer] = (float *)aom_malloc(
+        num_outputs * sizeof(*quant->weight_scale[layer]));
+    if (!quant->weights[layer] || !quant->weight_scale[layer]) {
+      av1_nn_free_quant_config(quant);
+      return 0;
+    }
+    for (int node = 0; node < num_outputs; ++node) {
+      quant->weight_scale[layer][node] = av1_nn_quantize_weights(
+          nn_config->weights[layer] + node * num_inputs, num_inputs,
+          quant->weights[layer] + node * padded);
+    }
+    num_inputs = num_outputs;
+  }
+  return 1;
+}
+
+void av1_nn_free_quant_config(NN_QUANT_CONFIG *quant) {
+  for (int layer = 0; layer <= NN_MAX_HIDDEN_LAYERS; ++layer) {
+    aom_free(quant->weights[layer]);
+    aom_free(quant->weight_scale[layer]);
+  }
+  memset(quant, 0, sizeof(*quant));
+}
+
+void av1_nn_predict_quant(const float *input_nodes,
+                          const NN_QUANT_CONFIG *quant, int reduce_prec,
+                          float *output) {
+  DECLARE_ALIGNED(32, int16_t, qbuf[NN_QUANT_MAX_INPUTS]);
+  int32_t acc[NN_MAX_NODES_PER_LAYER];
+  float buf[2][NN_MAX_NODES_PER_LAYER];
+  int num_input_nodes = quant->num_inputs;
+  const int num_layers = quant->num_hidden_layers;
+  for (int layer = 0; layer <= num_layers; ++layer) {
+    const int padded = quant->padded_inputs[layer];
+    const float in_scale = av1_nn_quantize_activations(
+        input_nodes, num_input_nodes, quant->act_max[layer], qbuf);
+    memset(qbuf + num_input_nodes, 0,
+           (padded - num_input_nodes) * sizeof(*qbuf));
+    const int is_output = layer == num_layers;
+    const int num_output_nodes =
+        is_output ? quant->num_outputs : quant->num_hidden_nodes[layer];
+    av1_nn_matvec_int16(qbuf, quant->weights[layer], padded, num_output_nodes,
+                        acc);
+    float *const output_nodes = is_output ? output : buf[layer & 1];
+    const float *const weight_scale = quant->weight_scale[layer];
+    const float *const bias = quant->bias[layer];
+    for (int node = 0; node < num_output_nodes; ++node) {
+      const float val =
+          acc[node] * (in_scale * weight_scale[node]) + bias[node];
+      // ReLU as activation function on the hidden layers.
+      output_nodes[node] = is_output ? val : AOMMAX(val, 0.0f);
+    }
+    num_input_nodes = num_output_nodes;
+    input_nodes = output_nodes;
+  }
+  if (reduce_prec) av1_nn_output_prec_reduce(output, quant->num_outputs);
+}
+
 #if CONFIG_NN_V2
 // Applies the ReLu activation to one fc layer
 // output[i] = Max(input[i],0.0f)
@@ -18,9 +18,20 @@ extern "C" {
 
 #include "config/av1_rtcd.h"
 
+#include "aom_dsp/aom_dsp_common.h"
+
 #define NN_MAX_HIDDEN_LAYERS 10
 #define NN_MAX_NODES_PER_LAYER 128
 
+// Quantized inference: weights are stored as int16 with a scale per output
+// node, activations are requantized to int16 with a scale per layer, and the
+// dot products accumulate in int32. Weight rows are padded with zeros to a
+// multiple of NN_QUANT_ALIGN inputs.
+#define NN_QUANT_WEIGHT_MAX 8191
+#define NN_QUANT_ALIGN 16
+#define NN_QUANT_MAX_INPUTS \
+  ((NN_MAX_NODES_PER_LAYER + NN_QUANT_ALIGN - 1) & ~(NN_QUANT_ALIGN - 1))
+
 struct NN_CONFIG {
   int num_inputs;         // Number of input nodes, i.e. features.
   int num_outputs;        // Number of output nodes.
@@ -66,6 +77,53 @@ void av1_nn_predict_v2(const float *features, NN_CONFIG_V2 *nn_config,
                        int reduce_prec, float *output);
 #endif  // CONFIG_NN_V2
 
+// Quantized copy of an NN_CONFIG, see av1_nn_quantize_config().
+typedef struct {
+  int num_inputs;
+  int num_outputs;
+  int num_hidden_layers;
+  int num_hidden_nodes[NN_MAX_HIDDEN_LAYERS];
+  // Number of inputs of each layer rounded up to NN_QUANT_ALIGN.
+  int padded_inputs[NN_MAX_HIDDEN_LAYERS + 1];
+  // Largest magnitude the inputs of each layer are quantized to, chosen so
+  // that the int32 accumulators cannot overflow.
+  int act_max[NN_MAX_HIDDEN_LAYERS + 1];
+  int16_t *weights[NN_MAX_HIDDEN_LAYERS + 1];
+  float *weight_scale[NN_MAX_HIDDEN_LAYERS + 1];
+  const float *bias[NN_MAX_HIDDEN_LAYERS + 1];
+} NN_QUANT_CONFIG;
+
+// Largest input magnitude that keeps dot products of padded_inputs terms
+// within int32 when weights are bounded by NN_QUANT_WEIGHT_MAX.
+static INLINE int av1_nn_quant_act_max(int padded_inputs) {
+  const int64_t max_act =
+      INT32_MAX / ((int64_t)padded_inputs * NN_QUANT_WEIGHT_MAX);
+  return (int)AOMMIN(max_act, INT16_MAX);
+}
+
+// Quantizes n weights to int16 in out, and returns the scale to multiply the
+// quantized values with to get the weights back.
+float av1_nn_quantize_weights(const float *weights, int n, int16_t *out);
+
+// Quantizes n activations to int16 values within +-act_max in out, and
+// returns the scale to multiply the quantized values with to get the
+// activations back.
+float av1_nn_quantize_activations(const float *input, int n, int act_max,
+                                  int16_t *out);
+
+// Builds the quantized copy of nn_config. Returns 0 if the network is too
+// large for the quantized path or on allocation failure, in which case quant
+// holds nothing to free.
+int av1_nn_quantize_config(const NN_CONFIG *nn_config, NN_QUANT_CONFIG *quant);
+
+void av1_nn_free_quant_config(NN_QUANT_CONFIG *quant);
+
+// Quantized counterpart of av1_nn_predict(). The inputs are quantized with a
+// single scale, so they should be normalized to comparable ranges.
+void av1_nn_predict_quant(const float *input_nodes,
+                          const NN_QUANT_CONFIG *quant, int reduce_prec,
+                          float *output);
+
 // Applies the softmax normalization function to the input
 // to get a valid probability distribution in the output:
 // output[i] = exp(input[i]) / sum_{k \in [0,n)}(exp(input[k]))
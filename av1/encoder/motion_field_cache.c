@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+
+#include "aom_mem/aom_mem.h"
+#include "av1/encoder/motion_field_cache.h"
+
+static void clear_level(MotionField *mf, int level) {
+  MotionFieldBlock *const blocks = mf->blocks[level];
+  if (blocks == NULL) return;
+  const int num_blocks = av1_mf_rows(mf, level) * av1_mf_cols(mf, level);
+  for (int i = 0; i < num_blocks; ++i) {
+    blocks[i].mv.as_int = INVALID_MV;
+    blocks[i].err = UINT32_MAX;
+  }
+}
+
+static void free_field(MotionField *mf) {
+  for (int level = 0; level < MF_NUM_LEVELS; ++level) {
+    aom_free(mf->blocks[level]);
+    mf->blocks[level] = NULL;
+  }
+  mf->in_use = 0;
+}
+
+MotionField *av1_mf_cache_get(MotionFieldCache *cache, int src_idx,
+                              int ref_idx, int width, int height) {
+  MotionField *victim = NULL;
+  for (int i = 0; i < MF_CACHE_MAX_FIELDS; ++i) {
+    MotionField *const mf = &cache->fields[i];
+    if (mf->in_use && mf->src_idx == src_idx && mf->ref_idx == ref_idx) {
+      victim = mf;
+      break;
+    }
+    if (victim == NULL || !mf->in_use ||
+        (victim->in_use && mf->last_use < victim->last_use)) {
+      victim = mf;
+    }
+  }
+  assert(victim != NULL);
+
+  if (!victim->in_use || victim->src_idx != src_idx ||
+      victim->ref_idx != ref_idx || victim->width != width ||
+      victim->height != height) {
+    // Keep the allocations when recycling a field of the same size.
+    if (victim->width != width || victim->height != height) free_field(victim);
+    victim->src_idx = src_idx;
+    victim->ref_idx = ref_idx;
+    victim->width = width;
+    victim->height = height;
+    victim->in_use = 1;
+    for (int level = 0; level < MF_NUM_LEVELS; ++level)
+      clear_level(victim, level);
+  }
+  victim->last_use = ++cache->use_count;
+  return victim;
+}
+
+const MotionField *av1_mf_cache_find(const MotionFieldCache *cache,
+                                     int src_idx, int ref_idx, int width,
+                                     int height) {
+  for (int i = 0; i < MF_CACHE_MAX_FIELDS; ++i) {
+    const MotionField *const mf = &cache->fields[i];
+    if (mf->in_use && mf->src_idx == src_idx && mf->ref_idx == ref_idx &&
+        mf->width == width && mf->height == height) {
+      return mf;
+    }
+  }
+  return NULL;
+}
+
+int av1_mf_alloc_level(MotionField *mf, int level) {
+  assert(level >= 0 && level < MF_NUM_LEVELS);
+  if (mf->blocks[level] != NULL) return 1;
+  const size_t num_blocks =
+      (size_t)av1_mf_rows(mf, level) * av1_mf_cols(mf, level);
+  mf->blocks[level] =
+      (MotionFieldBlock *)aom_malloc(num_blocks * sizeof(*mf->blocks[level]));
+  if (mf->blocks[level] == NULL) return 0;
+  clear_level(mf, level);
+  return 1;
+}
+
+void av1_mf_cache_free(MotionFieldCache *cache) {
+  for (int i = 0; i < MF_CACHE_MAX_FIELDS; ++i) free_field(&cache->fields[i]);
+  cache->use_count = 0;
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+/*!\file
+ * \brief Cache of source-to-source motion fields shared by the temporal
+ * filter, TPL and the final motion search.
+ */
+#ifndef AOM_AV1_ENCODER_MOTION_FIELD_CACHE_H_
+#define AOM_AV1_ENCODER_MOTION_FIELD_CACHE_H_
+
+#include <stdint.h>
+
+#include "av1/common/mv.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!\cond */
+
+// Maximum number of (source, reference) motion fields kept at once.
+#define MF_CACHE_MAX_FIELDS 32
+
+// Block sizes the fields are stored at: 8x8, 16x16 and 32x32.
+#define MF_MIN_BSIZE_LOG2 3
+#define MF_NUM_LEVELS 3
+
+typedef struct {
+  // Motion vector in 1/8 pel units, or INVALID_MV if the block was never
+  // searched.
+  int_mv mv;
+  // Motion search error of the block, normalized per pixel.
+  uint32_t err;
+} MotionFieldBlock;
+
+typedef struct {
+  // Display indices (see lookahead_entry::display_idx) of the frame that was
+  // searched and of the frame it was searched against.
+  int src_idx;
+  int ref_idx;
+  // Luma dimensions of the frames the field was computed on.
+  int width;
+  int height;
+  int in_use;
+  uint64_t last_use;
+  MotionFieldBlock *blocks[MF_NUM_LEVELS];
+} MotionField;
+
+typedef struct {
+  MotionField fields[MF_CACHE_MAX_FIELDS];
+  uint64_t use_count;
+} MotionFieldCache;
+
+// Returns the level index for a block of size (1 << bsize_log2), or -1 if the
+// size is not stored.
+static INLINE int av1_mf_level(int bsize_log2) {
+  const int level = bsize_log2 - MF_MIN_BSIZE_LOG2;
+  return (level >= 0 && level < MF_NUM_LEVELS) ? level : -1;
+}
+
+static INLINE int av1_mf_cols(const MotionField *mf, int level) {
+  const int log2 = level + MF_MIN_BSIZE_LOG2;
+  return (mf->width + (1 << log2) - 1) >> log2;
+}
+
+static INLINE int av1_mf_rows(const MotionField *mf, int level) {
+  const int log2 = level + MF_MIN_BSIZE_LOG2;
+  return (mf->height + (1 << log2) - 1) >> log2;
+}
+
+// Records the search result for the block covering luma pixel (x, y).
+static INLINE void av1_mf_store(MotionField *mf, int level, int x, int y,
+                                MV mv, uint32_t err) {
+  MotionFieldBlock *const blocks = mf->blocks[level];
+  if (blocks == NULL) return;
+  const int log2 = level + MF_MIN_BSIZE_LOG2;
+  const int row = y >> log2;
+  const int col = x >> log2;
+  if (row >= av1_mf_rows(mf, level) || col >= av1_mf_cols(mf, level)) return;
+  MotionFieldBlock *const b = &blocks[row * av1_mf_cols(mf, level) + col];
+  b->mv.as_mv = mv;
+  b->err = err;
+}
+
+// Returns the cached block covering luma pixel (x, y), preferring the given
+// level and falling back to the closest other stored level. Returns NULL if
+// no level holds a searched vector for that position. *found_level is set to
+// the level the block came from.
+static INLINE const MotionFieldBlock *av1_mf_lookup(const MotionField *mf,
+                                                    int level, int x, int y,
+                                                    int *found_level) {
+  static const int kLevelOrder[MF_NUM_LEVELS][MF_NUM_LEVELS] = {
+    { 0, 1, 2 }, { 1, 0, 2 }, { 2, 1, 0 }
+  };
+  if (mf == NULL || x < 0 || y < 0 || x >= mf->width || y >= mf->height)
+    return NULL;
+  for (int i = 0; i < MF_NUM_LEVELS; ++i) {
+    const int l = kLevelOrder[level][i];
+    const MotionFieldBlock *const blocks = mf->blocks[l];
+    if (blocks == NULL) continue;
+    const int log2 = l + MF_MIN_BSIZE_LOG2;
+    const MotionFieldBlock *const b =
+        &blocks[(y >> log2) * av1_mf_cols(mf, l) + (x >> log2)];
+    if (b->mv.as_int == INVALID_MV) continue;
+    if (found_level) *found_level = l;
+    return b;
+  }
+  return NULL;
+}
+
+/*!\endcond */
+
+/*!\brief Returns the motion field for the given frame pair, creating it if it
+ * is not cached yet.
+ *
+ * The least recently used field is recycled when the cache is full. A field
+ * whose dimensions differ from \p width x \p height is cleared. Must not be
+ * called while other threads read or write fields of the same cache.
+ *
+ * \param[in]   cache       Motion field cache
+ * \param[in]   src_idx     Display index of the searched frame
+ * \param[in]   ref_idx     Display index of the reference frame
+ * \param[in]   width       Luma width of the frames
+ * \param[in]   height      Luma height of the frames
+ *
+ * \return Pointer to the field.
+ */
+MotionField *av1_mf_cache_get(MotionFieldCache *cache, int src_idx,
+                              int ref_idx, int width, int height);
+
+/*!\brief Returns the cached motion field for the given frame pair, or NULL if
+ * there is none at the given dimensions. Does not create or recycle fields.
+ */
+const MotionField *av1_mf_cache_find(const MotionFieldCache *cache,
+                                     int src_idx, int ref_idx, int width,
+                                     int height);
+
+/*!\brief Makes sure blocks of the given level are allocated for \p mf.
+ *
+ * \return 0 on allocation failure, 1 otherwise.
+ */
+int av1_mf_alloc_level(MotionField *mf, int level);
+
+/*!\brief Releases all the memory held by the cache. */
+void av1_mf_cache_free(MotionFieldCache *cache);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // AOM_AV1_ENCODER_MOTION_FIELD_CACHE_H_
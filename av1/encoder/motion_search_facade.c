@@ -117,6 +117,53 @@ static INLINE void get_mv_candidate_from_tpl(const AV1_COMP *const cpi,
   }
 }
 
+// Replaces the starting point of the full pixel search by the vector cached
+// for this block between the sources of the current and the reference frame,
+// if it gives a lower SAD. Used for blocks without TPL stats.
+static INLINE void update_start_mv_from_mf_cache(const AV1_COMP *const cpi,
+                                                 const MACROBLOCK *x,
+                                                 BLOCK_SIZE bsize, int ref_idx,
+                                                 FULLPEL_MV *start_mv) {
+  const AV1_COMMON *cm = &cpi->common;
+  const MACROBLOCKD *xd = &x->e_mbd;
+  const RefCntBuffer *ref_buf =
+      get_ref_frame_buf(cm, xd->mi[0]->ref_frame[ref_idx]);
+  if (ref_buf == NULL) return;
+
+  const MotionField *mf = av1_mf_cache_find(
+      &cpi->ppi->mf_cache,
+      get_abs_display_idx(cpi, cm->current_frame.display_order_hint),
+      get_abs_display_idx(cpi, ref_buf->display_order_hint), cm->width,
+      cm->height);
+  if (mf == NULL) return;
+
+  const int bsize_log2 =
+      AOMMIN(mi_size_wide_log2[bsize], mi_size_high_log2[bsize]) +
+      MI_SIZE_LOG2;
+  const int level =
+      clamp(bsize_log2 - MF_MIN_BSIZE_LOG2, 0, MF_NUM_LEVELS - 1);
+  const MotionFieldBlock *b = av1_mf_lookup(
+      mf, level, xd->mi_col * MI_SIZE, xd->mi_row * MI_SIZE, NULL);
+  if (b == NULL) return;
+
+  const FULLPEL_MV mf_mv = get_fullmv_from_mv(&b->mv.as_mv);
+  if (!av1_is_fullmv_in_range(&x->mv_limits, mf_mv)) return;
+  FULLPEL_MV cur_mv = *start_mv;
+  clamp_fullmv(&cur_mv, &x->mv_limits);
+  if (mf_mv.row == cur_mv.row && mf_mv.col == cur_mv.col) return;
+
+  const struct buf_2d *const src = &x->plane[0].src;
+  const struct buf_2d *const pre = &xd->plane[0].pre[ref_idx];
+  const aom_variance_fn_ptr_t *const fn_ptr = &cpi->ppi->fn_ptr[bsize];
+  const unsigned int mf_sad =
+      fn_ptr->sdf(src->buf, src->stride,
+                  get_buf_from_fullmv(pre, &mf_mv), pre->stride);
+  const unsigned int cur_sad =
+      fn_ptr->sdf(src->buf, src->stride,
+                  get_buf_from_fullmv(pre, &cur_mv), pre->stride);
+  if (mf_sad < cur_sad) *start_mv = mf_mv;
+}
+
 void av1_single_motion_search(const AV1_COMP *const cpi, MACROBLOCK *x,
                               BLOCK_SIZE bsize, int ref_idx, int *rate_mv,
                               int search_range, inter_mode_info *mode_info,
@@ -169,6 +216,11 @@ void av1_single_motion_search(const AV1_COMP *const cpi, MACROBLOCK *x,
   else
     start_mv = get_fullmv_from_mv(&ref_mv);
 
+  if (!x->sb_enc.tpl_data_count && use_motion_field_cache(cpi) &&
+      mbmi->motion_mode == SIMPLE_TRANSLATION) {
+    update_start_mv_from_mf_cache(cpi, x, bsize, ref_idx, &start_mv);
+  }
+
   // cand stores start_mv and all possible MVs in a SB.
   cand_mv_t cand[MAX_TPL_BLK_IN_SB * MAX_TPL_BLK_IN_SB + 1];
   av1_zero(cand);
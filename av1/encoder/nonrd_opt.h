@@ -103,6 +103,11 @@ typedef struct {
   int use_ref_frame_mask[REF_FRAMES];
   //! Array to hold flags of evaluated modes for each reference frame
   uint8_t mode_checked[MB_MODE_COUNT][REF_FRAMES];
+  //! Reference frame of the decision reused from the last frame, or
+  //! NONE_FRAME if the full search is done
+  MV_REFERENCE_FRAME reuse_ref_frame;
+  //! Mode of the decision reused from the last frame
+  PREDICTION_MODE reuse_mode;
 } InterModeSearchStateNonrd;
 
 static const uint8_t b_width_log2_lookup[BLOCK_SIZES] = { 0, 0, 1, 1, 1, 2,
@@ -2359,6 +2359,14 @@ static AOM_FORCE_INLINE bool skip_inter_mode_nonrd(
        *ref_frame != LAST_FRAME))
     return true;
 
+  // When the decision of the last frame is reused, only search its reference
+  // frame, and only its mode unless that was NEWMV.
+  if (search_state->reuse_ref_frame != NONE_FRAME &&
+      (!*is_single_pred || *ref_frame != search_state->reuse_ref_frame ||
+       (search_state->reuse_mode != NEWMV &&
+        *this_mode != search_state->reuse_mode)))
+    return true;
+
   // Skip compound mode based on variance of previously evaluated single
   // reference modes.
   if (rt_sf->prune_compoundmode_with_singlemode_var && !*is_single_pred &&
@@ -3002,38 +3010,13 @@ static AOM_FORCE_INLINE void handle_screen_content_mode_nonrd(
   }
 }
 
-/*!\brief AV1 inter mode selection based on Non-RD optimized model.
- *
- * \ingroup nonrd_mode_search
- * \callgraph
- * Top level function for Non-RD optimized inter mode selection.
- * This finction will loop over subset of inter modes and select the best one
- * based on calculated modelled RD cost. While making decisions which modes to
- * check, this function applies heuristics based on previously checked modes,
- * block residual variance, block size, and other factors to prune certain
- * modes and reference frames. Currently only single reference frame modes
- * are checked. Additional heuristics are applied to decide if intra modes
- *  need to be checked.
- *  *
- * \param[in]    cpi            Top-level encoder structure
- * \param[in]    tile_data      Pointer to struct holding adaptive
-                                data/contexts/models for the tile during
-                                encoding
- * \param[in]    x              Pointer to structure holding all the data for
-                                the current macroblock
- * \param[in]    rd_cost        Struct to keep track of the RD information
- * \param[in]    bsize          Current block size
- * \param[in]    ctx            Structure to hold snapshot of coding context
-                                during the mode picking process
- *
- * \remark Nothing is returned. Instead, the MB_MODE_INFO struct inside x
- * is modified to store information about the best mode computed
- * in this function. The rd_cost struct is also updated with the RD stats
- * corresponding to the best mode found.
- */
-void av1_nonrd_pick_inter_mode_sb(AV1_COMP *cpi, TileDataEnc *tile_data,
+// Picks the mode of the block. If 'reuse' is not NULL, only the decision of the
+// last frame is evaluated, and false is returned without finalizing the block
+// if it no longer predicts about as well as it did.
+static bool nonrd_pick_inter_mode(AV1_COMP *cpi, TileDataEnc *tile_data,
                                   MACROBLOCK *x, RD_STATS *rd_cost,
-                                  BLOCK_SIZE bsize, PICK_MODE_CONTEXT *ctx) {
+                                  BLOCK_SIZE bsize, PICK_MODE_CONTEXT *ctx,
+                                  const NONRD_BLOCK_DECISION *reuse) {
   AV1_COMMON *const cm = &cpi->common;
   SVC *const svc = &cpi->svc;
   MACROBLOCKD *const xd = &x->e_mbd;
@@ -3056,6 +3039,8 @@ void av1_nonrd_pick_inter_mode_sb(AV1_COMP *cpi, TileDataEnc *tile_data,
       rt_sf->reuse_inter_pred_nonrd && cm->seq_params->bit_depth == AOM_BITS_8;
   InterModeSearchStateNonrd search_state;
   av1_zero(search_state.use_ref_frame_mask);
+  search_state.reuse_ref_frame = reuse ? reuse->ref_frame : NONE_FRAME;
+  search_state.reuse_mode = reuse ? reuse->mode : NEARESTMV;
   BEST_PICKMODE *const best_pickmode = &search_state.best_pickmode;
   (void)tile_data;
 
@@ -3229,6 +3214,14 @@ void av1_nonrd_pick_inter_mode_sb(AV1_COMP *cpi, TileDataEnc *tile_data,
     }
   }
 
+  if (reuse != NULL) {
+    const int64_t thresh_sse =
+        (int64_t)reuse->sse + (reuse->sse >> 2) + (pixels_in_block << 2);
+    if (search_state.best_rdc.rdcost == INT64_MAX ||
+        search_state.best_rdc.sse > thresh_sse)
+      return false;
+  }
+
   // Restore mode data of best inter mode
   mi->mode = best_pickmode->best_mode;
   mi->motion_mode = best_pickmode->best_motion_mode;
@@ -3278,17 +3271,19 @@ void av1_nonrd_pick_inter_mode_sb(AV1_COMP *cpi, TileDataEnc *tile_data,
   }
 
   // Evaluate Intra modes in inter frame
-  if (!x->force_zeromv_skip_for_blk)
+  if (!x->force_zeromv_skip_for_blk && reuse == NULL)
     av1_estimate_intra_mode(cpi, x, bsize, best_early_term,
                             search_state.ref_costs_single[INTRA_FRAME],
                             reuse_inter_pred, &orig_dst, tmp_buffer,
                             &this_mode_pred, &search_state.best_rdc,
                             best_pickmode, ctx);
 
-  int skip_idtx_palette = (x->color_sensitivity[COLOR_SENS_IDX(AOM_PLANE_U)] ||
-                           x->color_sensitivity[COLOR_SENS_IDX(AOM_PLANE_V)]) &&
-                          x->content_state_sb.source_sad_nonrd != kZeroSad &&
-                          !cpi->rc.high_source_sad;
+  int skip_idtx_palette =
+      reuse != NULL ||
+      ((x->color_sensitivity[COLOR_SENS_IDX(AOM_PLANE_U)] ||
+        x->color_sensitivity[COLOR_SENS_IDX(AOM_PLANE_V)]) &&
+       x->content_state_sb.source_sad_nonrd != kZeroSad &&
+       !cpi->rc.high_source_sad);
 
   int try_palette =
       !skip_idtx_palette && cpi->oxcf.tool_cfg.enable_palette &&
@@ -3399,4 +3394,209 @@ void av1_nonrd_pick_inter_mode_sb(AV1_COMP *cpi, TileDataEnc *tile_data,
 #endif  // COLLECT_NONRD_PICK_MODE_STAT
 
   *rd_cost = search_state.best_rdc;
+  return true;
+}
+
+// Returns the decision of the last frame for the block if it can be reused.
+static const NONRD_BLOCK_DECISION *get_reusable_decision(
+    const AV1_COMP *cpi, const MACROBLOCK *x, BLOCK_SIZE bsize) {
+  if (!x->reuse_sb_decisions) return NULL;
+  const NONRD_DECISION_CACHE *const cache = &cpi->nonrd_decisions;
+  const MACROBLOCKD *const xd = &x->e_mbd;
+  const NONRD_BLOCK_DECISION *const d =
+      &cache->blocks[cache->cur_idx ^ 1]
+                    [xd->mi_row * cache->mi_cols + xd->mi_col];
+  if (d->bsize != bsize || d->sse == UINT32_MAX) return NULL;
+  if (!(cpi->ref_frame_flags & av1_ref_frame_flag_list[d->ref_frame]))
+    return NULL;
+  return d;
+}
+
+/*!\brief AV1 inter mode selection based on Non-RD optimized model.
+ *
+ * \ingroup nonrd_mode_search
+ * \callgraph
+ * Top level function for Non-RD optimized inter mode selection.
+ * This finction will loop over subset of inter modes and select the best one
+ * based on calculated modelled RD cost. While making decisions which modes to
+ * check, this function applies heuristics based on previously checked modes,
+ * block residual variance, block size, and other factors to prune certain
+ * modes and reference frames. Currently only single reference frame modes
+ * are checked. Additional heuristics are applied to decide if intra modes
+ *  need to be checked.
+ *  *
+ * \param[in]    cpi            Top-level encoder structure
+ * \param[in]    tile_data      Pointer to struct holding adaptive
+                                data/contexts/models for the tile during
+                                encoding
+ * \param[in]    x              Pointer to structure holding all the data for
+                                the current macroblock
+ * \param[in]    rd_cost        Struct to keep track of the RD information
+ * \param[in]    bsize          Current block size
+ * \param[in]    ctx            Structure to hold snapshot of coding context
+                                during the mode picking process
+ *
+ * \remark Nothing is returned. Instead, the MB_MODE_INFO struct inside x
+ * is modified to store information about the best mode computed
+ * in this function. The rd_cost struct is also updated with the RD stats
+ * corresponding to the best mode found.
+ */
+void av1_nonrd_pick_inter_mode_sb(AV1_COMP *cpi, TileDataEnc *tile_data,
+                                  MACROBLOCK *x, RD_STATS *rd_cost,
+                                  BLOCK_SIZE bsize, PICK_MODE_CONTEXT *ctx) {
+  const NONRD_BLOCK_DECISION *const reuse =
+      get_reusable_decision(cpi, x, bsize);
+  if (reuse == NULL ||
+      !nonrd_pick_inter_mode(cpi, tile_data, x, rd_cost, bsize, ctx, reuse)) {
+    nonrd_pick_inter_mode(cpi, tile_data, x, rd_cost, bsize, ctx, NULL);
+  }
+
+  NONRD_DECISION_CACHE *const cache = &cpi->nonrd_decisions;
+  if (cpi->sf.rt_sf.reuse_sb_decisions_nonrd && cache->blocks[0] != NULL) {
+    const MACROBLOCKD *const xd = &x->e_mbd;
+    NONRD_BLOCK_DECISION *const d =
+        &cache->blocks[cache->cur_idx]
+                      [xd->mi_row * cache->mi_cols + xd->mi_col];
+    d->picked_bsize = bsize;
+    d->sse = (uint32_t)AOMMIN(rd_cost->sse, UINT32_MAX - 1);
+  }
+}
+
+// Returns the sum of the 8x8 luma source averages of the superblock.
+static uint32_t get_sb_fingerprint(const AV1_COMP *cpi, const MACROBLOCK *x,
+                                   int mi_row, int mi_col, int *num_blocks) {
+  const CommonModeInfoParams *const mi_params = &cpi->common.mi_params;
+  const int mib_size = cpi->common.seq_params->mib_size;
+  const struct buf_2d *const src = &x->plane[AOM_PLANE_Y].src;
+  const int rows = AOMMIN(mib_size, mi_params->mi_rows - mi_row) & ~1;
+  const int cols = AOMMIN(mib_size, mi_params->mi_cols - mi_col) & ~1;
+  uint32_t sum = 0;
+  for (int r = 0; r < rows; r += 2) {
+    for (int c = 0; c < cols; c += 2) {
+      sum += aom_avg_8x8(src->buf + (r * src->stride + c) * MI_SIZE,
+                         src->stride);
+    }
+  }
+  *num_blocks = (rows >> 1) * (cols >> 1);
+  return sum;
+}
+
+void av1_nonrd_decision_cache_setup(AV1_COMP *cpi) {
+  AV1_COMMON *const cm = &cpi->common;
+  NONRD_DECISION_CACHE *const cache = &cpi->nonrd_decisions;
+  if (!cpi->sf.rt_sf.reuse_sb_decisions_nonrd) return;
+
+  const int mi_rows = cm->mi_params.mi_rows;
+  const int mi_cols = cm->mi_params.mi_cols;
+  const int mib_size_log2 = cm->seq_params->mib_size_log2;
+  const int sb_cols = (mi_cols + (1 << mib_size_log2) - 1) >> mib_size_log2;
+  const int sb_rows = (mi_rows + (1 << mib_size_log2) - 1) >> mib_size_log2;
+  if (cache->blocks[0] == NULL || cache->mi_rows != mi_rows ||
+      cache->mi_cols != mi_cols || cache->sb_cols != sb_cols) {
+    av1_nonrd_decision_cache_free(cache);
+    for (int i = 0; i < 2; ++i) {
+      CHECK_MEM_ERROR(cm, cache->blocks[i],
+                      aom_calloc((size_t)mi_rows * mi_cols,
+                                 sizeof(*cache->blocks[i])));
+      CHECK_MEM_ERROR(
+          cm, cache->sbs[i],
+          aom_calloc((size_t)sb_rows * sb_cols, sizeof(*cache->sbs[i])));
+    }
+    cache->mi_rows = mi_rows;
+    cache->mi_cols = mi_cols;
+    cache->sb_cols = sb_cols;
+    cache->sb_rows = sb_rows;
+  } else {
+    cache->cur_idx ^= 1;
+  }
+  // Decisions are only reused from the frame just before the current one.
+  if (cache->frame_number + 1 != cm->current_frame.frame_number) {
+    memset(cache->sbs[cache->cur_idx ^ 1], 0,
+           (size_t)sb_rows * sb_cols * sizeof(*cache->sbs[0]));
+  }
+  cache->frame_number = cm->current_frame.frame_number;
+}
+
+void av1_nonrd_decision_cache_free(NONRD_DECISION_CACHE *cache) {
+  for (int i = 0; i < 2; ++i) {
+    aom_free(cache->blocks[i]);
+    cache->blocks[i] = NULL;
+    aom_free(cache->sbs[i]);
+    cache->sbs[i] = NULL;
+  }
+}
+
+int av1_nonrd_reuse_sb_decisions(AV1_COMP *cpi, MACROBLOCK *x, int mi_row,
+                                 int mi_col) {
+  const AV1_COMMON *const cm = &cpi->common;
+  NONRD_DECISION_CACHE *const cache = &cpi->nonrd_decisions;
+  const int max_reuse_count = cpi->sf.rt_sf.reuse_sb_decisions_nonrd;
+  if (!max_reuse_count || cache->blocks[0] == NULL) return 0;
+
+  const int mib_size_log2 = cm->seq_params->mib_size_log2;
+  const int sb_idx =
+      (mi_row >> mib_size_log2) * cache->sb_cols + (mi_col >> mib_size_log2);
+  NONRD_SB_DECISION *const cur = &cache->sbs[cache->cur_idx][sb_idx];
+  const NONRD_SB_DECISION *const prev = &cache->sbs[cache->cur_idx ^ 1][sb_idx];
+  cur->valid = 0;
+  if (is_cur_buf_hbd(&x->e_mbd)) return 0;
+
+  int num_blocks;
+  const uint32_t fingerprint =
+      get_sb_fingerprint(cpi, x, mi_row, mi_col, &num_blocks);
+  // The source must have barely changed since the last frame, and must not
+  // have drifted away from the frame the decisions were made on.
+  const int reuse =
+      prev->valid && prev->reuse_count < max_reuse_count &&
+      !frame_is_intra_only(cm) && !cpi->ppi->use_svc &&
+      !cpi->rc.high_source_sad &&
+      x->content_state_sb.source_sad_nonrd <= kVeryLowSad &&
+      abs((int)fingerprint - (int)prev->fingerprint) <= num_blocks;
+  cur->fingerprint = reuse ? prev->fingerprint : fingerprint;
+  cur->reuse_count = reuse ? prev->reuse_count + 1 : 0;
+  return reuse;
+}
+
+void av1_nonrd_store_sb_decisions(AV1_COMP *cpi, int mi_row, int mi_col) {
+  const AV1_COMMON *const cm = &cpi->common;
+  const CommonModeInfoParams *const mi_params = &cm->mi_params;
+  NONRD_DECISION_CACHE *const cache = &cpi->nonrd_decisions;
+  if (!cpi->sf.rt_sf.reuse_sb_decisions_nonrd || cache->blocks[0] == NULL)
+    return;
+
+  const int mib_size = cm->seq_params->mib_size;
+  const int mib_size_log2 = cm->seq_params->mib_size_log2;
+  const int rows = AOMMIN(mib_size, mi_params->mi_rows - mi_row);
+  const int cols = AOMMIN(mib_size, mi_params->mi_cols - mi_col);
+  MB_MODE_INFO **const grid =
+      mi_params->mi_grid_base + get_mi_grid_idx(mi_params, mi_row, mi_col);
+  NONRD_BLOCK_DECISION *const blocks =
+      &cache->blocks[cache->cur_idx][mi_row * cache->mi_cols + mi_col];
+  for (int r = 0; r < rows; ++r) {
+    for (int c = 0; c < cols; ++c) {
+      const MB_MODE_INFO *const mi = grid[r * mi_params->mi_stride + c];
+      NONRD_BLOCK_DECISION *const d = &blocks[r * cache->mi_cols + c];
+      // Units covered by the block above or to the left are not the top-left
+      // unit of their block.
+      const int is_origin =
+          (r == 0 || grid[(r - 1) * mi_params->mi_stride + c] != mi) &&
+          (c == 0 || grid[r * mi_params->mi_stride + c - 1] != mi);
+      if (is_origin) {
+        d->bsize = mi->bsize;
+        d->mode = mi->mode;
+        d->ref_frame = mi->ref_frame[0];
+        // Only single reference translational inter modes are reused, and
+        // only if the sse was recorded for the block that was coded.
+        if (d->picked_bsize != mi->bsize || !is_inter_block(mi) ||
+            has_second_ref(mi) || mi->motion_mode != SIMPLE_TRANSLATION)
+          d->sse = UINT32_MAX;
+      } else {
+        d->bsize = BLOCK_INVALID;
+      }
+      d->picked_bsize = BLOCK_INVALID;
+    }
+  }
+  const int sb_idx =
+      (mi_row >> mib_size_log2) * cache->sb_cols + (mi_col >> mib_size_log2);
+  cache->sbs[cache->cur_idx][sb_idx].valid = !frame_is_intra_only(cm);
 }
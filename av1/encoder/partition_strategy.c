@@ -14,6 +14,7 @@
 #include "av1/encoder/encodeframe_utils.h"
 #include "av1/encoder/thirdpass.h"
 #include "config/aom_dsp_rtcd.h"
+#include "aom_ports/aom_once.h"
 
 #include "av1/common/enums.h"
 #include "av1/common/reconinter.h"
@@ -134,9 +135,37 @@ static void write_features_to_file(const char *const path,
 //   -- add support for pruning rectangular partitions
 //   -- use reconstructed pixels instead of source pixels for padding
 //   -- use chroma pixels in addition to luma pixels
+// Quantized copies of the intra CNN partition model, shared by all encoder
+// instances and built on first use.
+static CNN_QUANT_CONFIG intra_cnn_quant;
+static NN_QUANT_CONFIG intra_dnn_quant[4];
+static int intra_cnn_quant_ready;
+
+static void init_intra_cnn_quant(void) {
+  const NN_CONFIG *const dnn_configs[4] = {
+    &av1_intra_mode_cnn_partition_branch_0_dnn_config,
+    &av1_intra_mode_cnn_partition_branch_1_dnn_config,
+    &av1_intra_mode_cnn_partition_branch_2_dnn_config,
+    &av1_intra_mode_cnn_partition_branch_3_dnn_config,
+  };
+  if (!av1_cnn_quantize_config(&av1_intra_mode_cnn_partition_cnn_config,
+                               &intra_cnn_quant)) {
+    return;
+  }
+  for (int i = 0; i < 4; ++i) {
+    if (!av1_nn_quantize_config(dnn_configs[i], &intra_dnn_quant[i])) {
+      for (int j = 0; j < i; ++j) av1_nn_free_quant_config(&intra_dnn_quant[j]);
+      av1_cnn_free_quant_config(&intra_cnn_quant);
+      return;
+    }
+  }
+  intra_cnn_quant_ready = 1;
+}
+
 void av1_intra_mode_cnn_partition(const AV1_COMMON *const cm, MACROBLOCK *x,
                                   int quad_tree_idx,
                                   int intra_cnn_based_part_prune_level,
+                                  int use_quantized_model,
                                   PartitionSearchState *part_state) {
   assert(cm->seq_params->sb_size >= BLOCK_64X64 &&
          "Invalid sb_size for intra_cnn!");
@@ -151,6 +180,11 @@ void av1_intra_mode_cnn_partition(const AV1_COMMON *const cm, MACROBLOCK *x,
 
   PartitionSearchInfo *part_info = &x->part_search_info;
 
+  if (use_quantized_model) {
+    aom_once(init_intra_cnn_quant);
+    use_quantized_model = intra_cnn_quant_ready;
+  }
+
   // Precompute the CNN part and cache the result in MACROBLOCK
   if (bsize == BLOCK_64X64 && !part_info->cnn_output_valid) {
     const CNN_CONFIG *cnn_config = &av1_intra_mode_cnn_partition_cnn_config;
@@ -195,7 +229,21 @@ void av1_intra_mode_cnn_partition(const AV1_COMMON *const cm, MACROBLOCK *x,
     const int width = 65, height = 65,
               stride = x->plane[AOM_PLANE_Y].src.stride;
 
-    if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
+    if (use_quantized_model) {
+      const int use_hbd = (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) != 0;
+      uint8_t *image[1] = { x->plane[AOM_PLANE_Y].src.buf - stride - 1 };
+      if (use_hbd) {
+        image[0] = CONVERT_TO_BYTEPTR(
+            CONVERT_TO_SHORTPTR(x->plane[AOM_PLANE_Y].src.buf) - stride - 1);
+      }
+      if (!av1_cnn_predict_img_multi_out_quant(image, width, height, stride,
+                                               use_hbd, bit_depth,
+                                               &intra_cnn_quant, &output)) {
+        aom_internal_error(cm->error, AOM_CODEC_MEM_ERROR,
+                           "Error allocating CNN data");
+        return;
+      }
+    } else if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
       uint16_t *image[1] = {
         CONVERT_TO_SHORTPTR(x->plane[AOM_PLANE_Y].src.buf) - stride - 1
       };
@@ -303,7 +351,12 @@ void av1_intra_mode_cnn_partition(const AV1_COMMON *const cm, MACROBLOCK *x,
   }
 
   // Make decision
-  av1_nn_predict(dnn_features, dnn_config, 1, logits);
+  if (use_quantized_model) {
+    av1_nn_predict_quant(dnn_features, &intra_dnn_quant[bsize_idx - 1], 1,
+                         logits);
+  } else {
+    av1_nn_predict(dnn_features, dnn_config, 1, logits);
+  }
 
   const int is_720p_or_larger = AOMMIN(cm->width, cm->height) >= 720;
   const int is_480p_or_larger = AOMMIN(cm->width, cm->height) >= 480;
@@ -1679,7 +1732,8 @@ void av1_prune_partitions_before_search(AV1_COMP *const cpi,
   if (try_intra_cnn_based_part_prune) {
     av1_intra_mode_cnn_partition(
         &cpi->common, x, x->part_search_info.quad_tree_idx,
-        cpi->sf.part_sf.intra_cnn_based_part_prune_level, part_state);
+        cpi->sf.part_sf.intra_cnn_based_part_prune_level,
+        cpi->sf.part_sf.intra_cnn_use_quantized_model, part_state);
   }
 
   // Use simple motion search to prune out split or non-split partitions. This
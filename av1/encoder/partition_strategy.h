@@ -20,6 +20,7 @@
 void av1_intra_mode_cnn_partition(const AV1_COMMON *const cm, MACROBLOCK *x,
                                   int label_idx,
                                   int intra_cnn_based_part_prune_level,
+                                  int use_quantized_model,
                                   PartitionSearchState *part_state);
 
 // Performs a simple_motion_search with a single reference frame and extract
@@ -158,6 +158,52 @@ void av1_nonrd_pick_inter_mode_sb(struct AV1_COMP *cpi,
                                   struct RD_STATS *rd_cost, BLOCK_SIZE bsize,
                                   PICK_MODE_CONTEXT *ctx);
 
+/*!\brief Prepares the decision cache of the nonrd path for a new frame.
+ *
+ * \ingroup nonrd_mode_search
+ * Makes the decisions recorded for the last frame available for reuse and
+ * allocates the cache on the first call. Does nothing unless
+ * sf->rt_sf.reuse_sb_decisions_nonrd is set.
+ *
+ * \param[in]    cpi            Top-level encoder structure
+ */
+void av1_nonrd_decision_cache_setup(struct AV1_COMP *cpi);
+
+/*!\brief Releases the memory held by the decision cache of the nonrd path. */
+void av1_nonrd_decision_cache_free(NONRD_DECISION_CACHE *cache);
+
+/*!\brief Decides whether the last frame's decisions are reused for a
+ * superblock.
+ *
+ * \ingroup nonrd_mode_search
+ * The decisions are reused if the source of the superblock barely changed
+ * since the last frame and since the frame they were made on, and if they
+ * have not been reused for too many frames already. Must be called for every
+ * superblock coded with nonrd pickmode, after av1_set_offsets() and the
+ * source content grading of the superblock.
+ *
+ * \param[in]    cpi            Top-level encoder structure
+ * \param[in]    x              Pointer to structure holding all the data for
+ *                              the current macroblock
+ * \param[in]    mi_row         Row coordinate of the superblock in 4x4 units
+ * \param[in]    mi_col         Column coordinate of the superblock
+ *
+ * \return 1 if the partition and modes of the last frame should be reused.
+ */
+int av1_nonrd_reuse_sb_decisions(struct AV1_COMP *cpi, struct macroblock *x,
+                                 int mi_row, int mi_col);
+
+/*!\brief Records the partition and modes of a coded superblock for reuse in
+ * the next frame.
+ *
+ * \ingroup nonrd_mode_search
+ * \param[in]    cpi            Top-level encoder structure
+ * \param[in]    mi_row         Row coordinate of the superblock in 4x4 units
+ * \param[in]    mi_col         Column coordinate of the superblock
+ */
+void av1_nonrd_store_sb_decisions(struct AV1_COMP *cpi, int mi_row,
+                                  int mi_col);
+
 void av1_rd_pick_inter_mode_sb_seg_skip(
     const struct AV1_COMP *cpi, struct TileDataEnc *tile_data,
     struct macroblock *x, int mi_row, int mi_col, struct RD_STATS *rd_cost,
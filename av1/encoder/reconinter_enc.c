@@ -26,6 +26,7 @@
 #include "av1/common/obmc.h"
 #include "av1/common/reconinter.h"
 #include "av1/common/reconintra.h"
+#include "av1/encoder/inter_pred_cache.h"
 #include "av1/encoder/reconinter_enc.h"
 
 static AOM_INLINE void enc_calc_subpel_params(
@@ -107,6 +108,69 @@ void av1_enc_build_inter_predictor_y_nonrd(MACROBLOCKD *xd,
                            subpel_params);
 }
 
+// Builds the luma prediction of a single reference translational block through
+// the superblock's inter prediction cache: a block whose prediction was built
+// earlier as part of a larger or equal region, e.g. by its parent partition or
+// an earlier rd pass, is copied out of the cache instead of being filtered
+// again. Returns 0 without building anything if the block is not eligible.
+static int enc_build_inter_predictor_y_cached(MACROBLOCKD *xd,
+                                              InterPredCache *cache, int mi_x,
+                                              int mi_y) {
+  const MB_MODE_INFO *const mi = xd->mi[0];
+  if (has_second_ref(mi) || is_intrabc_block(mi)) return 0;
+  const struct scale_factors *const sf = xd->block_ref_scale_factors[0];
+  if (av1_is_scaled(sf)) return 0;
+
+  struct macroblockd_plane *const pd = &xd->plane[AOM_PLANE_Y];
+  const int bw = pd->width;
+  const int bh = pd->height;
+  const WarpedMotionParams *const wm = &xd->global_motion[mi->ref_frame[0]];
+  const WarpTypesAllowed warp_types = { is_global_mv_block(mi, wm->wmtype),
+                                        mi->motion_mode == WARPED_CAUSAL };
+  InterPredParams inter_pred_params;
+  av1_init_inter_params(&inter_pred_params, bw, bh, mi_y, mi_x, 0, 0, xd->bd,
+                        is_cur_buf_hbd(xd), 0, sf, &pd->pre[0],
+                        mi->interp_filters);
+  inter_pred_params.conv_params = get_conv_params_no_round(
+      0, AOM_PLANE_Y, xd->tmp_conv_dst, MAX_SB_SIZE, 0, xd->bd);
+  av1_init_warp_params(&inter_pred_params, &warp_types, 0, xd, mi);
+  if (inter_pred_params.mode != TRANSLATION_PRED) return 0;
+
+  SubpelParams subpel_params;
+  uint8_t *src;
+  int src_stride;
+  enc_calc_subpel_params(&mi->mv[0].as_mv, &inter_pred_params, &src,
+                         &subpel_params, &src_stride);
+  uint8_t *const dst = pd->dst.buf;
+  const int dst_stride = pd->dst.stride;
+  // Full pel predictions are plain copies, not worth caching.
+  if (subpel_params.subpel_x == 0 && subpel_params.subpel_y == 0) {
+    av1_make_inter_predictor(src, src_stride, dst, dst_stride,
+                             &inter_pred_params, &subpel_params);
+    return 1;
+  }
+
+  const InterPredKey key = {
+    pd->pre[0].buf0,
+    inter_pred_params.interp_filter_params[0],
+    inter_pred_params.interp_filter_params[1],
+    (subpel_params.pos_x >> SCALE_SUBPEL_BITS) - mi_x,
+    (subpel_params.pos_y >> SCALE_SUBPEL_BITS) - mi_y,
+    subpel_params.subpel_x,
+    subpel_params.subpel_y,
+  };
+  const int use_hbd = inter_pred_params.use_hbd_buf;
+  if (av1_inter_pred_cache_read(cache, &key, mi_x, mi_y, bw, bh, dst,
+                                dst_stride, use_hbd)) {
+    return 1;
+  }
+  av1_make_inter_predictor(src, src_stride, dst, dst_stride, &inter_pred_params,
+                           &subpel_params);
+  av1_inter_pred_cache_write(cache, &key, mi_x, mi_y, bw, bh, dst, dst_stride,
+                             use_hbd);
+  return 1;
+}
+
 void av1_enc_build_inter_predictor(const AV1_COMMON *cm, MACROBLOCKD *xd,
                                    int mi_row, int mi_col,
                                    const BUFFER_SET *ctx, BLOCK_SIZE bsize,
@@ -115,8 +179,13 @@ void av1_enc_build_inter_predictor(const AV1_COMMON *cm, MACROBLOCKD *xd,
     if (plane && !xd->is_chroma_ref) break;
     const int mi_x = mi_col * MI_SIZE;
     const int mi_y = mi_row * MI_SIZE;
-    enc_build_inter_predictors(cm, xd, plane, xd->mi[0], xd->plane[plane].width,
-                               xd->plane[plane].height, mi_x, mi_y);
+    if (plane != AOM_PLANE_Y || xd->inter_pred_cache == NULL ||
+        !enc_build_inter_predictor_y_cached(xd, xd->inter_pred_cache, mi_x,
+                                            mi_y)) {
+      enc_build_inter_predictors(cm, xd, plane, xd->mi[0],
+                                 xd->plane[plane].width,
+                                 xd->plane[plane].height, mi_x, mi_y);
+    }
 
     if (is_interintra_pred(xd->mi[0])) {
       BUFFER_SET default_ctx = {
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+
+#include "av1/encoder/speed_control.h"
+
+// Frames to smooth over before the averaged time may raise the speed level.
+#define SPEED_UP_MIN_FRAMES 2
+// Frames under the budget needed before the speed level is lowered again.
+#define SPEED_DOWN_MIN_FRAMES 16
+// A faster level typically saves a quarter of the time or more, so going
+// back down is only allowed with enough headroom to stay under the budget.
+#define SPEED_DOWN_THRESH_PCT 60
+#define SPEED_UP_THRESH_PCT 95
+
+static void set_speed(SpeedControl *sc, int speed) {
+  sc->speed = speed;
+  sc->avg_time_us = 0;
+  sc->frames_at_speed = 0;
+}
+
+void av1_speed_control_configure(SpeedControl *sc, int64_t budget_us,
+                                 int min_speed, int max_speed) {
+  assert(min_speed <= max_speed);
+  if (sc->budget_us == budget_us && sc->min_speed == min_speed &&
+      sc->max_speed == max_speed) {
+    return;
+  }
+  sc->budget_us = budget_us;
+  sc->min_speed = min_speed;
+  sc->max_speed = max_speed;
+  set_speed(sc, min_speed);
+}
+
+int av1_speed_control_update(SpeedControl *sc, int64_t frame_time_us) {
+  if (sc->budget_us <= 0) return sc->speed;
+
+  // Exponential moving average with a weight of 1/4 on the new frame.
+  if (sc->frames_at_speed == 0) {
+    sc->avg_time_us = frame_time_us;
+  } else {
+    sc->avg_time_us += (frame_time_us - sc->avg_time_us) / 4;
+  }
+  ++sc->frames_at_speed;
+
+  const int64_t budget = sc->budget_us;
+  if (sc->speed < sc->max_speed &&
+      (2 * frame_time_us > 3 * budget ||
+       (sc->frames_at_speed >= SPEED_UP_MIN_FRAMES &&
+        100 * sc->avg_time_us >= SPEED_UP_THRESH_PCT * budget))) {
+    set_speed(sc, sc->speed + 1);
+  } else if (sc->speed > sc->min_speed &&
+             sc->frames_at_speed >= SPEED_DOWN_MIN_FRAMES &&
+             100 * sc->avg_time_us < SPEED_DOWN_THRESH_PCT * budget) {
+    set_speed(sc, sc->speed - 1);
+  }
+  return sc->speed;
+}
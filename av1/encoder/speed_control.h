@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+/*!\file
+ * \brief Closed-loop control of the real-time speed level against a per-frame
+ * encode time budget.
+ */
+#ifndef AOM_AV1_ENCODER_SPEED_CONTROL_H_
+#define AOM_AV1_ENCODER_SPEED_CONTROL_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!\cond */
+
+// Lowest cpu-used the control runs at. Speeds below this use the rd pick mode
+// path, whose buffers and tools cannot be switched per frame.
+#define SPEED_CONTROL_MIN_SPEED 7
+// Highest real-time speed level.
+#define SPEED_CONTROL_MAX_SPEED 11
+
+typedef struct {
+  // Per-frame encode time budget in microseconds. 0 disables the control.
+  int64_t budget_us;
+  // Range the speed level is kept in. min_speed is the configured cpu-used.
+  int min_speed;
+  int max_speed;
+  // Speed level the next frame is encoded at.
+  int speed;
+  // Smoothed encode time of the frames encoded at the current speed level.
+  int64_t avg_time_us;
+  // Number of frames encoded at the current speed level.
+  int frames_at_speed;
+} SpeedControl;
+
+/*!\endcond */
+
+/*!\brief Sets the budget and speed range of the control.
+ *
+ * The control restarts from \p min_speed when any of the parameters differ
+ * from the current ones, and keeps its state otherwise, so this can be called
+ * on every configuration change.
+ *
+ * \param[in]   sc          Speed control state
+ * \param[in]   budget_us   Per-frame encode time budget in microseconds, or 0
+ *                          to disable the control
+ * \param[in]   min_speed   Configured speed level
+ * \param[in]   max_speed   Highest speed level the control may use
+ */
+void av1_speed_control_configure(SpeedControl *sc, int64_t budget_us,
+                                 int min_speed, int max_speed);
+
+/*!\brief Records the encode time of a frame and picks the speed level for
+ * the next one.
+ *
+ * The level goes up one step as soon as a frame overshoots the budget by
+ * half, or the smoothed time over a few frames reaches the budget. It only
+ * comes back down after a longer run of frames well under the budget, so
+ * that it does not oscillate between two levels.
+ *
+ * \param[in]   sc              Speed control state
+ * \param[in]   frame_time_us   Time taken to encode the frame
+ *
+ * \return The speed level for the next frame.
+ */
+int av1_speed_control_update(SpeedControl *sc, int64_t frame_time_us);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // AOM_AV1_ENCODER_SPEED_CONTROL_H_
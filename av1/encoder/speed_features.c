@@ -362,6 +362,7 @@ static void set_allintra_speed_features_framesize_independent(
   if (speed >= 1) {
     sf->part_sf.intra_cnn_based_part_prune_level =
         allow_screen_content_tools ? 0 : 2;
+    sf->part_sf.intra_cnn_use_quantized_model = 1;
     sf->part_sf.simple_motion_search_early_term_none = 1;
     // TODO(Venkat): Clean-up frame type dependency for
     // simple_motion_search_split in partition search function and set the
@@ -448,6 +449,7 @@ static void set_allintra_speed_features_framesize_independent(
     sf->part_sf.ml_predict_breakout_level = 3;
 
     sf->intra_sf.prune_chroma_modes_using_luma_winner = 1;
+    sf->intra_sf.top_luma_model_rd_count = 8;
 
     sf->mv_sf.simple_motion_subpel_force_stop = HALF_PEL;
 
@@ -755,6 +757,8 @@ static void set_good_speed_feature_framesize_dependent(
       sf->intra_sf.skip_intra_in_interframe = boosted ? 1 : 3;
     }
 
+    if (is_720p_or_larger) sf->mv_sf.pyramid_search_levels = 3;
+
     if (is_720p_or_larger) {
       sf->inter_sf.disable_interinter_wedge_var_thresh = 100;
       sf->inter_sf.limit_txfm_eval_per_mode = boosted ? 0 : 1;
@@ -1069,6 +1073,7 @@ static void set_good_speed_features_framesize_independent(
     sf->gm_sf.num_refinement_steps = 0;
 
     sf->part_sf.less_rectangular_check_level = 2;
+    sf->part_sf.intra_cnn_use_quantized_model = 1;
     sf->part_sf.simple_motion_search_prune_agg =
         allow_screen_content_tools
             ? SIMPLE_AGG_LVL0
@@ -1078,6 +1083,7 @@ static void set_good_speed_features_framesize_independent(
 
     sf->mv_sf.full_pixel_search_level = 1;
     sf->mv_sf.subpel_search_method = SUBPEL_TREE_PRUNED;
+    sf->mv_sf.motion_field_cache = 1;
     sf->mv_sf.search_method = DIAMOND;
     sf->mv_sf.disable_second_mv = 2;
     sf->mv_sf.prune_mesh_search = PRUNE_MESH_SEARCH_LVL_1;
@@ -1139,6 +1145,7 @@ static void set_good_speed_features_framesize_independent(
 
   if (speed >= 4) {
     sf->mv_sf.subpel_search_method = SUBPEL_TREE_PRUNED_MORE;
+    sf->mv_sf.motion_field_cache = 2;
 
     sf->gm_sf.prune_zero_mv_with_sse = 2;
 
@@ -1840,6 +1847,7 @@ static void set_rt_speed_features_framesize_independent(AV1_COMP *cpi,
     sf->rt_sf.reduce_mv_pel_precision_highmotion = 0;
     sf->rt_sf.use_adaptive_subpel_search = true;
     sf->mv_sf.use_bsize_dependent_search_method = 0;
+    sf->rt_sf.reuse_sb_decisions_nonrd = 4;
   }
   if (speed >= 10) {
     sf->rt_sf.sse_early_term_inter_search = EARLY_TERM_IDX_4;
@@ -1921,6 +1929,7 @@ static AOM_INLINE void init_part_sf(PARTITION_SPEED_FEATURES *part_sf) {
   part_sf->simple_motion_search_early_term_none = 0;
   part_sf->simple_motion_search_reduce_search_steps = 0;
   part_sf->intra_cnn_based_part_prune_level = 0;
+  part_sf->intra_cnn_use_quantized_model = 0;
   part_sf->ext_partition_eval_thresh = BLOCK_8X8;
   part_sf->rect_partition_eval_thresh = BLOCK_128X128;
   part_sf->prune_ext_part_using_split_info = 0;
@@ -1958,6 +1967,8 @@ static AOM_INLINE void init_mv_sf(MV_SPEED_FEATURES *mv_sf) {
   mv_sf->skip_fullpel_search_using_startmv = 0;
   mv_sf->warp_search_method = WARP_SEARCH_SQUARE;
   mv_sf->warp_search_iters = 8;
+  mv_sf->motion_field_cache = 0;
+  mv_sf->pyramid_search_levels = 0;
 }
 
 static AOM_INLINE void init_inter_sf(INTER_MODE_SPEED_FEATURES *inter_sf) {
@@ -2042,6 +2053,7 @@ static AOM_INLINE void init_intra_sf(INTRA_MODE_SPEED_FEATURES *intra_sf) {
   intra_sf->early_term_chroma_palette_size_search = 0;
   intra_sf->skip_filter_intra_in_inter_frames = 0;
   intra_sf->prune_luma_odd_delta_angles_in_intra = 0;
+  intra_sf->top_luma_model_rd_count = 0;
 }
 
 static AOM_INLINE void init_tx_sf(TX_SPEED_FEATURES *tx_sf) {
@@ -2145,6 +2157,7 @@ static AOM_INLINE void init_rt_sf(REAL_TIME_SPEED_FEATURES *rt_sf) {
   rt_sf->use_real_time_ref_set = 0;
   rt_sf->short_circuit_low_temp_var = 0;
   rt_sf->reuse_inter_pred_nonrd = 0;
+  rt_sf->reuse_sb_decisions_nonrd = 0;
   rt_sf->num_inter_modes_for_tx_search = INT_MAX;
   rt_sf->use_nonrd_filter_search = 0;
   rt_sf->use_simple_rd_model = 0;
@@ -639,6 +639,10 @@ typedef struct PARTITION_SPEED_FEATURES {
   // 2: Prune none, split and rectangular partitions
   int intra_cnn_based_part_prune_level;
 
+  // Run the intra CNN partition model and its decision networks with int16
+  // quantized weights and activations instead of floats.
+  int intra_cnn_use_quantized_model;
+
   // Disable extended partition search for lower block sizes.
   int ext_partition_eval_thresh;
 
@@ -829,6 +833,20 @@ typedef struct MV_SPEED_FEATURES {
 
   // Maximum number of iterations in WARPED_CAUSAL refinement search
   int warp_search_iters;
+
+  // Share source motion fields between temporal filtering, TPL and the final
+  // motion search through AV1_PRIMARY::mf_cache.
+  // 0: disabled
+  // 1: cached vectors are used as extra starting points
+  // 2: as 1, and TPL accepts cached vectors with a low search error without
+  //    searching again
+  int motion_field_cache;
+
+  // Number of downsampled image pyramid levels the temporal filter and TPL
+  // search on, coarse to fine, before a reduced-range full-pixel search at
+  // full resolution. 0 disables it. Only takes effect when the frames carry
+  // pyramids, i.e. when global motion is enabled.
+  int pyramid_search_levels;
 } MV_SPEED_FEATURES;
 
 typedef struct INTER_MODE_SPEED_FEATURES {
@@ -1214,6 +1232,15 @@ typedef struct INTRA_MODE_SPEED_FEATURES {
   // performance change less than 0.27%.
   int prune_luma_odd_delta_angles_in_intra;
 
+  // Number of luma intra mode and angle delta candidates kept for rd
+  // evaluation in intra frames. The model rd of all the candidates is
+  // estimated up front and only the best ones go through the transform search.
+  // 0: no pruning
+  // For allintra encode at speed 4, a count of 8 reduces the number of luma rd
+  // evaluations by about 35% on 720p content with coding performance change
+  // below 0.1%.
+  int top_luma_model_rd_count;
+
   // Terminate early in chroma palette_size search.
   // 0: No early termination
   // 1: Terminate early for higher palette_size, if header rd cost of lower
@@ -1776,6 +1803,13 @@ typedef struct REAL_TIME_SPEED_FEATURES {
   // A flag that controls if we check or bypass GLOBALMV in rtc single ref frame
   // case.
   bool check_globalmv_on_single_ref;
+
+  // Reuse the partition and modes of the last frame for superblocks whose
+  // source is unchanged or nearly so, after checking that the reused mode
+  // predicts about as well as it did in the last frame. The value is the
+  // maximum number of consecutive frames the decisions of a superblock are
+  // reused for; 0 disables the feature.
+  int reuse_sb_decisions_nonrd;
 } REAL_TIME_SPEED_FEATURES;
 
 /*!\endcond */
@@ -18,6 +18,7 @@
 #include "aom_dsp/aom_dsp_common.h"
 #include "aom_dsp/mathutils.h"
 #include "aom_dsp/odintrin.h"
+#include "aom_dsp/pyramid.h"
 #include "aom_mem/aom_mem.h"
 #include "aom_ports/aom_timer.h"
 #include "aom_ports/mem.h"
@@ -81,6 +82,8 @@ static void tf_determine_block_partition(const MV block_mv, const int block_mse,
  * \param[out]  subblock_mvs    Pointer to the motion vectors for 4 sub-blocks
  * \param[out]  subblock_mses   Pointer to the search errors (MSE) for 4
  *                              sub-blocks
+ * \param[out]  mf              Motion field to record the block and
+ *                              sub-block search results in, or NULL
  *
  * \remark Nothing will be returned. Results are saved in subblock_mvs and
  *         subblock_mses
@@ -90,7 +93,7 @@ static void tf_motion_search(AV1_COMP *cpi, MACROBLOCK *mb,
                              const YV12_BUFFER_CONFIG *ref_frame,
                              const BLOCK_SIZE block_size, const int mb_row,
                              const int mb_col, MV *ref_mv, MV *subblock_mvs,
-                             int *subblock_mses) {
+                             int *subblock_mses, MotionField *mf) {
   // Frame information
   const int min_frame_size = AOMMIN(cpi->common.width, cpi->common.height);
 
@@ -98,6 +101,8 @@ static void tf_motion_search(AV1_COMP *cpi, MACROBLOCK *mb,
   const int mb_height = block_size_high[block_size];
   const int mb_width = block_size_wide[block_size];
   const int mb_pels = mb_height * mb_width;
+  const int block_level =
+      av1_mf_level(mi_size_wide_log2[block_size] + MI_SIZE_LOG2);
   const int y_stride = frame_to_filter->y_stride;
   assert(y_stride == ref_frame->y_stride);
   const int y_offset = mb_row * mb_height * y_stride + mb_col * mb_width;
@@ -110,8 +115,9 @@ static void tf_motion_search(AV1_COMP *cpi, MACROBLOCK *mb,
   // Parameters used for motion search.
   FULLPEL_MOTION_SEARCH_PARAMS full_ms_params;
   SUBPEL_MOTION_SEARCH_PARAMS ms_params;
-  const int step_param = av1_init_search_range(
+  int step_param = av1_init_search_range(
       AOMMAX(frame_to_filter->y_crop_width, frame_to_filter->y_crop_height));
+  const int pyramid_search_levels = cpi->tf_ctx.pyramid_search_levels;
   const SUBPEL_SEARCH_TYPE subpel_search_type = USE_8_TAPS;
   const int force_integer_mv = cpi->common.features.cur_frame_force_integer_mv;
   const MV_COST_TYPE mv_cost_type =
@@ -158,6 +164,17 @@ static void tf_motion_search(AV1_COMP *cpi, MACROBLOCK *mb,
     full_ms_params.mesh_search_mv_diff_threshold = 2;
   }
 
+  if (pyramid_search_levels > 0) {
+    // Find large motion on the downsampled frames first, so that the search
+    // at full resolution, and the sub-block searches starting from its
+    // result, only need a small range.
+    start_mv = av1_pyramid_full_pixel_search(
+        frame_to_filter->y_pyramid, ref_frame->y_pyramid, mb_col * mb_width,
+        mb_row * mb_height, mb_width, mb_height, pyramid_search_levels,
+        &full_ms_params.mv_limits, start_mv);
+    step_param = AOMMAX(step_param, MAX_MVSEARCH_STEPS - 4);
+  }
+
   av1_full_pixel_search(start_mv, &full_ms_params, step_param,
                         cond_cost_list(cpi, cost_list), &best_mv.as_fullmv,
                         NULL);
@@ -192,6 +209,7 @@ static void tf_motion_search(AV1_COMP *cpi, MACROBLOCK *mb,
     *ref_mv = best_mv.as_mv;
     // On 4 sub-blocks.
     const BLOCK_SIZE subblock_size = av1_ss_size_lookup[block_size][1][1];
+    const int subblock_level = block_level - 1;
     const int subblock_height = block_size_high[subblock_size];
     const int subblock_width = block_size_wide[subblock_size];
     const int subblock_pels = subblock_height * subblock_width;
@@ -237,6 +255,11 @@ static void tf_motion_search(AV1_COMP *cpi, MACROBLOCK *mb,
             &best_mv.as_mv, &distortion, &sse, NULL);
         subblock_mses[subblock_idx] = DIVIDE_AND_ROUND(error, subblock_pels);
         subblock_mvs[subblock_idx] = best_mv.as_mv;
+        if (mf != NULL) {
+          av1_mf_store(mf, subblock_level, mb_col * mb_width + j,
+                       mb_row * mb_height + i, best_mv.as_mv,
+                       subblock_mses[subblock_idx]);
+        }
         ++subblock_idx;
       }
     }
@@ -246,6 +269,11 @@ static void tf_motion_search(AV1_COMP *cpi, MACROBLOCK *mb,
   mb->plane[0].src = ori_src_buf;
   mbd->plane[0].pre[0] = ori_pre_buf;
 
+  if (mf != NULL) {
+    av1_mf_store(mf, block_level, mb_col * mb_width, mb_row * mb_height,
+                 block_mv, block_mse);
+  }
+
   // Make partition decision.
   tf_determine_block_partition(block_mv, block_mse, subblock_mvs,
                                subblock_mses);
@@ -855,7 +883,8 @@ void av1_tf_do_filtering_row(AV1_COMP *cpi, ThreadData *td, int mb_row) {
         ref_mv.col *= -1;
       } else {  // Other reference frames.
         tf_motion_search(cpi, mb, frame_to_filter, frames[frame], block_size,
-                         mb_row, mb_col, &ref_mv, subblock_mvs, subblock_mses);
+                         mb_row, mb_col, &ref_mv, subblock_mvs, subblock_mses,
+                         tf_ctx->motion_fields[frame]);
       }
 
       // Perform weighted averaging.
@@ -1099,12 +1128,41 @@ static void tf_setup_filtering_buffer(AV1_COMP *cpi,
   num_frames = num_before + 1 + num_after;
 
   // Setup the frame buffer.
+  const int use_mf_cache = use_motion_field_cache(cpi);
   for (int frame = 0; frame < num_frames; ++frame) {
     const int lookahead_idx = frame - num_before + filter_frame_lookahead_idx;
     struct lookahead_entry *buf = av1_lookahead_peek(
         cpi->ppi->lookahead, lookahead_idx, cpi->compressor_stage);
     assert(buf != NULL);
     frames[frame] = &buf->img;
+    tf_ctx->motion_fields[frame] = NULL;
+    // Record the block and sub-block vectors against each neighbor so that TPL
+    // and the final motion search can reuse them.
+    if (use_mf_cache && frame != num_before) {
+      MotionField *mf = av1_mf_cache_get(
+          &cpi->ppi->mf_cache, to_filter_buf->display_idx, buf->display_idx,
+          to_filter_frame->y_crop_width, to_filter_frame->y_crop_height);
+      const int block_level =
+          av1_mf_level(mi_size_wide_log2[TF_BLOCK_SIZE] + MI_SIZE_LOG2);
+      assert(block_level > 0);
+      if (av1_mf_alloc_level(mf, block_level) &&
+          av1_mf_alloc_level(mf, block_level - 1)) {
+        tf_ctx->motion_fields[frame] = mf;
+      }
+    }
+  }
+
+  // The pyramids stay valid until the lookahead buffers are reused, so each
+  // frame is downsampled only once across the filtering passes it is part of.
+  tf_ctx->pyramid_search_levels = cpi->sf.mv_sf.pyramid_search_levels;
+  for (int frame = 0; frame < num_frames; ++frame) {
+    if (frames[frame]->y_pyramid == NULL) tf_ctx->pyramid_search_levels = 0;
+  }
+  if (tf_ctx->pyramid_search_levels > 0) {
+    for (int frame = 0; frame < num_frames; ++frame) {
+      aom_compute_pyramid(frames[frame], cpi->common.seq_params->bit_depth,
+                          frames[frame]->y_pyramid);
+    }
   }
   tf_ctx->num_frames = num_frames;
   tf_ctx->filter_frame_idx = num_before;
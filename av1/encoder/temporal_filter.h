@@ -14,6 +14,8 @@
 
 #include <stdbool.h>
 
+#include "av1/encoder/motion_field_cache.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -98,6 +100,16 @@ typedef struct {
    * Frame buffers used for temporal filtering.
    */
   YV12_BUFFER_CONFIG *frames[MAX_LAG_BUFFERS];
+  /*!
+   * Cached motion fields from the frame to be filtered to each frame in the
+   * frame buffer, or NULL if the results are not recorded.
+   */
+  MotionField *motion_fields[MAX_LAG_BUFFERS];
+  /*!
+   * Number of downsampled pyramid levels used by the coarse-to-fine motion
+   * search, or 0 if it is disabled or some frames have no pyramid.
+   */
+  int pyramid_search_levels;
   /*!
    * Number of frames in the frame buffer.
    */
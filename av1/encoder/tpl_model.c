@@ -19,6 +19,7 @@
 #include "config/aom_scale_rtcd.h"
 
 #include "aom/aom_codec.h"
+#include "aom_dsp/pyramid.h"
 
 #include "av1/common/av1_common_int.h"
 #include "av1/common/enums.h"
@@ -250,11 +251,11 @@ static uint32_t motion_estimation(AV1_COMP *cpi, MACROBLOCK *x,
                                   uint8_t *cur_frame_buf,
                                   uint8_t *ref_frame_buf, int stride,
                                   int stride_ref, BLOCK_SIZE bsize,
-                                  MV center_mv, int_mv *best_mv) {
+                                  MV center_mv, int step_param,
+                                  int_mv *best_mv) {
   AV1_COMMON *cm = &cpi->common;
   MACROBLOCKD *const xd = &x->e_mbd;
   TPL_SPEED_FEATURES *tpl_sf = &cpi->sf.tpl_sf;
-  int step_param;
   uint32_t bestsme = UINT_MAX;
   int distortion;
   uint32_t sse;
@@ -267,7 +268,6 @@ static uint32_t motion_estimation(AV1_COMP *cpi, MACROBLOCK *x,
   xd->plane[0].pre[0].buf = ref_frame_buf;
   xd->plane[0].pre[0].stride = stride_ref;
 
-  step_param = tpl_sf->reduce_first_step_size;
   step_param = AOMMIN(step_param, MAX_MVSEARCH_STEPS - 2);
 
   const search_site_config *search_site_cfg =
@@ -629,6 +629,13 @@ static AOM_INLINE void mode_estimation(AV1_COMP *cpi,
   best_mv[0].as_int = INVALID_MV;
   best_mv[1].as_int = INVALID_MV;
 
+  const int mf_level = av1_mf_level(get_msb(tpl_data->tpl_bsize_1d));
+  int mf_block_level = -1;
+  // Per-pixel search error below which a cached vector is accepted without
+  // searching again, as in tf_motion_search().
+  const uint32_t mf_accept_thresh =
+      (AOMMIN(cm->width, cm->height) >= 720 ? 12 : 3) << (xd->bd - 8);
+
   for (rf_idx = 0; rf_idx < INTER_REFS_PER_FRAME; ++rf_idx) {
     single_mv[rf_idx].as_int = INVALID_MV;
     if (tpl_data->ref_frame[rf_idx] == NULL ||
@@ -646,13 +653,27 @@ static AOM_INLINE void mode_estimation(AV1_COMP *cpi,
     int_mv best_rfidx_mv = { 0 };
     uint32_t bestsme = UINT32_MAX;
 
-    center_mv_t center_mvs[4] = { { { 0 }, INT_MAX },
-                                  { { 0 }, INT_MAX },
-                                  { { 0 }, INT_MAX },
+    center_mv_t center_mvs[7] = { { { 0 }, INT_MAX }, { { 0 }, INT_MAX },
+                                  { { 0 }, INT_MAX }, { { 0 }, INT_MAX },
+                                  { { 0 }, INT_MAX }, { { 0 }, INT_MAX },
                                   { { 0 }, INT_MAX } };
+    int step_param = cpi->sf.tpl_sf.reduce_first_step_size;
     int refmv_count = 1;
     int idx;
 
+    MotionField *const mf = tpl_data->motion_field[rf_idx];
+    const MotionFieldBlock *mf_block = av1_mf_lookup(
+        mf, mf_level, mi_col * MI_SIZE, mi_row * MI_SIZE, &mf_block_level);
+    if (mf_block != NULL && cpi->sf.mv_sf.motion_field_cache >= 2 &&
+        mf_block_level == mf_level && mf_block->err <= mf_accept_thresh &&
+        av1_is_fullmv_in_range(&x->mv_limits,
+                               get_fullmv_from_mv(&mf_block->mv.as_mv))) {
+      // This block was already searched on the same frame pair with a low
+      // error, so take its vector as is.
+      best_rfidx_mv = mf_block->mv;
+      refmv_count = 0;
+    }
+
     if (xd->up_available) {
       TplDepStats *ref_tpl_stats = &tpl_frame->tpl_stats_ptr[av1_tpl_ptr_pos(
           mi_row - mi_height, mi_col, tpl_frame->stride, block_mis_log2)];
@@ -702,8 +723,50 @@ static AOM_INLINE void mode_estimation(AV1_COMP *cpi,
       }
     }
 
+    // Use the vectors cached for this frame pair, and the negated vectors
+    // cached for the opposite direction, as starting points.
+    if (refmv_count > 0 && mf_block != NULL &&
+        !is_alike_mv(mf_block->mv, center_mvs, refmv_count,
+                     cpi->sf.tpl_sf.skip_alike_starting_mv)) {
+      center_mvs[refmv_count].mv.as_int = mf_block->mv.as_int;
+      ++refmv_count;
+    }
+    const MotionFieldBlock *rev_block =
+        refmv_count > 0
+            ? av1_mf_lookup(tpl_data->rev_motion_field[rf_idx], mf_level,
+                            mi_col * MI_SIZE, mi_row * MI_SIZE, NULL)
+            : NULL;
+    if (rev_block != NULL) {
+      int_mv rev_mv;
+      rev_mv.as_mv.row = -rev_block->mv.as_mv.row;
+      rev_mv.as_mv.col = -rev_block->mv.as_mv.col;
+      if (!is_alike_mv(rev_mv, center_mvs, refmv_count,
+                       cpi->sf.tpl_sf.skip_alike_starting_mv)) {
+        center_mvs[refmv_count].mv.as_int = rev_mv.as_int;
+        ++refmv_count;
+      }
+    }
+
+    if (refmv_count > 0 && tpl_data->pyramid_search_levels > 0) {
+      // Search the downsampled frames, starting from the first neighbor's
+      // vector, for a starting point that lets the full resolution search
+      // use a small range.
+      int_mv pyr_mv;
+      pyr_mv.as_fullmv = av1_pyramid_full_pixel_search(
+          xd->cur_buf->y_pyramid, ref_frame_ptr->y_pyramid, mi_col * MI_SIZE,
+          mi_row * MI_SIZE, bw, bh, tpl_data->pyramid_search_levels,
+          &x->mv_limits, get_fullmv_from_mv(&center_mvs[1].mv.as_mv));
+      convert_fullmv_to_mv(&pyr_mv);
+      if (!is_alike_mv(pyr_mv, center_mvs, refmv_count,
+                       cpi->sf.tpl_sf.skip_alike_starting_mv)) {
+        center_mvs[refmv_count].mv.as_int = pyr_mv.as_int;
+        ++refmv_count;
+      }
+      step_param = AOMMAX(step_param, MAX_MVSEARCH_STEPS - 4);
+    }
+
     // Prune starting mvs
-    if (cpi->sf.tpl_sf.prune_starting_mv) {
+    if (cpi->sf.tpl_sf.prune_starting_mv && refmv_count > 0) {
       // Get each center mv's sad.
       for (idx = 0; idx < refmv_count; ++idx) {
         FULLPEL_MV mv = get_fullmv_from_mv(&center_mvs[idx].mv.as_mv);
@@ -731,13 +794,18 @@ static AOM_INLINE void mode_estimation(AV1_COMP *cpi,
       int_mv this_mv;
       uint32_t thissme = motion_estimation(cpi, x, src_mb_buffer, ref_mb,
                                            src_stride, ref_stride, bsize,
-                                           center_mvs[idx].mv.as_mv, &this_mv);
+                                           center_mvs[idx].mv.as_mv, step_param,
+                                           &this_mv);
 
       if (thissme < bestsme) {
         bestsme = thissme;
         best_rfidx_mv = this_mv;
       }
     }
+    if (mf != NULL && refmv_count > 0) {
+      av1_mf_store(mf, mf_level, mi_col * MI_SIZE, mi_row * MI_SIZE,
+                   best_rfidx_mv.as_mv, bestsme / (bw * bh));
+    }
 
     tpl_stats->mv[rf_idx].as_int = best_rfidx_mv.as_int;
     single_mv[rf_idx] = best_rfidx_mv;
@@ -1276,6 +1344,51 @@ static AOM_INLINE void init_mc_flow_dispenser(AV1_COMP *cpi, int frame_idx,
     }
   }
 
+  // Look up the motion fields already searched between these frames, by the
+  // temporal filter or an earlier TPL pass, and record the new results.
+  const int mf_level = av1_mf_level(get_msb(tpl_data->tpl_bsize_1d));
+  const int use_mf_cache = use_motion_field_cache(cpi) && mf_level >= 0;
+  const int cur_disp_idx =
+      get_abs_display_idx(cpi, tpl_frame->frame_display_index);
+  for (idx = 0; idx < INTER_REFS_PER_FRAME; ++idx) {
+    tpl_data->motion_field[idx] = NULL;
+    tpl_data->rev_motion_field[idx] = NULL;
+    if (!use_mf_cache || tpl_data->ref_frame[idx] == NULL ||
+        tpl_data->src_ref_frame[idx] == NULL)
+      continue;
+    const int ref_disp_idx =
+        get_abs_display_idx(cpi, ref_frame_display_indices[idx]);
+    if (ref_disp_idx == cur_disp_idx) continue;
+    tpl_data->rev_motion_field[idx] = av1_mf_cache_find(
+        &cpi->ppi->mf_cache, ref_disp_idx, cur_disp_idx,
+        this_frame->y_crop_width, this_frame->y_crop_height);
+    MotionField *mf =
+        av1_mf_cache_get(&cpi->ppi->mf_cache, cur_disp_idx, ref_disp_idx,
+                         this_frame->y_crop_width, this_frame->y_crop_height);
+    if (av1_mf_alloc_level(mf, mf_level)) tpl_data->motion_field[idx] = mf;
+  }
+
+  // Downsample the current frame and the sources of its references for the
+  // coarse-to-fine motion search. Lookahead frames keep their pyramids until
+  // the buffers are reused, so each is computed once per GOP.
+  tpl_data->pyramid_search_levels = cpi->sf.mv_sf.pyramid_search_levels;
+  if (this_frame->y_pyramid == NULL) tpl_data->pyramid_search_levels = 0;
+  for (idx = 0; idx < INTER_REFS_PER_FRAME; ++idx) {
+    if (tpl_data->ref_frame[idx] != NULL &&
+        tpl_data->src_ref_frame[idx] != NULL &&
+        tpl_data->src_ref_frame[idx]->y_pyramid == NULL)
+      tpl_data->pyramid_search_levels = 0;
+  }
+  if (tpl_data->pyramid_search_levels > 0) {
+    const int bit_depth = cm->seq_params->bit_depth;
+    aom_compute_pyramid(this_frame, bit_depth, this_frame->y_pyramid);
+    for (idx = 0; idx < INTER_REFS_PER_FRAME; ++idx) {
+      const YV12_BUFFER_CONFIG *const ref = tpl_data->src_ref_frame[idx];
+      if (tpl_data->ref_frame[idx] == NULL || ref == NULL) continue;
+      aom_compute_pyramid(ref, bit_depth, ref->y_pyramid);
+    }
+  }
+
   // Make a temporary mbmi for tpl model
   MB_MODE_INFO mbmi;
   memset(&mbmi, 0, sizeof(mbmi));
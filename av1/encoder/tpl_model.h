@@ -34,6 +34,7 @@ struct TPL_INFO;
 #include "av1/common/scale.h"
 #include "av1/encoder/block.h"
 #include "av1/encoder/lookahead.h"
+#include "av1/encoder/motion_field_cache.h"
 #include "av1/encoder/ratectrl.h"
 
 static INLINE BLOCK_SIZE convert_length_to_bsize(int length) {
@@ -216,6 +217,24 @@ typedef struct TplParams {
    */
   const YV12_BUFFER_CONFIG *ref_frame[INTER_REFS_PER_FRAME];
 
+  /*!
+   * Cached motion fields from the current frame to the source of each
+   * reference frame, or NULL if the motion field cache is not used.
+   */
+  MotionField *motion_field[INTER_REFS_PER_FRAME];
+
+  /*!
+   * Cached motion fields from the source of each reference frame to the
+   * current frame. Negated vectors are used as starting points.
+   */
+  const MotionField *rev_motion_field[INTER_REFS_PER_FRAME];
+
+  /*!
+   * Number of downsampled pyramid levels used by the coarse-to-fine motion
+   * search, or 0 if it is not used for the current frame.
+   */
+  int pyramid_search_levels;
+
   /*!
    * Parameters related to synchronization for top-right dependency in row based
    * multi-threading of tpl
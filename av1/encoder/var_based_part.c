@@ -144,6 +144,25 @@ static AOM_INLINE void set_block_size(AV1_COMP *const cpi, int mi_row,
   }
 }
 
+// Sets the partition of the superblock to the one coded in the last frame.
+static void set_partition_from_last_frame(AV1_COMP *cpi, int mi_row,
+                                          int mi_col) {
+  const AV1_COMMON *const cm = &cpi->common;
+  const NONRD_DECISION_CACHE *const cache = &cpi->nonrd_decisions;
+  const NONRD_BLOCK_DECISION *const blocks =
+      &cache->blocks[cache->cur_idx ^ 1][mi_row * cache->mi_cols + mi_col];
+  const int mib_size = cm->seq_params->mib_size;
+  const int rows = AOMMIN(mib_size, cm->mi_params.mi_rows - mi_row);
+  const int cols = AOMMIN(mib_size, cm->mi_params.mi_cols - mi_col);
+  for (int r = 0; r < rows; ++r) {
+    for (int c = 0; c < cols; ++c) {
+      const BLOCK_SIZE bsize = blocks[r * cache->mi_cols + c].bsize;
+      if (bsize != BLOCK_INVALID)
+        set_block_size(cpi, mi_row + r, mi_col + c, bsize);
+    }
+  }
+}
+
 static int set_vt_partitioning(AV1_COMP *cpi, MACROBLOCKD *const xd,
                                const TileInfo *const tile, void *data,
                                BLOCK_SIZE bsize, int mi_row, int mi_col,
@@ -1673,6 +1692,15 @@ int av1_choose_var_based_partitioning(AV1_COMP *cpi, const TileInfo *const tile,
       return 0;
   }
 
+  if (x->reuse_sb_decisions) {
+    set_partition_from_last_frame(cpi, mi_row, mi_col);
+    aom_free(vt);
+#if CONFIG_COLLECT_COMPONENT_TIMING
+    end_timing(cpi, choose_var_based_partitioning_time);
+#endif
+    return 0;
+  }
+
   if (cpi->noise_estimate.enabled)
     noise_level = av1_noise_estimate_extract_level(&cpi->noise_estimate);
 
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "config/av1_rtcd.h"
+#include "av1/encoder/ml.h"
+
+// Adds up the four lanes of each 128-bit half of a and b, and returns
+// { sum(a), sum(b), ... } in the low two 32-bit lanes of the result.
+static INLINE __m128i hadd_pair(__m256i a, __m256i b) {
+  const __m256i ab = _mm256_hadd_epi32(a, b);
+  const __m256i abab = _mm256_hadd_epi32(ab, ab);
+  return _mm_add_epi32(_mm256_castsi256_si128(abab),
+                       _mm256_extracti128_si256(abab, 1));
+}
+
+void av1_nn_matvec_int16_avx2(const int16_t *input, const int16_t *weights,
+                              int num_inputs, int num_outputs,
+                              int32_t *output) {
+  assert(num_inputs % NN_QUANT_ALIGN == 0);
+  int node = 0;
+  // Two output nodes at a time, so that the horizontal reduction is shared.
+  for (; node + 1 < num_outputs; node += 2) {
+    const int16_t *const w0 = weights + node * num_inputs;
+    const int16_t *const w1 = w0 + num_inputs;
+    __m256i sum0 = _mm256_setzero_si256();
+    __m256i sum1 = _mm256_setzero_si256();
+    for (int i = 0; i < num_inputs; i += 16) {
+      const __m256i in = _mm256_loadu_si256((const __m256i *)(input + i));
+      sum0 = _mm256_add_epi32(
+          sum0, _mm256_madd_epi16(
+                    in, _mm256_loadu_si256((const __m256i *)(w0 + i))));
+      sum1 = _mm256_add_epi32(
+          sum1, _mm256_madd_epi16(
+                    in, _mm256_loadu_si256((const __m256i *)(w1 + i))));
+    }
+    _mm_storel_epi64((__m128i *)(output + node), hadd_pair(sum0, sum1));
+  }
+  if (node < num_outputs) {
+    const int16_t *const w0 = weights + node * num_inputs;
+    __m256i sum0 = _mm256_setzero_si256();
+    for (int i = 0; i < num_inputs; i += 16) {
+      const __m256i in = _mm256_loadu_si256((const __m256i *)(input + i));
+      sum0 = _mm256_add_epi32(
+          sum0, _mm256_madd_epi16(
+                    in, _mm256_loadu_si256((const __m256i *)(w0 + i))));
+    }
+    output[node] = _mm_cvtsi128_si32(hadd_pair(sum0, sum0));
+  }
+}
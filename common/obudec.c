@@ -504,6 +504,92 @@ int obudec_read_temporal_unit(struct ObuDecInputContext *obu_ctx,
   return 0;
 }
 
+// Scans the OBUs of one frame unit, or of a whole Temporal Unit when not in
+// Annex B format, for the first frame header. Returns 1 if it is found and
+// stores whether it belongs to a shown key frame in 'is_key_frame', and
+// whether a sequence header precedes it in 'seen_sequence_header'. Returns 0
+// if there is no frame header in the unit and -1 on error.
+static int find_first_frame_header(const uint8_t *data, size_t size,
+                                   int is_annexb, int *seen_sequence_header,
+                                   int *reduced_still_picture_header,
+                                   int *is_key_frame) {
+  const uint8_t *const data_end = data + size;
+  while (data < data_end) {
+    ObuHeader obu_header;
+    size_t payload_size = 0;
+    size_t bytes_read = 0;
+    if (aom_read_obu_header_and_size(data, (size_t)(data_end - data),
+                                     is_annexb, &obu_header, &payload_size,
+                                     &bytes_read) != AOM_CODEC_OK) {
+      return -1;
+    }
+    data += bytes_read;
+    if ((size_t)(data_end - data) < payload_size) return -1;
+
+    if (obu_header.type == OBU_SEQUENCE_HEADER && payload_size > 0) {
+      // seq_profile (3 bits), still_picture (1 bit), then
+      // reduced_still_picture_header (1 bit).
+      *seen_sequence_header = 1;
+      *reduced_still_picture_header = (data[0] >> 3) & 1;
+    } else if (obu_header.type == OBU_FRAME_HEADER ||
+               obu_header.type == OBU_FRAME) {
+      if (*reduced_still_picture_header) {
+        *is_key_frame = 1;
+      } else {
+        if (payload_size == 0) return -1;
+        // show_existing_frame (1 bit), frame_type (2 bits, 0 for KEY_FRAME),
+        // then show_frame (1 bit).
+        const int show_existing_frame = data[0] >> 7;
+        const int frame_type = (data[0] >> 5) & 3;
+        const int show_frame = (data[0] >> 4) & 1;
+        *is_key_frame = !show_existing_frame && frame_type == 0 && show_frame;
+      }
+      return 1;
+    }
+    data += payload_size;
+  }
+  return 0;
+}
+
+int obudec_temporal_unit_is_key_frame(const uint8_t *data, size_t size,
+                                      int is_annexb) {
+  const uint8_t *data_end = data + size;
+  int seen_sequence_header = 0;
+  int reduced_still_picture_header = 0;
+  int is_key_frame = 0;
+
+  if (!is_annexb) {
+    return find_first_frame_header(data, size, is_annexb,
+                                   &seen_sequence_header,
+                                   &reduced_still_picture_header,
+                                   &is_key_frame) == 1 &&
+           seen_sequence_header && is_key_frame;
+  }
+
+  uint64_t unit_size = 0;
+  size_t length_of_size = 0;
+  if (aom_uleb_decode(data, size, &unit_size, &length_of_size) != 0) return 0;
+  data += length_of_size;
+  if (unit_size > (uint64_t)(data_end - data)) return 0;
+  data_end = data + unit_size;
+
+  while (data < data_end) {
+    if (aom_uleb_decode(data, (size_t)(data_end - data), &unit_size,
+                        &length_of_size) != 0) {
+      return 0;
+    }
+    data += length_of_size;
+    if (unit_size > (uint64_t)(data_end - data)) return 0;
+    const int found = find_first_frame_header(
+        data, (size_t)unit_size, is_annexb, &seen_sequence_header,
+        &reduced_still_picture_header, &is_key_frame);
+    if (found < 0) return 0;
+    if (found) return seen_sequence_header && is_key_frame;
+    data += unit_size;
+  }
+  return 0;
+}
+
 void obudec_free(struct ObuDecInputContext *obu_ctx) {
   free(obu_ctx->buffer);
   obu_ctx->buffer = NULL;
@@ -39,6 +39,14 @@ int obudec_read_temporal_unit(struct ObuDecInputContext *obu_ctx,
                               uint8_t **buffer, size_t *bytes_read,
                               size_t *buffer_size);
 
+// Returns 1 when the Temporal Unit in 'data' can be decoded without any of
+// the ones before it, i.e. when it holds a sequence header and its first frame
+// is a shown key frame, and 0 otherwise. Only the OBU headers and the first
+// bits of the sequence and frame headers are read, so this is cheap enough to
+// scan a stream for seek points.
+int obudec_temporal_unit_is_key_frame(const uint8_t *data, size_t size,
+                                      int is_annexb);
+
 void obudec_free(struct ObuDecInputContext *obu_ctx);
 
 #ifdef __cplusplus
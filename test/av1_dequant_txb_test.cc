@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <tuple>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+#include "config/av1_rtcd.h"
+
+#include "aom_ports/aom_timer.h"
+#include "test/acm_random.h"
+#include "test/util.h"
+
+namespace {
+
+typedef void (*DequantTxbFunc)(tran_low_t *coeff, int n_coeffs,
+                               const int16_t *dequant,
+                               const qm_val_t *iqmatrix, int shift, int bd);
+
+// Number of coefficients in the transform block: 4x4, 8x8, 16x16, 32x32.
+const int kTxbCoeffs[] = { 16, 64, 256, 1024 };
+
+// |func|, |txb_coeffs|, |bd|
+typedef std::tuple<DequantTxbFunc, int, int> DequantTxbParam;
+
+class AV1DequantTxbTest : public ::testing::TestWithParam<DequantTxbParam> {
+ public:
+  void SetUp() override {
+    rnd_.Reset(libaom_test::ACMRandom::DeterministicSeed());
+  }
+
+ protected:
+  // Fills the first n_coeffs entries with sparse signed levels and leaves the
+  // remainder of the transform block zero, as the decoder guarantees.
+  void FillCoeffs(int n_coeffs, int txb_coeffs) {
+    memset(ref_, 0, sizeof(ref_));
+    for (int i = 0; i < n_coeffs; ++i) {
+      if (rnd_(4) == 0) continue;
+      // Mostly small levels, occasionally large ones close to the 20-bit
+      // limit applied by the coefficient reader.
+      const int level = rnd_(8) ? rnd_(64) + 1 : rnd_(0xfffff) + 1;
+      ref_[i] = rnd_(2) ? -level : level;
+    }
+    ASSERT_LE(n_coeffs, txb_coeffs);
+    memcpy(tst_, ref_, sizeof(ref_));
+  }
+
+  void RunCheckOutput(DequantTxbFunc func, int txb_coeffs, int bd) {
+    for (int iter = 0; iter < 200; ++iter) {
+      const int n_coeffs = 1 + rnd_(txb_coeffs);
+      const int shift = rnd_(3);
+      const int16_t dequant[2] = { static_cast<int16_t>(4 + rnd_(5000)),
+                                   static_cast<int16_t>(4 + rnd_(21000)) };
+      for (int i = 0; i < txb_coeffs; ++i) iqmatrix_[i] = rnd_.Rand8();
+      const qm_val_t *iqmatrix = (iter & 1) ? iqmatrix_ : NULL;
+      FillCoeffs(n_coeffs, txb_coeffs);
+
+      av1_dequant_txb_c(ref_, n_coeffs, dequant, iqmatrix, shift, bd);
+      func(tst_, n_coeffs, dequant, iqmatrix, shift, bd);
+      for (int i = 0; i < txb_coeffs; ++i) {
+        ASSERT_EQ(ref_[i], tst_[i])
+            << "mismatch at " << i << " n_coeffs " << n_coeffs << " shift "
+            << shift << " bd " << bd << " qm " << (iqmatrix != NULL);
+      }
+    }
+  }
+
+  libaom_test::ACMRandom rnd_;
+  tran_low_t ref_[1024];
+  tran_low_t tst_[1024];
+  qm_val_t iqmatrix_[1024];
+};
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(AV1DequantTxbTest);
+
+TEST_P(AV1DequantTxbTest, CheckOutput) {
+  RunCheckOutput(GET_PARAM(0), GET_PARAM(1), GET_PARAM(2));
+}
+
+TEST_P(AV1DequantTxbTest, DISABLED_Speed) {
+  const DequantTxbFunc funcs[2] = { av1_dequant_txb_c, GET_PARAM(0) };
+  const int txb_coeffs = GET_PARAM(1);
+  const int16_t dequant[2] = { 52, 64 };
+  const int kNumIters = 1000000;
+  double elapsed_time[2];
+  for (int i = 0; i < 2; ++i) {
+    aom_usec_timer timer;
+    aom_usec_timer_start(&timer);
+    for (int j = 0; j < kNumIters; ++j) {
+      // Rewrite the levels every iteration since the kernel works in place.
+      for (int k = 0; k < txb_coeffs; k += 3) tst_[k] = (k & 7) - 4;
+      funcs[i](tst_, txb_coeffs, dequant, NULL, 0, GET_PARAM(2));
+    }
+    aom_usec_timer_mark(&timer);
+    elapsed_time[i] = static_cast<double>(aom_usec_timer_elapsed(&timer));
+  }
+  printf("av1_dequant_txb %4d coeffs: %7.2f/%7.2fus (%4.2f)\n", txb_coeffs,
+         elapsed_time[0], elapsed_time[1], elapsed_time[0] / elapsed_time[1]);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    C, AV1DequantTxbTest,
+    ::testing::Combine(::testing::Values(&av1_dequant_txb_c),
+                       ::testing::ValuesIn(kTxbCoeffs),
+                       ::testing::Values(8, 10, 12)));
+
+#if HAVE_SSE4_1
+INSTANTIATE_TEST_SUITE_P(
+    SSE4_1, AV1DequantTxbTest,
+    ::testing::Combine(::testing::Values(&av1_dequant_txb_sse4_1),
+                       ::testing::ValuesIn(kTxbCoeffs),
+                       ::testing::Values(8, 10, 12)));
+#endif  // HAVE_SSE4_1
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, AV1DequantTxbTest,
+    ::testing::Combine(::testing::Values(&av1_dequant_txb_avx2),
+                       ::testing::ValuesIn(kTxbCoeffs),
+                       ::testing::Values(8, 10, 12)));
+#endif  // HAVE_AVX2
+
+}  // namespace
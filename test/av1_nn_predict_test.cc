@@ -205,6 +205,92 @@ TEST_P(NnPredictTest, DISABLED_Speed) {
   RunNnPredictSpeedTest_all(shapes, sizeof(shapes) / sizeof(*shapes), 10000000);
 }
 
+// Checks the quantized path against the float one with the weights of each
+// shape drawn from [-1, 1).
+TEST(NnPredictQuantTest, MatchesFloat) {
+  libaom_test::ACMRandom rng(libaom_test::ACMRandom::DeterministicSeed());
+  static float weights[NN_MAX_HIDDEN_LAYERS + 1]
+                      [NN_MAX_NODES_PER_LAYER * NN_MAX_NODES_PER_LAYER];
+  static float bias[NN_MAX_HIDDEN_LAYERS + 1][NN_MAX_NODES_PER_LAYER];
+  for (const NN_CONFIG &shape : shapes) {
+    NN_CONFIG nn_config = shape;
+    for (int layer = 0; layer <= shape.num_hidden_layers; ++layer) {
+      for (float &w : weights[layer])
+        w = ((float)rng.Rand31() - (1 << 30)) / (1u << 30);
+      for (float &b : bias[layer])
+        b = ((float)rng.Rand31() - (1 << 30)) / (1u << 30);
+      nn_config.weights[layer] = weights[layer];
+      nn_config.bias[layer] = bias[layer];
+    }
+    NN_QUANT_CONFIG quant;
+    ASSERT_EQ(av1_nn_quantize_config(&nn_config, &quant), 1);
+    for (int iter = 0; iter < 1000; ++iter) {
+      float inputs[NN_MAX_NODES_PER_LAYER];
+      float outputs_ref[NN_MAX_NODES_PER_LAYER];
+      float outputs_test[NN_MAX_NODES_PER_LAYER];
+      for (int i = 0; i < shape.num_inputs; ++i)
+        inputs[i] = ((float)rng.Rand31() - (1 << 30)) / (1u << 30);
+      av1_nn_predict_c(inputs, &nn_config, 0, outputs_ref);
+      av1_nn_predict_quant(inputs, &quant, 0, outputs_test);
+      for (int i = 0; i < shape.num_outputs; ++i) {
+        ASSERT_NEAR(outputs_ref[i], outputs_test[i],
+                    0.01f * AOMMAX(1.0f, fabsf(outputs_ref[i])))
+            << "shape " << shape.num_inputs << "x"
+            << shape.num_hidden_nodes[0] << "x" << shape.num_outputs;
+      }
+    }
+    av1_nn_free_quant_config(&quant);
+  }
+}
+
+typedef void (*NnMatvecInt16Func)(const int16_t *input, const int16_t *weights,
+                                  int num_inputs, int num_outputs,
+                                  int32_t *output);
+
+class NnMatvecInt16Test : public ::testing::TestWithParam<NnMatvecInt16Func> {
+};
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(NnMatvecInt16Test);
+
+TEST_P(NnMatvecInt16Test, MatchesC) {
+  libaom_test::ACMRandom rng(libaom_test::ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(32, int16_t, input[NN_QUANT_MAX_INPUTS]);
+  static int16_t weights[NN_MAX_NODES_PER_LAYER * NN_QUANT_MAX_INPUTS];
+  int32_t ref[NN_MAX_NODES_PER_LAYER], test[NN_MAX_NODES_PER_LAYER];
+  for (int iter = 0; iter < 1000; ++iter) {
+    const int num_inputs =
+        NN_QUANT_ALIGN * (1 + rng(NN_QUANT_MAX_INPUTS / NN_QUANT_ALIGN));
+    const int num_outputs = 1 + rng(NN_MAX_NODES_PER_LAYER);
+    const int act_max = av1_nn_quant_act_max(num_inputs);
+    // Use the extreme values half of the time.
+    const int extreme = iter & 1;
+    for (int i = 0; i < num_inputs; ++i) {
+      input[i] = extreme ? (rng(2) ? act_max : -act_max)
+                         : rng(2 * act_max + 1) - act_max;
+    }
+    for (int i = 0; i < num_inputs * num_outputs; ++i) {
+      weights[i] = extreme ? (rng(2) ? NN_QUANT_WEIGHT_MAX
+                                     : -NN_QUANT_WEIGHT_MAX)
+                           : rng(2 * NN_QUANT_WEIGHT_MAX + 1) -
+                                 NN_QUANT_WEIGHT_MAX;
+    }
+    av1_nn_matvec_int16_c(input, weights, num_inputs, num_outputs, ref);
+    GetParam()(input, weights, num_inputs, num_outputs, test);
+    for (int i = 0; i < num_outputs; ++i) {
+      ASSERT_EQ(ref[i], test[i]) << num_inputs << "x" << num_outputs;
+    }
+  }
+}
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(AVX2, NnMatvecInt16Test,
+                         ::testing::Values(av1_nn_matvec_int16_avx2));
+#endif
+
+#if HAVE_NEON
+INSTANTIATE_TEST_SUITE_P(NEON, NnMatvecInt16Test,
+                         ::testing::Values(av1_nn_matvec_int16_neon));
+#endif
+
 #if HAVE_SSE3 && !CONFIG_EXCLUDE_SIMD_MISMATCH
 INSTANTIATE_TEST_SUITE_P(SSE3, NnPredictTest,
                          ::testing::Values(av1_nn_predict_sse3));
@@ -17,6 +17,7 @@
 
 #include "config/av1_rtcd.h"
 
+#include "aom_dsp/aom_dsp_common.h"
 #include "aom_ports/aom_timer.h"
 #include "av1/encoder/cnn.h"
 #include "av1/encoder/partition_cnn_weights.h"
@@ -2508,6 +2509,94 @@ TEST_F(CNNTest, TestMultiOutput) {
   aom_free(output_);
 }
 
+// Checks the quantized intra partition model against the float one on
+// textured 8-bit and 10-bit blocks.
+TEST(CNNQuantTest, MatchesFloatPartitionModel) {
+  const CNN_CONFIG *const cnn_config = &av1_intra_mode_cnn_partition_cnn_config;
+  CNN_QUANT_CONFIG quant;
+  ASSERT_TRUE(av1_cnn_quantize_config(cnn_config, &quant));
+
+  const int kDim = 65;
+  const int kNumOutputs = 4;
+  const int output_dims[4] = { 1, 2, 4, 8 };
+  const int out_chs[4] = { CNN_BRANCH_0_OUT_CH, CNN_BRANCH_1_OUT_CH,
+                           CNN_BRANCH_2_OUT_CH, CNN_BRANCH_3_OUT_CH };
+  float ref_buf[CNN_OUT_BUF_SIZE], quant_buf[CNN_OUT_BUF_SIZE];
+  float *ref_ptrs[CNN_TOT_OUT_CH], *quant_ptrs[CNN_TOT_OUT_CH];
+  int ch_offset[CNN_TOT_OUT_CH + 1] = { 0 };
+  int ch_idx = 0;
+  for (int i = 0; i < kNumOutputs; ++i) {
+    for (int ch = 0; ch < out_chs[i]; ++ch, ++ch_idx) {
+      ref_ptrs[ch_idx] = ref_buf + ch_offset[ch_idx];
+      quant_ptrs[ch_idx] = quant_buf + ch_offset[ch_idx];
+      ch_offset[ch_idx + 1] =
+          ch_offset[ch_idx] + output_dims[i] * output_dims[i];
+    }
+  }
+  CNN_MULTI_OUT ref_out = { kNumOutputs, out_chs, output_dims, ref_ptrs };
+  CNN_MULTI_OUT quant_out = { kNumOutputs, out_chs, output_dims, quant_ptrs };
+  const CNN_THREAD_DATA thread_data = { 1, nullptr };
+
+  libaom_test::ACMRandom rnd(libaom_test::ACMRandom::DeterministicSeed());
+  uint8_t pixels[kDim * kDim];
+  uint16_t pixels16[kDim * kDim];
+  for (int bit_depth = 8; bit_depth <= 10; bit_depth += 2) {
+    for (int iter = 0; iter < 20; ++iter) {
+      // A gradient with a random slope plus noise of random strength.
+      const int slope = rnd.Rand8() % 8;
+      const int noise = 1 + rnd.Rand8() % 64;
+      for (int i = 0; i < kDim * kDim; ++i) {
+        const int val = (i / kDim + i % kDim) * slope / 2 + rnd(noise);
+        pixels16[i] = static_cast<uint16_t>(
+            AOMMIN(val << (bit_depth - 8), (1 << bit_depth) - 1));
+        pixels[i] = static_cast<uint8_t>(AOMMIN(val, 255));
+      }
+      if (bit_depth == 8) {
+        uint8_t *image[1] = { pixels };
+        ASSERT_TRUE(av1_cnn_predict_img_multi_out(image, kDim, kDim, kDim,
+                                                  cnn_config, &thread_data,
+                                                  &ref_out));
+        ASSERT_TRUE(av1_cnn_predict_img_multi_out_quant(
+            image, kDim, kDim, kDim, 0, 8, &quant, &quant_out));
+      } else {
+        uint16_t *image16[1] = { pixels16 };
+        uint8_t *image[1] = { CONVERT_TO_BYTEPTR(pixels16) };
+        ASSERT_TRUE(av1_cnn_predict_img_multi_out_highbd(
+            image16, kDim, kDim, kDim, cnn_config, &thread_data, bit_depth,
+            &ref_out));
+        ASSERT_TRUE(av1_cnn_predict_img_multi_out_quant(
+            image, kDim, kDim, kDim, 1, bit_depth, &quant, &quant_out));
+      }
+      // Each output should be within 5% of its own range.
+      ch_idx = 0;
+      for (int i = 0; i < kNumOutputs; ++i) {
+        const int start = ch_offset[ch_idx];
+        ch_idx += out_chs[i];
+        const int end = ch_offset[ch_idx];
+        float max_abs = 0.0f;
+        for (int j = start; j < end; ++j)
+          max_abs = AOMMAX(max_abs, fabsf(ref_buf[j]));
+        for (int j = start; j < end; ++j) {
+          ASSERT_NEAR(ref_buf[j], quant_buf[j], 0.05f * max_abs + 1e-3f)
+              << "bit depth " << bit_depth << " output " << i << " index "
+              << j - start;
+        }
+      }
+    }
+  }
+  av1_cnn_free_quant_config(&quant);
+}
+
+TEST(CNNQuantTest, RejectsUnsupportedLayers) {
+  CNN_CONFIG cnn_config = av1_intra_mode_cnn_partition_cnn_config;
+  CNN_QUANT_CONFIG quant;
+  cnn_config.layer_config[2].maxpool = 1;
+  EXPECT_FALSE(av1_cnn_quantize_config(&cnn_config, &quant));
+  cnn_config = av1_intra_mode_cnn_partition_cnn_config;
+  cnn_config.layer_config[1].pad = PADDING_SAME_ZERO;
+  EXPECT_FALSE(av1_cnn_quantize_config(&cnn_config, &quant));
+}
+
 namespace {
 
 typedef void (*CNNConvolveNoMaxpoolPaddingValidFunc)(
@@ -59,4 +59,34 @@ TEST(DecodeAPI, InvalidControlId) {
   EXPECT_EQ(AOM_CODEC_OK, aom_codec_destroy(&dec));
 }
 
+TEST(DecodeAPI, FastDecodeLevels) {
+  aom_codec_iface_t *iface = aom_codec_av1_dx();
+  aom_codec_ctx_t dec;
+  EXPECT_EQ(AOM_CODEC_OK, aom_codec_dec_init(&dec, iface, nullptr, 0));
+  for (int level = 0; level <= 4; ++level) {
+    EXPECT_EQ(AOM_CODEC_OK,
+              aom_codec_control(&dec, AV1D_SET_FAST_DECODE, level));
+  }
+  EXPECT_EQ(AOM_CODEC_INVALID_PARAM,
+            aom_codec_control(&dec, AV1D_SET_FAST_DECODE, -1));
+  EXPECT_EQ(AOM_CODEC_INVALID_PARAM,
+            aom_codec_control(&dec, AV1D_SET_FAST_DECODE, 5));
+  EXPECT_EQ(AOM_CODEC_OK, aom_codec_destroy(&dec));
+}
+
+TEST(DecodeAPI, SkipFramesModes) {
+  aom_codec_iface_t *iface = aom_codec_av1_dx();
+  aom_codec_ctx_t dec;
+  EXPECT_EQ(AOM_CODEC_OK, aom_codec_dec_init(&dec, iface, nullptr, 0));
+  for (int mode = 0; mode <= 2; ++mode) {
+    EXPECT_EQ(AOM_CODEC_OK,
+              aom_codec_control(&dec, AV1D_SET_SKIP_FRAMES, mode));
+  }
+  EXPECT_EQ(AOM_CODEC_INVALID_PARAM,
+            aom_codec_control(&dec, AV1D_SET_SKIP_FRAMES, -1));
+  EXPECT_EQ(AOM_CODEC_INVALID_PARAM,
+            aom_codec_control(&dec, AV1D_SET_SKIP_FRAMES, 3));
+  EXPECT_EQ(AOM_CODEC_OK, aom_codec_destroy(&dec));
+}
+
 }  // namespace
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+#include "aom/aom_decoder.h"
+#include "aom/aomdx.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/md5_helper.h"
+#include "test/util.h"
+#include "test/video_source.h"
+
+namespace {
+
+const int kNumStreams = 5;
+const aom_codec_dec_cfg_t kDecCfg = { 1, 0, 0, !FORCE_HIGHBITDEPTH_DECODING };
+
+// Decodes an encoded stream in several decoder contexts at once with
+// aom_codec_decode_batch(), and checks each of them against a decoder that
+// decodes on its own.
+class DecodeBatchTest : public ::libaom_test::CodecTestWithParam<int>,
+                        public ::libaom_test::EncoderTest {
+ protected:
+  DecodeBatchTest() : EncoderTest(GET_PARAM(0)), num_threads_(GET_PARAM(1)) {}
+
+  ~DecodeBatchTest() override { delete ref_decoder_; }
+
+  void SetUp() override {
+    InitializeConfig(::libaom_test::kOnePassGood);
+    cfg_.g_lag_in_frames = 0;
+    ref_decoder_ = codec_->CreateDecoder(kDecCfg, 0);
+  }
+
+  void PreEncodeFrameHook(::libaom_test::VideoSource *video,
+                          ::libaom_test::Encoder *encoder) override {
+    if (video->frame() == 0) encoder->Control(AOME_SET_CPUUSED, 6);
+  }
+
+  void FramePktHook(const aom_codec_cx_pkt_t *pkt) override {
+    const uint8_t *data = static_cast<const uint8_t *>(pkt->data.frame.buf);
+    packets_.emplace_back(data, data + pkt->data.frame.sz);
+    ASSERT_EQ(ref_decoder_->DecodeFrame(data, pkt->data.frame.sz),
+              AOM_CODEC_OK)
+        << ref_decoder_->DecodeError();
+    ::libaom_test::DxDataIterator dec_iter = ref_decoder_->GetDxData();
+    const aom_image_t *img = dec_iter.Next();
+    ASSERT_NE(img, nullptr);
+    ::libaom_test::MD5 md5;
+    md5.Add(img);
+    ref_md5_.push_back(md5.Get());
+  }
+
+  const int num_threads_;
+  ::libaom_test::Decoder *ref_decoder_ = nullptr;
+  std::vector<std::vector<uint8_t>> packets_;
+  std::vector<std::string> ref_md5_;
+};
+
+TEST_P(DecodeBatchTest, MatchesSingleStreamDecode) {
+  ::libaom_test::RandomVideoSource video;
+  video.SetSize(176, 144);
+  video.set_limit(6);
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+
+  aom_codec_ctx_t decoders[kNumStreams];
+  for (aom_codec_ctx_t &decoder : decoders) {
+    ASSERT_EQ(aom_codec_dec_init(&decoder, aom_codec_av1_dx(), &kDecCfg, 0),
+              AOM_CODEC_OK);
+  }
+  aom_codec_dec_pool_t *const pool = aom_codec_dec_pool_create(num_threads_);
+  ASSERT_NE(pool, nullptr);
+
+  for (size_t i = 0; i < packets_.size(); ++i) {
+    aom_codec_decode_job_t jobs[kNumStreams];
+    for (int s = 0; s < kNumStreams; ++s) {
+      jobs[s].ctx = &decoders[s];
+      jobs[s].data = packets_[i].data();
+      jobs[s].data_sz = packets_[i].size();
+      jobs[s].user_priv = nullptr;
+      jobs[s].res = AOM_CODEC_ERROR;
+    }
+    ASSERT_EQ(aom_codec_decode_batch(pool, jobs, kNumStreams), AOM_CODEC_OK);
+    for (int s = 0; s < kNumStreams; ++s) {
+      EXPECT_EQ(jobs[s].res, AOM_CODEC_OK);
+      aom_codec_iter_t iter = nullptr;
+      const aom_image_t *img = aom_codec_get_frame(&decoders[s], &iter);
+      ASSERT_NE(img, nullptr);
+      ::libaom_test::MD5 md5;
+      md5.Add(img);
+      EXPECT_EQ(md5.Get(), ref_md5_[i]) << "stream " << s << " frame " << i;
+    }
+  }
+
+  EXPECT_EQ(aom_codec_decode_batch(pool, nullptr, 0), AOM_CODEC_OK);
+  EXPECT_EQ(aom_codec_decode_batch(nullptr, nullptr, 0),
+            AOM_CODEC_INVALID_PARAM);
+  aom_codec_dec_pool_destroy(pool);
+  for (aom_codec_ctx_t &decoder : decoders) {
+    EXPECT_EQ(aom_codec_destroy(&decoder), AOM_CODEC_OK);
+  }
+}
+
+AV1_INSTANTIATE_TEST_SUITE(DecodeBatchTest, ::testing::Values(1, 3));
+
+}  // namespace
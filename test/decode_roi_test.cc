@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string.h>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+#include "aom/aomdx.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/util.h"
+#include "test/video_source.h"
+
+namespace {
+
+const int kWidth = 352;
+const int kHeight = 288;
+// With 64x64 superblocks, the right one of two tile columns starts at 192.
+const int kTileColEdge = 192;
+// Keeps the region clear of the pixels the in-loop filters change across the
+// edge of the tiles.
+const int kFilterMargin = 16;
+
+// Decodes the right tile column of an intra only stream with the region of
+// interest set, and checks the region against a decoder that decodes whole
+// frames.
+class DecodeRoiTest : public ::libaom_test::CodecTestWithParam<int>,
+                      public ::libaom_test::EncoderTest {
+ protected:
+  DecodeRoiTest() : EncoderTest(GET_PARAM(0)), threads_(GET_PARAM(1)) {}
+
+  ~DecodeRoiTest() override {
+    delete decoder_;
+    delete ref_decoder_;
+  }
+
+  void SetUp() override {
+    InitializeConfig(::libaom_test::kOnePassGood);
+    cfg_.g_lag_in_frames = 0;
+    cfg_.kf_max_dist = 0;
+    aom_codec_dec_cfg_t dec_cfg = aom_codec_dec_cfg_t();
+    dec_cfg.threads = threads_;
+    decoder_ = codec_->CreateDecoder(dec_cfg, 0);
+    ref_decoder_ = codec_->CreateDecoder(dec_cfg, 0);
+    aom_decode_roi_t roi = { kTileColEdge + kFilterMargin, 0,
+                             kWidth - kTileColEdge - kFilterMargin, kHeight };
+    decoder_->Control(AV1D_SET_DECODE_ROI, &roi);
+  }
+
+  void PreEncodeFrameHook(::libaom_test::VideoSource *video,
+                          ::libaom_test::Encoder *encoder) override {
+    if (video->frame() == 0) {
+      encoder->Control(AOME_SET_CPUUSED, 6);
+      encoder->Control(AV1E_SET_TILE_COLUMNS, 1);
+      encoder->Control(AV1E_SET_SUPERBLOCK_SIZE, AOM_SUPERBLOCK_SIZE_64X64);
+      encoder->Control(AV1E_SET_ENABLE_RESTORATION, 0);
+      // Otherwise the tile the entropy contexts are carried over from may be
+      // the left one, which is then decoded too.
+      encoder->Control(AV1E_SET_FRAME_PARALLEL_DECODING, 1);
+    }
+  }
+
+  void FramePktHook(const aom_codec_cx_pkt_t *pkt) override {
+    const uint8_t *data = static_cast<const uint8_t *>(pkt->data.frame.buf);
+    ASSERT_EQ(decoder_->DecodeFrame(data, pkt->data.frame.sz), AOM_CODEC_OK)
+        << decoder_->DecodeError();
+    ASSERT_EQ(ref_decoder_->DecodeFrame(data, pkt->data.frame.sz),
+              AOM_CODEC_OK)
+        << ref_decoder_->DecodeError();
+    ::libaom_test::DxDataIterator dec_iter = decoder_->GetDxData();
+    ::libaom_test::DxDataIterator ref_iter = ref_decoder_->GetDxData();
+    const aom_image_t *img = dec_iter.Next();
+    const aom_image_t *ref_img = ref_iter.Next();
+    ASSERT_NE(img, nullptr);
+    ASSERT_NE(ref_img, nullptr);
+
+    const int bytes = (img->fmt & AOM_IMG_FMT_HIGHBITDEPTH) ? 2 : 1;
+    for (int plane = 0; plane < 3; ++plane) {
+      const int ss_y = plane ? img->y_chroma_shift : 0;
+      const int ss_x = plane ? img->x_chroma_shift : 0;
+      const int start = ((kTileColEdge + kFilterMargin) >> ss_x) * bytes;
+      const int width = ((kWidth + ss_x) >> ss_x) * bytes - start;
+      const int height = (kHeight + ss_y) >> ss_y;
+      for (int r = 0; r < height; ++r) {
+        ASSERT_EQ(memcmp(img->planes[plane] + r * img->stride[plane] + start,
+                         ref_img->planes[plane] + r * ref_img->stride[plane] +
+                             start,
+                         width),
+                  0)
+            << "plane " << plane << " row " << r;
+      }
+      // The left tile column is not decoded.
+      for (int r = 0; r < height; ++r) {
+        if (memcmp(img->planes[plane] + r * img->stride[plane],
+                   ref_img->planes[plane] + r * ref_img->stride[plane],
+                   (kTileColEdge >> ss_x) * bytes) != 0) {
+          ++num_planes_skipped_;
+          break;
+        }
+      }
+    }
+  }
+
+  const int threads_;
+  ::libaom_test::Decoder *decoder_ = nullptr;
+  ::libaom_test::Decoder *ref_decoder_ = nullptr;
+  int num_planes_skipped_ = 0;
+};
+
+TEST_P(DecodeRoiTest, RegionMatchesFullDecode) {
+  ::libaom_test::RandomVideoSource video;
+  video.SetSize(kWidth, kHeight);
+  video.set_limit(3);
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  EXPECT_GT(num_planes_skipped_, 0);
+}
+
+AV1_INSTANTIATE_TEST_SUITE(DecodeRoiTest, ::testing::Values(1, 4));
+
+}  // namespace
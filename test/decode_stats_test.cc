@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+#include "aom/aomdx.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/util.h"
+#include "test/video_source.h"
+
+namespace {
+
+const int kWidth = 176;
+const int kHeight = 144;
+
+// Checks the counters AV1D_GET_DECODE_STATS returns for each frame of an
+// encoded stream against what is known of the frame.
+class DecodeStatsTest : public ::libaom_test::CodecTestWithParam<int>,
+                        public ::libaom_test::EncoderTest {
+ protected:
+  DecodeStatsTest() : EncoderTest(GET_PARAM(0)), threads_(GET_PARAM(1)) {}
+
+  ~DecodeStatsTest() override { delete decoder_; }
+
+  void SetUp() override {
+    InitializeConfig(::libaom_test::kOnePassGood);
+    cfg_.g_lag_in_frames = 0;
+    aom_codec_dec_cfg_t dec_cfg = aom_codec_dec_cfg_t();
+    dec_cfg.threads = threads_;
+    decoder_ = codec_->CreateDecoder(dec_cfg, 0);
+    decoder_->Control(AV1D_SET_ROW_MT, 1);
+  }
+
+  void PreEncodeFrameHook(::libaom_test::VideoSource *video,
+                          ::libaom_test::Encoder *encoder) override {
+    if (video->frame() == 0) {
+      encoder->Control(AOME_SET_CPUUSED, 6);
+      encoder->Control(AV1E_SET_TILE_COLUMNS, 1);
+    }
+  }
+
+  void FramePktHook(const aom_codec_cx_pkt_t *pkt) override {
+    const uint8_t *data = static_cast<const uint8_t *>(pkt->data.frame.buf);
+    ASSERT_EQ(decoder_->DecodeFrame(data, pkt->data.frame.sz), AOM_CODEC_OK)
+        << decoder_->DecodeError();
+    ::libaom_test::DxDataIterator dec_iter = decoder_->GetDxData();
+    ASSERT_NE(dec_iter.Next(), nullptr);
+
+    aom_decode_stats_t stats;
+    ASSERT_EQ(aom_codec_control(decoder_->GetDecoder(), AV1D_GET_DECODE_STATS,
+                                &stats),
+              AOM_CODEC_OK);
+    EXPECT_EQ(stats.frames, 1u);
+    EXPECT_EQ(stats.bytes, pkt->data.frame.sz);
+    EXPECT_GE(stats.decode_us, stats.stage_us[AOM_DECODE_STAGE_TILES]);
+
+    unsigned int blocks = 0;
+    int area = 0;
+    for (int i = 0; i < AOM_DECODE_STATS_BLOCK_SIZES; ++i) {
+      static const int kBlockArea[AOM_DECODE_STATS_BLOCK_SIZES] = {
+        16,   32,    32,   64,   128,  128,   256,   512,
+        512,  1024,  2048, 2048, 4096, 8192,  8192,  16384,
+        64,   64,    256,  256,  1024, 1024
+      };
+      blocks += stats.blocks[i];
+      area += stats.blocks[i] * kBlockArea[i];
+    }
+    EXPECT_EQ(blocks, stats.intra_blocks + stats.inter_blocks);
+    EXPECT_LE(stats.compound_blocks, stats.inter_blocks);
+    EXPECT_LE(stats.skip_blocks, blocks);
+    // The blocks cover the frame, rounded up to 8x8 luma blocks.
+    EXPECT_GE(area, kWidth * kHeight);
+    if (pkt->data.frame.flags & AOM_FRAME_IS_KEY) {
+      EXPECT_EQ(stats.inter_blocks, 0u);
+    }
+    ++num_frames_;
+  }
+
+  const int threads_;
+  ::libaom_test::Decoder *decoder_ = nullptr;
+  int num_frames_ = 0;
+};
+
+TEST_P(DecodeStatsTest, CountsMatchStream) {
+  ::libaom_test::RandomVideoSource video;
+  video.SetSize(kWidth, kHeight);
+  video.set_limit(4);
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  EXPECT_EQ(num_frames_, 4);
+}
+
+AV1_INSTANTIATE_TEST_SUITE(DecodeStatsTest, ::testing::Values(1, 4));
+
+}  // namespace
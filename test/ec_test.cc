@@ -12,6 +12,7 @@
 #include "third_party/googletest/src/googletest/include/gtest/gtest.h"
 
 #include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <new>
 
@@ -150,3 +151,63 @@ TEST(EC_TEST, random_ec_test) {
   od_ec_enc_clear(&enc);
   EXPECT_EQ(ret, 0);
 }
+
+TEST(EC_TEST, enc_bits_matches_bool) {
+  od_ec_enc enc_bits;
+  od_ec_enc enc_bool;
+  od_ec_dec dec;
+  unsigned char *ptr;
+  uint32_t ptr_sz;
+  srand(0xb175);
+  od_ec_enc_init(&enc_bits, 1);
+  od_ec_enc_init(&enc_bool, 1);
+  for (int i = 0; i < 2000; i++) {
+    const int sz = 1 + rand() % 64;
+    std::unique_ptr<uint32_t[]> data(new (std::nothrow) uint32_t[sz]);
+    ASSERT_NE(data, nullptr);
+    std::unique_ptr<unsigned[]> nbits(new (std::nothrow) unsigned[sz]);
+    ASSERT_NE(nbits, nullptr);
+    std::unique_ptr<unsigned[]> fz(new (std::nothrow) unsigned[sz]);
+    ASSERT_NE(fz, nullptr);
+    od_ec_enc_reset(&enc_bits);
+    od_ec_enc_reset(&enc_bool);
+    for (int j = 0; j < sz; j++) {
+      // Interleave runs of bypass bits with skewed binary symbols so that the
+      // runs start from arbitrary coder states.
+      nbits[j] = rand() % 33;
+      data[j] = ((uint32_t)rand() << 16 ^ (uint32_t)rand()) &
+                (uint32_t)((1ULL << nbits[j]) - 1);
+      fz[j] = OD_MAXI(rand() % (CDF_PROB_TOP - 2), 1);
+      od_ec_encode_bool_q15(&enc_bits, j & 1, OD_ICDF(fz[j]));
+      od_ec_encode_bool_q15(&enc_bool, j & 1, OD_ICDF(fz[j]));
+      od_ec_enc_bits(&enc_bits, data[j], nbits[j]);
+      for (int b = nbits[j] - 1; b >= 0; b--) {
+        od_ec_encode_bool_q15(&enc_bool, (data[j] >> b) & 1, 16384);
+      }
+      ASSERT_EQ(od_ec_enc_tell_frac(&enc_bits), od_ec_enc_tell_frac(&enc_bool));
+    }
+    uint32_t ref_sz;
+    ptr = od_ec_enc_done(&enc_bool, &ref_sz);
+    ASSERT_NE(ptr, nullptr);
+    std::unique_ptr<unsigned char[]> ref(new (std::nothrow)
+                                             unsigned char[ref_sz]);
+    ASSERT_NE(ref, nullptr);
+    memcpy(ref.get(), ptr, ref_sz);
+    ptr = od_ec_enc_done(&enc_bits, &ptr_sz);
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_EQ(ptr_sz, ref_sz);
+    ASSERT_EQ(memcmp(ptr, ref.get(), ptr_sz), 0);
+
+    od_ec_dec_init(&dec, ptr, ptr_sz);
+    for (int j = 0; j < sz; j++) {
+      ASSERT_EQ(od_ec_decode_bool_q15(&dec, OD_ICDF(fz[j])), j & 1);
+      uint32_t val = 0;
+      for (unsigned b = 0; b < nbits[j]; b++) {
+        val = (val << 1) | od_ec_decode_bool_q15(&dec, 16384);
+      }
+      ASSERT_EQ(val, data[j]);
+    }
+  }
+  od_ec_enc_clear(&enc_bits);
+  od_ec_enc_clear(&enc_bool);
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string.h>
+#include <tuple>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+#include "aom/aom_image.h"
+#include "aom_util/aom_thread.h"
+#include "av1/decoder/grain_synthesis.h"
+#include "av1/encoder/grain_test_vectors.h"
+#include "test/acm_random.h"
+
+namespace {
+
+const int kMaxWorkers = 4;
+
+// |fmt|, |width|, |height|
+typedef std::tuple<aom_img_fmt_t, int, int> GrainSynthesisParam;
+
+class GrainSynthesisTest
+    : public ::testing::TestWithParam<GrainSynthesisParam> {
+ public:
+  void SetUp() override {
+    rnd_.Reset(libaom_test::ACMRandom::DeterministicSeed());
+    fmt_ = std::get<0>(GetParam());
+    width_ = std::get<1>(GetParam());
+    height_ = std::get<2>(GetParam());
+    const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+    for (int i = 0; i < kMaxWorkers; ++i) {
+      winterface->init(&workers_[i]);
+      if (i > 0) {
+        ASSERT_NE(winterface->reset(&workers_[i]), 0);
+      }
+    }
+  }
+
+  void TearDown() override {
+    const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+    for (int i = 0; i < kMaxWorkers; ++i) winterface->end(&workers_[i]);
+  }
+
+ protected:
+  void FillRandom(aom_image_t *img, int bit_depth) {
+    const int hbd = (img->fmt & AOM_IMG_FMT_HIGHBITDEPTH) ? 1 : 0;
+    const int num_planes = img->monochrome ? 1 : 3;
+    for (int plane = 0; plane < num_planes; ++plane) {
+      const int w = aom_img_plane_width(img, plane);
+      const int h = aom_img_plane_height(img, plane);
+      for (int r = 0; r < h; ++r) {
+        uint8_t *row = img->planes[plane] + r * img->stride[plane];
+        for (int c = 0; c < w; ++c) {
+          if (hbd) {
+            reinterpret_cast<uint16_t *>(row)[c] =
+                rnd_.Rand16() & ((1 << bit_depth) - 1);
+          } else {
+            row[c] = rnd_.Rand8();
+          }
+        }
+      }
+    }
+  }
+
+  void CheckEqual(const aom_image_t &a, const aom_image_t &b) {
+    const int bytes = (a.fmt & AOM_IMG_FMT_HIGHBITDEPTH) ? 2 : 1;
+    for (int plane = 0; plane < 3; ++plane) {
+      const int w = aom_img_plane_width(&a, plane);
+      const int h = aom_img_plane_height(&a, plane);
+      for (int r = 0; r < h; ++r) {
+        ASSERT_EQ(memcmp(a.planes[plane] + r * a.stride[plane],
+                         b.planes[plane] + r * b.stride[plane], w * bytes),
+                  0)
+            << "plane " << plane << " row " << r;
+      }
+    }
+  }
+
+  libaom_test::ACMRandom rnd_;
+  aom_img_fmt_t fmt_;
+  int width_;
+  int height_;
+  AVxWorker workers_[kMaxWorkers];
+};
+
+// Checks that splitting the frame into stripe ranges across workers produces
+// the same output as the single-threaded path, for every test vector.
+TEST_P(GrainSynthesisTest, MatchesSingleThreaded) {
+  const int even_w = (width_ + 1) & ~1;
+  const int even_h = (height_ + 1) & ~1;
+  for (size_t v = 0; v < sizeof(film_grain_test_vectors) /
+                             sizeof(film_grain_test_vectors[0]);
+       ++v) {
+    aom_film_grain_t params = film_grain_test_vectors[v];
+    if (!params.apply_grain) continue;
+    const int hbd = (fmt_ & AOM_IMG_FMT_HIGHBITDEPTH) ? 1 : 0;
+    params.bit_depth = hbd ? 10 : 8;
+    params.random_seed = static_cast<uint16_t>(rnd_.Rand16());
+
+    aom_image_t src;
+    ASSERT_NE(aom_img_alloc(&src, fmt_, width_, height_, 32), nullptr);
+    src.bit_depth = params.bit_depth;
+    FillRandom(&src, params.bit_depth);
+
+    aom_image_t ref;
+    ASSERT_NE(aom_img_alloc(&ref, fmt_, even_w, even_h, 32), nullptr);
+    ASSERT_EQ(av1_add_film_grain(&params, &src, &ref), 0);
+
+    for (int num_workers = 1; num_workers <= kMaxWorkers; ++num_workers) {
+      aom_image_t tst;
+      ASSERT_NE(aom_img_alloc(&tst, fmt_, even_w, even_h, 32), nullptr);
+      ASSERT_EQ(
+          av1_add_film_grain_mt(&params, &src, &tst, workers_, num_workers), 0);
+      CheckEqual(ref, tst);
+      aom_img_free(&tst);
+      if (HasFatalFailure()) {
+        ADD_FAILURE() << "test vector " << v << " workers " << num_workers;
+        break;
+      }
+    }
+    aom_img_free(&ref);
+    aom_img_free(&src);
+    if (HasFatalFailure()) return;
+  }
+}
+
+const aom_img_fmt_t kFormats[] = { AOM_IMG_FMT_I420,   AOM_IMG_FMT_I422,
+                                   AOM_IMG_FMT_I444,   AOM_IMG_FMT_I42016,
+                                   AOM_IMG_FMT_I42216, AOM_IMG_FMT_I44416 };
+
+// Sizes with odd dimensions and partial stripes, and a frame with fewer
+// stripes than workers.
+INSTANTIATE_TEST_SUITE_P(
+    C, GrainSynthesisTest,
+    ::testing::Combine(::testing::ValuesIn(kFormats),
+                       ::testing::Values(33, 176, 353),
+                       ::testing::Values(17, 97, 145)));
+
+}  // namespace
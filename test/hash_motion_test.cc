@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string.h>
+
+#include <vector>
+
+#include "av1/encoder/hash_motion.h"
+#include "test/acm_random.h"
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+namespace {
+
+const int kWidth = 200;
+const int kHeight = 264;
+const int kStride = 224;
+const int kMinBlockSize = 4;
+const int kMaxBlockSize = 64;
+const int kNumAddresses = 6 << 16;
+
+class HashTableUpdateTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    memset(&updated_, 0, sizeof(updated_));
+    memset(&rebuilt_, 0, sizeof(rebuilt_));
+    av1_hash_table_init(&updated_);
+    av1_hash_table_init(&rebuilt_);
+    // Screen-like content: flat areas and a few repeated patterns.
+    libaom_test::ACMRandom rnd(libaom_test::ACMRandom::DeterministicSeed());
+    pixels_.resize(kStride * kHeight);
+    for (int r = 0; r < kHeight; ++r) {
+      for (int c = 0; c < kStride; ++c) {
+        pixels_[r * kStride + c] =
+            ((r / 16 + c / 16) % 3 == 0) ? 255 : ((r * 7 + c * 3) % 5) * 40;
+      }
+    }
+    for (int i = 0; i < 500; ++i)
+      pixels_[rnd.Rand16() % (kStride * kHeight)] = rnd.Rand8();
+    memset(&picture_, 0, sizeof(picture_));
+    picture_.y_buffer = pixels_.data();
+    picture_.y_stride = kStride;
+    picture_.y_crop_width = kWidth;
+    picture_.y_crop_height = kHeight;
+  }
+
+  void TearDown() override {
+    av1_hash_table_release(&updated_);
+    av1_hash_table_release(&rebuilt_);
+  }
+
+  void ChangeRows(int first_row, int num_rows) {
+    for (int r = first_row; r < first_row + num_rows; ++r) {
+      for (int c = 0; c < kWidth; c += 3) pixels_[r * kStride + c] ^= 0x5a;
+    }
+  }
+
+  // Checks that the table updated for the current picture holds the same
+  // entries, in the same order, as one built for it from scratch.
+  void CheckUpdate() {
+    ASSERT_TRUE(av1_hash_table_update(&updated_, &picture_, kMinBlockSize,
+                                      kMaxBlockSize));
+    av1_hash_table_release(&rebuilt_);
+    ASSERT_TRUE(av1_hash_table_update(&rebuilt_, &picture_, kMinBlockSize,
+                                      kMaxBlockSize));
+    hash_table *updated = &updated_.intrabc_hash_table;
+    hash_table *rebuilt = &rebuilt_.intrabc_hash_table;
+    for (uint32_t addr = 0; addr < kNumAddresses; ++addr) {
+      const int count = av1_hash_table_count(rebuilt, addr);
+      ASSERT_EQ(av1_hash_table_count(updated, addr), count) << "addr " << addr;
+      if (count == 0) continue;
+      const block_hash *a =
+          static_cast<const block_hash *>(updated->p_lookup_table[addr]->data);
+      const block_hash *b =
+          static_cast<const block_hash *>(rebuilt->p_lookup_table[addr]->data);
+      for (int i = 0; i < count; ++i) {
+        ASSERT_EQ(a[i].x, b[i].x) << "addr " << addr << " entry " << i;
+        ASSERT_EQ(a[i].y, b[i].y) << "addr " << addr << " entry " << i;
+        ASSERT_EQ(a[i].hash_value2, b[i].hash_value2);
+      }
+    }
+  }
+
+  IntraBCHashInfo updated_;
+  IntraBCHashInfo rebuilt_;
+  std::vector<uint8_t> pixels_;
+  YV12_BUFFER_CONFIG picture_;
+};
+
+TEST_F(HashTableUpdateTest, UnchangedPicture) {
+  ASSERT_TRUE(av1_hash_table_update(&updated_, &picture_, kMinBlockSize,
+                                    kMaxBlockSize));
+  CheckUpdate();
+}
+
+TEST_F(HashTableUpdateTest, ChangedRows) {
+  ASSERT_TRUE(av1_hash_table_update(&updated_, &picture_, kMinBlockSize,
+                                    kMaxBlockSize));
+  ChangeRows(70, 5);
+  CheckUpdate();
+  // Bands close enough to be hashed together.
+  ChangeRows(3, 2);
+  ChangeRows(40, 1);
+  CheckUpdate();
+  // Bands hashed separately, including the last rows of the picture.
+  ChangeRows(0, 1);
+  ChangeRows(130, 20);
+  ChangeRows(kHeight - 3, 3);
+  CheckUpdate();
+  ChangeRows(0, kHeight);
+  CheckUpdate();
+}
+
+TEST_F(HashTableUpdateTest, ChangedPictureSize) {
+  ASSERT_TRUE(av1_hash_table_update(&updated_, &picture_, kMinBlockSize,
+                                    kMaxBlockSize));
+  picture_.y_crop_width = kWidth - 40;
+  picture_.y_crop_height = kHeight - 70;
+  CheckUpdate();
+}
+
+}  // namespace
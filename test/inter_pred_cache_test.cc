@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string.h>
+
+#include "aom_mem/aom_mem.h"
+#include "av1/encoder/inter_pred_cache.h"
+#include "test/acm_random.h"
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+namespace {
+
+const int kStride = 160;
+
+class InterPredCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    cache_ = static_cast<InterPredCache *>(aom_memalign(32, sizeof(*cache_)));
+    ASSERT_NE(cache_, nullptr);
+    av1_inter_pred_cache_reset(cache_);
+    libaom_test::ACMRandom rnd(libaom_test::ACMRandom::DeterministicSeed());
+    for (int i = 0; i < kStride * kStride; ++i) {
+      pred_[i] = rnd.Rand8();
+      pred16_[i] = rnd.Rand16() & 1023;
+    }
+    memset(&key_, 0, sizeof(key_));
+    key_.ref_buf = pred_;
+    key_.subpel_x = 3;
+  }
+  void TearDown() override { aom_free(cache_); }
+
+  // Checks that the (x, y, w, h) region of a block stored at (0, 0) is read
+  // back from the cache.
+  void CheckRead(int x, int y, int w, int h) {
+    uint8_t out[kStride * kStride];
+    ASSERT_EQ(
+        av1_inter_pred_cache_read(cache_, &key_, x, y, w, h, out, kStride, 0),
+        1);
+    for (int r = 0; r < h; ++r) {
+      ASSERT_EQ(memcmp(out + r * kStride, pred_ + (y + r) * kStride + x, w), 0)
+          << "row " << r;
+    }
+  }
+
+  InterPredCache *cache_;
+  InterPredKey key_;
+  uint8_t pred_[kStride * kStride];
+  uint16_t pred16_[kStride * kStride];
+};
+
+TEST_F(InterPredCacheTest, ChildReadsParentRegion) {
+  av1_inter_pred_cache_write(cache_, &key_, 0, 0, 64, 32, pred_, kStride, 0);
+  CheckRead(0, 0, 64, 32);
+  CheckRead(32, 16, 32, 16);
+  CheckRead(8, 4, 4, 8);
+
+  uint8_t out[kStride * kStride];
+  // Regions that are not fully inside the stored one miss.
+  EXPECT_EQ(
+      av1_inter_pred_cache_read(cache_, &key_, 48, 0, 32, 16, out, kStride, 0),
+      0);
+  EXPECT_EQ(
+      av1_inter_pred_cache_read(cache_, &key_, 0, 16, 16, 32, out, kStride, 0),
+      0);
+  // So do blocks with a different key.
+  InterPredKey other = key_;
+  other.offset_x = 1;
+  EXPECT_EQ(
+      av1_inter_pred_cache_read(cache_, &other, 0, 0, 8, 8, out, kStride, 0),
+      0);
+  other = key_;
+  other.subpel_y = 5;
+  EXPECT_EQ(
+      av1_inter_pred_cache_read(cache_, &other, 0, 0, 8, 8, out, kStride, 0),
+      0);
+
+  av1_inter_pred_cache_reset(cache_);
+  EXPECT_EQ(
+      av1_inter_pred_cache_read(cache_, &key_, 0, 0, 8, 8, out, kStride, 0), 0);
+}
+
+TEST_F(InterPredCacheTest, HighBitDepth) {
+  av1_inter_pred_cache_write(cache_, &key_, 16, 16, 32, 32,
+                             CONVERT_TO_BYTEPTR(pred16_), kStride, 1);
+  uint16_t out[kStride * kStride];
+  ASSERT_EQ(av1_inter_pred_cache_read(cache_, &key_, 24, 32, 16, 8,
+                                      CONVERT_TO_BYTEPTR(out), kStride, 1),
+            1);
+  for (int r = 0; r < 8; ++r) {
+    ASSERT_EQ(memcmp(out + r * kStride, pred16_ + (16 + r) * kStride + 8,
+                     16 * sizeof(*out)),
+              0)
+        << "row " << r;
+  }
+}
+
+TEST_F(InterPredCacheTest, EvictsLeastRecentlyUsed) {
+  InterPredKey keys[INTER_PRED_CACHE_ENTRIES + 1];
+  for (int i = 0; i <= INTER_PRED_CACHE_ENTRIES; ++i) {
+    keys[i] = key_;
+    keys[i].offset_y = i;
+  }
+  for (int i = 0; i < INTER_PRED_CACHE_ENTRIES; ++i) {
+    av1_inter_pred_cache_write(cache_, &keys[i], 0, 0, 16, 16, pred_, kStride,
+                               0);
+  }
+  uint8_t out[kStride * kStride];
+  // Touch the oldest entry so that the second one is recycled instead.
+  ASSERT_EQ(av1_inter_pred_cache_read(cache_, &keys[0], 0, 0, 8, 8, out,
+                                      kStride, 0),
+            1);
+  av1_inter_pred_cache_write(cache_, &keys[INTER_PRED_CACHE_ENTRIES], 0, 0, 16,
+                             16, pred_, kStride, 0);
+  for (int i = 0; i <= INTER_PRED_CACHE_ENTRIES; ++i) {
+    EXPECT_EQ(av1_inter_pred_cache_read(cache_, &keys[i], 0, 0, 16, 16, out,
+                                        kStride, 0),
+              i != 1)
+        << "entry " << i;
+  }
+}
+
+TEST_F(InterPredCacheTest, LargerRegionReplacesContainedEntry) {
+  av1_inter_pred_cache_write(cache_, &key_, 16, 0, 16, 16, pred_ + 16, kStride,
+                             0);
+  // Fill the rest of the cache with other keys.
+  for (int i = 1; i < INTER_PRED_CACHE_ENTRIES; ++i) {
+    InterPredKey other = key_;
+    other.offset_x = i;
+    av1_inter_pred_cache_write(cache_, &other, 0, 0, 8, 8, pred_, kStride, 0);
+  }
+  // The parent region takes over the entry of its own child, keeping all the
+  // other keys.
+  av1_inter_pred_cache_write(cache_, &key_, 0, 0, 32, 32, pred_, kStride, 0);
+  CheckRead(16, 0, 16, 16);
+  CheckRead(0, 16, 16, 16);
+  uint8_t out[kStride * kStride];
+  for (int i = 1; i < INTER_PRED_CACHE_ENTRIES; ++i) {
+    InterPredKey other = key_;
+    other.offset_x = i;
+    EXPECT_EQ(
+        av1_inter_pred_cache_read(cache_, &other, 0, 0, 8, 8, out, kStride, 0),
+        1);
+  }
+}
+
+}  // namespace
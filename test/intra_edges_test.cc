@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string.h>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+#include "config/aom_config.h"
+
+#include "av1/common/reconintra.h"
+#include "test/acm_random.h"
+
+namespace {
+
+const int kFrameSize = 128;
+const int kStride = kFrameSize + 64;
+const int kBorder = 32;
+
+// Blocks that are a single transform block.
+const BLOCK_SIZE kBlockSizes[] = { BLOCK_4X4,   BLOCK_4X8,   BLOCK_8X4,
+                                   BLOCK_8X8,   BLOCK_8X16,  BLOCK_16X8,
+                                   BLOCK_16X16, BLOCK_16X32, BLOCK_32X16,
+                                   BLOCK_32X32, BLOCK_4X16,  BLOCK_16X4,
+                                   BLOCK_8X32,  BLOCK_32X8 };
+
+class IntraEdgesTest : public ::testing::TestWithParam<int> {
+ protected:
+  void SetUp() override {
+    av1_init_intra_predictors();
+    use_hbd_ = GetParam() > 8;
+    libaom_test::ACMRandom rnd(libaom_test::ACMRandom::DeterministicSeed());
+    const int mask = (1 << GetParam()) - 1;
+    for (int i = 0; i < kStride * (kFrameSize + kBorder); ++i) {
+      frame16_[i] = rnd.Rand16() & mask;
+      frame_[i] = static_cast<uint8_t>(frame16_[i]);
+    }
+    memset(&buf_, 0, sizeof(buf_));
+    buf_.flags = use_hbd_ ? YV12_FLAG_HIGHBITDEPTH : 0;
+    memset(&xd_, 0, sizeof(xd_));
+    memset(&mbmi_, 0, sizeof(mbmi_));
+    memset(&smooth_mbmi_, 0, sizeof(smooth_mbmi_));
+    smooth_mbmi_.mode = SMOOTH_PRED;
+    mi_ = &mbmi_;
+    xd_.mi = &mi_;
+    xd_.cur_buf = &buf_;
+    xd_.bd = GetParam();
+    xd_.tile.mi_col_end = kFrameSize / MI_SIZE;
+    xd_.tile.mi_row_end = kFrameSize / MI_SIZE;
+  }
+
+  // Places a block of the given size at (mi_row, mi_col) of the frame.
+  void SetBlock(BLOCK_SIZE bsize, int mi_row, int mi_col) {
+    const int mi_size = kFrameSize / MI_SIZE;
+    mbmi_.bsize = bsize;
+    mbmi_.partition = PARTITION_NONE;
+    xd_.up_available = mi_row > 0;
+    xd_.left_available = mi_col > 0;
+    xd_.mb_to_top_edge = -GET_MV_SUBPEL(mi_row * MI_SIZE);
+    xd_.mb_to_left_edge = -GET_MV_SUBPEL(mi_col * MI_SIZE);
+    xd_.mb_to_bottom_edge =
+        GET_MV_SUBPEL((mi_size - mi_size_high[bsize] - mi_row) * MI_SIZE);
+    xd_.mb_to_right_edge =
+        GET_MV_SUBPEL((mi_size - mi_size_wide[bsize] - mi_col) * MI_SIZE);
+    const int offset = mi_row * MI_SIZE * kStride + mi_col * MI_SIZE;
+    ref_ = use_hbd_ ? CONVERT_TO_BYTEPTR(frame16_ + kBorder * kStride + offset)
+                    : frame_ + kBorder * kStride + offset;
+  }
+
+  // Checks the predictions built from the gathered edges against those of
+  // av1_predict_intra_block() for every directional mode and angle delta.
+  void CheckAllAngles(int enable_edge_filter) {
+    const BLOCK_SIZE bsize = mbmi_.bsize;
+    const TX_SIZE tx_size = max_txsize_rect_lookup[bsize];
+    const int bw = block_size_wide[bsize];
+    const int bh = block_size_high[bsize];
+    IntraEdges edges;
+    av1_prepare_dr_intra_edges(&xd_, BLOCK_64X64, enable_edge_filter, bw, bh,
+                               tx_size, ref_, kStride, 0, 0, 0, &edges);
+    for (int mode = V_PRED; mode <= D67_PRED; ++mode) {
+      for (int delta = -MAX_ANGLE_DELTA; delta <= MAX_ANGLE_DELTA; ++delta) {
+        mbmi_.mode = static_cast<PREDICTION_MODE>(mode);
+        uint8_t *ref_pred = Pred(ref_pred_, ref_pred16_);
+        uint8_t *pred = Pred(pred_, pred16_);
+        av1_predict_intra_block(&xd_, BLOCK_64X64, enable_edge_filter, bw, bh,
+                                tx_size, mbmi_.mode, delta * ANGLE_STEP, 0,
+                                FILTER_INTRA_MODES, ref_, kStride, ref_pred,
+                                MAX_TX_SIZE, 0, 0, 0);
+        av1_predict_dr_intra_from_edges(
+            &edges, mode_to_angle_map[mode] + delta * ANGLE_STEP, pred,
+            MAX_TX_SIZE);
+        for (int r = 0; r < bh; ++r) {
+          for (int c = 0; c < bw; ++c) {
+            const int i = r * MAX_TX_SIZE + c;
+            ASSERT_EQ(use_hbd_ ? pred16_[i] : pred_[i],
+                      use_hbd_ ? ref_pred16_[i] : ref_pred_[i])
+                << "bsize " << bsize << " mode " << mode << " delta " << delta
+                << " at " << r << "," << c;
+          }
+        }
+      }
+    }
+  }
+
+  uint8_t *Pred(uint8_t *buf, uint16_t *buf16) {
+    return use_hbd_ ? CONVERT_TO_BYTEPTR(buf16) : buf;
+  }
+
+  bool use_hbd_;
+  YV12_BUFFER_CONFIG buf_;
+  MACROBLOCKD xd_;
+  MB_MODE_INFO mbmi_;
+  MB_MODE_INFO smooth_mbmi_;
+  MB_MODE_INFO *mi_;
+  uint8_t *ref_;
+  uint8_t frame_[kStride * (kFrameSize + kBorder)];
+  uint16_t frame16_[kStride * (kFrameSize + kBorder)];
+  uint8_t pred_[MAX_TX_SQUARE];
+  uint8_t ref_pred_[MAX_TX_SQUARE];
+  uint16_t pred16_[MAX_TX_SQUARE];
+  uint16_t ref_pred16_[MAX_TX_SQUARE];
+};
+
+TEST_P(IntraEdgesTest, MatchesPredictIntraBlock) {
+  // Corners, edges and the inside of the frame.
+  const int kPositions[][2] = { { 0, 0 },  { 0, 8 },   { 8, 0 },
+                                { 8, 8 },  { 4, 26 },  { 26, 4 },
+                                { 12, 6 }, { 24, 24 } };
+  for (const BLOCK_SIZE bsize : kBlockSizes) {
+    for (const auto &pos : kPositions) {
+      if (pos[0] + mi_size_high[bsize] > kFrameSize / MI_SIZE ||
+          pos[1] + mi_size_wide[bsize] > kFrameSize / MI_SIZE) {
+        continue;
+      }
+      SetBlock(bsize, pos[0], pos[1]);
+      for (int smooth = 0; smooth <= 1; ++smooth) {
+        xd_.above_mbmi = smooth ? &smooth_mbmi_ : nullptr;
+        CheckAllAngles(/*enable_edge_filter=*/1);
+        if (HasFatalFailure()) return;
+      }
+      CheckAllAngles(/*enable_edge_filter=*/0);
+      if (HasFatalFailure()) return;
+    }
+  }
+}
+
+#if CONFIG_AV1_HIGHBITDEPTH
+INSTANTIATE_TEST_SUITE_P(C, IntraEdgesTest, ::testing::Values(8, 10, 12));
+#else
+INSTANTIATE_TEST_SUITE_P(C, IntraEdgesTest, ::testing::Values(8));
+#endif
+
+}  // namespace
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string.h>
+
+#include "av1/encoder/motion_field_cache.h"
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+namespace {
+
+const int kWidth = 100;
+const int kHeight = 60;
+
+class MotionFieldCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override { memset(&cache_, 0, sizeof(cache_)); }
+  void TearDown() override { av1_mf_cache_free(&cache_); }
+
+  MotionFieldCache cache_;
+};
+
+TEST_F(MotionFieldCacheTest, StoreAndLookup) {
+  MotionField *mf = av1_mf_cache_get(&cache_, 5, 4, kWidth, kHeight);
+  ASSERT_NE(mf, nullptr);
+  ASSERT_EQ(av1_mf_alloc_level(mf, av1_mf_level(4)), 1);
+  // Blocks that were never searched are not returned.
+  EXPECT_EQ(av1_mf_lookup(mf, 1, 0, 0, nullptr), nullptr);
+
+  const MV mv = { -12, 34 };
+  // The last partial 16x16 column still has a block.
+  av1_mf_store(mf, 1, 96, 48, mv, 7);
+  int level = -1;
+  const MotionFieldBlock *b = av1_mf_lookup(mf, 1, 99, 59, &level);
+  ASSERT_NE(b, nullptr);
+  EXPECT_EQ(level, 1);
+  EXPECT_EQ(b->mv.as_mv.row, mv.row);
+  EXPECT_EQ(b->mv.as_mv.col, mv.col);
+  EXPECT_EQ(b->err, 7u);
+  EXPECT_EQ(av1_mf_lookup(mf, 1, 100, 59, nullptr), nullptr);
+
+  // Falls back to the stored level when the requested one is missing.
+  b = av1_mf_lookup(mf, 2, 99, 59, &level);
+  ASSERT_NE(b, nullptr);
+  EXPECT_EQ(level, 1);
+
+  EXPECT_EQ(av1_mf_cache_find(&cache_, 5, 4, kWidth, kHeight), mf);
+  EXPECT_EQ(av1_mf_cache_find(&cache_, 4, 5, kWidth, kHeight), nullptr);
+  EXPECT_EQ(av1_mf_cache_find(&cache_, 5, 4, kWidth / 2, kHeight), nullptr);
+  // Getting the same pair again keeps the stored vectors.
+  EXPECT_EQ(av1_mf_cache_get(&cache_, 5, 4, kWidth, kHeight), mf);
+  EXPECT_NE(av1_mf_lookup(mf, 1, 99, 59, nullptr), nullptr);
+}
+
+TEST_F(MotionFieldCacheTest, ResizeClearsField) {
+  MotionField *mf = av1_mf_cache_get(&cache_, 1, 0, kWidth, kHeight);
+  ASSERT_EQ(av1_mf_alloc_level(mf, 0), 1);
+  const MV mv = { 1, 1 };
+  av1_mf_store(mf, 0, 0, 0, mv, 0);
+  ASSERT_NE(av1_mf_lookup(mf, 0, 0, 0, nullptr), nullptr);
+
+  EXPECT_EQ(av1_mf_cache_get(&cache_, 1, 0, kWidth * 2, kHeight), mf);
+  EXPECT_EQ(mf->blocks[0], nullptr);
+  EXPECT_EQ(av1_mf_lookup(mf, 0, 0, 0, nullptr), nullptr);
+}
+
+TEST_F(MotionFieldCacheTest, EvictsLeastRecentlyUsed) {
+  for (int i = 0; i < MF_CACHE_MAX_FIELDS; ++i) {
+    MotionField *mf = av1_mf_cache_get(&cache_, i + 1, i, kWidth, kHeight);
+    ASSERT_EQ(av1_mf_alloc_level(mf, 2), 1);
+    const MV mv = { static_cast<int16_t>(i), 0 };
+    av1_mf_store(mf, 2, 0, 0, mv, 0);
+  }
+  // Touch the oldest field so that the second one is recycled instead.
+  av1_mf_cache_get(&cache_, 1, 0, kWidth, kHeight);
+  MotionField *mf = av1_mf_cache_get(&cache_, 100, 99, kWidth, kHeight);
+  EXPECT_EQ(av1_mf_lookup(mf, 2, 0, 0, nullptr), nullptr);
+  EXPECT_NE(av1_mf_cache_find(&cache_, 1, 0, kWidth, kHeight), nullptr);
+  EXPECT_EQ(av1_mf_cache_find(&cache_, 2, 1, kWidth, kHeight), nullptr);
+  for (int i = 2; i < MF_CACHE_MAX_FIELDS; ++i) {
+    const MotionField *found =
+        av1_mf_cache_find(&cache_, i + 1, i, kWidth, kHeight);
+    ASSERT_NE(found, nullptr);
+    const MotionFieldBlock *b = av1_mf_lookup(found, 2, 0, 0, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(b->mv.as_mv.row, i);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+#include "config/aom_dsp_rtcd.h"
+
+#include "aom_dsp/pyramid.h"
+#include "aom_scale/yv12config.h"
+#include "av1/encoder/encoder.h"
+#include "test/acm_random.h"
+
+namespace {
+
+const int kWidth = 256;
+const int kHeight = 192;
+const int kPyramidLevels = 4;
+// Texture is generated on a grid this coarse and interpolated, so that the
+// downsampled levels keep enough detail to match on.
+const int kGridStep = 8;
+
+class PyramidSearchTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    aom_dsp_rtcd();
+    rnd_.Reset(libaom_test::ACMRandom::DeterministicSeed());
+    memset(&src_, 0, sizeof(src_));
+    memset(&ref_, 0, sizeof(ref_));
+    ASSERT_EQ(aom_alloc_frame_buffer(&src_, kWidth, kHeight, 1, 1, 0, 32, 16,
+                                     kPyramidLevels, 0),
+              0);
+    ASSERT_EQ(aom_alloc_frame_buffer(&ref_, kWidth, kHeight, 1, 1, 0, 32, 16,
+                                     kPyramidLevels, 0),
+              0);
+    const int grid_w = (kWidth + 2 * kMaxShift) / kGridStep + 2;
+    const int grid_h = (kHeight + 2 * kMaxShift) / kGridStep + 2;
+    grid_.resize(grid_w * grid_h);
+    grid_w_ = grid_w;
+    for (int &v : grid_) v = rnd_.Rand8();
+  }
+
+  void TearDown() override {
+    aom_free_frame_buffer(&src_);
+    aom_free_frame_buffer(&ref_);
+  }
+
+  // Smooth texture value at (r, c), with r and c in [-kMaxShift,
+  // size + kMaxShift).
+  uint8_t Texture(int r, int c) const {
+    r += kMaxShift;
+    c += kMaxShift;
+    const int gr = r / kGridStep, gc = c / kGridStep;
+    const int fr = r % kGridStep, fc = c % kGridStep;
+    const int *g = &grid_[gr * grid_w_ + gc];
+    const int top = g[0] * (kGridStep - fc) + g[1] * fc;
+    const int bottom = g[grid_w_] * (kGridStep - fc) + g[grid_w_ + 1] * fc;
+    return static_cast<uint8_t>((top * (kGridStep - fr) + bottom * fr) /
+                                (kGridStep * kGridStep));
+  }
+
+  // Fills the frames so that the block at (y, x) in the source is found at
+  // (y + mv.row, x + mv.col) in the reference.
+  void FillFrames(FULLPEL_MV mv) {
+    for (int r = 0; r < kHeight; ++r) {
+      for (int c = 0; c < kWidth; ++c) {
+        src_.y_buffer[r * src_.y_stride + c] = Texture(r, c);
+        ref_.y_buffer[r * ref_.y_stride + c] = Texture(r - mv.row, c - mv.col);
+      }
+    }
+    aom_invalidate_pyramid(src_.y_pyramid);
+    aom_invalidate_pyramid(ref_.y_pyramid);
+    aom_compute_pyramid(&src_, 8, src_.y_pyramid);
+    aom_compute_pyramid(&ref_, 8, ref_.y_pyramid);
+  }
+
+  static const int kMaxShift = 64;
+  libaom_test::ACMRandom rnd_;
+  YV12_BUFFER_CONFIG src_;
+  YV12_BUFFER_CONFIG ref_;
+  std::vector<int> grid_;
+  int grid_w_;
+};
+
+TEST_F(PyramidSearchTest, FindsLargeMotion) {
+  const FullMvLimits limits = { -96, 96, -96, 96 };
+  const FULLPEL_MV start_mv = { 0, 0 };
+  const FULLPEL_MV kMotion[] = {
+    { 0, 0 }, { 20, -28 }, { -41, 53 }, { 7, 60 }
+  };
+  for (const FULLPEL_MV &mv : kMotion) {
+    FillFrames(mv);
+    const FULLPEL_MV found = av1_pyramid_full_pixel_search(
+        src_.y_pyramid, ref_.y_pyramid, 96, 64, 32, 32, 3, &limits, start_mv);
+    // The result comes from the half resolution level, so it is within a
+    // couple of pixels of the true motion.
+    EXPECT_LE(abs(found.row - mv.row), 2) << mv.row << "," << mv.col;
+    EXPECT_LE(abs(found.col - mv.col), 2) << mv.row << "," << mv.col;
+  }
+}
+
+TEST_F(PyramidSearchTest, RespectsLimits) {
+  const FULLPEL_MV motion = { -41, 53 };
+  FillFrames(motion);
+  const FullMvLimits limits = { -16, 16, -16, 16 };
+  const FULLPEL_MV start_mv = { 0, 0 };
+  const FULLPEL_MV found = av1_pyramid_full_pixel_search(
+      src_.y_pyramid, ref_.y_pyramid, 96, 64, 32, 32, 3, &limits, start_mv);
+  EXPECT_TRUE(av1_is_fullmv_in_range(&limits, found));
+}
+
+TEST_F(PyramidSearchTest, ReturnsStartWithoutLevels) {
+  FillFrames(FULLPEL_MV{ 20, -28 });
+  const FullMvLimits limits = { -96, 96, -96, 96 };
+  const FULLPEL_MV start_mv = { 3, -5 };
+  // No level above full resolution is allowed.
+  FULLPEL_MV found = av1_pyramid_full_pixel_search(
+      src_.y_pyramid, ref_.y_pyramid, 96, 64, 32, 32, 0, &limits, start_mv);
+  EXPECT_EQ(found.row, start_mv.row);
+  EXPECT_EQ(found.col, start_mv.col);
+  // Too small a block for any downsampled level.
+  found = av1_pyramid_full_pixel_search(src_.y_pyramid, ref_.y_pyramid, 96,
+                                        64, 4, 4, 3, &limits, start_mv);
+  EXPECT_EQ(found.row, start_mv.row);
+  EXPECT_EQ(found.col, start_mv.col);
+}
+
+}  // namespace
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+#include "aom/aomdx.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/util.h"
+#include "test/video_source.h"
+
+namespace {
+
+const int kWidth = 352;
+const int kHeight = 288;
+
+// Copies the rows handed out by the sub-frame output callback as they arrive,
+// and checks them against the frame of a decoder without the callback.
+class RowOutputTest : public ::libaom_test::CodecTestWith2Params<int, int>,
+                      public ::libaom_test::EncoderTest {
+ protected:
+  RowOutputTest()
+      : EncoderTest(GET_PARAM(0)), tile_cols_log2_(GET_PARAM(1)),
+        enable_restoration_(GET_PARAM(2)) {}
+
+  ~RowOutputTest() override {
+    delete decoder_;
+    delete ref_decoder_;
+  }
+
+  void SetUp() override {
+    InitializeConfig(::libaom_test::kOnePassGood);
+    cfg_.g_lag_in_frames = 0;
+    cfg_.rc_target_bitrate = 300;
+    cfg_.rc_min_quantizer = 40;
+    aom_codec_dec_cfg_t dec_cfg = aom_codec_dec_cfg_t();
+    dec_cfg.threads = 1;
+    decoder_ = codec_->CreateDecoder(dec_cfg, 0);
+    ref_decoder_ = codec_->CreateDecoder(dec_cfg, 0);
+    aom_row_output_cb_init init = { RowOutput, this };
+    decoder_->Control(AV1D_SET_ROW_OUTPUT_CALLBACK, &init);
+  }
+
+  void PreEncodeFrameHook(::libaom_test::VideoSource *video,
+                          ::libaom_test::Encoder *encoder) override {
+    if (video->frame() == 0) {
+      encoder->Control(AOME_SET_CPUUSED, 5);
+      encoder->Control(AV1E_SET_TILE_COLUMNS, tile_cols_log2_);
+      encoder->Control(AV1E_SET_ENABLE_RESTORATION, enable_restoration_);
+    }
+  }
+
+  static void RowOutput(void *user_priv, const aom_image_t *img,
+                        unsigned int row_start, unsigned int row_end) {
+    static_cast<RowOutputTest *>(user_priv)->CopyRows(img, row_start, row_end);
+  }
+
+  void CopyRows(const aom_image_t *img, unsigned int row_start,
+                unsigned int row_end) {
+    EXPECT_EQ(row_start, rows_out_);
+    EXPECT_LT(row_start, row_end);
+    EXPECT_LE(row_end, img->d_h);
+    rows_out_ = row_end;
+    ++num_calls_;
+    const int bytes = (img->fmt & AOM_IMG_FMT_HIGHBITDEPTH) ? 2 : 1;
+    for (int plane = 0; plane < 3; ++plane) {
+      const int ss_y = plane ? img->y_chroma_shift : 0;
+      const int ss_x = plane ? img->x_chroma_shift : 0;
+      const size_t width = ((img->d_w + ss_x) >> ss_x) * bytes;
+      const unsigned int start = (row_start + ss_y) >> ss_y;
+      const unsigned int end = (row_end + ss_y) >> ss_y;
+      std::vector<uint8_t> &rows = rows_[plane];
+      rows.resize(width * ((img->d_h + ss_y) >> ss_y));
+      for (unsigned int r = start; r < end; ++r) {
+        memcpy(&rows[r * width], img->planes[plane] + r * img->stride[plane],
+               width);
+      }
+    }
+  }
+
+  void FramePktHook(const aom_codec_cx_pkt_t *pkt) override {
+    rows_out_ = 0;
+    num_calls_ = 0;
+    const uint8_t *data = static_cast<const uint8_t *>(pkt->data.frame.buf);
+    ASSERT_EQ(decoder_->DecodeFrame(data, pkt->data.frame.sz), AOM_CODEC_OK)
+        << decoder_->DecodeError();
+    ASSERT_EQ(ref_decoder_->DecodeFrame(data, pkt->data.frame.sz),
+              AOM_CODEC_OK)
+        << ref_decoder_->DecodeError();
+    ::libaom_test::DxDataIterator dec_iter = ref_decoder_->GetDxData();
+    const aom_image_t *img = dec_iter.Next();
+    ASSERT_NE(img, nullptr);
+    ASSERT_EQ(rows_out_, img->d_h);
+    // Without loop restoration and with a single tile column, the rows of a
+    // single thread decode are handed out while the frame is decoded.
+    if (!enable_restoration_ && tile_cols_log2_ == 0) {
+      EXPECT_GT(num_calls_, 1);
+    }
+    max_calls_ = std::max(max_calls_, num_calls_);
+
+    const int bytes = (img->fmt & AOM_IMG_FMT_HIGHBITDEPTH) ? 2 : 1;
+    for (int plane = 0; plane < 3; ++plane) {
+      const int ss_y = plane ? img->y_chroma_shift : 0;
+      const int ss_x = plane ? img->x_chroma_shift : 0;
+      const size_t width = ((img->d_w + ss_x) >> ss_x) * bytes;
+      const unsigned int height = (img->d_h + ss_y) >> ss_y;
+      for (unsigned int r = 0; r < height; ++r) {
+        ASSERT_EQ(memcmp(&rows_[plane][r * width],
+                         img->planes[plane] + r * img->stride[plane], width),
+                  0)
+            << "plane " << plane << " row " << r;
+      }
+    }
+  }
+
+  const int tile_cols_log2_;
+  const int enable_restoration_;
+  ::libaom_test::Decoder *decoder_ = nullptr;
+  ::libaom_test::Decoder *ref_decoder_ = nullptr;
+  unsigned int rows_out_ = 0;
+  int num_calls_ = 0;
+  int max_calls_ = 0;
+  std::vector<uint8_t> rows_[3];
+};
+
+TEST_P(RowOutputTest, RowsMatchDecodedFrame) {
+  ::libaom_test::RandomVideoSource video;
+  video.SetSize(kWidth, kHeight);
+  video.set_limit(6);
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  EXPECT_GT(max_calls_, 0);
+}
+
+AV1_INSTANTIATE_TEST_SUITE(RowOutputTest, ::testing::Values(0, 1),
+                           ::testing::Values(0, 1));
+
+}  // namespace
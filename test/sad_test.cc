@@ -63,6 +63,12 @@ typedef void (*SadMxNx4Func)(const uint8_t *src_ptr, int src_stride,
                              uint32_t *sad_array);
 typedef std::tuple<int, int, SadMxNx4Func, int> SadMxNx4Param;
 
+typedef void (*SadMxNx8Func)(const uint8_t *src_ptr, int src_stride,
+                             const uint8_t *const ref_ptr[], int ref_stride,
+                             uint32_t *sad_array);
+// |width|, |height|, |x8d function|, |x4d function of the same block size|
+typedef std::tuple<int, int, SadMxNx8Func, SadMxNx4Func> SadMxNx8Param;
+
 typedef void (*SadSkipMxNx4Func)(const uint8_t *src_ptr, int src_stride,
                                  const uint8_t *const ref_ptr[], int ref_stride,
                                  uint32_t *sad_array);
@@ -449,6 +455,71 @@ class SADx3Test : public ::testing::WithParamInterface<SadMxNx4Param>,
   }
 };
 
+class SADx8Test : public ::testing::WithParamInterface<SadMxNx8Param>,
+                  public SADTestBase {
+ public:
+  SADx8Test() : SADTestBase(GET_PARAM(0), GET_PARAM(1), -1) {}
+
+ protected:
+  // The buffer only holds 4 blocks, so the last 4 references are the first 4
+  // shifted by a few pixels.
+  uint8_t *GetReference(int block_idx) override {
+    return SADTestBase::GetReference(block_idx & 3) + (block_idx >> 2) * 3;
+  }
+
+  void FillReferences() {
+    for (int block = 0; block < 8; ++block) {
+      FillRandom(GetReference(block), reference_stride_);
+    }
+  }
+
+  void CheckSADs() {
+    const uint8_t *references[8];
+    for (int block = 0; block < 8; ++block) {
+      references[block] = GetReference(block);
+    }
+    unsigned int exp_sad[8];
+    API_REGISTER_STATE_CHECK(GET_PARAM(2)(
+        source_data_, source_stride_, references, reference_stride_, exp_sad));
+    for (int block = 0; block < 8; ++block) {
+      EXPECT_EQ(ReferenceSAD(block), exp_sad[block]) << "block " << block;
+    }
+  }
+
+  // Compares one 8-wide call against two calls of the 4-wide kernel.
+  void SpeedSADs() {
+    const int kNumLoops = 10000000;
+    const uint8_t *references[8];
+    for (int block = 0; block < 8; ++block) {
+      references[block] = GetReference(block);
+    }
+    unsigned int sads[8];
+    const SadMxNx8Func x8d = GET_PARAM(2);
+    const SadMxNx4Func x4d = GET_PARAM(3);
+
+    aom_usec_timer timer;
+    aom_usec_timer_start(&timer);
+    for (int i = 0; i < kNumLoops; ++i) {
+      x4d(source_data_, source_stride_, references, reference_stride_, sads);
+      x4d(source_data_, source_stride_, references + 4, reference_stride_,
+          sads + 4);
+    }
+    aom_usec_timer_mark(&timer);
+    const int64_t time_x4d = aom_usec_timer_elapsed(&timer) / 1000;
+
+    aom_usec_timer_start(&timer);
+    for (int i = 0; i < kNumLoops; ++i) {
+      x8d(source_data_, source_stride_, references, reference_stride_, sads);
+    }
+    aom_usec_timer_mark(&timer);
+    const int64_t time_x8d = aom_usec_timer_elapsed(&timer) / 1000;
+
+    std::cout << "BLOCK_" << width_ << "X" << height_
+              << ", 2 x4d calls: " << time_x4d << "ms, x8d: " << time_x8d
+              << "ms" << std::endl;
+  }
+};
+
 class SADSkipx4Test : public ::testing::WithParamInterface<SadMxNx4Param>,
                       public SADTestBase {
  public:
@@ -971,6 +1042,49 @@ TEST_P(SADx4Test, DISABLED_Speed) {
   SpeedSAD();
 }
 
+// SADx8
+TEST_P(SADx8Test, MaxRef) {
+  FillConstant(source_data_, source_stride_, 0);
+  for (int block = 0; block < 8; ++block) {
+    FillConstant(GetReference(block), reference_stride_, mask_);
+  }
+  CheckSADs();
+}
+
+TEST_P(SADx8Test, MaxSrc) {
+  FillConstant(source_data_, source_stride_, mask_);
+  for (int block = 0; block < 8; ++block) {
+    FillConstant(GetReference(block), reference_stride_, 0);
+  }
+  CheckSADs();
+}
+
+TEST_P(SADx8Test, UnalignedRef) {
+  int tmp_stride = reference_stride_;
+  reference_stride_ -= 1;
+  FillRandom(source_data_, source_stride_);
+  FillReferences();
+  CheckSADs();
+  reference_stride_ = tmp_stride;
+}
+
+TEST_P(SADx8Test, ShortSrc) {
+  int tmp_stride = source_stride_;
+  source_stride_ >>= 1;
+  for (int i = 0; i < 100; ++i) {
+    FillRandom(source_data_, source_stride_);
+    FillReferences();
+    CheckSADs();
+  }
+  source_stride_ = tmp_stride;
+}
+
+TEST_P(SADx8Test, DISABLED_Speed) {
+  FillRandom(source_data_, source_stride_);
+  FillReferences();
+  SpeedSADs();
+}
+
 // SADx3
 TEST_P(SADx3Test, MaxRef) {
   FillConstant(source_data_, source_stride_, 0);
@@ -1712,6 +1826,22 @@ const SadMxNx4Param x3d_c_tests[] = {
 };
 INSTANTIATE_TEST_SUITE_P(C, SADx3Test, ::testing::ValuesIn(x3d_c_tests));
 
+const SadMxNx8Param x8d_c_tests[] = {
+  make_tuple(128, 128, &aom_sad128x128x8d_c, &aom_sad128x128x4d_c),
+  make_tuple(64, 64, &aom_sad64x64x8d_c, &aom_sad64x64x4d_c),
+  make_tuple(32, 16, &aom_sad32x16x8d_c, &aom_sad32x16x4d_c),
+  make_tuple(16, 16, &aom_sad16x16x8d_c, &aom_sad16x16x4d_c),
+  make_tuple(8, 16, &aom_sad8x16x8d_c, &aom_sad8x16x4d_c),
+  make_tuple(8, 8, &aom_sad8x8x8d_c, &aom_sad8x8x4d_c),
+  make_tuple(4, 8, &aom_sad4x8x8d_c, &aom_sad4x8x4d_c),
+  make_tuple(4, 4, &aom_sad4x4x8d_c, &aom_sad4x4x4d_c),
+#if !CONFIG_REALTIME_ONLY
+  make_tuple(16, 4, &aom_sad16x4x8d_c, &aom_sad16x4x4d_c),
+  make_tuple(4, 16, &aom_sad4x16x8d_c, &aom_sad4x16x4d_c),
+#endif  // !CONFIG_REALTIME_ONLY
+};
+INSTANTIATE_TEST_SUITE_P(C, SADx8Test, ::testing::ValuesIn(x8d_c_tests));
+
 const SadMxNx4Param skip_x4d_c_tests[] = {
   make_tuple(128, 128, &aom_sad_skip_128x128x4d_c, -1),
   make_tuple(128, 64, &aom_sad_skip_128x64x4d_c, -1),
@@ -2837,6 +2967,28 @@ const SadMxNx4Param x4d_avx2_tests[] = {
 };
 INSTANTIATE_TEST_SUITE_P(AVX2, SADx4Test, ::testing::ValuesIn(x4d_avx2_tests));
 
+const SadMxNx8Param x8d_avx2_tests[] = {
+  make_tuple(16, 32, &aom_sad16x32x8d_avx2, &aom_sad16x32x4d_avx2),
+  make_tuple(16, 16, &aom_sad16x16x8d_avx2, &aom_sad16x16x4d_avx2),
+  make_tuple(16, 8, &aom_sad16x8x8d_avx2, &aom_sad16x8x4d_avx2),
+  make_tuple(32, 64, &aom_sad32x64x8d_avx2, &aom_sad32x64x4d_avx2),
+  make_tuple(32, 32, &aom_sad32x32x8d_avx2, &aom_sad32x32x4d_avx2),
+  make_tuple(32, 16, &aom_sad32x16x8d_avx2, &aom_sad32x16x4d_avx2),
+  make_tuple(64, 128, &aom_sad64x128x8d_avx2, &aom_sad64x128x4d_avx2),
+  make_tuple(64, 64, &aom_sad64x64x8d_avx2, &aom_sad64x64x4d_avx2),
+  make_tuple(64, 32, &aom_sad64x32x8d_avx2, &aom_sad64x32x4d_avx2),
+  make_tuple(128, 128, &aom_sad128x128x8d_avx2, &aom_sad128x128x4d_avx2),
+  make_tuple(128, 64, &aom_sad128x64x8d_avx2, &aom_sad128x64x4d_avx2),
+
+#if !CONFIG_REALTIME_ONLY
+  make_tuple(16, 64, &aom_sad16x64x8d_avx2, &aom_sad16x64x4d_avx2),
+  make_tuple(16, 4, &aom_sad16x4x8d_avx2, &aom_sad16x4x4d_avx2),
+  make_tuple(32, 8, &aom_sad32x8x8d_avx2, &aom_sad32x8x4d_avx2),
+  make_tuple(64, 16, &aom_sad64x16x8d_avx2, &aom_sad64x16x4d_avx2),
+#endif
+};
+INSTANTIATE_TEST_SUITE_P(AVX2, SADx8Test, ::testing::ValuesIn(x8d_avx2_tests));
+
 const SadMxNx4Param x3d_avx2_tests[] = {
   make_tuple(32, 64, &aom_sad32x64x3d_avx2, -1),
   make_tuple(32, 32, &aom_sad32x32x3d_avx2, -1),
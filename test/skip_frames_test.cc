@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+#include "aom/aomdx.h"
+#include "common/obudec.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/md5_helper.h"
+#include "test/util.h"
+#include "test/video_source.h"
+
+namespace {
+
+const int kNumFrames = 12;
+
+// Decodes the stream with each of the frame skipping modes next to a decoder
+// that decodes all the frames, and checks that the frames that are output
+// match.
+class SkipFramesTest : public ::libaom_test::CodecTestWithParam<int>,
+                       public ::libaom_test::EncoderTest {
+ protected:
+  SkipFramesTest() : EncoderTest(GET_PARAM(0)), lag_in_frames_(GET_PARAM(1)) {}
+
+  ~SkipFramesTest() override {
+    delete ref_decoder_;
+    delete non_ref_decoder_;
+    delete key_decoder_;
+  }
+
+  void SetUp() override {
+    InitializeConfig(::libaom_test::kOnePassGood);
+    cfg_.g_lag_in_frames = lag_in_frames_;
+    cfg_.kf_min_dist = 4;
+    cfg_.kf_max_dist = 4;
+    aom_codec_dec_cfg_t dec_cfg = aom_codec_dec_cfg_t();
+    ref_decoder_ = codec_->CreateDecoder(dec_cfg, 0);
+    non_ref_decoder_ = codec_->CreateDecoder(dec_cfg, 0);
+    key_decoder_ = codec_->CreateDecoder(dec_cfg, 0);
+    non_ref_decoder_->Control(AV1D_SET_SKIP_FRAMES, 1);
+    key_decoder_->Control(AV1D_SET_SKIP_FRAMES, 2);
+  }
+
+  void PreEncodeFrameHook(::libaom_test::VideoSource *video,
+                          ::libaom_test::Encoder *encoder) override {
+    if (video->frame() == 0) encoder->Control(AOME_SET_CPUUSED, 6);
+  }
+
+  // Decodes 'data' and returns the MD5 of the frame output, or an empty
+  // string if there is none.
+  static std::string Decode(::libaom_test::Decoder *decoder,
+                            const uint8_t *data, size_t size) {
+    EXPECT_EQ(decoder->DecodeFrame(data, size), AOM_CODEC_OK)
+        << decoder->DecodeError();
+    ::libaom_test::DxDataIterator dec_iter = decoder->GetDxData();
+    const aom_image_t *img = dec_iter.Next();
+    if (img == nullptr) return std::string();
+    ::libaom_test::MD5 md5;
+    md5.Add(img);
+    EXPECT_EQ(dec_iter.Next(), nullptr);
+    return md5.Get();
+  }
+
+  void FramePktHook(const aom_codec_cx_pkt_t *pkt) override {
+    const uint8_t *data = static_cast<const uint8_t *>(pkt->data.frame.buf);
+    const size_t size = pkt->data.frame.sz;
+    const bool is_key = (pkt->data.frame.flags & AOM_FRAME_IS_KEY) != 0;
+    EXPECT_EQ(obudec_temporal_unit_is_key_frame(data, size, 0), is_key);
+
+    const std::string ref_md5 = Decode(ref_decoder_, data, size);
+    ASSERT_FALSE(ref_md5.empty());
+    const std::string non_ref_md5 = Decode(non_ref_decoder_, data, size);
+    if (!non_ref_md5.empty()) {
+      EXPECT_EQ(non_ref_md5, ref_md5);
+      ++num_non_ref_decoder_frames_;
+    }
+    const std::string key_md5 = Decode(key_decoder_, data, size);
+    if (is_key) {
+      EXPECT_EQ(key_md5, ref_md5);
+      ++num_key_frames_;
+    } else {
+      EXPECT_TRUE(key_md5.empty());
+    }
+  }
+
+  const int lag_in_frames_;
+  ::libaom_test::Decoder *ref_decoder_ = nullptr;
+  ::libaom_test::Decoder *non_ref_decoder_ = nullptr;
+  ::libaom_test::Decoder *key_decoder_ = nullptr;
+  int num_non_ref_decoder_frames_ = 0;
+  int num_key_frames_ = 0;
+};
+
+TEST_P(SkipFramesTest, OutputMatchesFullDecode) {
+  ::libaom_test::RandomVideoSource video;
+  video.SetSize(176, 144);
+  video.set_limit(kNumFrames);
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  EXPECT_EQ(num_key_frames_, kNumFrames / 4);
+  EXPECT_GE(num_non_ref_decoder_frames_, num_key_frames_);
+}
+
+AV1_INSTANTIATE_TEST_SUITE(SkipFramesTest, ::testing::Values(0, 10));
+
+}  // namespace
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string.h>
+
+#include "av1/encoder/speed_control.h"
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+namespace {
+
+const int64_t kBudget = 10000;
+
+class SpeedControlTest : public ::testing::Test {
+ protected:
+  void SetUp() override { memset(&sc_, 0, sizeof(sc_)); }
+
+  SpeedControl sc_;
+};
+
+TEST_F(SpeedControlTest, DisabledKeepsSpeed) {
+  av1_speed_control_configure(&sc_, 0, 7, 11);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(av1_speed_control_update(&sc_, 100 * kBudget), 7);
+  }
+}
+
+TEST_F(SpeedControlTest, SpeedsUpOnOvershoot) {
+  av1_speed_control_configure(&sc_, kBudget, 7, 11);
+  // A single frame far over the budget moves up right away.
+  EXPECT_EQ(av1_speed_control_update(&sc_, 2 * kBudget), 8);
+  // A single frame just over the budget does not.
+  EXPECT_EQ(av1_speed_control_update(&sc_, kBudget + kBudget / 10), 8);
+  EXPECT_EQ(av1_speed_control_update(&sc_, kBudget + kBudget / 10), 9);
+  for (int i = 0; i < 10; ++i) av1_speed_control_update(&sc_, 3 * kBudget);
+  EXPECT_EQ(sc_.speed, 11);
+}
+
+TEST_F(SpeedControlTest, SlowsDownWithHeadroom) {
+  av1_speed_control_configure(&sc_, kBudget, 7, 11);
+  av1_speed_control_update(&sc_, 2 * kBudget);
+  ASSERT_EQ(sc_.speed, 8);
+  // Frames in the dead band between the thresholds keep the speed.
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_EQ(av1_speed_control_update(&sc_, kBudget * 3 / 4), 8);
+  }
+  int frames = 0;
+  while (sc_.speed == 8 && frames < 100) {
+    av1_speed_control_update(&sc_, kBudget / 4);
+    ++frames;
+  }
+  EXPECT_EQ(sc_.speed, 7);
+  EXPECT_GT(frames, 1);
+  // Never goes below the configured speed.
+  for (int i = 0; i < 100; ++i) av1_speed_control_update(&sc_, 0);
+  EXPECT_EQ(sc_.speed, 7);
+}
+
+TEST_F(SpeedControlTest, ReconfigureResets) {
+  av1_speed_control_configure(&sc_, kBudget, 7, 11);
+  av1_speed_control_update(&sc_, 2 * kBudget);
+  ASSERT_EQ(sc_.speed, 8);
+  // Same parameters keep the state.
+  av1_speed_control_configure(&sc_, kBudget, 7, 11);
+  EXPECT_EQ(sc_.speed, 8);
+  av1_speed_control_configure(&sc_, kBudget, 9, 11);
+  EXPECT_EQ(sc_.speed, 9);
+  EXPECT_EQ(sc_.frames_at_speed, 0);
+}
+
+}  // namespace
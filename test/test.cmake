@@ -149,13 +149,15 @@ if(NOT BUILD_SHARED_LIBS)
               "${AOM_ROOT}/test/hiprec_convolve_test.cc"
               "${AOM_ROOT}/test/hiprec_convolve_test_util.cc"
               "${AOM_ROOT}/test/hiprec_convolve_test_util.h"
+              "${AOM_ROOT}/test/intra_edges_test.cc"
               "${AOM_ROOT}/test/intrabc_test.cc"
               "${AOM_ROOT}/test/intrapred_test.cc"
               "${AOM_ROOT}/test/lpf_test.cc"
               "${AOM_ROOT}/test/scan_test.cc"
               "${AOM_ROOT}/test/selfguided_filter_test.cc"
               "${AOM_ROOT}/test/simd_cmp_impl.h"
-              "${AOM_ROOT}/test/simd_impl.h")
+              "${AOM_ROOT}/test/simd_impl.h"
+              "${AOM_ROOT}/test/yv12_extend_test.cc")
 
   list(APPEND AOM_UNIT_TEST_COMMON_INTRIN_NEON
               "${AOM_ROOT}/test/simd_cmp_neon.cc")
@@ -202,17 +204,22 @@ if(NOT BUILD_SHARED_LIBS)
               "${AOM_ROOT}/test/fwht4x4_test.cc"
               "${AOM_ROOT}/test/fdct4x4_test.cc"
               "${AOM_ROOT}/test/hadamard_test.cc"
+              "${AOM_ROOT}/test/hash_motion_test.cc"
               "${AOM_ROOT}/test/horver_correlation_test.cc"
+              "${AOM_ROOT}/test/inter_pred_cache_test.cc"
               "${AOM_ROOT}/test/masked_sad_test.cc"
               "${AOM_ROOT}/test/masked_variance_test.cc"
               "${AOM_ROOT}/test/minmax_test.cc"
+              "${AOM_ROOT}/test/motion_field_cache_test.cc"
               "${AOM_ROOT}/test/motion_vector_test.cc"
               "${AOM_ROOT}/test/mv_cost_test.cc"
               "${AOM_ROOT}/test/noise_model_test.cc"
               "${AOM_ROOT}/test/obmc_sad_test.cc"
               "${AOM_ROOT}/test/obmc_variance_test.cc"
               "${AOM_ROOT}/test/pickrst_test.cc"
+              "${AOM_ROOT}/test/pyramid_search_test.cc"
               "${AOM_ROOT}/test/sad_test.cc"
+              "${AOM_ROOT}/test/speed_control_test.cc"
               "${AOM_ROOT}/test/subtract_test.cc"
               "${AOM_ROOT}/test/reconinter_test.cc"
               "${AOM_ROOT}/test/sum_squares_test.cc"
@@ -240,6 +247,11 @@ if(NOT BUILD_SHARED_LIBS)
                 "${AOM_ROOT}/test/accounting_test.cc")
   endif()
 
+  if(CONFIG_AV1_DECODER)
+    list(APPEND AOM_UNIT_TEST_COMMON_SOURCES
+                "${AOM_ROOT}/test/av1_dequant_txb_test.cc")
+  endif()
+
   if(CONFIG_AV1_DECODER AND CONFIG_AV1_ENCODER)
     list(APPEND AOM_UNIT_TEST_COMMON_SOURCES
                 "${AOM_ROOT}/test/altref_test.cc"
@@ -248,22 +260,28 @@ if(NOT BUILD_SHARED_LIBS)
                 "${AOM_ROOT}/test/binary_codes_test.cc"
                 "${AOM_ROOT}/test/boolcoder_test.cc"
                 "${AOM_ROOT}/test/cnn_test.cc"
+                "${AOM_ROOT}/test/decode_batch_test.cc"
                 "${AOM_ROOT}/test/decode_multithreaded_test.cc"
+                "${AOM_ROOT}/test/decode_roi_test.cc"
+                "${AOM_ROOT}/test/decode_stats_test.cc"
                 "${AOM_ROOT}/test/divu_small_test.cc"
                 "${AOM_ROOT}/test/dr_prediction_test.cc"
                 "${AOM_ROOT}/test/ec_test.cc"
                 "${AOM_ROOT}/test/error_resilience_test.cc"
                 "${AOM_ROOT}/test/ethread_test.cc"
                 "${AOM_ROOT}/test/film_grain_table_test.cc"
+                "${AOM_ROOT}/test/grain_synthesis_test.cc"
                 "${AOM_ROOT}/test/kf_test.cc"
                 "${AOM_ROOT}/test/lossless_test.cc"
                 "${AOM_ROOT}/test/quant_test.cc"
                 "${AOM_ROOT}/test/ratectrl_test.cc"
                 "${AOM_ROOT}/test/rd_test.cc"
+                "${AOM_ROOT}/test/row_output_test.cc"
                 "${AOM_ROOT}/test/sb_multipass_test.cc"
                 "${AOM_ROOT}/test/sb_qp_sweep_test.cc"
                 "${AOM_ROOT}/test/screen_content_test.cc"
                 "${AOM_ROOT}/test/segment_binarization_sync.cc"
+                "${AOM_ROOT}/test/skip_frames_test.cc"
                 "${AOM_ROOT}/test/still_picture_test.cc"
                 "${AOM_ROOT}/test/temporal_filter_test.cc"
                 "${AOM_ROOT}/test/tile_config_test.cc"
@@ -279,7 +297,10 @@ if(NOT BUILD_SHARED_LIBS)
                        "${AOM_ROOT}/test/av1_encoder_parms_get_to_decoder.cc"
                        "${AOM_ROOT}/test/av1_ext_tile_test.cc"
                        "${AOM_ROOT}/test/cnn_test.cc"
+                       "${AOM_ROOT}/test/decode_batch_test.cc"
                        "${AOM_ROOT}/test/decode_multithreaded_test.cc"
+                       "${AOM_ROOT}/test/decode_roi_test.cc"
+                       "${AOM_ROOT}/test/decode_stats_test.cc"
                        "${AOM_ROOT}/test/error_resilience_test.cc"
                        "${AOM_ROOT}/test/kf_test.cc"
                        "${AOM_ROOT}/test/lossless_test.cc"
@@ -368,6 +389,7 @@ if(NOT BUILD_SHARED_LIBS)
                      "${AOM_ROOT}/test/obmc_sad_test.cc"
                      "${AOM_ROOT}/test/obmc_variance_test.cc"
                      "${AOM_ROOT}/test/pickrst_test.cc"
+                     "${AOM_ROOT}/test/pyramid_search_test.cc"
                      "${AOM_ROOT}/test/warp_filter_test.cc"
                      "${AOM_ROOT}/test/warp_filter_test_util.cc"
                      "${AOM_ROOT}/test/warp_filter_test_util.h"
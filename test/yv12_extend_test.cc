@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string.h>
+#include <tuple>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+#include "config/aom_config.h"
+#include "config/aom_scale_rtcd.h"
+
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_ports/aom_timer.h"
+#include "aom_scale/yv12config.h"
+#include "test/acm_random.h"
+#include "test/util.h"
+
+namespace {
+
+typedef void (*ExtendFrameFunc)(YV12_BUFFER_CONFIG *ybf, const int num_planes);
+typedef void (*ExtendPlaneRowFunc)(const YV12_BUFFER_CONFIG *ybf, int plane,
+                                   int v_start, int v_end);
+typedef void (*CopyFrameFunc)(const YV12_BUFFER_CONFIG *src_bc,
+                              YV12_BUFFER_CONFIG *dst_bc,
+                              const int num_planes);
+
+struct Yv12ExtendFuncs {
+  ExtendFrameFunc extend_frame;
+  ExtendPlaneRowFunc extend_plane_row;
+  CopyFrameFunc copy_frame;
+};
+
+struct FrameDims {
+  int width;
+  int height;
+  int border;
+};
+
+// Includes odd sizes so that the overlapping tail stores are exercised. The
+// frame buffer allocator requires borders to be a multiple of 32.
+const FrameDims kFrameDims[] = {
+  { 1, 1, 32 },     { 7, 9, 32 },     { 16, 16, 32 },     { 33, 17, 64 },
+  { 98, 66, 96 },   { 352, 288, 288 }, { 1920, 1080, 288 },
+};
+
+// |hbd|, |ss_x|, |ss_y|
+typedef std::tuple<Yv12ExtendFuncs, FrameDims, int, int, int> Yv12ExtendParam;
+
+class Yv12ExtendTest : public ::testing::TestWithParam<Yv12ExtendParam> {
+ public:
+  void SetUp() override {
+    rnd_.Reset(libaom_test::ACMRandom::DeterministicSeed());
+    funcs_ = GET_PARAM(0);
+    dims_ = GET_PARAM(1);
+    hbd_ = GET_PARAM(2);
+    memset(&ref_, 0, sizeof(ref_));
+    memset(&tst_, 0, sizeof(tst_));
+    memset(&src_, 0, sizeof(src_));
+    ASSERT_EQ(AllocFrame(&ref_), 0);
+    ASSERT_EQ(AllocFrame(&tst_), 0);
+    ASSERT_EQ(AllocFrame(&src_), 0);
+  }
+
+  void TearDown() override {
+    aom_free_frame_buffer(&ref_);
+    aom_free_frame_buffer(&tst_);
+    aom_free_frame_buffer(&src_);
+  }
+
+ protected:
+  int AllocFrame(YV12_BUFFER_CONFIG *ybf) {
+    return aom_alloc_frame_buffer(ybf, dims_.width, dims_.height,
+                                  GET_PARAM(3), GET_PARAM(4), hbd_,
+                                  dims_.border, 0, 0, 0);
+  }
+
+  void FillRandom(YV12_BUFFER_CONFIG *ybf) {
+    for (size_t i = 0; i < ybf->frame_size; ++i) {
+      ybf->buffer_alloc[i] = rnd_.Rand8();
+    }
+  }
+
+  void CheckEqual(const YV12_BUFFER_CONFIG &a, const YV12_BUFFER_CONFIG &b) {
+    ASSERT_EQ(a.frame_size, b.frame_size);
+    for (size_t i = 0; i < a.frame_size; ++i) {
+      ASSERT_EQ(a.buffer_alloc[i], b.buffer_alloc[i])
+          << "mismatch at byte " << i << " (" << dims_.width << "x"
+          << dims_.height << ", border " << dims_.border << ")";
+    }
+  }
+
+  libaom_test::ACMRandom rnd_;
+  Yv12ExtendFuncs funcs_;
+  FrameDims dims_;
+  int hbd_;
+  YV12_BUFFER_CONFIG ref_;
+  YV12_BUFFER_CONFIG tst_;
+  YV12_BUFFER_CONFIG src_;
+};
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(Yv12ExtendTest);
+
+TEST_P(Yv12ExtendTest, ExtendFrameBorders) {
+  FillRandom(&ref_);
+  memcpy(tst_.buffer_alloc, ref_.buffer_alloc, ref_.frame_size);
+  aom_yv12_extend_frame_borders_c(&ref_, 3);
+  funcs_.extend_frame(&tst_, 3);
+  CheckEqual(ref_, tst_);
+}
+
+TEST_P(Yv12ExtendTest, ExtendFrameBordersPlaneRow) {
+  FillRandom(&ref_);
+  memcpy(tst_.buffer_alloc, ref_.buffer_alloc, ref_.frame_size);
+  for (int plane = 0; plane < 3; ++plane) {
+    const int is_uv = plane > 0;
+    const int h = ref_.crop_heights[is_uv];
+    // Extend in uneven row ranges, as the decoder's row-based loop filter
+    // does.
+    for (int v_start = 0; v_start < h; v_start += 13) {
+      const int v_end = AOMMIN(v_start + 13, h);
+      aom_extend_frame_borders_plane_row_c(&ref_, plane, v_start, v_end);
+      funcs_.extend_plane_row(&tst_, plane, v_start, v_end);
+    }
+  }
+  CheckEqual(ref_, tst_);
+}
+
+TEST_P(Yv12ExtendTest, CopyFrame) {
+  FillRandom(&src_);
+  FillRandom(&ref_);
+  memcpy(tst_.buffer_alloc, ref_.buffer_alloc, ref_.frame_size);
+  aom_yv12_copy_frame_c(&src_, &ref_, 3);
+  funcs_.copy_frame(&src_, &tst_, 3);
+  CheckEqual(ref_, tst_);
+}
+
+TEST_P(Yv12ExtendTest, DISABLED_Speed) {
+  FillRandom(&src_);
+  const int kNumIters = 200;
+  const CopyFrameFunc copy_funcs[2] = { aom_yv12_copy_frame_c,
+                                        funcs_.copy_frame };
+  double elapsed_time[2];
+  for (int i = 0; i < 2; ++i) {
+    aom_usec_timer timer;
+    aom_usec_timer_start(&timer);
+    for (int j = 0; j < kNumIters; ++j) copy_funcs[i](&src_, &tst_, 3);
+    aom_usec_timer_mark(&timer);
+    elapsed_time[i] = static_cast<double>(aom_usec_timer_elapsed(&timer));
+  }
+  printf("aom_yv12_copy_frame %4dx%-4d hbd %d: %8.1f/%8.1fus (%4.2f)\n",
+         dims_.width, dims_.height, hbd_, elapsed_time[0] / kNumIters,
+         elapsed_time[1] / kNumIters, elapsed_time[0] / elapsed_time[1]);
+}
+
+#if CONFIG_AV1_HIGHBITDEPTH
+const int kHbd[] = { 0, 1 };
+#else
+const int kHbd[] = { 0 };
+#endif
+
+const Yv12ExtendFuncs kCFuncs = { aom_yv12_extend_frame_borders_c,
+                                  aom_extend_frame_borders_plane_row_c,
+                                  aom_yv12_copy_frame_c };
+INSTANTIATE_TEST_SUITE_P(C, Yv12ExtendTest,
+                         ::testing::Combine(::testing::Values(kCFuncs),
+                                            ::testing::ValuesIn(kFrameDims),
+                                            ::testing::ValuesIn(kHbd),
+                                            ::testing::Values(0, 1),
+                                            ::testing::Values(0, 1)));
+
+#if HAVE_SSE2
+const Yv12ExtendFuncs kSse2Funcs = { aom_yv12_extend_frame_borders_sse2,
+                                     aom_extend_frame_borders_plane_row_sse2,
+                                     aom_yv12_copy_frame_sse2 };
+INSTANTIATE_TEST_SUITE_P(SSE2, Yv12ExtendTest,
+                         ::testing::Combine(::testing::Values(kSse2Funcs),
+                                            ::testing::ValuesIn(kFrameDims),
+                                            ::testing::ValuesIn(kHbd),
+                                            ::testing::Values(0, 1),
+                                            ::testing::Values(0, 1)));
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+const Yv12ExtendFuncs kAvx2Funcs = { aom_yv12_extend_frame_borders_avx2,
+                                     aom_extend_frame_borders_plane_row_avx2,
+                                     aom_yv12_copy_frame_avx2 };
+INSTANTIATE_TEST_SUITE_P(AVX2, Yv12ExtendTest,
+                         ::testing::Combine(::testing::Values(kAvx2Funcs),
+                                            ::testing::ValuesIn(kFrameDims),
+                                            ::testing::ValuesIn(kHbd),
+                                            ::testing::Values(0, 1),
+                                            ::testing::Values(0, 1)));
+#endif  // HAVE_AVX2
+
+}  // namespace